@@ -13,6 +13,22 @@
 
 namespace emlang {
 
+// Attribute implementation
+std::string Attribute::toString() const {
+    std::stringstream ss;
+    ss << "#[" << name;
+    if (!args.empty()) {
+        ss << "(";
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (i > 0) ss << ", ";
+            ss << args[i];
+        }
+        ss << ")";
+    }
+    ss << "]";
+    return ss.str();
+}
+
 // ASTNode base class implementation
 ASTNode::ASTNode(NodeType type, size_t line, size_t column)
     : type(type), line(line), column(column) {}
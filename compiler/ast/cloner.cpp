@@ -0,0 +1,269 @@
+//===--- cloner.cpp - AST Deep Copy -----------------------------*- C++ -*-===//
+//
+// Part of the RNR Project, under the Apache License v2.0 with LLVM Exceptions.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Deep copy of AST subtrees with type substitution
+//===----------------------------------------------------------------------===//
+
+#include "ast/cloner.h"
+#include "ast/expr.h"
+#include "ast/stmt.h"
+#include "ast/decl.h"
+#include <cctype>
+
+namespace emlang {
+
+ASTCloner::ASTCloner(std::map<std::string, std::string> substitutions)
+    : substitutions_(std::move(substitutions)) {}
+
+ExpressionPtr ASTCloner::clone(Expression& expr) {
+    expr.accept(*this);
+    return std::move(exprResult_);
+}
+
+StatementPtr ASTCloner::clone(Statement& stmt) {
+    stmt.accept(*this);
+    return std::move(stmtResult_);
+}
+
+ExpressionPtr ASTCloner::cloneOptional(const ExpressionPtr& expr) {
+    return expr ? clone(*expr) : nullptr;
+}
+
+StatementPtr ASTCloner::cloneOptional(const StatementPtr& stmt) {
+    return stmt ? clone(*stmt) : nullptr;
+}
+
+std::string ASTCloner::substitute(const std::string& type) const {
+    if (substitutions_.empty()) {
+        return type;
+    }
+    // Replace whole identifiers only, so T does not match inside int32 or Tree
+    std::string result;
+    size_t i = 0;
+    while (i < type.size()) {
+        if (std::isalpha(static_cast<unsigned char>(type[i])) || type[i] == '_') {
+            size_t start = i;
+            while (i < type.size() && (std::isalnum(static_cast<unsigned char>(type[i])) || type[i] == '_')) {
+                ++i;
+            }
+            std::string name = type.substr(start, i - start);
+            auto it = substitutions_.find(name);
+            result += it != substitutions_.end() ? it->second : name;
+        } else {
+            result += type[i++];
+        }
+    }
+    return result;
+}
+
+/******************** Program ********************/
+
+void ASTCloner::visit(Program&) {
+    // Programs are never copied; only their statements are
+}
+
+/******************** Expressions ********************/
+
+void ASTCloner::visit(LiteralExpr& node) {
+    exprResult_ = std::make_unique<LiteralExpr>(node.literalType, node.value, node.line, node.column);
+}
+
+void ASTCloner::visit(IdentifierExpr& node) {
+    exprResult_ = std::make_unique<IdentifierExpr>(node.name, node.line, node.column);
+}
+
+void ASTCloner::visit(BinaryOpExpr& node) {
+    auto left = clone(*node.left);
+    auto right = clone(*node.right);
+    exprResult_ = std::make_unique<BinaryOpExpr>(std::move(left), node.operator_, std::move(right), node.line, node.column);
+}
+
+void ASTCloner::visit(UnaryOpExpr& node) {
+    auto operand = clone(*node.operand);
+    exprResult_ = std::make_unique<UnaryOpExpr>(node.operator_, std::move(operand), node.line, node.column);
+}
+
+void ASTCloner::visit(AssignmentExpr& node) {
+    auto target = clone(*node.target);
+    auto value = clone(*node.value);
+    exprResult_ = std::make_unique<AssignmentExpr>(std::move(target), std::move(value), node.line, node.column);
+}
+
+void ASTCloner::visit(FunctionCallExpr& node) {
+    std::vector<ExpressionPtr> args;
+    for (auto& arg : node.arguments) {
+        args.push_back(clone(*arg));
+    }
+    // Type arguments are deduced again for the copy
+    exprResult_ = std::make_unique<FunctionCallExpr>(node.functionName, std::move(args), node.line, node.column);
+}
+
+void ASTCloner::visit(MemberExpr& node) {
+    auto object = clone(*node.object);
+    exprResult_ = std::make_unique<MemberExpr>(std::move(object), node.memberName, node.isMethodCall, node.line, node.column);
+}
+
+#ifdef EMLANG_FEATURE_CASTING
+void ASTCloner::visit(CastExpr& node) {
+    auto operand = clone(*node.operand);
+    exprResult_ = std::make_unique<CastExpr>(std::move(operand), substitute(node.targetType), node.isExplicit, node.line, node.column);
+}
+#endif // EMLANG_FEATURE_CASTING
+
+void ASTCloner::visit(IndexExpr& node) {
+    auto array = clone(*node.array);
+    auto index = clone(*node.index);
+    exprResult_ = std::make_unique<IndexExpr>(std::move(array), std::move(index), node.line, node.column);
+}
+
+void ASTCloner::visit(SliceExpr& node) {
+    auto array = clone(*node.array);
+    auto start = cloneOptional(node.start);
+    auto end = cloneOptional(node.end);
+    exprResult_ = std::make_unique<SliceExpr>(std::move(array), std::move(start), std::move(end), node.line, node.column);
+}
+
+void ASTCloner::visit(ArrayExpr& node) {
+    std::vector<ExpressionPtr> elements;
+    for (auto& element : node.elements) {
+        elements.push_back(clone(*element));
+    }
+    exprResult_ = std::make_unique<ArrayExpr>(std::move(elements), node.line, node.column);
+}
+
+void ASTCloner::visit(ObjectExpr& node) {
+    std::vector<ObjectField> fields;
+    for (auto& field : node.fields) {
+        fields.emplace_back(field.key, clone(*field.value));
+    }
+    exprResult_ = std::make_unique<ObjectExpr>(std::move(fields), node.line, node.column);
+}
+
+void ASTCloner::visit(AwaitExpr& node) {
+    exprResult_ = std::make_unique<AwaitExpr>(clone(*node.operand), node.line, node.column);
+}
+
+#ifdef EMLANG_FEATURE_POINTERS
+void ASTCloner::visit(DereferenceExpr& node) {
+    auto operand = clone(*node.operand);
+    exprResult_ = std::make_unique<DereferenceExpr>(std::move(operand), node.line, node.column);
+}
+
+void ASTCloner::visit(AddressOfExpr& node) {
+    auto operand = clone(*node.operand);
+    exprResult_ = std::make_unique<AddressOfExpr>(std::move(operand), node.line, node.column);
+}
+#endif // EMLANG_FEATURE_POINTERS
+
+/******************** Declarations ********************/
+
+void ASTCloner::visit(VariableDecl& node) {
+    auto init = cloneOptional(node.initializer);
+    stmtResult_ = std::make_unique<VariableDecl>(
+        node.name, substitute(node.type.value_or("")), std::move(init), node.isConstant,
+        node.line, node.column, node.isRestrict);
+}
+
+void ASTCloner::visit(FunctionDecl& node) {
+    std::vector<Parameter> params;
+    for (const auto& param : node.parameters) {
+        params.emplace_back(param.name, substitute(param.type), param.isRestrict);
+    }
+    auto body = cloneOptional(node.body);
+    auto decl = std::make_unique<FunctionDecl>(
+        node.name, std::move(params), substitute(node.returnType.value_or("")), std::move(body),
+        node.isExtern, node.isAsync, node.isUnsafe, node.line, node.column);
+    decl->abi = node.abi;
+    decl->attributes = node.attributes;
+    decl->typeArguments = node.typeArguments;
+    // Type parameters that are substituted are no longer parameters of the copy
+    for (const auto& typeParam : node.typeParameters) {
+        if (substitutions_.find(typeParam.name) == substitutions_.end()) {
+            decl->typeParameters.push_back(typeParam);
+        }
+    }
+    stmtResult_ = std::move(decl);
+}
+
+void ASTCloner::visit(ExternFunctionDecl& node) {
+    std::vector<Parameter> params;
+    for (const auto& param : node.parameters) {
+        params.emplace_back(param.name, substitute(param.type), param.isRestrict);
+    }
+    stmtResult_ = std::make_unique<ExternFunctionDecl>(node.name, std::move(params), substitute(node.returnType), node.line, node.column);
+}
+
+void ASTCloner::visit(StructDecl& node) {
+    std::vector<StructField> fields;
+    for (const auto& field : node.fields) {
+        fields.push_back({field.name, substitute(field.type), field.line, field.column});
+    }
+    auto decl = std::make_unique<StructDecl>(node.name, std::move(fields), node.line, node.column);
+    decl->attributes = node.attributes;
+    stmtResult_ = std::move(decl);
+}
+
+/******************** Statements ********************/
+
+void ASTCloner::visit(BlockStmt& node) {
+    std::vector<StatementPtr> statements;
+    for (auto& stmt : node.statements) {
+        statements.push_back(cloneOptional(stmt));
+    }
+    stmtResult_ = std::make_unique<BlockStmt>(std::move(statements), node.line, node.column);
+}
+
+void ASTCloner::visit(IfStmt& node) {
+    auto condition = clone(*node.condition);
+    auto thenBranch = clone(*node.thenBranch);
+    auto elseBranch = cloneOptional(node.elseBranch);
+    stmtResult_ = std::make_unique<IfStmt>(std::move(condition), std::move(thenBranch), std::move(elseBranch), node.line, node.column);
+}
+
+void ASTCloner::visit(WhileStmt& node) {
+    auto condition = clone(*node.condition);
+    auto body = clone(*node.body);
+    stmtResult_ = std::make_unique<WhileStmt>(std::move(condition), std::move(body), node.line, node.column);
+}
+
+void ASTCloner::visit(ForStmt& node) {
+    if (node.isRange()) {
+        auto start = clone(*node.rangeStart);
+        auto end = clone(*node.rangeEnd);
+        auto step = cloneOptional(node.step);
+        auto body = clone(*node.body);
+        stmtResult_ = std::make_unique<ForStmt>(node.variable, std::move(start), std::move(end), std::move(step), std::move(body), node.line, node.column);
+        return;
+    }
+    auto init = cloneOptional(node.initializer);
+    auto condition = cloneOptional(node.condition);
+    auto increment = cloneOptional(node.increment);
+    auto body = clone(*node.body);
+    stmtResult_ = std::make_unique<ForStmt>(std::move(init), std::move(condition), std::move(increment), std::move(body), node.line, node.column);
+}
+
+void ASTCloner::visit(SwitchStmt& node) {
+    auto discriminant = clone(*node.discriminant);
+    std::vector<SwitchCase> cases;
+    for (auto& arm : node.cases) {
+        SwitchCase copy{{}, arm.isDefault, cloneOptional(arm.body), arm.line, arm.column};
+        for (auto& label : arm.labels) {
+            copy.labels.push_back(clone(*label));
+        }
+        cases.push_back(std::move(copy));
+    }
+    stmtResult_ = std::make_unique<SwitchStmt>(std::move(discriminant), std::move(cases), node.line, node.column);
+}
+
+void ASTCloner::visit(ReturnStmt& node) {
+    stmtResult_ = std::make_unique<ReturnStmt>(cloneOptional(node.value), node.line, node.column);
+}
+
+void ASTCloner::visit(ExpressionStmt& node) {
+    stmtResult_ = std::make_unique<ExpressionStmt>(clone(*node.expression), node.line, node.column);
+}
+
+} // namespace emlang
@@ -21,17 +21,22 @@ VariableDecl::VariableDecl(
     ExpressionPtr init, 
     bool isConst, 
     size_t line, 
-    size_t column
+    size_t column,
+    bool isRestrict
 ) : Statement(NodeType::VARIABLE_DECL, line, column), 
     name(name), 
     type(type), 
     initializer(std::move(init)), 
-    isConstant(isConst) {}
+    isConstant(isConst),
+    isRestrict(isRestrict) {}
 
 std::string VariableDecl::toString() const {
     std::string result = (isConstant ? "const " : "let ") + name;
     if (type.has_value() && !type->empty()) {
         result += ": " + type.value();
+        if (isRestrict) {
+            result += " restrict";
+        }
     }
     if (initializer) {
         result += " = " + initializer->toString();
@@ -63,12 +68,37 @@ FunctionDecl::FunctionDecl(
     isAsync(Async),
     isUnsafe(Unsafe) {}
 
+const Attribute* FunctionDecl::findAttribute(const std::string& attrName) const {
+    for (const auto& attribute : attributes) {
+        if (attribute.name == attrName) {
+            return &attribute;
+        }
+    }
+    return nullptr;
+}
+
 std::string FunctionDecl::toString() const {
     std::stringstream ss;
-    ss << "FunctionDecl(" << name << "(";
+    ss << "FunctionDecl(";
+    for (const auto& attribute : attributes) {
+        ss << attribute.toString() << " ";
+    }
+    if (isAsync) ss << "async ";
+    ss << name;
+    if (!typeParameters.empty()) {
+        ss << "<";
+        for (size_t i = 0; i < typeParameters.size(); ++i) {
+            if (i > 0) ss << ", ";
+            ss << typeParameters[i].name;
+            if (!typeParameters[i].constraint.empty()) ss << ": " << typeParameters[i].constraint;
+        }
+        ss << ">";
+    }
+    ss << "(";
     for (size_t i = 0; i < parameters.size(); ++i) {
         if (i > 0) ss << ", ";
         ss << parameters[i].name << ": " << parameters[i].type;
+        if (parameters[i].isRestrict) ss << " restrict";
     }
     ss << ")";
     if (!returnType->empty()) {
@@ -113,4 +143,42 @@ void ExternFunctionDecl::accept(ASTVisitor& visitor) {
     visitor.visit(*this);
 }
 
+// StructDeclaration
+StructDecl::StructDecl(
+    const std::string& name, 
+    std::vector<StructField> fields, 
+    size_t line, 
+    size_t column
+) : Statement(NodeType::STRUCT_DECL, line, column), 
+    name(name), 
+    fields(std::move(fields)) {}
+
+const Attribute* StructDecl::findAttribute(const std::string& attrName) const {
+    for (const auto& attribute : attributes) {
+        if (attribute.name == attrName) {
+            return &attribute;
+        }
+    }
+    return nullptr;
+}
+
+std::string StructDecl::toString() const {
+    std::stringstream ss;
+    ss << "StructDecl(";
+    for (const auto& attribute : attributes) {
+        ss << attribute.toString() << " ";
+    }
+    ss << name << " {";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) ss << ",";
+        ss << " " << fields[i].name << ": " << fields[i].type;
+    }
+    ss << " })";
+    return ss.str();
+}
+
+void StructDecl::accept(ASTVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 } // namespace emlang
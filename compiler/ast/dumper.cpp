@@ -137,7 +137,11 @@ void ASTDumper::visit(AssignmentExpr& node) {
 
 void ASTDumper::visit(FunctionCallExpr& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("FunctionCallExpr", node), Colors::CYAN);
-    std::cout << " " << colorize("name='" + node.functionName + "'", Colors::YELLOW) << std::endl;
+    std::cout << " " << colorize("name='" + node.functionName + "'", Colors::YELLOW);
+    for (const auto& typeArg : node.genericArgs) {
+        std::cout << " " << colorize("typeArg='" + typeArg + "'", Colors::YELLOW);
+    }
+    std::cout << std::endl;
     
     if (!node.arguments.empty()) {
         indent_++;
@@ -197,6 +201,30 @@ void ASTDumper::visit(IndexExpr& node) {
     indent_--;
 }
 
+void ASTDumper::visit(SliceExpr& node) {
+    std::cout << getIndent() << colorize(formatNodeHeader("SliceExpr", node), Colors::CYAN) << std::endl;
+    
+    indent_++;
+    std::cout << getIndent() << "\\-array: ";
+    indent_++;
+    node.array->accept(*this);
+    indent_--;
+    
+    if (node.start) {
+        std::cout << getIndent() << "\\-start: ";
+        indent_++;
+        node.start->accept(*this);
+        indent_--;
+    }
+    if (node.end) {
+        std::cout << getIndent() << "\\-end: ";
+        indent_++;
+        node.end->accept(*this);
+        indent_--;
+    }
+    indent_--;
+}
+
 void ASTDumper::visit(ArrayExpr& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("ArrayExpr", node), Colors::CYAN) << std::endl;
     
@@ -231,6 +259,17 @@ void ASTDumper::visit(ObjectExpr& node) {
     }
 }
 
+void ASTDumper::visit(AwaitExpr& node) {
+    std::cout << getIndent() << colorize(formatNodeHeader("AwaitExpr", node), Colors::CYAN) << std::endl;
+    
+    indent_++;
+    std::cout << getIndent() << "\\-task: ";
+    indent_++;
+    node.operand->accept(*this);
+    indent_--;
+    indent_--;
+}
+
 #ifdef EMLANG_FEATURE_POINTERS
 void ASTDumper::visit(DereferenceExpr& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("DereferenceExpr", node), Colors::CYAN) << std::endl;
@@ -315,6 +354,33 @@ void ASTDumper::visit(ForStmt& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("ForStmt", node), Colors::PURPLE) << std::endl;
     
     indent_++;
+    if (node.isRange()) {
+        std::cout << getIndent() << "\\-variable: " << colorize(node.variable, Colors::YELLOW) << std::endl;
+        std::cout << getIndent() << "\\-start: ";
+        indent_++;
+        node.rangeStart->accept(*this);
+        indent_--;
+        
+        std::cout << getIndent() << "\\-end: ";
+        indent_++;
+        node.rangeEnd->accept(*this);
+        indent_--;
+        
+        if (node.step) {
+            std::cout << getIndent() << "\\-step: ";
+            indent_++;
+            node.step->accept(*this);
+            indent_--;
+        }
+        
+        std::cout << getIndent() << "\\-body: ";
+        indent_++;
+        node.body->accept(*this);
+        indent_--;
+        indent_--;
+        return;
+    }
+    
     std::cout << getIndent() << "\\-init: ";
     indent_++;
     node.initializer->accept(*this);
@@ -336,6 +402,27 @@ void ASTDumper::visit(ForStmt& node) {
     indent_--;
 }
 
+void ASTDumper::visit(SwitchStmt& node) {
+    std::cout << getIndent() << colorize(formatNodeHeader("SwitchStmt", node), Colors::PURPLE) << std::endl;
+    
+    indent_++;
+    std::cout << getIndent() << "\\-value: ";
+    indent_++;
+    node.discriminant->accept(*this);
+    indent_--;
+    
+    for (auto& arm : node.cases) {
+        std::cout << getIndent() << (arm.isDefault ? "\\-default" : "\\-case") << ":" << std::endl;
+        indent_++;
+        for (auto& label : arm.labels) {
+            label->accept(*this);
+        }
+        arm.body->accept(*this);
+        indent_--;
+    }
+    indent_--;
+}
+
 void ASTDumper::visit(ReturnStmt& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("ReturnStmt", node), Colors::PURPLE);
     
@@ -368,7 +455,7 @@ void ASTDumper::visit(VariableDecl& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("VarDecl", node), Colors::GREEN);
     std::cout << " " << colorize((node.isConstant ? "const " : "let ") + node.name, Colors::YELLOW);
     if (!node.type->empty()) {
-        std::cout << " " << colorize("type='" + node.type.value() + "'", Colors::YELLOW);
+        std::cout << " " << colorize("type='" + node.type.value() + (node.isRestrict ? " restrict" : "") + "'", Colors::YELLOW);
     }
     std::cout << std::endl;
     
@@ -385,17 +472,30 @@ void ASTDumper::visit(VariableDecl& node) {
 void ASTDumper::visit(FunctionDecl& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("FunctionDecl", node), Colors::GREEN);
     std::cout << " " << colorize("name='" + node.name + "'", Colors::YELLOW);
+    if (node.isAsync) {
+        std::cout << " " << colorize("async", Colors::YELLOW);
+    }
     if (!node.returnType->empty()) {
         std::cout << " " << colorize("return='" + node.returnType.value() + "'", Colors::YELLOW);
     }
+    for (const auto& attribute : node.attributes) {
+        std::cout << " " << colorize(attribute.toString(), Colors::YELLOW);
+    }
     std::cout << std::endl;
     
     indent_++;
+    for (const auto& typeParam : node.typeParameters) {
+        std::cout << getIndent() << "\\-typeParam: ";
+        std::cout << colorize(typeParam.name + (typeParam.constraint.empty() ? "" : ": " + typeParam.constraint), Colors::YELLOW) << std::endl;
+    }
+    for (size_t i = 0; i < node.typeArguments.size(); ++i) {
+        std::cout << getIndent() << "\\-typeArg" << i << ": " << colorize(node.typeArguments[i], Colors::YELLOW) << std::endl;
+    }
     if (!node.parameters.empty()) {
         for (size_t i = 0; i < node.parameters.size(); ++i) {
             const auto& param = node.parameters[i];
             std::cout << getIndent() << "\\-param" << i << ": ";
-            std::cout << colorize(param.name + ": " + param.type, Colors::YELLOW) << std::endl;
+            std::cout << colorize(param.name + ": " + param.type + (param.isRestrict ? " restrict" : ""), Colors::YELLOW) << std::endl;
         }
     }
     
@@ -427,6 +527,23 @@ void ASTDumper::visit(ExternFunctionDecl& node) {
     }
 }
 
+void ASTDumper::visit(StructDecl& node) {
+    std::cout << getIndent() << colorize(formatNodeHeader("StructDecl", node), Colors::GREEN);
+    std::cout << " " << colorize("name='" + node.name + "'", Colors::YELLOW);
+    for (const auto& attribute : node.attributes) {
+        std::cout << " " << colorize(attribute.toString(), Colors::YELLOW);
+    }
+    std::cout << std::endl;
+    
+    indent_++;
+    for (size_t i = 0; i < node.fields.size(); ++i) {
+        const auto& field = node.fields[i];
+        std::cout << getIndent() << "\\-field" << i << ": ";
+        std::cout << colorize(field.name + ": " + field.type, Colors::YELLOW) << std::endl;
+    }
+    indent_--;
+}
+
 void ASTDumper::visit(Program& node) {
     std::cout << getIndent() << colorize(formatNodeHeader("Program", node), Colors::PURPLE) << std::endl;
     
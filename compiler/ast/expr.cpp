@@ -89,7 +89,16 @@ FunctionCallExpr::FunctionCallExpr(const std::string& name, std::vector<Expressi
 
 std::string FunctionCallExpr::toString() const {
     std::stringstream ss;
-    ss << "FunctionCall(" << functionName << "(";
+    ss << "FunctionCall(" << functionName;
+    if (!genericArgs.empty()) {
+        ss << "<";
+        for (size_t i = 0; i < genericArgs.size(); ++i) {
+            if (i > 0) ss << ", ";
+            ss << genericArgs[i];
+        }
+        ss << ">";
+    }
+    ss << "(";
     for (size_t i = 0; i < arguments.size(); ++i) {
         if (i > 0) ss << ", ";
         ss << arguments[i]->toString();
@@ -140,6 +149,19 @@ void IndexExpr::accept(ASTVisitor& visitor) {
     visitor.visit(*this);
 }
 
+// SliceExpression
+SliceExpr::SliceExpr(ExpressionPtr array, ExpressionPtr start, ExpressionPtr end, size_t line, size_t column)
+    : Expression(NodeType::SLICE_EXPR, line, column), array(std::move(array)), start(std::move(start)), end(std::move(end)) {}
+
+std::string SliceExpr::toString() const {
+    return "Slice(" + array->toString() + "[" + (start ? start->toString() : "") + ".." + 
+           (end ? end->toString() : "") + "])";
+}
+
+void SliceExpr::accept(ASTVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 // ArrayExpression
 ArrayExpr::ArrayExpr(std::vector<ExpressionPtr> elements, size_t line, size_t column)
     : Expression(NodeType::ARRAY_EXPR, line, column), elements(std::move(elements)) {}
@@ -178,6 +200,18 @@ void ObjectExpr::accept(ASTVisitor& visitor) {
     visitor.visit(*this);
 }
 
+// AwaitExpression
+AwaitExpr::AwaitExpr(ExpressionPtr operand, size_t line, size_t column)
+    : Expression(NodeType::AWAIT_EXPR, line, column), operand(std::move(operand)) {}
+
+std::string AwaitExpr::toString() const {
+    return "Await(" + operand->toString() + ")";
+}
+
+void AwaitExpr::accept(ASTVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 #ifdef EMLANG_FEATURE_POINTERS
 // DereferenceExpression
 DereferenceExpr::DereferenceExpr(ExpressionPtr operand, size_t line, size_t column)
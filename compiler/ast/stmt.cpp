@@ -67,6 +67,33 @@ void WhileStmt::accept(ASTVisitor& visitor) {
     visitor.visit(*this);
 }
 
+// SwitchStatement
+SwitchStmt::SwitchStmt(ExpressionPtr discriminant, std::vector<SwitchCase> cases, size_t line, size_t column)
+    : Statement(NodeType::SWITCH_STMT, line, column), 
+      discriminant(std::move(discriminant)), 
+      cases(std::move(cases)) {}
+
+std::string SwitchStmt::toString() const {
+    std::stringstream ss;
+    ss << "Switch(" << discriminant->toString();
+    for (const auto& arm : cases) {
+        ss << " ";
+        for (size_t i = 0; i < arm.labels.size(); ++i) {
+            ss << (i > 0 ? ", " : "case ") << arm.labels[i]->toString();
+        }
+        if (arm.isDefault) {
+            ss << (arm.labels.empty() ? "default" : ", default");
+        }
+        ss << ": " << arm.body->toString();
+    }
+    ss << ")";
+    return ss.str();
+}
+
+void SwitchStmt::accept(ASTVisitor& visitor) {
+    visitor.visit(*this);
+}
+
 // ReturnStatement
 ReturnStmt::ReturnStmt(ExpressionPtr val, size_t line, size_t column)
     : Statement(NodeType::RETURN_STMT, line, column), value(std::move(val)) {}
@@ -102,7 +129,21 @@ ForStmt::ForStmt(StatementPtr init, ExpressionPtr cond, ExpressionPtr incr, Stat
       increment(std::move(incr)), 
       body(std::move(body)) {}
 
+ForStmt::ForStmt(const std::string& variable, ExpressionPtr start, ExpressionPtr end, ExpressionPtr step, StatementPtr body,
+                 size_t line, size_t column)
+    : Statement(NodeType::FOR_STMT, line, column),
+      body(std::move(body)),
+      variable(variable),
+      rangeStart(std::move(start)),
+      rangeEnd(std::move(end)),
+      step(std::move(step)) {}
+
 std::string ForStmt::toString() const {
+    if (isRange()) {
+        std::string result = "For(" + variable + " in " + rangeStart->toString() + ".." + rangeEnd->toString();
+        if (step) result += " step " + step->toString();
+        return result + "; " + body->toString() + ")";
+    }
     std::string result = "For(";
     if (initializer) result += initializer->toString();
     result += "; ";
@@ -38,7 +38,139 @@ std::map<std::string, BuiltinFunction> getBuiltinFunctions() {
             {BuiltinParameter("str", "string")}, "int32")},
         {"emlang_strcmp", BuiltinFunction("emlang_strcmp", 
             {BuiltinParameter("str1", "string"), BuiltinParameter("str2", "string")}, "int32")},
-        
+
+        // String Builder Functions
+        {"emlang_strbuf_new", BuiltinFunction("emlang_strbuf_new", {}, "void*")},
+        {"emlang_strbuf_free", BuiltinFunction("emlang_strbuf_free",
+            {BuiltinParameter("sb", "void*")}, "void")},
+        {"emlang_strbuf_reserve", BuiltinFunction("emlang_strbuf_reserve",
+            {BuiltinParameter("sb", "void*"), BuiltinParameter("capacity", "int32")}, "int32")},
+        {"emlang_strbuf_clear", BuiltinFunction("emlang_strbuf_clear",
+            {BuiltinParameter("sb", "void*")}, "void")},
+        {"emlang_strbuf_append_str", BuiltinFunction("emlang_strbuf_append_str",
+            {BuiltinParameter("sb", "void*"), BuiltinParameter("str", "string")}, "void")},
+        {"emlang_strbuf_append_char", BuiltinFunction("emlang_strbuf_append_char",
+            {BuiltinParameter("sb", "void*"), BuiltinParameter("c", "char")}, "void")},
+        {"emlang_strbuf_append_int", BuiltinFunction("emlang_strbuf_append_int",
+            {BuiltinParameter("sb", "void*"), BuiltinParameter("value", "int64")}, "void")},
+        {"emlang_strbuf_append_float", BuiltinFunction("emlang_strbuf_append_float",
+            {BuiltinParameter("sb", "void*"), BuiltinParameter("value", "double")}, "void")},
+        {"emlang_strbuf_view", BuiltinFunction("emlang_strbuf_view",
+            {BuiltinParameter("sb", "void*")}, "string")},
+        {"emlang_strbuf_length", BuiltinFunction("emlang_strbuf_length",
+            {BuiltinParameter("sb", "void*")}, "int32")},
+
+        // Rope Functions
+        {"emlang_rope_new", BuiltinFunction("emlang_rope_new", {}, "void*")},
+        {"emlang_rope_from_str", BuiltinFunction("emlang_rope_from_str",
+            {BuiltinParameter("str", "string")}, "void*")},
+        {"emlang_rope_free", BuiltinFunction("emlang_rope_free",
+            {BuiltinParameter("rope", "void*")}, "void")},
+        {"emlang_rope_length", BuiltinFunction("emlang_rope_length",
+            {BuiltinParameter("rope", "void*")}, "int64")},
+        {"emlang_rope_insert", BuiltinFunction("emlang_rope_insert",
+            {BuiltinParameter("rope", "void*"), BuiltinParameter("pos", "int64"),
+             BuiltinParameter("str", "string")}, "int32")},
+        {"emlang_rope_append", BuiltinFunction("emlang_rope_append",
+            {BuiltinParameter("rope", "void*"), BuiltinParameter("str", "string")}, "int32")},
+        {"emlang_rope_erase", BuiltinFunction("emlang_rope_erase",
+            {BuiltinParameter("rope", "void*"), BuiltinParameter("pos", "int64"),
+             BuiltinParameter("len", "int64")}, "int32")},
+        {"emlang_rope_char_at", BuiltinFunction("emlang_rope_char_at",
+            {BuiltinParameter("rope", "void*"), BuiltinParameter("pos", "int64")}, "char")},
+        {"emlang_rope_to_strbuf", BuiltinFunction("emlang_rope_to_strbuf",
+            {BuiltinParameter("rope", "void*"), BuiltinParameter("sb", "void*")}, "void")},
+
+        // Hash Map Functions
+        {"emlang_hashmap_new", BuiltinFunction("emlang_hashmap_new", {}, "void*")},
+        {"emlang_hashmap_new_str", BuiltinFunction("emlang_hashmap_new_str", {}, "void*")},
+        {"emlang_hashmap_free", BuiltinFunction("emlang_hashmap_free",
+            {BuiltinParameter("map", "void*")}, "void")},
+        {"emlang_hashmap_clear", BuiltinFunction("emlang_hashmap_clear",
+            {BuiltinParameter("map", "void*")}, "void")},
+        {"emlang_hashmap_reserve", BuiltinFunction("emlang_hashmap_reserve",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("count", "int32")}, "int32")},
+        {"emlang_hashmap_size", BuiltinFunction("emlang_hashmap_size",
+            {BuiltinParameter("map", "void*")}, "int32")},
+        {"emlang_hashmap_insert", BuiltinFunction("emlang_hashmap_insert",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "int64"),
+             BuiltinParameter("value", "int64")}, "int32")},
+        {"emlang_hashmap_get", BuiltinFunction("emlang_hashmap_get",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "int64"),
+             BuiltinParameter("fallback", "int64")}, "int64")},
+        {"emlang_hashmap_contains", BuiltinFunction("emlang_hashmap_contains",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "int64")}, "int32")},
+        {"emlang_hashmap_erase", BuiltinFunction("emlang_hashmap_erase",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "int64")}, "int32")},
+        {"emlang_hashmap_insert_str", BuiltinFunction("emlang_hashmap_insert_str",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "string"),
+             BuiltinParameter("value", "int64")}, "int32")},
+        {"emlang_hashmap_get_str", BuiltinFunction("emlang_hashmap_get_str",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "string"),
+             BuiltinParameter("fallback", "int64")}, "int64")},
+        {"emlang_hashmap_contains_str", BuiltinFunction("emlang_hashmap_contains_str",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "string")}, "int32")},
+        {"emlang_hashmap_erase_str", BuiltinFunction("emlang_hashmap_erase_str",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("key", "string")}, "int32")},
+        {"emlang_hashmap_next", BuiltinFunction("emlang_hashmap_next",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("slot", "int32")}, "int32")},
+        {"emlang_hashmap_key_at", BuiltinFunction("emlang_hashmap_key_at",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("slot", "int32")}, "int64")},
+        {"emlang_hashmap_key_str_at", BuiltinFunction("emlang_hashmap_key_str_at",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("slot", "int32")}, "string")},
+        {"emlang_hashmap_value_at", BuiltinFunction("emlang_hashmap_value_at",
+            {BuiltinParameter("map", "void*"), BuiltinParameter("slot", "int32")}, "int64")},
+
+        // UTF-8 Functions
+        {"emlang_utf8_strlen", BuiltinFunction("emlang_utf8_strlen",
+            {BuiltinParameter("str", "string")}, "int64")},
+        {"emlang_utf8_slice", BuiltinFunction("emlang_utf8_slice",
+            {BuiltinParameter("str", "string"), BuiltinParameter("start", "int64"),
+             BuiltinParameter("count", "int64")}, "string")},
+
+        // Heap Profiling Functions
+        {"emlang_heapprof_dump", BuiltinFunction("emlang_heapprof_dump",
+            {BuiltinParameter("path", "string")}, "int32")},
+
+        // Timing Functions
+        {"emlang_now_ns", BuiltinFunction("emlang_now_ns", {}, "int64")},
+        {"emlang_cycles", BuiltinFunction("emlang_cycles", {}, "int64")},
+        {"emlang_cycles_per_ns", BuiltinFunction("emlang_cycles_per_ns", {}, "double")},
+
+        // Benchmark Functions
+        {"emlang_bench_begin", BuiltinFunction("emlang_bench_begin",
+            {BuiltinParameter("name", "string")}, "void*")},
+        {"emlang_bench_iteration", BuiltinFunction("emlang_bench_iteration",
+            {BuiltinParameter("bench", "void*")}, "int32")},
+        {"emlang_bench_end", BuiltinFunction("emlang_bench_end",
+            {BuiltinParameter("bench", "void*")}, "double")},
+        {"emlang_bench_consume", BuiltinFunction("emlang_bench_consume",
+            {BuiltinParameter("value", "int64")}, "void")},
+
+        // Performance Counter Functions
+        {"emlang_perf_begin", BuiltinFunction("emlang_perf_begin",
+            {BuiltinParameter("region", "string")}, "void")},
+        {"emlang_perf_end", BuiltinFunction("emlang_perf_end",
+            {BuiltinParameter("region", "string")}, "void")},
+        {"emlang_perf_hardware", BuiltinFunction("emlang_perf_hardware", {}, "int32")},
+        {"emlang_perf_export_json", BuiltinFunction("emlang_perf_export_json",
+            {BuiltinParameter("path", "string")}, "int32")},
+
+        // CPU Feature Functions
+        {"emlang_cpu_supports", BuiltinFunction("emlang_cpu_supports",
+            {BuiltinParameter("feature", "string")}, "int32")},
+        {"emlang_cpu_features", BuiltinFunction("emlang_cpu_features", {}, "string")},
+
+        // Number Functions
+        {"emlang_str_to_int64", BuiltinFunction("emlang_str_to_int64",
+            {BuiltinParameter("str", "string")}, "int64")},
+        {"emlang_str_to_double", BuiltinFunction("emlang_str_to_double",
+            {BuiltinParameter("str", "string")}, "double")},
+        {"emlang_int64_to_str", BuiltinFunction("emlang_int64_to_str",
+            {BuiltinParameter("value", "int64")}, "string")},
+        {"emlang_double_to_str", BuiltinFunction("emlang_double_to_str",
+            {BuiltinParameter("value", "double")}, "string")},
+
         // Math Functions
         {"emlang_pow", BuiltinFunction("emlang_pow", 
             {BuiltinParameter("base", "int32"), BuiltinParameter("exp", "int32")}, "int32")},
@@ -70,4 +202,26 @@ const BuiltinFunction* getBuiltinFunction(const std::string& name) {
     return (it != builtins.end()) ? &it->second : nullptr;
 }
 
+bool isVecIntrinsic(const std::string& name) {
+    return name == "vec_push" || name == "vec_pop" || name == "vec_len" ||
+           name == "vec_reserve" || name == "vec_shrink" || name == "vec_clear" ||
+           name == "vec_free";
+}
+
+bool isHintIntrinsic(const std::string& name) {
+    return name == "likely" || name == "unlikely" || name == "prefetch";
+}
+
+bool isSliceIntrinsic(const std::string& name) {
+    return name == "slice_len";
+}
+
+bool isArrayIntrinsic(const std::string& name) {
+    return name == "sum";
+}
+
+bool isTaskIntrinsic(const std::string& name) {
+    return name == "yield_now";
+}
+
 } // namespace emlang
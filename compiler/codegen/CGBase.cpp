@@ -11,6 +11,7 @@
 #include "codegen/CGExpr.h"
 #include "codegen/CGDecl.h"
 #include "codegen/CGStmt.h"
+#include "codegen/debug_info.h"
 
 namespace emlang {
 namespace codegen {
@@ -59,6 +60,12 @@ void CGBase::setCurrentValue(llvm::Value* value, const std::string& type) {
     // Base class doesn't handle type, derived classes can override
 }
 
+void CGBase::setVisitors(CGExpr* exprVisitor, CGDecl* declVisitor, CGStmt* stmtVisitor) {
+    this->exprVisitor = exprVisitor;
+    this->declVisitor = declVisitor;
+    this->stmtVisitor = stmtVisitor;
+}
+
 /****************************** 
 * AST Visitor - Program
 ******************************/
@@ -137,6 +144,93 @@ void CGBase::visit(Program& node) {
     }
 }
 
+/****************************** 
+* AST Visitor - Forwarding
+******************************/
+
+void CGBase::forward(ASTNode& node, CGBase* visitor) {
+    if (!visitor || visitor == this) {
+        return;
+    }
+    node.accept(*visitor);
+    if (visitor == exprVisitor) {
+        setCurrentValue(visitor->getCurrentValue(), exprVisitor->getCurrentExpressionType());
+    } else {
+        setCurrentValue(visitor->getCurrentValue());
+    }
+}
+
+void CGBase::visit(LiteralExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(IdentifierExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(BinaryOpExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(UnaryOpExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(AssignmentExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(FunctionCallExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(MemberExpr& node) { forward(node, exprVisitor); }
+#ifdef EMLANG_FEATURE_CASTING
+void CGBase::visit(CastExpr& node) { forward(node, exprVisitor); }
+#endif
+void CGBase::visit(IndexExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(SliceExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(ArrayExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(ObjectExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(AwaitExpr& node) { forward(node, exprVisitor); }
+#ifdef EMLANG_FEATURE_POINTERS
+void CGBase::visit(DereferenceExpr& node) { forward(node, exprVisitor); }
+void CGBase::visit(AddressOfExpr& node) { forward(node, exprVisitor); }
+#endif
+
+void CGBase::visit(VariableDecl& node) { forward(node, declVisitor); }
+void CGBase::visit(FunctionDecl& node) { forward(node, declVisitor); }
+void CGBase::visit(ExternFunctionDecl& node) { forward(node, declVisitor); }
+void CGBase::visit(StructDecl& node) { forward(node, declVisitor); }
+
+void CGBase::visit(BlockStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(IfStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(WhileStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(ForStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(SwitchStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(ReturnStmt& node) { forward(node, stmtVisitor); }
+void CGBase::visit(ExpressionStmt& node) { forward(node, stmtVisitor); }
+
+/****************************** 
+* Value Conversion
+******************************/
+
+llvm::Value* CGBase::convertValue(llvm::Value* value, llvm::Type* type, bool isUnsigned) {
+    if (!value || !type || value->getType() == type) {
+        return value;
+    }
+    auto& builder = contextManager.getBuilder();
+    llvm::Type* sourceType = value->getType();
+    if (sourceType->isIntegerTy() && type->isIntegerTy()) {
+        if (sourceType->getIntegerBitWidth() == 1 || isUnsigned) {
+            return builder.CreateZExtOrTrunc(value, type, "zext");
+        }
+        return builder.CreateSExtOrTrunc(value, type, "conv");
+    }
+    if (sourceType->isIntegerTy() && type->isFloatingPointTy()) {
+        return isUnsigned ? builder.CreateUIToFP(value, type, "uitofp") : builder.CreateSIToFP(value, type, "sitofp");
+    }
+    if (sourceType->isFloatingPointTy() && type->isIntegerTy()) {
+        return isUnsigned ? builder.CreateFPToUI(value, type, "fptoui") : builder.CreateFPToSI(value, type, "fptosi");
+    }
+    if (sourceType->isFloatingPointTy() && type->isFloatingPointTy()) {
+        return builder.CreateFPCast(value, type, "fpcast");
+    }
+    return value;
+}
+
+/****************************** 
+* Debug Locations
+******************************/
+
+void CGBase::emitLocation(const ASTNode& node) {
+    if (DebugInfo* debugInfo = contextManager.getDebugInfo()) {
+        debugInfo->setLocation(static_cast<unsigned>(node.line), static_cast<unsigned>(node.column));
+    }
+}
+
 /****************************** 
 * Error Handling
 ******************************/
@@ -8,8 +8,17 @@
 //===----------------------------------------------------------------------===//
 
 #include "codegen/CGDecl.h"
+#include "codegen/CGExpr.h"
+#include "codegen/CGStmt.h"
+#include "codegen/debug_info.h"
 #include "ast.h"
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <algorithm>
+#include <numeric>
 
 namespace emlang {
 namespace codegen {
@@ -24,6 +33,10 @@ void CGDecl::visit(VariableDecl& node) {
 }
 
 void CGDecl::visit(FunctionDecl& node) {
+    // Templates are only generated through their instances
+    if (node.isGeneric()) {
+        return;
+    }
     generateFunctionDecl(node);
 }
 
@@ -31,6 +44,10 @@ void CGDecl::visit(ExternFunctionDecl& node) {
     generateExternFunctionDecl(node);
 }
 
+void CGDecl::visit(StructDecl& node) {
+    generateStructDecl(node);
+}
+
 void CGDecl::setCurrentValue(llvm::Value* value, const std::string& type) {
     currentValue = value;
     currentExpressionType = type;
@@ -48,7 +65,28 @@ llvm::Value* CGDecl::generateVariableDecl(VariableDecl& node) {
     if (!currentFunction) {
         // Global variable
         llvm::Constant* initVal = nullptr;
-        if (node.initializer) {
+        auto* objectInit = dynamic_cast<ObjectExpr*>(node.initializer.get());
+        if (objectInit && valueMap.getStruct(typeStr) && exprVisitor) {
+            initVal = llvm::dyn_cast_or_null<llvm::Constant>(exprVisitor->generateStructLiteral(typeStr, *objectInit));
+            if (!initVal) {
+                error(CodegenErrorType::InternalError, 
+                      "Global variable initializer must be a constant: " + node.name);
+                return nullptr;
+            }
+        }
+        else if (auto* arrayInit = dynamic_cast<ArrayExpr*>(node.initializer.get());
+                 arrayInit && llvmType && llvmType->isArrayTy() && exprVisitor) {
+            std::string elementType;
+            uint64_t size = 0;
+            ValueMap::splitArrayType(typeStr, elementType, size);
+            initVal = exprVisitor->generateConstantArray(elementType, *arrayInit);
+            if (!initVal) {
+                error(CodegenErrorType::InternalError, 
+                      "Global variable initializer must be a constant: " + node.name);
+                return nullptr;
+            }
+        }
+        else if (node.initializer) {
             node.initializer->accept(*this);
             // Convert currentValue to constant if it's not already
             if (auto constVal = llvm::dyn_cast<llvm::Constant>(currentValue)) {
@@ -66,6 +104,8 @@ llvm::Value* CGDecl::generateVariableDecl(VariableDecl& node) {
                 initVal = llvm::ConstantInt::get(llvmType, 0);
             } else if (llvmType->isFloatingPointTy()) {
                 initVal = llvm::ConstantFP::get(llvmType, 0.0);
+            } else if (llvmType->isAggregateType()) {
+                initVal = llvm::Constant::getNullValue(llvmType);
             } else {
                 initVal = llvm::UndefValue::get(llvmType);
             }
@@ -79,16 +119,70 @@ llvm::Value* CGDecl::generateVariableDecl(VariableDecl& node) {
             initVal,
             node.name
         );
+        // Constants are never written, so equal ones may be merged
+        if (node.isConstant) {
+            globalVar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+        }
+        if (unsigned alignment = valueMap.getAlignment(typeStr)) {
+            globalVar->setAlignment(llvm::Align(alignment));
+        }
         // Remember the global variable in value map
         valueMap.addVariable(node.name, globalVar, typeStr);
         currentValue = globalVar;
     } else {
         // Local variable
+        emitLocation(node);
         llvm::Value* initVal = nullptr;
-        if (node.initializer) {
+        auto* objectInit = dynamic_cast<ObjectExpr*>(node.initializer.get());
+        auto* arrayInit = dynamic_cast<ArrayExpr*>(node.initializer.get());
+        // Array literals fill the variable in place; source holds an array to copy instead
+        bool fillArray = false;
+        llvm::Value* arraySource = nullptr;
+        if (typeStr.compare(0, 4, "vec<") == 0 && exprVisitor) {
+            initVal = exprVisitor->generateVecInit(typeStr, node.initializer.get());
+        }
+        else if (objectInit && valueMap.getStruct(typeStr) && exprVisitor) {
+            initVal = exprVisitor->generateStructLiteral(typeStr, *objectInit);
+        }
+        else if (arrayInit && llvmType && llvmType->isArrayTy() && exprVisitor) {
+            std::string elementType;
+            uint64_t size = 0;
+            ValueMap::splitArrayType(typeStr, elementType, size);
+            // A constant table is read in place; nothing is copied to the stack
+            if (node.isConstant) {
+                if (llvm::Constant* values = exprVisitor->generateConstantArray(elementType, *arrayInit)) {
+                    currentValue = exprVisitor->getArrayTable(values);
+                    valueMap.addVariable(node.name, currentValue, typeStr);
+                    return currentValue;
+                }
+            }
+            fillArray = true;
+        }
+        else if (node.initializer) {
             node.initializer->accept(*this);
             initVal = currentValue;
+            // Untyped declarations take the initializer's type
+            bool inferred = !llvmType;
+            if (inferred && initVal) {
+                llvmType = initVal->getType();
+                typeStr = currentExpressionType;
+            }
+            // Inferred arrays are copied from the literal's table or temporary
+            if (inferred && arrayInit && initVal) {
+                llvmType = valueMap.getLLVMType(typeStr, contextManager);
+                if (node.isConstant && llvm::isa<llvm::GlobalVariable>(initVal)) {
+                    valueMap.addVariable(node.name, initVal, typeStr);
+                    return initVal;
+                }
+                arraySource = initVal;
+            } else {
+                initVal = convertValue(initVal, llvmType, CGExpr::isUnsignedType(currentExpressionType));
+            }
         } 
+        else if (!llvmType) {
+            error(CodegenErrorType::UnknownType, "Unknown type: " + typeStr + " for variable: " + node.name);
+            return nullptr;
+        }
         else {
             // Default initialization for local variables - use null/zero constants
             if (llvmType->isPointerTy()) {
@@ -97,11 +191,13 @@ llvm::Value* CGDecl::generateVariableDecl(VariableDecl& node) {
                 initVal = llvm::ConstantInt::get(llvmType, 0);
             } else if (llvmType->isFloatingPointTy()) {
                 initVal = llvm::ConstantFP::get(llvmType, 0.0);
+            } else if (llvmType->isAggregateType()) {
+                initVal = llvm::Constant::getNullValue(llvmType);
             } else {
                 initVal = llvm::UndefValue::get(llvmType);
             }
         }
-        if (!initVal) {
+        if (!initVal && !fillArray) {
             error(CodegenErrorType::InternalError, 
                   "Failed to generate initial value for variable: " + node.name);
             return nullptr;
@@ -109,10 +205,35 @@ llvm::Value* CGDecl::generateVariableDecl(VariableDecl& node) {
           
         // Create alloca for the local variable - simplified approach
         llvm::IRBuilder<> tmpBuilder(&currentFunction->getEntryBlock(), currentFunction->getEntryBlock().begin());
-        llvm::Value* alloca = tmpBuilder.CreateAlloca(llvmType, nullptr, node.name);
+        llvm::AllocaInst* alloca = tmpBuilder.CreateAlloca(llvmType, nullptr, node.name);
+        unsigned alignment = valueMap.getAlignment(typeStr);
+        if (alignment > alloca->getAlign().value()) {
+            alloca->setAlignment(llvm::Align(alignment));
+        }
+        
+        if (DebugInfo* debugInfo = contextManager.getDebugInfo()) {
+            debugInfo->declareVariable(alloca, node.name, typeStr, static_cast<unsigned>(node.line));
+        }
+        
+        if (node.isRestrict) {
+            valueMap.addRestrictStorage(alloca, node.name);
+        }
         
-        // Store initial value using context manager's builder
-        contextManager.getBuilder().CreateStore(initVal, alloca);
+        // Store initial value using context manager's builder; zeroed aggregates
+        // are cleared with a memset rather than one store of a large constant
+        auto& builder = contextManager.getBuilder();
+        if (fillArray) {
+            exprVisitor->generateArrayInit(typeStr, *arrayInit, alloca);
+        } else if (arraySource) {
+            const llvm::DataLayout& dataLayout = contextManager.getModule()->getDataLayout();
+            builder.CreateMemCpy(alloca, alloca->getAlign(), arraySource, arraySource->getPointerAlignment(dataLayout),
+                                 dataLayout.getTypeAllocSize(llvmType));
+        } else if (llvm::isa<llvm::ConstantAggregateZero>(initVal)) {
+            const llvm::DataLayout& dataLayout = contextManager.getModule()->getDataLayout();
+            builder.CreateMemSet(alloca, builder.getInt8(0), dataLayout.getTypeAllocSize(llvmType), alloca->getAlign());
+        } else {
+            builder.CreateStore(initVal, alloca);
+        }
         // Remember the variable in value map
         valueMap.addVariable(node.name, alloca, typeStr);
         currentValue = alloca;
@@ -138,8 +259,9 @@ llvm::Function* CGDecl::generateFunctionDecl(FunctionDecl& node) {
         return nullptr;
     }
     
-    // Create function type
-    llvm::FunctionType* funcType = llvm::FunctionType::get(returnType, paramTypes, false);
+    // Create function type; async functions return their task
+    llvm::Type* resultType = node.isAsync ? llvm::PointerType::get(contextManager.getContext(), 0) : returnType;
+    llvm::FunctionType* funcType = llvm::FunctionType::get(resultType, paramTypes, false);
     
     // Create function
     llvm::Function* function = llvm::Function::Create(
@@ -148,6 +270,15 @@ llvm::Function* CGDecl::generateFunctionDecl(FunctionDecl& node) {
         node.name,
         contextManager.getModule()
     );
+    // Every module using an instance carries its own copy; the linker keeps one
+    if (!node.typeArguments.empty()) {
+        function->setLinkage(llvm::Function::LinkOnceODRLinkage);
+    }
+    // Under --whole-program nothing outside this module calls it, so LLVM may drop or rewrite it
+    if (contextManager.getOptions().wholeProgram && node.name != "main" && !node.findAttribute("export")) {
+        function->setLinkage(llvm::Function::InternalLinkage);
+    }
+    applyFunctionAttributes(function, node);
     
     // Set parameter names
     unsigned idx = 0;
@@ -164,6 +295,18 @@ llvm::Function* CGDecl::generateFunctionDecl(FunctionDecl& node) {
         function
     );
     contextManager.getBuilder().SetInsertPoint(bb);
+    // Floating-point instructions in the body carry the function's fast-math flags
+    llvm::IRBuilderBase::FastMathFlagGuard fastMathGuard(contextManager.getBuilder());
+    contextManager.getBuilder().setFastMathFlags(getFastMathFlags(node));
+
+    DebugInfo* debugInfo = contextManager.getDebugInfo();
+    if (debugInfo) {
+        std::vector<std::string> paramTypeNames;
+        for (const auto& param : node.parameters) {
+            paramTypeNames.push_back(param.type);
+        }
+        debugInfo->beginFunction(function, returnTypeStr, paramTypeNames, static_cast<unsigned>(node.line));
+    }
 
     // Save previous state
     llvm::Function* prevFunction = currentFunction;    
@@ -171,6 +314,14 @@ llvm::Function* CGDecl::generateFunctionDecl(FunctionDecl& node) {
     
     currentFunction = function;
     
+    // Parameters are copied into the coroutine frame, after it has been allocated
+    if (node.isAsync && exprVisitor && !exprVisitor->beginCoroutine(function, returnTypeStr)) {
+        function->eraseFromParent();
+        currentFunction = prevFunction;
+        valueMap.restoreScope(prevNamedValues);
+        return nullptr;
+    }
+    
     // Create allocas for parameters
     unsigned paramIdx = 0;
     for (auto& arg : function->args()) {
@@ -182,25 +333,51 @@ llvm::Function* CGDecl::generateFunctionDecl(FunctionDecl& node) {
         
         // Store parameter in value map
         if (paramIdx < node.parameters.size()) {
+            if (node.parameters[paramIdx].isRestrict) {
+                arg.addAttr(llvm::Attribute::NoAlias);
+                valueMap.addRestrictStorage(alloca, std::string(arg.getName()));
+            }
             valueMap.addVariable(std::string(arg.getName()), alloca, node.parameters[paramIdx].type);
+            if (debugInfo) {
+                debugInfo->declareVariable(alloca, std::string(arg.getName()), node.parameters[paramIdx].type,
+                                           static_cast<unsigned>(node.line), paramIdx + 1);
+            }
         }
         paramIdx++;
     }
     
     // Generate function body
     if (node.body) {
+        if (stmtVisitor) {
+            stmtVisitor->beginFunction(*node.body);
+        }
         node.body->accept(*this);
         
         // Add return if missing for void functions
-        if (returnType->isVoidTy()) {
+        if (node.isAsync && exprVisitor) {
+            exprVisitor->endCoroutine();
+        } else if (returnType->isVoidTy() && !contextManager.getBuilder().GetInsertBlock()->getTerminator()) {
             contextManager.getBuilder().CreateRetVoid();
         }
     }
     
+    emitAliasScopes(function);
+    
+    if (node.body && contextManager.getOptions().instrumentFunctions != CodegenOptions::FunctionInstrumentation::None) {
+        instrumentFunction(function);
+    }
+    if (debugInfo) {
+        debugInfo->endFunction();
+    }
+    
     // Verify function - simplified approach
     if (llvm::verifyFunction(*function, &llvm::errs())) {
         error(CodegenErrorType::InternalError, "Function verification failed for: " + node.name);
         function->eraseFromParent();
+        function = nullptr;
+    }
+    else if (node.findAttribute("target_clones")) {
+        function = emitTargetClones(function, node);
     }
       // Restore previous state
     currentFunction = prevFunction;
@@ -240,6 +417,306 @@ llvm::Function* CGDecl::generateExternFunctionDecl(ExternFunctionDecl& node) {
     return function;
 }
 
+llvm::StructType* CGDecl::generateStructDecl(StructDecl& node) {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    const llvm::DataLayout& dataLayout = contextManager.getModule()->getDataLayout();
+    bool packed = node.findAttribute("packed") != nullptr;
+    
+    std::vector<llvm::Type*> fieldTypes;
+    for (const auto& field : node.fields) {
+        llvm::Type* fieldType = valueMap.getLLVMType(field.type, contextManager);
+        if (!fieldType || fieldType->isVoidTy()) {
+            error(CodegenErrorType::UnknownType, "Unknown type " + field.type + " for field " + field.name + 
+                  " in struct: " + node.name);
+            return nullptr;
+        }
+        fieldTypes.push_back(fieldType);
+    }
+    
+    std::vector<size_t> order(node.fields.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (node.findAttribute("reorder")) {
+        // Falling alignment leaves no holes between fields; ties keep source order
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return dataLayout.getABITypeAlign(fieldTypes[a]) > dataLayout.getABITypeAlign(fieldTypes[b]);
+        });
+    }
+    
+    ValueMap::StructLayout layout;
+    std::vector<llvm::Type*> elements;
+    for (size_t index : order) {
+        elements.push_back(fieldTypes[index]);
+        layout.fieldNames.push_back(node.fields[index].name);
+        layout.fieldTypes.push_back(node.fields[index].type);
+    }
+    
+    if (const Attribute* align = node.findAttribute("align")) {
+        layout.alignment = static_cast<unsigned>(std::stoul(align->args[0]));
+        // Tail padding keeps every element of an array on its own N-byte boundary.
+        // The size is measured on a literal type: DataLayout caches the layout of
+        // named structs, so the named one must not be measured before its body is final.
+        uint64_t size = dataLayout.getTypeAllocSize(llvm::StructType::get(ctx, elements, packed));
+        if (size % layout.alignment != 0) {
+            elements.push_back(llvm::ArrayType::get(llvm::Type::getInt8Ty(ctx), layout.alignment - size % layout.alignment));
+        }
+    }
+    llvm::StructType* structType = llvm::StructType::create(ctx, elements, node.name, packed);
+    layout.type = structType;
+    layout.soa = node.findAttribute("soa") != nullptr;
+    valueMap.addStruct(node.name, std::move(layout));
+    return structType;
+}
+
+void CGDecl::instrumentFunction(llvm::Function* function) {
+    if (contextManager.getOptions().instrumentFunctions == CodegenOptions::FunctionInstrumentation::XRay) {
+        function->addFnAttr("function-instrument", "xray-always");
+        return;
+    }
+
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::FunctionType* hookType = llvm::FunctionType::get(
+        llvm::Type::getVoidTy(ctx), {llvm::Type::getInt32Ty(ctx)}, false);
+    llvm::FunctionCallee enterHook = module->getOrInsertFunction("emlang_funcprof_enter", hookType);
+    llvm::FunctionCallee exitHook = module->getOrInsertFunction("emlang_funcprof_exit", hookType);
+
+    llvm::Constant* id = llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx), instrumentedFunctions.size());
+    instrumentedFunctions.push_back(function->getName().str());
+
+    // Enter after the allocas so they stay in one group at the top of the entry block
+    llvm::BasicBlock& entry = function->getEntryBlock();
+    llvm::BasicBlock::iterator insertPoint = entry.begin();
+    while (insertPoint != entry.end() && llvm::isa<llvm::AllocaInst>(*insertPoint)) {
+        ++insertPoint;
+    }
+    llvm::IRBuilder<> enterBuilder(&entry, insertPoint);
+    if (llvm::DISubprogram* subprogram = function->getSubprogram()) {
+        enterBuilder.SetCurrentDebugLocation(llvm::DILocation::get(ctx, subprogram->getLine(), 0, subprogram));
+    }
+    enterBuilder.CreateCall(enterHook, {id});
+
+    for (llvm::BasicBlock& block : *function) {
+        if (auto* ret = llvm::dyn_cast_or_null<llvm::ReturnInst>(block.getTerminator())) {
+            llvm::IRBuilder<> exitBuilder(ret);
+            exitBuilder.CreateCall(exitHook, {id});
+        }
+    }
+}
+
+void CGDecl::emitInstrumentationTable() {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i32Ty = llvm::Type::getInt32Ty(ctx);
+
+    std::vector<llvm::Constant*> names;
+    for (const auto& name : instrumentedFunctions) {
+        names.push_back(contextManager.createPrivateString(name, "funcprof.name"));
+    }
+    auto* namesType = llvm::ArrayType::get(ptrTy, names.size());
+    auto* namesTable = new llvm::GlobalVariable(*module, namesType, true, llvm::GlobalValue::PrivateLinkage,
+                                                llvm::ConstantArray::get(namesType, names), "funcprof.names");
+
+    llvm::FunctionCallee registerNames = module->getOrInsertFunction(
+        "emlang_funcprof_register", llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {ptrTy, i32Ty}, false));
+    contextManager.addModuleInit("emlang.funcprof.init", registerNames,
+                                 {namesTable, llvm::ConstantInt::get(i32Ty, names.size())});
+}
+
+void CGDecl::emitAliasScopes(llvm::Function* function) {
+    std::vector<ValueMap::RestrictPointer> pointers = valueMap.takeRestrictPointers();
+    if (pointers.size() < 2) {
+        return;
+    }
+
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::MDBuilder mdBuilder(ctx);
+    llvm::MDNode* domain = mdBuilder.createAnonymousAliasScopeDomain(function->getName());
+    std::vector<llvm::Metadata*> scopes;
+    for (const auto& pointer : pointers) {
+        scopes.push_back(mdBuilder.createAnonymousAliasScope(domain, pointer.name));
+    }
+
+    // Each access is in its pointer's scope and disjoint from every other restrict scope
+    for (size_t i = 0; i < pointers.size(); ++i) {
+        std::vector<llvm::Metadata*> others;
+        for (size_t j = 0; j < scopes.size(); ++j) {
+            if (j != i) {
+                others.push_back(scopes[j]);
+            }
+        }
+        llvm::MDNode* ownScope = llvm::MDNode::get(ctx, scopes[i]);
+        llvm::MDNode* otherScopes = llvm::MDNode::get(ctx, others);
+        for (llvm::Instruction* access : pointers[i].accesses) {
+            access->setMetadata(llvm::LLVMContext::MD_alias_scope, ownScope);
+            access->setMetadata(llvm::LLVMContext::MD_noalias, otherScopes);
+        }
+    }
+}
+
+void CGDecl::applyFunctionAttributes(llvm::Function* function, FunctionDecl& node) {
+    const Attribute* inlineAttr = node.findAttribute("inline");
+    const Attribute* optAttr = node.findAttribute("opt");
+    std::string inlineMode = inlineAttr && !inlineAttr->args.empty() ? inlineAttr->args[0] : "";
+    std::string optLevel = optAttr && !optAttr->args.empty() ? optAttr->args[0] : "";
+
+    if (node.findAttribute("optnone") || optLevel == "0") {
+        // optnone is only valid together with noinline
+        function->addFnAttr(llvm::Attribute::OptimizeNone);
+        function->addFnAttr(llvm::Attribute::NoInline);
+    } else if (node.findAttribute("noinline") || inlineMode == "never") {
+        function->addFnAttr(llvm::Attribute::NoInline);
+    } else if (inlineMode == "always") {
+        function->addFnAttr(llvm::Attribute::AlwaysInline);
+    } else if (inlineAttr) {
+        function->addFnAttr(llvm::Attribute::InlineHint);
+    }
+
+    if (node.findAttribute("hot")) {
+        function->addFnAttr(llvm::Attribute::Hot);
+    }
+    if (node.findAttribute("cold")) {
+        function->addFnAttr(llvm::Attribute::Cold);
+        if (optLevel.empty() && !function->hasFnAttribute(llvm::Attribute::OptimizeNone)) {
+            function->addFnAttr(llvm::Attribute::OptimizeForSize);
+        }
+    }
+    if (optLevel == "s" || optLevel == "z") {
+        function->addFnAttr(llvm::Attribute::OptimizeForSize);
+        if (optLevel == "z") {
+            function->addFnAttr(llvm::Attribute::MinSize);
+        }
+    }
+
+    // Entry/exit hooks write profiler state, which memory(none) would let LLVM drop
+    if (node.findAttribute("pure") &&
+        contextManager.getOptions().instrumentFunctions != CodegenOptions::FunctionInstrumentation::Hooks) {
+        function->setDoesNotAccessMemory();
+    }
+
+    if (getFastMathFlags(node).isFast()) {
+        function->addFnAttr("unsafe-fp-math", "true");
+        function->addFnAttr("no-infs-fp-math", "true");
+        function->addFnAttr("no-nans-fp-math", "true");
+        function->addFnAttr("no-signed-zeros-fp-math", "true");
+    }
+}
+
+llvm::FastMathFlags CGDecl::getFastMathFlags(FunctionDecl& node) const {
+    const CodegenOptions& options = contextManager.getOptions();
+    llvm::FastMathFlags flags;
+    if (options.fastMath || node.findAttribute("fast_math")) {
+        flags.setFast();
+    } else if (options.fpContractFast) {
+        flags.setAllowContract();
+    }
+    return flags;
+}
+
+/**
+ * @brief Splits a clone target such as "avx2+fma" into its feature names
+ */
+static std::vector<std::string> splitCloneTarget(const std::string& target) {
+    std::vector<std::string> features;
+    size_t start = 0;
+    size_t end;
+    while ((end = target.find('+', start)) != std::string::npos) {
+        features.push_back(target.substr(start, end - start));
+        start = end + 1;
+    }
+    features.push_back(target.substr(start));
+    return features;
+}
+
+llvm::Function* CGDecl::emitTargetClones(llvm::Function* function, FunctionDecl& node) {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::FunctionType* type = function->getFunctionType();
+    llvm::PointerType* ptrTy = llvm::PointerType::get(ctx, 0);
+    const Attribute* clones = node.findAttribute("target_clones");
+
+    // The dispatcher takes over the public name; the generated body is the default clone
+    llvm::Function* dispatcher = llvm::Function::Create(type, function->getLinkage(), "", module);
+    dispatcher->takeName(function);
+    const std::string name = dispatcher->getName().str();
+    function->setName(name + ".default");
+    function->setLinkage(llvm::GlobalValue::InternalLinkage);
+
+    std::vector<std::pair<std::string, llvm::Function*>> variants;
+    for (const auto& target : clones->args) {
+        if (target == "default") {
+            continue;
+        }
+        llvm::Function* clone = llvm::Function::Create(type, llvm::GlobalValue::InternalLinkage,
+                                                       name + "." + target, module);
+        llvm::ValueToValueMapTy valueMap;
+        auto cloneArg = clone->arg_begin();
+        for (auto& arg : function->args()) {
+            cloneArg->setName(arg.getName());
+            valueMap[&arg] = &*cloneArg++;
+        }
+        // Recursion stays inside the clone instead of going back through dispatch; remapping
+        // a global makes this a global change, which also gives the clone its own subprogram
+        valueMap[function] = clone;
+        llvm::SmallVector<llvm::ReturnInst*, 4> returns;
+        llvm::CloneFunctionInto(clone, function, valueMap, llvm::CloneFunctionChangeType::GlobalChanges, returns);
+
+        std::string features;
+        for (const auto& feature : splitCloneTarget(target)) {
+            features += (features.empty() ? "+" : ",+") + feature;
+        }
+        clone->addFnAttr("target-features", features);
+        variants.emplace_back(target, clone);
+    }
+
+    auto* slot = new llvm::GlobalVariable(*module, ptrTy, false, llvm::GlobalValue::InternalLinkage,
+                                          function, name + ".resolved");
+
+    llvm::IRBuilder<> dispatchBuilder(llvm::BasicBlock::Create(ctx, "entry", dispatcher));
+    std::vector<llvm::Value*> args;
+    auto dispatcherArg = dispatcher->arg_begin();
+    for (auto& arg : function->args()) {
+        dispatcherArg->setName(arg.getName());
+        args.push_back(&*dispatcherArg++);
+    }
+    llvm::Value* target = dispatchBuilder.CreateLoad(ptrTy, slot, "target");
+    llvm::CallInst* call = dispatchBuilder.CreateCall(type, target, args);
+    call->setTailCallKind(llvm::CallInst::TCK_MustTail);
+    if (type->getReturnType()->isVoidTy()) {
+        dispatchBuilder.CreateRetVoid();
+    } else {
+        dispatchBuilder.CreateRet(call);
+    }
+
+    // Targets are tried in the order written; the first one the CPU fully supports wins
+    llvm::Function* resolver = llvm::Function::Create(
+        llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), false),
+        llvm::GlobalValue::InternalLinkage, name + ".resolver", module);
+    llvm::FunctionCallee supports = module->getOrInsertFunction(
+        "emlang_cpu_supports", llvm::FunctionType::get(llvm::Type::getInt32Ty(ctx), {ptrTy}, false));
+    llvm::IRBuilder<> resolveBuilder(llvm::BasicBlock::Create(ctx, "entry", resolver));
+    for (const auto& [target, clone] : variants) {
+        llvm::Value* supported = resolveBuilder.getTrue();
+        for (const auto& feature : splitCloneTarget(target)) {
+            llvm::Value* has = resolveBuilder.CreateCall(
+                supports, {contextManager.createPrivateString(feature, "cpu.feature")});
+            supported = resolveBuilder.CreateAnd(
+                supported, resolveBuilder.CreateICmpNE(has, llvm::ConstantInt::get(has->getType(), 0)));
+        }
+        llvm::BasicBlock* selectBB = llvm::BasicBlock::Create(ctx, "select", resolver);
+        llvm::BasicBlock* nextBB = llvm::BasicBlock::Create(ctx, "next", resolver);
+        resolveBuilder.CreateCondBr(supported, selectBB, nextBB);
+        resolveBuilder.SetInsertPoint(selectBB);
+        resolveBuilder.CreateStore(clone, slot);
+        resolveBuilder.CreateRetVoid();
+        resolveBuilder.SetInsertPoint(nextBB);
+    }
+    resolveBuilder.CreateRetVoid();
+    llvm::appendToGlobalCtors(*module, resolver, 0);
+
+    return dispatcher;
+}
+
 void CGDecl::createFunctionParameters(llvm::Function* function, FunctionDecl& node) {
     // TODO: Implement function parameter creation
     error("Function parameter creation not yet implemented");
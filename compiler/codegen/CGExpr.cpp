@@ -9,6 +9,11 @@
 
 #include "codegen/CGExpr.h"
 #include "ast.h"
+#include "builtins.h"
+
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/MDBuilder.h>
+#include <algorithm>
 
 namespace emlang {
 namespace codegen {
@@ -108,8 +113,17 @@ void CGExpr::visit(IdentifierExpr& node) {
     // Set the current expression type from value map for proper type tracking
     currentExpressionType = valueMap.getVariableType(node.name);
     
-    // Load the value using context manager's builder with proper type
-    llvm::Type* loadType = value->getType();
+    // Load the value using context manager's builder with proper type;
+    // range-for variables are bound to their SSA value and used directly
+    llvm::Type* loadType = nullptr;
+    if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(value)) {
+        loadType = alloca->getAllocatedType();
+    } else if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+        loadType = global->getValueType();
+    } else {
+        currentValue = value;
+        return;
+    }
     currentValue = contextManager.getBuilder().CreateLoad(loadType, value, node.name);
 }
 
@@ -128,48 +142,103 @@ void CGExpr::visit(BinaryOpExpr& node) {
         error(CodegenErrorType::InternalError, "Invalid operands in binary expression");
         return;
     }
+    if (isWholeArrayExpression(node)) {
+        error(CodegenErrorType::TypeMismatch, "Whole-array expressions can only be assigned to an array or slice, or summed");
+        return;
+    }
     
-    // Generate appropriate instruction based on operator
     auto& builder = contextManager.getBuilder();
     
+    // Operands meet at the analyzer's promoted type: floats win over integers, wider
+    // over narrower, and at equal width unsigned over signed
+    llvm::Type* leftLLVMType = leftValue->getType();
+    llvm::Type* rightLLVMType = rightValue->getType();
+    bool leftUnsigned = isUnsignedType(leftType);
+    bool rightUnsigned = isUnsignedType(rightType);
+    bool isFloat = leftLLVMType->isFloatingPointTy() || rightLLVMType->isFloatingPointTy();
+    bool isUnsigned = false;
+    if (isFloat) {
+        // Float literals are typed float, like the analyzer does, so only a double
+        // value that is not a literal makes the operation double. Literal-only
+        // arithmetic folds in double and is narrowed once where it is used, so
+        // `let d: double = 1.0 / 3.0` keeps double precision.
+        bool isConstant = llvm::isa<llvm::Constant>(leftValue) && llvm::isa<llvm::Constant>(rightValue);
+        bool isDouble = isConstant ||
+                        (leftLLVMType->isDoubleTy() && !llvm::isa<llvm::ConstantFP>(leftValue)) ||
+                        (rightLLVMType->isDoubleTy() && !llvm::isa<llvm::ConstantFP>(rightValue));
+        llvm::Type* floatType = isDouble ? builder.getDoubleTy() : builder.getFloatTy();
+        leftValue = convertValue(leftValue, floatType, leftUnsigned);
+        rightValue = convertValue(rightValue, floatType, rightUnsigned);
+        currentExpressionType = floatType->isDoubleTy() ? "double" : "float";
+    } else if (leftLLVMType->isIntegerTy() && rightLLVMType->isIntegerTy()) {
+        unsigned leftBits = leftLLVMType->getIntegerBitWidth();
+        unsigned rightBits = rightLLVMType->getIntegerBitWidth();
+        if (leftBits < rightBits) {
+            leftValue = convertValue(leftValue, rightLLVMType, leftUnsigned);
+            isUnsigned = rightUnsigned;
+        } else if (leftBits > rightBits) {
+            rightValue = convertValue(rightValue, leftLLVMType, rightUnsigned);
+            isUnsigned = leftUnsigned;
+            currentExpressionType = leftType;
+        } else {
+            isUnsigned = leftUnsigned || rightUnsigned;
+            currentExpressionType = leftUnsigned || !rightUnsigned ? leftType : rightType;
+        }
+    }
+
+    // Generate appropriate instruction based on operator
+    bool checked = contextManager.getOptions().checkedArith && leftValue->getType()->isIntegerTy() &&
+                   leftValue->getType() == rightValue->getType() && leftValue->getType()->getIntegerBitWidth() > 1;
     switch (node.operator_) {
         case BinaryOpExpr::BinOp::ADD:
-            currentValue = builder.CreateAdd(leftValue, rightValue, "addtmp");
-            break;
         case BinaryOpExpr::BinOp::SUB:
-            currentValue = builder.CreateSub(leftValue, rightValue, "subtmp");
-            break;
         case BinaryOpExpr::BinOp::MUL:
-            currentValue = builder.CreateMul(leftValue, rightValue, "multmp");
+            if (isFloat) {
+                currentValue = generateFloatArithmetic(node.operator_, leftValue, rightValue);
+            } else if (checked) {
+                currentValue = generateCheckedArithmetic(node.operator_, leftValue, rightValue, isUnsigned, node.line);
+            } else if (node.operator_ == BinaryOpExpr::BinOp::ADD) {
+                currentValue = builder.CreateAdd(leftValue, rightValue, "addtmp");
+            } else if (node.operator_ == BinaryOpExpr::BinOp::SUB) {
+                currentValue = builder.CreateSub(leftValue, rightValue, "subtmp");
+            } else {
+                currentValue = builder.CreateMul(leftValue, rightValue, "multmp");
+            }
             break;
         case BinaryOpExpr::BinOp::DIV:
-            currentValue = builder.CreateSDiv(leftValue, rightValue, "divtmp");
+            if (isFloat) {
+                currentValue = generateFloatArithmetic(node.operator_, leftValue, rightValue);
+            } else if (isUnsigned) {
+                currentValue = builder.CreateUDiv(leftValue, rightValue, "divtmp");
+            } else {
+                currentValue = builder.CreateSDiv(leftValue, rightValue, "divtmp");
+            }
             break;
         case BinaryOpExpr::BinOp::MOD:
-            currentValue = builder.CreateSRem(leftValue, rightValue, "modtmp");
+            if (isFloat) {
+                currentValue = generateFloatArithmetic(node.operator_, leftValue, rightValue);
+                break;
+            }
+            currentValue = isUnsigned ? builder.CreateURem(leftValue, rightValue, "modtmp")
+                                      : builder.CreateSRem(leftValue, rightValue, "modtmp");
+            // The remainder is smaller in magnitude than a constant divisor
+            if (auto* divisor = llvm::dyn_cast<llvm::ConstantInt>(rightValue); divisor && checked && !divisor->isZero()) {
+                if (isUnsigned) {
+                    setValueRange(currentValue, llvm::ConstantRange::getNonEmpty(
+                        llvm::APInt::getZero(divisor->getBitWidth()), divisor->getValue()));
+                } else if (!divisor->getValue().isMinSignedValue()) {
+                    llvm::APInt bound = divisor->getValue().abs();
+                    setValueRange(currentValue, llvm::ConstantRange::getNonEmpty(-bound + 1, bound));
+                }
+            }
             break;
         case BinaryOpExpr::BinOp::LT:
-            currentValue = builder.CreateICmpSLT(leftValue, rightValue, "cmptmp");
-            currentExpressionType = "bool";
-            break;
         case BinaryOpExpr::BinOp::GT:
-            currentValue = builder.CreateICmpSGT(leftValue, rightValue, "cmptmp");
-            currentExpressionType = "bool";
-            break;
         case BinaryOpExpr::BinOp::LE:
-            currentValue = builder.CreateICmpSLE(leftValue, rightValue, "cmptmp");
-            currentExpressionType = "bool";
-            break;
         case BinaryOpExpr::BinOp::GE:
-            currentValue = builder.CreateICmpSGE(leftValue, rightValue, "cmptmp");
-            currentExpressionType = "bool";
-            break;
         case BinaryOpExpr::BinOp::EQ:
-            currentValue = builder.CreateICmpEQ(leftValue, rightValue, "cmptmp");
-            currentExpressionType = "bool";
-            break;
         case BinaryOpExpr::BinOp::NE:
-            currentValue = builder.CreateICmpNE(leftValue, rightValue, "cmptmp");
+            currentValue = generateComparison(node.operator_, leftValue, rightValue, isFloat, isUnsigned);
             currentExpressionType = "bool";
             break;
         case BinaryOpExpr::BinOp::LAND:
@@ -193,7 +262,9 @@ void CGExpr::visit(BinaryOpExpr& node) {
             currentValue = builder.CreateShl(leftValue, rightValue, "shltmp");
             break;
         case BinaryOpExpr::BinOp::SHR:
-            currentValue = builder.CreateLShr(leftValue, rightValue, "shrtmp");
+            // Signed values shift in copies of the sign bit
+            currentValue = isUnsigned ? builder.CreateLShr(leftValue, rightValue, "shrtmp")
+                                      : builder.CreateAShr(leftValue, rightValue, "shrtmp");
             break;
         default:
             error(CodegenErrorType::TypeMismatch, "Unknown binary operator");
@@ -210,12 +281,25 @@ void CGExpr::visit(UnaryOpExpr& node) {
         error(CodegenErrorType::InternalError, "Invalid operand in unary expression");
         return;
     }
+    if (isWholeArrayExpression(node)) {
+        error(CodegenErrorType::TypeMismatch, "Whole-array expressions can only be assigned to an array or slice, or summed");
+        return;
+    }
     
     auto& builder = contextManager.getBuilder();
     
     switch (node.operator_) {
         case BinaryOpExpr::BinOp::SUB:  // Negation uses SUB operator
-            currentValue = builder.CreateNeg(operandValue, "negtmp");
+            // Negating the minimum signed value overflows
+            if (contextManager.getOptions().checkedArith && operandValue->getType()->isIntegerTy() &&
+                !isUnsignedType(currentExpressionType)) {
+                currentValue = generateCheckedArithmetic(BinaryOpExpr::BinOp::SUB, 
+                                                         llvm::ConstantInt::get(operandValue->getType(), 0), 
+                                                         operandValue, false, node.line);
+                break;
+            }
+            currentValue = operandValue->getType()->isFloatingPointTy() ? builder.CreateFNeg(operandValue, "negtmp")
+                                                                        : builder.CreateNeg(operandValue, "negtmp");
             break;
         case BinaryOpExpr::BinOp::LNOT:  // Logical NOT
             currentValue = builder.CreateNot(operandValue, "nottmp");
@@ -231,8 +315,15 @@ void CGExpr::visit(UnaryOpExpr& node) {
 }
 
 void CGExpr::visit(AssignmentExpr& node) {
+    if (isWholeArrayExpression(*node.value)) {
+        generateArrayAssignment(node);
+        return;
+    }
+    
     // First, determine where we're storing the value (target)
     llvm::Value* targetPtr = nullptr;
+    llvm::Type* storeType = nullptr;
+    llvm::Value* pointerStorage = nullptr; // Variable holding the pointer written through, if any
     
     if (auto* identExpr = dynamic_cast<IdentifierExpr*>(node.target.get())) {
         // Target is a simple variable
@@ -250,7 +341,25 @@ void CGExpr::visit(AssignmentExpr& node) {
             error(CodegenErrorType::InternalError, "Invalid pointer dereference in assignment");
             return;
         }
+        if (auto* pointerIdent = dynamic_cast<IdentifierExpr*>(derefExpr->operand.get())) {
+            pointerStorage = valueMap.getVariable(pointerIdent->name);
+        }
 #endif // EMLANG_FEATURE_POINTERS
+    } else if (dynamic_cast<IndexExpr*>(node.target.get()) || dynamic_cast<MemberExpr*>(node.target.get())) {
+        // Target is an element or field - store through its (bounds-checked for vectors) address
+        std::string targetType;
+        if (!generateAddress(*node.target, targetPtr, targetType)) {
+            error(CodegenErrorType::TypeMismatch, "Indexed assignment is only supported for vectors and arrays");
+            return;
+        }
+        if (!targetPtr) {
+            return;
+        }
+        storeType = valueMap.getLLVMType(targetType, contextManager);
+        auto* element = dynamic_cast<IndexExpr*>(node.target.get());
+        if (auto* pointerIdent = element ? dynamic_cast<IdentifierExpr*>(element->array.get()) : nullptr) {
+            pointerStorage = valueMap.getVariable(pointerIdent->name);
+        }
     } else {
         error(CodegenErrorType::TypeMismatch, "Invalid assignment target type");
         return;
@@ -266,15 +375,66 @@ void CGExpr::visit(AssignmentExpr& node) {
     
     // Create a store instruction to assign the value using context manager's builder
     auto& builder = contextManager.getBuilder();
-    builder.CreateStore(valueToStore, targetPtr);
+    if (!storeType) {
+        if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(targetPtr)) {
+            storeType = alloca->getAllocatedType();
+        } else if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(targetPtr)) {
+            storeType = global->getValueType();
+        }
+    }
+    valueToStore = convertValue(valueToStore, storeType, isUnsignedType(currentExpressionType));
+    llvm::StoreInst* store = builder.CreateStore(valueToStore, targetPtr);
+    if (pointerStorage) {
+        valueMap.recordRestrictAccess(pointerStorage, store);
+    }
     
     // The value of the assignment expression is the value assigned
     currentValue = valueToStore;
 }
 
 void CGExpr::visit(FunctionCallExpr& node) {
+    // Vector intrinsics are generic over the element type and lowered inline
+    if (isVecIntrinsic(node.functionName)) {
+        generateVecIntrinsic(node);
+        return;
+    }
+    // The program's own function of the same name, if any, was declared before this call
+    bool shadowed = contextManager.getModule()->getFunction(node.functionName) != nullptr;
+    if (isHintIntrinsic(node.functionName) && !shadowed) {
+        generateHintIntrinsic(node);
+        return;
+    }
+    if (isArrayIntrinsic(node.functionName) && !shadowed) {
+        generateArraySum(node);
+        return;
+    }
+    if (isTaskIntrinsic(node.functionName)) {
+        generateYield(node);
+        return;
+    }
+    // Without errno the math builtins are pure, so LLVM may fold, hoist and vectorize them
+    if (!contextManager.getOptions().mathErrno && generateMathIntrinsic(node)) {
+        return;
+    }
+    if (isSliceIntrinsic(node.functionName)) {
+        // slice_len: the length is the second half of the slice value
+        node.arguments[0]->accept(*this);
+        if (currentValue) {
+            currentValue = contextManager.getBuilder().CreateExtractValue(currentValue, {1}, "slicelen");
+            currentExpressionType = "int64";
+        }
+        return;
+    }
+
     // Look up function using context manager
     llvm::Function* calleeF = contextManager.getModule()->getFunction(node.functionName);
+    std::string returnType;
+    if (!calleeF) {
+        calleeF = declareBuiltinFunction(node.functionName);
+        if (calleeF) {
+            returnType = getBuiltinFunction(node.functionName)->returnType;
+        }
+    }
     
     if (!calleeF) {
         error(CodegenErrorType::UndefinedSymbol, "Unknown function referenced: " + node.functionName);
@@ -298,7 +458,14 @@ void CGExpr::visit(FunctionCallExpr& node) {
             error(CodegenErrorType::InternalError, "Invalid argument in function call");
             return;
         }
-        argsV.push_back(currentValue);
+        argsV.push_back(convertValue(currentValue, calleeF->getArg(argsV.size())->getType(),
+                                     isUnsignedType(currentExpressionType)));
+    }
+    // Arguments may contain calls of their own; the call itself is attributed to its name
+    emitLocation(node);
+    
+    if (contextManager.getOptions().heapProfile && generateProfiledAllocation(node, argsV)) {
+        return;
     }
     
     // Create call instruction using context manager's builder
@@ -308,23 +475,147 @@ void CGExpr::visit(FunctionCallExpr& node) {
         currentExpressionType = "void";
     } else {
         currentValue = builder.CreateCall(calleeF, argsV, "calltmp");
+        // Struct results are named after their struct so members can be extracted
+        auto* structType = llvm::dyn_cast<llvm::StructType>(calleeF->getReturnType());
+        if (returnType.empty() && structType && structType->hasName() &&
+            valueMap.getStruct(structType->getName().str())) {
+            returnType = structType->getName().str();
+        }
+        // Async functions return their task
+        auto task = taskTypes.find(node.functionName);
+        if (returnType.empty() && task != taskTypes.end()) {
+            returnType = task->second;
+        }
         // Set the expression type to a default for now - type conversion needs improvement
-        currentExpressionType = "i32"; // Fallback type
+        currentExpressionType = returnType.empty() ? "i32" : returnType; // Fallback type
+    }
+}
+
+llvm::Function* CGExpr::declareBuiltinFunction(const std::string& name) {
+    const BuiltinFunction* builtin = getBuiltinFunction(name);
+    if (!builtin) {
+        return nullptr;
+    }
+
+    llvm::Module* module = contextManager.getModule();
+    if (llvm::Function* existing = module->getFunction(builtin->linkName)) {
+        return existing;
+    }
+
+    std::vector<llvm::Type*> paramTypes;
+    for (const auto& param : builtin->parameters) {
+        llvm::Type* paramType = valueMap.getLLVMType(param.type, contextManager);
+        if (!paramType) {
+            return nullptr;
+        }
+        paramTypes.push_back(paramType);
+    }
+    llvm::Type* returnType = valueMap.getLLVMType(builtin->returnType, contextManager);
+    if (!returnType) {
+        return nullptr;
     }
+
+    llvm::FunctionType* funcType = llvm::FunctionType::get(returnType, paramTypes, false);
+    return llvm::Function::Create(funcType, llvm::Function::ExternalLinkage, builtin->linkName, module);
+}
+
+bool CGExpr::generateProfiledAllocation(FunctionCallExpr& node, const std::vector<llvm::Value*>& args) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i32Ty = llvm::Type::getInt32Ty(ctx);
+
+    if (node.functionName == "emlang_malloc") {
+        llvm::FunctionCallee profiledMalloc = module->getOrInsertFunction(
+            "emlang_heapprof_malloc", llvm::FunctionType::get(ptrTy, {i32Ty, i32Ty}, false));
+        std::string function = builder.GetInsertBlock()->getParent()->getName().str();
+        int site = static_cast<int>(heapProfileSites.size());
+        heapProfileSites.emplace_back(function, static_cast<int>(node.line));
+        currentValue = builder.CreateCall(profiledMalloc, {args[0], builder.getInt32(site)}, "calltmp");
+        currentExpressionType = "void*";
+        return true;
+    }
+    if (node.functionName == "emlang_free") {
+        llvm::FunctionCallee profiledFree = module->getOrInsertFunction(
+            "emlang_heapprof_free", llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {ptrTy}, false));
+        currentValue = builder.CreateCall(profiledFree, {args[0]});
+        currentExpressionType = "void";
+        return true;
+    }
+    return false;
+}
+
+void CGExpr::emitHeapProfileSites() {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i32Ty = llvm::Type::getInt32Ty(ctx);
+
+    // Sites in one function share its name string
+    std::map<std::string, llvm::Constant*> functionNames;
+    std::vector<llvm::Constant*> names;
+    std::vector<llvm::Constant*> lines;
+    for (const auto& site : heapProfileSites) {
+        llvm::Constant*& name = functionNames[site.first];
+        if (!name) {
+            name = contextManager.createPrivateString(site.first, "heapprof.fn");
+        }
+        names.push_back(name);
+        lines.push_back(llvm::ConstantInt::get(i32Ty, site.second));
+    }
+
+    llvm::Constant* namesTable = llvm::ConstantPointerNull::get(llvm::PointerType::get(ctx, 0));
+    llvm::Constant* linesTable = namesTable;
+    if (!heapProfileSites.empty()) {
+        auto* namesType = llvm::ArrayType::get(ptrTy, names.size());
+        auto* linesType = llvm::ArrayType::get(i32Ty, lines.size());
+        namesTable = new llvm::GlobalVariable(*module, namesType, true, llvm::GlobalValue::PrivateLinkage,
+                                              llvm::ConstantArray::get(namesType, names), "heapprof.sites");
+        linesTable = new llvm::GlobalVariable(*module, linesType, true, llvm::GlobalValue::PrivateLinkage,
+                                              llvm::ConstantArray::get(linesType, lines), "heapprof.lines");
+    }
+    const std::string& sourceFile = contextManager.getOptions().sourceFile;
+    llvm::Constant* file = contextManager.createPrivateString(
+        sourceFile.empty() ? module->getName().str() : sourceFile, "heapprof.file");
+
+    // Register the table before main runs so the first allocation is attributed
+    llvm::FunctionCallee registerSites = module->getOrInsertFunction(
+        "emlang_heapprof_register",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {ptrTy, ptrTy, i32Ty, ptrTy}, false));
+    contextManager.addModuleInit("emlang.heapprof.init", registerSites,
+                                 {namesTable, linesTable, llvm::ConstantInt::get(i32Ty, heapProfileSites.size()), file});
 }
 
 void CGExpr::visit(MemberExpr& node) {
-    // Generate object expression
-    node.object->accept(*this);
-    llvm::Value* objectValue = currentValue;
+    auto& builder = contextManager.getBuilder();
     
-    if (!objectValue) {
-        error(CodegenErrorType::InternalError, "Invalid object in member access");
+    // Fields of variables and elements are loaded straight from memory
+    llvm::Value* fieldPtr = nullptr;
+    std::string fieldType;
+    if (generateAddress(node, fieldPtr, fieldType)) {
+        if (fieldPtr) {
+            currentValue = builder.CreateLoad(valueMap.getLLVMType(fieldType, contextManager), fieldPtr, node.memberName);
+            currentExpressionType = fieldType;
+        }
         return;
     }
     
-    // TODO: Implement proper struct/object member access
-    error(CodegenErrorType::UnknownType, "Member access not yet fully implemented");
+    // Struct rvalues (e.g. call results) are taken apart in registers
+    node.object->accept(*this);
+    llvm::Value* objectValue = currentValue;
+    const ValueMap::StructLayout* layout = valueMap.getStruct(currentExpressionType);
+    if (!objectValue || !layout) {
+        error(CodegenErrorType::TypeMismatch, "Member access requires a struct: ." + node.memberName);
+        return;
+    }
+    int index = layout->fieldIndex(node.memberName);
+    if (index < 0) {
+        error(CodegenErrorType::UndefinedSymbol, "Unknown field: " + node.memberName);
+        return;
+    }
+    currentValue = builder.CreateExtractValue(objectValue, {static_cast<unsigned>(index)}, node.memberName);
+    currentExpressionType = layout->fieldTypes[index];
 }
 
 #ifdef EMLANG_FEATURE_CASTING
@@ -406,21 +697,59 @@ void CGExpr::visit(CastExpr& node) {
 #endif // EMLANG_FEATURE_CASTING
 
 void CGExpr::visit(IndexExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    
+    // Elements of array and vector variables are loaded through their address
+    llvm::Value* address = nullptr;
+    std::string elementTypeStr;
+    if (generateAddress(node, address, elementTypeStr)) {
+        if (address) {
+            llvm::LoadInst* load = builder.CreateLoad(valueMap.getLLVMType(elementTypeStr, contextManager), address, "arrayload");
+            if (auto* identifier = dynamic_cast<IdentifierExpr*>(node.array.get())) {
+                valueMap.recordRestrictAccess(valueMap.getVariable(identifier->name), load);
+            }
+            currentValue = load;
+            currentExpressionType = elementTypeStr;
+        }
+        return;
+    }
+    
     // Generate array expression
     node.array->accept(*this);
     llvm::Value* arrayValue = currentValue;
     std::string arrayType = currentExpressionType;
     
+    // Slice rvalues (e.g. call results) are indexed through their data pointer
+    if (arrayValue && arrayType.compare(0, 2, "[]") == 0) {
+        generateSliceElementAddress(node, arrayValue, arrayType, address, elementTypeStr);
+        if (address) {
+            currentValue = builder.CreateLoad(valueMap.getLLVMType(elementTypeStr, contextManager), address, "sliceload");
+            currentExpressionType = elementTypeStr;
+        }
+        return;
+    }
+    
     // Generate index expression
-    node.index->accept(*this);
-    llvm::Value* indexValue = currentValue;
+    llvm::Value* indexValue = generateIndex(*node.index);
     
     if (!arrayValue || !indexValue) {
         error(CodegenErrorType::InternalError, "Invalid array or index in array access");
         return;
     }
-    
-    auto& builder = contextManager.getBuilder();
+
+    // Vector element - inline bounds check and load
+    if (arrayType.compare(0, 4, "vec<") == 0) {
+        std::string elementTypeStr = vecElementType(arrayType);
+        llvm::Type* elementType = valueMap.getLLVMType(elementTypeStr, contextManager);
+        if (!elementType) {
+            error(CodegenErrorType::UnknownType, "Unknown vector element type: " + elementTypeStr);
+            return;
+        }
+        llvm::Value* elementPtr = generateVecElementPtr(arrayValue, indexValue, elementType);
+        currentValue = builder.CreateLoad(elementType, elementPtr, "vecload");
+        currentExpressionType = elementTypeStr;
+        return;
+    }
     
     // Create GEP (GetElementPtr) instruction for array access
     std::vector<llvm::Value*> indices;
@@ -456,12 +785,104 @@ void CGExpr::visit(IndexExpr& node) {
     }
 }
 
+void CGExpr::visit(SliceExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Type* ptrTy = llvm::PointerType::get(contextManager.getContext(), 0);
+    llvm::Type* i64Ty = builder.getInt64Ty();
+    
+    // Fixed arrays are sliced in place; vectors and slices are read as values
+    llvm::Value* arrayPtr = nullptr;
+    llvm::Value* arrayValue = nullptr;
+    std::string arrayType;
+    if (generateAddress(*node.array, arrayPtr, arrayType)) {
+        if (!arrayPtr) {
+            return;
+        }
+    } else {
+        node.array->accept(*this);
+        arrayValue = currentValue;
+        arrayType = currentExpressionType;
+        if (!arrayValue) {
+            return;
+        }
+    }
+    
+    llvm::Value* data = nullptr;
+    llvm::Value* length = nullptr;
+    std::string elementType;
+    uint64_t size = 0;
+    if (arrayPtr && ValueMap::splitArrayType(arrayType, elementType, size)) {
+        const ValueMap::StructLayout* layout = valueMap.getStruct(elementType);
+        if (layout && layout->soa) {
+            error(CodegenErrorType::TypeMismatch, "#[soa] arrays cannot be sliced: " + arrayType);
+            return;
+        }
+        data = arrayPtr;
+        length = builder.getInt64(size);
+    } else if (arrayType.compare(0, 4, "vec<") == 0) {
+        elementType = vecElementType(arrayType);
+        llvm::Value* vec = arrayPtr ? builder.CreateLoad(ptrTy, arrayPtr, "vec") : arrayValue;
+        llvm::StructType* headerType = llvm::StructType::get(contextManager.getContext(), {ptrTy, i64Ty, i64Ty});
+        data = builder.CreateLoad(ptrTy, builder.CreateStructGEP(headerType, vec, 0, "vecdataptr"), "vecdata");
+        length = builder.CreateLoad(i64Ty, builder.CreateStructGEP(headerType, vec, 1, "veclenptr"), "veclen");
+    } else if (arrayType.compare(0, 2, "[]") == 0) {
+        elementType = arrayType.substr(2);
+        llvm::Value* slice = arrayPtr ? builder.CreateLoad(valueMap.getLLVMType(arrayType, contextManager), arrayPtr, "slice")
+                                      : arrayValue;
+        data = builder.CreateExtractValue(slice, {0}, "slicedata");
+        length = builder.CreateExtractValue(slice, {1}, "slicelen");
+    } else {
+        error(CodegenErrorType::TypeMismatch, "Slicing requires an array, vector or slice, got: " + arrayType);
+        return;
+    }
+    
+    llvm::Value* start = builder.getInt64(0);
+    if (node.start) {
+        node.start->accept(*this);
+        if (!currentValue) {
+            return;
+        }
+        start = convertValue(currentValue, i64Ty, isUnsignedType(currentExpressionType));
+    }
+    llvm::Value* end = length;
+    if (node.end) {
+        node.end->accept(*this);
+        if (!currentValue) {
+            return;
+        }
+        end = convertValue(currentValue, i64Ty, isUnsignedType(currentExpressionType));
+    }
+    
+    if (contextManager.getOptions().boundsChecks) {
+        // Unsigned compares reject negative bounds as well
+        llvm::Value* inRange = builder.CreateAnd(builder.CreateICmpULE(start, end), builder.CreateICmpULE(end, length),
+                                                 "sliceinrange");
+        generateRangeCheck(inRange, "emlang_slice_range_fail", {start, end, length});
+    }
+    
+    llvm::Type* sliceType = valueMap.getLLVMType("[]" + elementType, contextManager);
+    llvm::Value* slice = llvm::Constant::getNullValue(sliceType);
+    slice = builder.CreateInsertValue(slice, builder.CreateInBoundsGEP(valueMap.getLLVMType(elementType, contextManager),
+                                                                       data, start, "slicebegin"), {0});
+    slice = builder.CreateInsertValue(slice, builder.CreateSub(end, start, "slicelen"), {1}, "slice");
+    currentValue = slice;
+    currentExpressionType = "[]" + elementType;
+}
+
 void CGExpr::visit(ArrayExpr& node) {
     if (node.elements.empty()) {
         error(CodegenErrorType::TypeMismatch, "Empty array literals not supported");
         return;
     }
     
+    // Literal-only arrays are read in place from read-only data
+    if (llvm::Constant* values = generateConstantArray("", node)) {
+        std::string elementType = currentExpressionType;
+        currentValue = getArrayTable(values);
+        currentExpressionType = elementType + "[" + std::to_string(node.elements.size()) + "]";
+        return;
+    }
+    
     // Generate all elements and determine common type
     std::vector<llvm::Value*> elementValues;
     std::string elementType;
@@ -509,8 +930,61 @@ void CGExpr::visit(ArrayExpr& node) {
 }
 
 void CGExpr::visit(ObjectExpr& node) {
-    // TODO: Implement proper object literal support
-    error(CodegenErrorType::UnknownType, "Object literals not yet implemented");
+    // The struct type comes from the declaration being initialized
+    error(CodegenErrorType::UnknownType, "Object literals are only supported as struct variable initializers");
+}
+
+void CGExpr::visit(AwaitExpr& node) {
+    node.operand->accept(*this);
+    llvm::Value* task = currentValue;
+    currentValue = nullptr;
+    if (!task || !task->getType()->isPointerTy()) {
+        error(CodegenErrorType::TypeMismatch, "await requires a task");
+        return;
+    }
+    llvm::Type* resultTy = valueMap.getLLVMType(node.resultType, contextManager);
+    if (!resultTy) {
+        error(CodegenErrorType::UnknownType, "Unknown task result type: " + node.resultType);
+        return;
+    }
+    emitLocation(node);
+    
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    if (inCoroutine()) {
+        // Suspend unless the task has finished; it schedules this one when it does
+        llvm::Function* function = builder.GetInsertBlock()->getParent();
+        llvm::BasicBlock* suspendBB = llvm::BasicBlock::Create(ctx, "await.suspend", function);
+        llvm::BasicBlock* readyBB = llvm::BasicBlock::Create(ctx, "await.ready", function);
+        llvm::Value* done = builder.CreateIntrinsic(llvm::Intrinsic::coro_done, {}, {task}, nullptr, "await.done");
+        builder.CreateCondBr(done, readyBB, suspendBB);
+        
+        builder.SetInsertPoint(suspendBB);
+        llvm::Value* save = builder.CreateIntrinsic(llvm::Intrinsic::coro_save, {}, {coroutine.handle}, nullptr, "coro.save");
+        llvm::Value* promise = builder.CreateIntrinsic(llvm::Intrinsic::coro_promise, {},
+                                                       {task, builder.getInt32(promiseAlignment), builder.getFalse()},
+                                                       nullptr, "await.promise");
+        // The waiter is the first field of every promise
+        builder.CreateStore(coroutine.handle, promise);
+        generateSuspend(save);
+        builder.CreateBr(readyBB);
+        builder.SetInsertPoint(readyBB);
+    } else {
+        // Outside async functions the executor runs ready tasks until this one finishes
+        builder.CreateCall(getTaskRuntime("emlang_task_block_on"), {task});
+    }
+    
+    // The result stays in the finished task's promise until the task is destroyed
+    if (!resultTy->isVoidTy()) {
+        llvm::StructType* promiseType = llvm::StructType::get(ctx, {ptrTy, resultTy});
+        llvm::Value* promise = builder.CreateIntrinsic(llvm::Intrinsic::coro_promise, {},
+                                                       {task, builder.getInt32(promiseAlignment), builder.getFalse()},
+                                                       nullptr, "await.promise");
+        currentValue = builder.CreateLoad(resultTy, builder.CreateStructGEP(promiseType, promise, 1), "await.result");
+    }
+    builder.CreateIntrinsic(llvm::Intrinsic::coro_destroy, {}, {task});
+    currentExpressionType = node.resultType;
 }
 
 #ifdef EMLANG_FEATURE_POINTERS
@@ -539,27 +1013,1414 @@ void CGExpr::visit(DereferenceExpr& node) {
     
     // Create load instruction to dereference pointer using context manager's builder
     auto& builder = contextManager.getBuilder();
-    currentValue = builder.CreateLoad(elementType, ptrValue, "deref");
+    llvm::LoadInst* load = builder.CreateLoad(elementType, ptrValue, "deref");
+    if (auto* identifier = dynamic_cast<IdentifierExpr*>(node.operand.get())) {
+        valueMap.recordRestrictAccess(valueMap.getVariable(identifier->name), load);
+    }
+    currentValue = load;
 }
 
 void CGExpr::visit(AddressOfExpr& node) {
-    // For address-of operation, we need the address of a variable
-    if (auto identifier = dynamic_cast<IdentifierExpr*>(node.operand.get())) {
-        llvm::Value* value = valueMap.getVariable(identifier->name);
+    // Variables, elements and fields have an address: &var, &arr[i], &point.x
+    llvm::Value* address = nullptr;
+    std::string type;
+    if (!generateAddress(*node.operand, address, type)) {
+        error(CodegenErrorType::TypeMismatch, "Address-of operation only supported for variables, elements and fields");
+        return;
+    }
+    if (address) {
+        currentValue = address;
+        currentExpressionType = type + "*";
+    }
+}
+#endif // EMLANG_FEATURE_POINTERS
+
+/******************** Arithmetic Lowering ********************/
+
+llvm::Value* CGExpr::generateFloatArithmetic(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right) {
+    auto& builder = contextManager.getBuilder();
+    switch (op) {
+        case BinaryOpExpr::BinOp::ADD:
+            return builder.CreateFAdd(left, right, "addtmp");
+        case BinaryOpExpr::BinOp::SUB:
+            return builder.CreateFSub(left, right, "subtmp");
+        case BinaryOpExpr::BinOp::MUL:
+            return builder.CreateFMul(left, right, "multmp");
+        case BinaryOpExpr::BinOp::DIV:
+            return builder.CreateFDiv(left, right, "divtmp");
+        default:
+            return builder.CreateFRem(left, right, "modtmp");
+    }
+}
+
+llvm::Value* CGExpr::generateComparison(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right,
+                                        bool isFloat, bool isUnsigned) {
+    auto& builder = contextManager.getBuilder();
+    llvm::CmpInst::Predicate predicate;
+    switch (op) {
+        case BinaryOpExpr::BinOp::LT:
+            predicate = isFloat ? llvm::CmpInst::FCMP_OLT : isUnsigned ? llvm::CmpInst::ICMP_ULT : llvm::CmpInst::ICMP_SLT;
+            break;
+        case BinaryOpExpr::BinOp::GT:
+            predicate = isFloat ? llvm::CmpInst::FCMP_OGT : isUnsigned ? llvm::CmpInst::ICMP_UGT : llvm::CmpInst::ICMP_SGT;
+            break;
+        case BinaryOpExpr::BinOp::LE:
+            predicate = isFloat ? llvm::CmpInst::FCMP_OLE : isUnsigned ? llvm::CmpInst::ICMP_ULE : llvm::CmpInst::ICMP_SLE;
+            break;
+        case BinaryOpExpr::BinOp::GE:
+            predicate = isFloat ? llvm::CmpInst::FCMP_OGE : isUnsigned ? llvm::CmpInst::ICMP_UGE : llvm::CmpInst::ICMP_SGE;
+            break;
+        case BinaryOpExpr::BinOp::EQ:
+            predicate = isFloat ? llvm::CmpInst::FCMP_OEQ : llvm::CmpInst::ICMP_EQ;
+            break;
+        default:
+            predicate = isFloat ? llvm::CmpInst::FCMP_UNE : llvm::CmpInst::ICMP_NE;
+            break;
+    }
+    return isFloat ? builder.CreateFCmp(predicate, left, right, "cmptmp")
+                   : builder.CreateICmp(predicate, left, right, "cmptmp");
+}
+
+bool CGExpr::generateMathIntrinsic(FunctionCallExpr& node) {
+    llvm::Intrinsic::ID id;
+    if (node.functionName == "emlang_sin") {
+        id = llvm::Intrinsic::sin;
+    } else if (node.functionName == "emlang_cos") {
+        id = llvm::Intrinsic::cos;
+    } else {
+        return false;
+    }
+    if (node.arguments.size() != 1) {
+        return false;
+    }
+    node.arguments[0]->accept(*this);
+    if (!currentValue) {
+        return true;
+    }
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* argument = convertValue(currentValue, builder.getDoubleTy(), isUnsignedType(currentExpressionType));
+    emitLocation(node);
+    currentValue = builder.CreateUnaryIntrinsic(id, argument, nullptr, "calltmp");
+    currentExpressionType = "double";
+    return true;
+}
+
+/******************** Struct Lowering ********************/
+
+llvm::Value* CGExpr::generateStructLiteral(const std::string& structType, ObjectExpr& node) {
+    const ValueMap::StructLayout* layout = valueMap.getStruct(structType);
+    if (!layout) {
+        error(CodegenErrorType::UnknownType, "Unknown struct type: " + structType);
+        return nullptr;
+    }
+    
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* value = llvm::Constant::getNullValue(layout->type);
+    for (auto& field : node.fields) {
+        int index = layout->fieldIndex(field.key);
+        if (index < 0) {
+            error(CodegenErrorType::UndefinedSymbol, "Struct " + structType + " has no field: " + field.key);
+            return nullptr;
+        }
+        field.value->accept(*this);
+        if (!currentValue) {
+            return nullptr;
+        }
+        llvm::Value* fieldValue = convertValue(currentValue, layout->type->getElementType(index),
+                                               isUnsignedType(currentExpressionType));
+        value = builder.CreateInsertValue(value, fieldValue, {static_cast<unsigned>(index)});
+    }
+    currentExpressionType = structType;
+    return value;
+}
+
+/******************** Array Literals ********************/
+
+bool CGExpr::isConstantElement(Expression& element) {
+    if (auto* unary = dynamic_cast<UnaryOpExpr*>(&element)) {
+        auto* literal = dynamic_cast<LiteralExpr*>(unary->operand.get());
+        return unary->operator_ == BinaryOpExpr::BinOp::SUB && literal &&
+               (literal->literalType == LiteralType::INT || literal->literalType == LiteralType::FLOAT);
+    }
+    auto* literal = dynamic_cast<LiteralExpr*>(&element);
+    return literal && literal->literalType != LiteralType::STR && literal->literalType != LiteralType::NULL_LITERAL;
+}
+
+llvm::Constant* CGExpr::generateConstantElement(Expression& element, llvm::Type* type) {
+    // Negation is folded here so that checked arithmetic never sees a constant operand
+    auto* unary = dynamic_cast<UnaryOpExpr*>(&element);
+    (unary ? *unary->operand : element).accept(*this);
+    if (!currentValue) {
+        return nullptr;
+    }
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* value = currentValue;
+    if (unary) {
+        value = value->getType()->isFloatingPointTy() ? builder.CreateFNeg(value) : builder.CreateNeg(value);
+    }
+    if (!type) {
+        type = valueMap.getLLVMType(currentExpressionType, contextManager);
+    }
+    // Conversions of constants fold, so no instructions are emitted
+    return llvm::dyn_cast_or_null<llvm::Constant>(convertValue(value, type, isUnsignedType(currentExpressionType)));
+}
+
+llvm::Constant* CGExpr::generateConstantArray(const std::string& elementType, ArrayExpr& node) {
+    if (node.elements.empty()) {
+        return nullptr;
+    }
+    for (auto& element : node.elements) {
+        if (!isConstantElement(*element)) {
+            return nullptr;
+        }
+    }
+    llvm::Type* elementLLVMType = elementType.empty() ? nullptr : valueMap.getLLVMType(elementType, contextManager);
+    std::vector<llvm::Constant*> values;
+    for (auto& element : node.elements) {
+        llvm::Constant* value = generateConstantElement(*element, elementLLVMType);
+        if (!value) {
+            return nullptr;
+        }
+        elementLLVMType = value->getType();
+        values.push_back(value);
+    }
+    return llvm::ConstantArray::get(llvm::ArrayType::get(elementLLVMType, values.size()), values);
+}
+
+llvm::GlobalVariable* CGExpr::getArrayTable(llvm::Constant* values) {
+    auto it = arrayTables.find(values);
+    if (it != arrayTables.end()) {
+        return it->second;
+    }
+    llvm::Module* module = contextManager.getModule();
+    auto* table = new llvm::GlobalVariable(*module, values->getType(), true, llvm::GlobalValue::PrivateLinkage,
+                                           values, "array.table");
+    table->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    table->setAlignment(module->getDataLayout().getPrefTypeAlign(values->getType()->getArrayElementType()));
+    arrayTables.emplace(values, table);
+    return table;
+}
+
+void CGExpr::generateArrayInit(const std::string& arrayType, ArrayExpr& node, llvm::Value* storage) {
+    auto& builder = contextManager.getBuilder();
+    const llvm::DataLayout& dataLayout = contextManager.getModule()->getDataLayout();
+    std::string elementTypeStr;
+    uint64_t size = 0;
+    ValueMap::splitArrayType(arrayType, elementTypeStr, size);
+    llvm::Type* elementType = valueMap.getLLVMType(elementTypeStr, contextManager);
+    llvm::ArrayType* arrayLLVMType = llvm::ArrayType::get(elementType, size);
+    llvm::Align align = dataLayout.getPrefTypeAlign(elementType);
+    
+    // Constant elements come from one read-only template; runtime slots are zero in it
+    std::vector<llvm::Constant*> values;
+    bool hasConstant = false;
+    bool hasNonZero = false;
+    for (auto& element : node.elements) {
+        llvm::Constant* value = nullptr;
+        if (isConstantElement(*element)) {
+            value = generateConstantElement(*element, elementType);
+        }
         if (value) {
-            // value map stores alloca instructions (addresses)
-            currentValue = value;
-            // Set the expression type to pointer of the variable type using value map
-            std::string variableType = valueMap.getVariableType(identifier->name);
-            currentExpressionType = variableType + "*";
+            hasConstant = true;
+            hasNonZero = hasNonZero || !value->isNullValue();
         } else {
-            error(CodegenErrorType::UndefinedSymbol, "Undefined variable for address-of: " + identifier->name);
+            value = llvm::Constant::getNullValue(elementType);
         }
-    } else {
-        error(CodegenErrorType::TypeMismatch, "Address-of operation only supported for variables");
+        values.push_back(value);
     }
-}
-#endif // EMLANG_FEATURE_POINTERS
+    llvm::Value* bytes = builder.getInt64(dataLayout.getTypeAllocSize(arrayLLVMType));
+    if (hasNonZero) {
+        llvm::GlobalVariable* table = getArrayTable(llvm::ConstantArray::get(arrayLLVMType, values));
+        builder.CreateMemCpy(storage, align, table, table->getAlign().valueOrOne(), bytes);
+    } else if (hasConstant) {
+        builder.CreateMemSet(storage, builder.getInt8(0), bytes, align);
+    }
+    
+    // Runtime elements are evaluated left to right
+    for (size_t i = 0; i < node.elements.size(); ++i) {
+        Expression& element = *node.elements[i];
+        if (isConstantElement(element)) {
+            continue;
+        }
+        size_t run = 1;
+        auto* variable = dynamic_cast<IdentifierExpr*>(&element);
+        while (variable && i + run < node.elements.size()) {
+            auto* next = dynamic_cast<IdentifierExpr*>(node.elements[i + run].get());
+            if (!next || next->name != variable->name) {
+                break;
+            }
+            ++run;
+        }
+        element.accept(*this);
+        if (!currentValue) {
+            return;
+        }
+        llvm::Value* value = convertValue(currentValue, elementType, isUnsignedType(currentExpressionType));
+        llvm::Value* first = builder.CreateConstInBoundsGEP2_64(arrayLLVMType, storage, 0, i, "arrayelem");
+        if (run < arrayFillLoopThreshold) {
+            for (size_t j = 0; j < run; ++j) {
+                llvm::Value* address = j == 0 ? first : builder.CreateConstInBoundsGEP1_64(elementType, first, j, "arrayelem");
+                builder.CreateStore(value, address);
+            }
+        } else {
+            generateArrayLoop(builder.getInt64(run), nullptr, [&](llvm::Value* index, llvm::Value*) -> llvm::Value* {
+                builder.CreateStore(value, builder.CreateInBoundsGEP(elementType, first, index, "arrayelem"));
+                return nullptr;
+            });
+        }
+        i += run - 1;
+    }
+}
+
+/******************** Address Helpers ********************/
+
+bool CGExpr::generateAddress(Expression& expr, llvm::Value*& address, std::string& type) {
+    auto& builder = contextManager.getBuilder();
+    address = nullptr;
+    
+    if (auto* identifier = dynamic_cast<IdentifierExpr*>(&expr)) {
+        // Values bound without storage (range-for variables) have no address
+        llvm::Value* variable = valueMap.getVariable(identifier->name);
+        if (!llvm::isa_and_nonnull<llvm::AllocaInst>(variable) && !llvm::isa_and_nonnull<llvm::GlobalVariable>(variable)) {
+            return false;
+        }
+        address = variable;
+        type = valueMap.getVariableType(identifier->name);
+        return true;
+    }
+    
+    if (auto* element = dynamic_cast<IndexExpr*>(&expr)) {
+        // Elements of a sub-slice are addressed through the slice value: a[lo..hi][i]
+        if (auto* slice = dynamic_cast<SliceExpr*>(element->array.get())) {
+            slice->accept(*this);
+            if (currentValue) {
+                generateSliceElementAddress(*element, currentValue, currentExpressionType, address, type);
+            }
+            return true;
+        }
+        llvm::Value* arrayPtr = nullptr;
+        std::string arrayType;
+        if (!generateAddress(*element->array, arrayPtr, arrayType)) {
+            return false;
+        }
+        return generateElementAddress(*element, arrayPtr, arrayType, address, type);
+    }
+    
+    auto* member = dynamic_cast<MemberExpr*>(&expr);
+    if (!member) {
+        return false;
+    }
+    
+    llvm::Value* objectPtr = nullptr;
+    std::string objectType;
+    if (auto* element = dynamic_cast<IndexExpr*>(member->object.get())) {
+        llvm::Value* arrayPtr = nullptr;
+        std::string arrayType;
+        if (!generateAddress(*element->array, arrayPtr, arrayType)) {
+            return false;
+        }
+        
+        // A field of an #[soa] array element lives in that field's column: &a.x[i]
+        std::string elementType;
+        uint64_t size = 0;
+        const ValueMap::StructLayout* layout = ValueMap::splitArrayType(arrayType, elementType, size)
+            ? valueMap.getStruct(elementType) : nullptr;
+        if (arrayPtr && layout && layout->soa) {
+            int index = layout->fieldIndex(member->memberName);
+            if (index < 0) {
+                error(CodegenErrorType::UndefinedSymbol, "Unknown field: " + member->memberName);
+                return true;
+            }
+            llvm::Value* indexValue = generateIndex(*element->index);
+            if (!indexValue) {
+                return true;
+            }
+            if (!dynamic_cast<LiteralExpr*>(element->index.get())) {
+                generateBoundsCheck(*element, indexValue, builder.getInt64(size));
+            }
+            llvm::Value* indices[] = {builder.getInt32(0), builder.getInt32(index), indexValue};
+            address = builder.CreateInBoundsGEP(valueMap.getLLVMType(arrayType, contextManager), arrayPtr,
+                                                indices, member->memberName + ".addr");
+            type = layout->fieldTypes[index];
+            return true;
+        }
+        if (!generateElementAddress(*element, arrayPtr, arrayType, objectPtr, objectType)) {
+            return false;
+        }
+    } else if (!generateAddress(*member->object, objectPtr, objectType)) {
+        return false;
+    }
+    if (!objectPtr) {
+        return true;
+    }
+    
+    const ValueMap::StructLayout* layout = valueMap.getStruct(objectType);
+    int index = layout ? layout->fieldIndex(member->memberName) : -1;
+    if (index < 0) {
+        error(CodegenErrorType::UndefinedSymbol, "Unknown field: " + member->memberName);
+        return true;
+    }
+    address = builder.CreateStructGEP(layout->type, objectPtr, index, member->memberName + ".addr");
+    type = layout->fieldTypes[index];
+    return true;
+}
+
+bool CGExpr::generateElementAddress(IndexExpr& element, llvm::Value* arrayPtr, const std::string& arrayType,
+                                    llvm::Value*& address, std::string& type) {
+    auto& builder = contextManager.getBuilder();
+    address = nullptr;
+    
+    std::string elementType;
+    uint64_t size = 0;
+    bool isArray = ValueMap::splitArrayType(arrayType, elementType, size);
+    bool isVec = arrayType.compare(0, 4, "vec<") == 0;
+    bool isSlice = arrayType.compare(0, 2, "[]") == 0;
+    bool isPointer = !arrayType.empty() && arrayType.back() == '*';
+    if (!isArray && !isVec && !isSlice && !isPointer) {
+        return false;
+    }
+    if (!arrayPtr) {
+        return true;
+    }
+    
+    if (isPointer) {
+        elementType = valueMap.getPointeeType(arrayType);
+        llvm::Type* elementLLVMType = valueMap.getLLVMType(elementType, contextManager);
+        llvm::Value* pointer = builder.CreateLoad(llvm::PointerType::get(contextManager.getContext(), 0), arrayPtr, "ptr");
+        llvm::Value* index = generateIndex(*element.index);
+        if (!index || !elementLLVMType) {
+            error(CodegenErrorType::InternalError, "Invalid index in pointer access");
+            return true;
+        }
+        address = builder.CreateGEP(elementLLVMType, pointer, index, "ptridx");
+        type = elementType;
+        return true;
+    }
+    
+    if (isSlice) {
+        llvm::Value* slice = builder.CreateLoad(valueMap.getLLVMType(arrayType, contextManager), arrayPtr, "slice");
+        generateSliceElementAddress(element, slice, arrayType, address, type);
+        return true;
+    }
+    
+    if (isVec) {
+        elementType = vecElementType(arrayType);
+        llvm::Type* elementLLVMType = valueMap.getLLVMType(elementType, contextManager);
+        llvm::Value* vec = builder.CreateLoad(llvm::PointerType::get(contextManager.getContext(), 0), arrayPtr, "vec");
+        llvm::Value* index = generateIndex(*element.index);
+        if (!index || !elementLLVMType) {
+            error(CodegenErrorType::InternalError, "Invalid index in vector access");
+            return true;
+        }
+        address = generateVecElementPtr(vec, index, elementLLVMType);
+        type = elementType;
+        return true;
+    }
+    
+    const ValueMap::StructLayout* layout = valueMap.getStruct(elementType);
+    if (layout && layout->soa) {
+        error(CodegenErrorType::TypeMismatch, "Elements of #[soa] arrays can only be accessed field by field");
+        return true;
+    }
+    llvm::Value* index = generateIndex(*element.index);
+    if (!index) {
+        return true;
+    }
+    // Constant indices were already checked against the array size during analysis
+    if (!dynamic_cast<LiteralExpr*>(element.index.get())) {
+        generateBoundsCheck(element, index, builder.getInt64(size));
+    }
+    llvm::Value* indices[] = {builder.getInt32(0), index};
+    address = builder.CreateInBoundsGEP(valueMap.getLLVMType(arrayType, contextManager), arrayPtr, indices,
+                                        "arrayidx");
+    type = elementType;
+    return true;
+}
+
+/******************** Bounds Checks ********************/
+
+void CGExpr::beginHoistedChecks(const std::vector<IndexExpr*>& elements) {
+    hoistedChecks.insert(elements.begin(), elements.end());
+}
+
+void CGExpr::endHoistedChecks(const std::vector<IndexExpr*>& elements) {
+    for (IndexExpr* element : elements) {
+        hoistedChecks.erase(element);
+    }
+}
+
+void CGExpr::generateSliceElementAddress(IndexExpr& element, llvm::Value* slice, const std::string& sliceType,
+                                         llvm::Value*& address, std::string& type) {
+    auto& builder = contextManager.getBuilder();
+    address = nullptr;
+    type = sliceType.substr(2);
+    llvm::Type* elementLLVMType = valueMap.getLLVMType(type, contextManager);
+    llvm::Value* index = generateIndex(*element.index);
+    if (!index || !elementLLVMType) {
+        error(CodegenErrorType::InternalError, "Invalid index in slice access");
+        return;
+    }
+    generateBoundsCheck(element, index, builder.CreateExtractValue(slice, {1}, "slicelen"));
+    address = builder.CreateInBoundsGEP(elementLLVMType, builder.CreateExtractValue(slice, {0}, "slicedata"), index,
+                                        "sliceelem");
+}
+
+llvm::Value* CGExpr::generateIndex(Expression& index) {
+    index.accept(*this);
+    if (!currentValue) {
+        return nullptr;
+    }
+    // GEP would sign-extend a narrower index, so unsigned ones are widened here
+    return convertValue(currentValue, contextManager.getBuilder().getInt64Ty(), isUnsignedType(currentExpressionType));
+}
+
+void CGExpr::generateBoundsCheck(IndexExpr& element, llvm::Value* index, llvm::Value* length) {
+    if (!contextManager.getOptions().boundsChecks || hoistedChecks.count(&element)) {
+        return;
+    }
+    auto& builder = contextManager.getBuilder();
+    // Unsigned compare rejects negative indices as well
+    llvm::Value* index64 = convertValue(index, builder.getInt64Ty());
+    generateRangeCheck(builder.CreateICmpULT(index64, length, "inbounds"), "emlang_bounds_fail", {index64, length});
+}
+
+void CGExpr::generateRangeCheck(llvm::Value* inRange, const std::string& failFunction, 
+                                llvm::ArrayRef<llvm::Value*> args) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    if (auto* constant = llvm::dyn_cast<llvm::ConstantInt>(inRange)) {
+        if (constant->isOne()) {
+            return;
+        }
+    }
+    
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* okBB = llvm::BasicBlock::Create(ctx, "bounds.ok", function);
+    llvm::BasicBlock* failBB = llvm::BasicBlock::Create(ctx, "bounds.fail", function);
+    llvm::MDBuilder mdBuilder(ctx);
+    builder.CreateCondBr(inRange, okBB, failBB, mdBuilder.createBranchWeights(2000, 1));
+    
+    builder.SetInsertPoint(failBB);
+    builder.CreateCall(getCheckRuntime(failFunction), args);
+    builder.CreateUnreachable();
+    
+    builder.SetInsertPoint(okBB);
+}
+
+llvm::FunctionCallee CGExpr::getCheckRuntime(const std::string& name) {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+    llvm::Type* voidTy = llvm::Type::getVoidTy(ctx);
+
+    llvm::FunctionType* funcType = nullptr;
+    if (name == "emlang_bounds_fail" || name == "emlang_length_fail") {
+        funcType = llvm::FunctionType::get(voidTy, {i64Ty, i64Ty}, false);
+    } else if (name == "emlang_slice_range_fail") {
+        funcType = llvm::FunctionType::get(voidTy, {i64Ty, i64Ty, i64Ty}, false);
+    } else {
+        funcType = llvm::FunctionType::get(voidTy, {i64Ty}, false); // emlang_overflow_fail
+    }
+
+    // Every check handler reports and aborts
+    llvm::FunctionCallee callee = contextManager.getModule()->getOrInsertFunction(name, funcType);
+    if (auto* function = llvm::dyn_cast<llvm::Function>(callee.getCallee())) {
+        function->setDoesNotReturn();
+        function->addFnAttr(llvm::Attribute::Cold);
+    }
+    return callee;
+}
+
+/******************** Overflow Checks ********************/
+
+bool CGExpr::isUnsignedType(const std::string& type) {
+    return type.compare(0, 4, "uint") == 0 || type == "usize";
+}
+
+void CGExpr::setValueRange(llvm::Value* value, const llvm::ConstantRange& range) {
+    if (value && value->getType()->isIntegerTy(range.getBitWidth())) {
+        valueRanges.insert_or_assign(value, range);
+    }
+}
+
+llvm::ConstantRange CGExpr::getValueRange(llvm::Value* value) const {
+    unsigned width = value->getType()->getIntegerBitWidth();
+    if (auto* constant = llvm::dyn_cast<llvm::ConstantInt>(value)) {
+        return llvm::ConstantRange(constant->getValue());
+    }
+    auto it = valueRanges.find(value);
+    if (it != valueRanges.end()) {
+        return it->second;
+    }
+    if (auto* extension = llvm::dyn_cast<llvm::SExtInst>(value)) {
+        return getValueRange(extension->getOperand(0)).signExtend(width);
+    }
+    if (auto* extension = llvm::dyn_cast<llvm::ZExtInst>(value)) {
+        return getValueRange(extension->getOperand(0)).zeroExtend(width);
+    }
+    return llvm::ConstantRange::getFull(width);
+}
+
+llvm::Value* CGExpr::generateCheckedArithmetic(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right,
+                                               bool isUnsigned, size_t line) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    unsigned width = left->getType()->getIntegerBitWidth();
+    
+    // At twice the width (plus a sign bit) the exact result of any two
+    // operands is representable, so the range says whether it fits
+    unsigned wide = 2 * width + 1;
+    auto extend = [&](llvm::Value* value) {
+        llvm::ConstantRange range = getValueRange(value);
+        return isUnsigned ? range.zeroExtend(wide) : range.signExtend(wide);
+    };
+    llvm::ConstantRange leftRange = extend(left);
+    llvm::ConstantRange rightRange = extend(right);
+    llvm::ConstantRange exact = op == BinaryOpExpr::BinOp::ADD ? leftRange.add(rightRange)
+                              : op == BinaryOpExpr::BinOp::SUB ? leftRange.sub(rightRange)
+                              : leftRange.multiply(rightRange);
+    llvm::ConstantRange representable = isUnsigned
+        ? llvm::ConstantRange::getNonEmpty(llvm::APInt::getMinValue(width).zext(wide), 
+                                           llvm::APInt::getMaxValue(width).zext(wide) + 1)
+        : llvm::ConstantRange::getNonEmpty(llvm::APInt::getSignedMinValue(width).sext(wide), 
+                                           llvm::APInt::getSignedMaxValue(width).sext(wide) + 1);
+    
+    llvm::Value* result = nullptr;
+    if (representable.contains(exact)) {
+        ++overflowChecksRemoved;
+        bool nuw = isUnsigned;
+        bool nsw = !isUnsigned;
+        if (op == BinaryOpExpr::BinOp::ADD) {
+            result = builder.CreateAdd(left, right, "addtmp", nuw, nsw);
+        } else if (op == BinaryOpExpr::BinOp::SUB) {
+            result = builder.CreateSub(left, right, "subtmp", nuw, nsw);
+        } else {
+            result = builder.CreateMul(left, right, "multmp", nuw, nsw);
+        }
+        setValueRange(result, exact.truncate(width));
+        return result;
+    }
+    
+    ++overflowChecksEmitted;
+    llvm::Intrinsic::ID id;
+    if (op == BinaryOpExpr::BinOp::ADD) {
+        id = isUnsigned ? llvm::Intrinsic::uadd_with_overflow : llvm::Intrinsic::sadd_with_overflow;
+    } else if (op == BinaryOpExpr::BinOp::SUB) {
+        id = isUnsigned ? llvm::Intrinsic::usub_with_overflow : llvm::Intrinsic::ssub_with_overflow;
+    } else {
+        id = isUnsigned ? llvm::Intrinsic::umul_with_overflow : llvm::Intrinsic::smul_with_overflow;
+    }
+    llvm::Value* pair = builder.CreateBinaryIntrinsic(id, left, right, nullptr, "checked");
+    result = builder.CreateExtractValue(pair, 0, "checked.value");
+    llvm::Value* overflow = builder.CreateExtractValue(pair, 1, "checked.overflow");
+    
+    llvm::PHINode* trapLine = getOverflowTrap();
+    trapLine->addIncoming(builder.getInt64(line), builder.GetInsertBlock());
+    llvm::BasicBlock* okBB = llvm::BasicBlock::Create(ctx, "overflow.ok", builder.GetInsertBlock()->getParent());
+    llvm::MDBuilder mdBuilder(ctx);
+    builder.CreateCondBr(overflow, trapLine->getParent(), okBB, mdBuilder.createBranchWeights(1, 2000));
+    builder.SetInsertPoint(okBB);
+    
+    // Past the check, the result is the exact value
+    setValueRange(result, exact.intersectWith(representable).truncate(width));
+    return result;
+}
+
+llvm::PHINode* CGExpr::getOverflowTrap() {
+    auto& builder = contextManager.getBuilder();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    auto it = overflowTraps.find(function);
+    if (it != overflowTraps.end()) {
+        return it->second;
+    }
+    
+    // One cold block per function keeps each check down to a compare and a branch
+    llvm::BasicBlock* trapBB = llvm::BasicBlock::Create(contextManager.getContext(), "overflow.trap", function);
+    llvm::IRBuilder<> trapBuilder(trapBB);
+    trapBuilder.SetCurrentDebugLocation(builder.getCurrentDebugLocation());
+    llvm::PHINode* line = trapBuilder.CreatePHI(trapBuilder.getInt64Ty(), 4, "overflow.line");
+    trapBuilder.CreateCall(getCheckRuntime("emlang_overflow_fail"), {line});
+    trapBuilder.CreateUnreachable();
+    overflowTraps[function] = line;
+    return line;
+}
+
+/******************** Coroutine Lowering ********************/
+
+bool CGExpr::beginCoroutine(llvm::Function* function, const std::string& resultType) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::PointerType* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* resultTy = valueMap.getLLVMType(resultType, contextManager);
+    if (!resultTy) {
+        error(CodegenErrorType::UnknownType, "Unknown return type: " + resultType + " in async function: " + 
+              function->getName().str());
+        return false;
+    }
+    
+    // The waiter comes first, so awaiting needs no knowledge of the result type
+    std::vector<llvm::Type*> promiseFields = {ptrTy};
+    if (!resultTy->isVoidTy()) {
+        promiseFields.push_back(resultTy);
+    }
+    coroutine = Coroutine();
+    coroutine.promiseType = llvm::StructType::get(ctx, promiseFields);
+    llvm::IRBuilder<> entryBuilder(&function->getEntryBlock(), function->getEntryBlock().begin());
+    coroutine.promise = entryBuilder.CreateAlloca(coroutine.promiseType, nullptr, "promise");
+    coroutine.promise->setAlignment(llvm::Align(promiseAlignment));
+    function->setPresplitCoroutine();
+    taskTypes[function->getName().str()] = "task<" + resultType + ">";
+    
+    // The frame is allocated only if CoroElide could not place it in the caller's frame
+    llvm::Value* null = llvm::ConstantPointerNull::get(ptrTy);
+    coroutine.id = builder.CreateIntrinsic(llvm::Intrinsic::coro_id, {},
+                                           {builder.getInt32(promiseAlignment), coroutine.promise, null, null},
+                                           nullptr, "coro.id");
+    llvm::Value* needsFrame = builder.CreateIntrinsic(llvm::Intrinsic::coro_alloc, {}, {coroutine.id}, nullptr, "coro.needs.frame");
+    llvm::BasicBlock* entryBB = builder.GetInsertBlock();
+    llvm::BasicBlock* allocBB = llvm::BasicBlock::Create(ctx, "coro.alloc", function);
+    llvm::BasicBlock* beginBB = llvm::BasicBlock::Create(ctx, "coro.begin", function);
+    builder.CreateCondBr(needsFrame, allocBB, beginBB);
+    
+    builder.SetInsertPoint(allocBB);
+    llvm::Value* size = builder.CreateIntrinsic(llvm::Intrinsic::coro_size, {builder.getInt64Ty()}, {}, nullptr, "coro.size");
+    llvm::Value* memory = builder.CreateCall(getTaskRuntime("emlang_coro_alloc"), {size}, "coro.memory");
+    builder.CreateBr(beginBB);
+    
+    builder.SetInsertPoint(beginBB);
+    llvm::PHINode* frame = builder.CreatePHI(ptrTy, 2, "coro.frame");
+    frame->addIncoming(null, entryBB);
+    frame->addIncoming(memory, allocBB);
+    coroutine.handle = builder.CreateIntrinsic(llvm::Intrinsic::coro_begin, {}, {coroutine.id, frame}, nullptr, "coro.handle");
+    // Nobody awaits the task yet
+    builder.CreateStore(null, builder.CreateStructGEP(coroutine.promiseType, coroutine.promise, 0));
+    
+    // Filled in by endCoroutine, once the body has branched to them
+    coroutine.finalBlock = llvm::BasicBlock::Create(ctx, "coro.final");
+    coroutine.cleanupBlock = llvm::BasicBlock::Create(ctx, "coro.cleanup");
+    coroutine.suspendBlock = llvm::BasicBlock::Create(ctx, "coro.suspend");
+    return true;
+}
+
+llvm::Value* CGExpr::generateCoroutineReturn(llvm::Value* value) {
+    auto& builder = contextManager.getBuilder();
+    if (value && coroutine.promiseType->getNumElements() > 1) {
+        llvm::Type* resultTy = coroutine.promiseType->getElementType(1);
+        builder.CreateStore(convertValue(value, resultTy, isUnsignedType(currentExpressionType)),
+                            builder.CreateStructGEP(coroutine.promiseType, coroutine.promise, 1));
+    }
+    return builder.CreateBr(coroutine.finalBlock);
+}
+
+void CGExpr::endCoroutine() {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    if (!builder.GetInsertBlock()->getTerminator()) {
+        generateCoroutineReturn(nullptr);
+    }
+    
+    // Final suspend: schedule the awaiting task, then wait to be destroyed by it
+    coroutine.finalBlock->insertInto(function);
+    builder.SetInsertPoint(coroutine.finalBlock);
+    llvm::Value* waiter = builder.CreateLoad(llvm::PointerType::get(ctx, 0),
+                                             builder.CreateStructGEP(coroutine.promiseType, coroutine.promise, 0), "waiter");
+    llvm::BasicBlock* wakeBB = llvm::BasicBlock::Create(ctx, "coro.wake", function);
+    llvm::BasicBlock* finalSuspendBB = llvm::BasicBlock::Create(ctx, "coro.final.suspend", function);
+    builder.CreateCondBr(builder.CreateIsNotNull(waiter), wakeBB, finalSuspendBB);
+    builder.SetInsertPoint(wakeBB);
+    builder.CreateCall(getTaskRuntime("emlang_task_schedule"), {waiter});
+    builder.CreateBr(finalSuspendBB);
+    
+    builder.SetInsertPoint(finalSuspendBB);
+    llvm::Value* state = builder.CreateIntrinsic(llvm::Intrinsic::coro_suspend, {},
+                                                 {llvm::ConstantTokenNone::get(ctx), builder.getTrue()},
+                                                 nullptr, "coro.final.state");
+    // A finished task is never resumed, only destroyed
+    llvm::BasicBlock* resumedBB = llvm::BasicBlock::Create(ctx, "coro.final.resumed", function);
+    llvm::SwitchInst* dispatch = builder.CreateSwitch(state, coroutine.suspendBlock, 2);
+    dispatch->addCase(builder.getInt8(0), resumedBB);
+    dispatch->addCase(builder.getInt8(1), coroutine.cleanupBlock);
+    builder.SetInsertPoint(resumedBB);
+    builder.CreateIntrinsic(llvm::Intrinsic::trap, {}, {});
+    builder.CreateUnreachable();
+    
+    // Destruction frees the frame, unless it lives in the caller's frame
+    coroutine.cleanupBlock->insertInto(function);
+    builder.SetInsertPoint(coroutine.cleanupBlock);
+    llvm::Value* memory = builder.CreateIntrinsic(llvm::Intrinsic::coro_free, {}, {coroutine.id, coroutine.handle},
+                                                  nullptr, "coro.memory");
+    llvm::BasicBlock* deallocBB = llvm::BasicBlock::Create(ctx, "coro.dealloc", function);
+    builder.CreateCondBr(builder.CreateIsNotNull(memory), deallocBB, coroutine.suspendBlock);
+    builder.SetInsertPoint(deallocBB);
+    llvm::Value* size = builder.CreateIntrinsic(llvm::Intrinsic::coro_size, {builder.getInt64Ty()}, {}, nullptr, "coro.size");
+    builder.CreateCall(getTaskRuntime("emlang_coro_free"), {memory, size});
+    builder.CreateBr(coroutine.suspendBlock);
+    
+    // Every suspension returns the task to whoever started or resumed it
+    coroutine.suspendBlock->insertInto(function);
+    builder.SetInsertPoint(coroutine.suspendBlock);
+    builder.CreateIntrinsic(llvm::Intrinsic::coro_end, {},
+                            {coroutine.handle, builder.getFalse(), llvm::ConstantTokenNone::get(ctx)});
+    builder.CreateRet(coroutine.handle);
+    coroutine = Coroutine();
+}
+
+llvm::FunctionCallee CGExpr::getTaskRuntime(const std::string& name) {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+    llvm::Type* voidTy = llvm::Type::getVoidTy(ctx);
+
+    llvm::FunctionType* funcType = nullptr;
+    if (name == "emlang_coro_alloc") {
+        funcType = llvm::FunctionType::get(ptrTy, {i64Ty}, false);
+    } else if (name == "emlang_coro_free") {
+        funcType = llvm::FunctionType::get(voidTy, {ptrTy, i64Ty}, false);
+    } else {
+        funcType = llvm::FunctionType::get(voidTy, {ptrTy}, false); // emlang_task_schedule, emlang_task_block_on
+    }
+
+    llvm::FunctionCallee callee = module->getOrInsertFunction(name, funcType);
+    if (name == "emlang_coro_alloc") {
+        // Aborts instead of failing, and never hands out a live frame twice
+        if (auto* function = llvm::dyn_cast<llvm::Function>(callee.getCallee())) {
+            function->addRetAttr(llvm::Attribute::NoAlias);
+            function->addRetAttr(llvm::Attribute::NonNull);
+        }
+    }
+    return callee;
+}
+
+void CGExpr::generateSuspend(llvm::Value* save) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* state = builder.CreateIntrinsic(llvm::Intrinsic::coro_suspend, {}, {save, builder.getFalse()},
+                                                 nullptr, "coro.state");
+    llvm::BasicBlock* resumeBB = llvm::BasicBlock::Create(contextManager.getContext(), "coro.resume",
+                                                          builder.GetInsertBlock()->getParent());
+    llvm::SwitchInst* dispatch = builder.CreateSwitch(state, coroutine.suspendBlock, 2);
+    dispatch->addCase(builder.getInt8(0), resumeBB);
+    dispatch->addCase(builder.getInt8(1), coroutine.cleanupBlock);
+    builder.SetInsertPoint(resumeBB);
+}
+
+void CGExpr::generateYield(FunctionCallExpr& node) {
+    currentValue = nullptr;
+    currentExpressionType = "void";
+    if (!inCoroutine()) {
+        error(CodegenErrorType::InternalError, "yield_now outside of an async function");
+        return;
+    }
+    emitLocation(node);
+    // Saved before the task is queued, so the executor's resume matches this suspension
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* save = builder.CreateIntrinsic(llvm::Intrinsic::coro_save, {}, {coroutine.handle}, nullptr, "coro.save");
+    builder.CreateCall(getTaskRuntime("emlang_task_schedule"), {coroutine.handle});
+    generateSuspend(save);
+}
+
+/******************** Whole-Array Lowering ********************/
+
+bool CGExpr::isWholeArrayExpression(Expression& expr) {
+    if (auto* binary = dynamic_cast<BinaryOpExpr*>(&expr)) {
+        return hasArrayOperand(*binary->left) || hasArrayOperand(*binary->right);
+    }
+    if (auto* unary = dynamic_cast<UnaryOpExpr*>(&expr)) {
+        return unary->operator_ == BinaryOpExpr::BinOp::SUB && hasArrayOperand(*unary->operand);
+    }
+    return false;
+}
+
+bool CGExpr::hasArrayOperand(Expression& expr) {
+    if (dynamic_cast<SliceExpr*>(&expr)) {
+        return true;
+    }
+    if (auto* identifier = dynamic_cast<IdentifierExpr*>(&expr)) {
+        std::string type = valueMap.getVariableType(identifier->name);
+        std::string elementType;
+        uint64_t size = 0;
+        return ValueMap::splitArrayType(type, elementType, size) || type.compare(0, 2, "[]") == 0;
+    }
+    return isWholeArrayExpression(expr);
+}
+
+bool CGExpr::prepareArrayOperands(Expression& expr, ArrayOperands& operands) {
+    if (isWholeArrayExpression(expr)) {
+        if (auto* binary = dynamic_cast<BinaryOpExpr*>(&expr)) {
+            return prepareArrayOperands(*binary->left, operands) && prepareArrayOperands(*binary->right, operands);
+        }
+        return prepareArrayOperands(*static_cast<UnaryOpExpr&>(expr).operand, operands);
+    }
+    
+    // Leaves are evaluated once, ahead of the loop
+    auto& builder = contextManager.getBuilder();
+    ArrayOperand operand;
+    llvm::Value* address = nullptr;
+    std::string type;
+    uint64_t size = 0;
+    if (dynamic_cast<IdentifierExpr*>(&expr) && generateAddress(expr, address, type) && 
+        ValueMap::splitArrayType(type, operand.elementType, size)) {
+        operand.data = address;
+        operand.length = builder.getInt64(size);
+    } else {
+        expr.accept(*this);
+        if (!currentValue) {
+            return false;
+        }
+        if (currentExpressionType.compare(0, 2, "[]") == 0) {
+            operand.elementType = currentExpressionType.substr(2);
+            operand.data = builder.CreateExtractValue(currentValue, {0}, "slicedata");
+            operand.length = builder.CreateExtractValue(currentValue, {1}, "slicelen");
+        } else {
+            operand.scalar = currentValue;
+            operand.isUnsigned = isUnsignedType(currentExpressionType);
+        }
+    }
+    operands.emplace_back(&expr, operand);
+    return true;
+}
+
+void CGExpr::finishArrayOperands(ArrayOperands& operands, llvm::Value* length, llvm::Type* elementType) {
+    for (auto& entry : operands) {
+        ArrayOperand& operand = entry.second;
+        if (operand.scalar) {
+            operand.scalar = convertValue(operand.scalar, elementType, operand.isUnsigned);
+        } else if (contextManager.getOptions().boundsChecks && operand.length != length) {
+            generateRangeCheck(contextManager.getBuilder().CreateICmpEQ(operand.length, length, "sameshape"),
+                               "emlang_length_fail", {operand.length, length});
+        }
+    }
+}
+
+llvm::Value* CGExpr::generateArrayElement(Expression& expr, const ArrayOperands& operands, llvm::Value* index,
+                                          llvm::Type* elementType, bool isUnsigned) {
+    auto& builder = contextManager.getBuilder();
+    auto it = std::find_if(operands.begin(), operands.end(), [&](const auto& entry) { return entry.first == &expr; });
+    if (it != operands.end()) {
+        const ArrayOperand& operand = it->second;
+        if (operand.scalar) {
+            return operand.scalar;
+        }
+        llvm::Value* address = builder.CreateInBoundsGEP(elementType, operand.data, index, "elemptr");
+        return builder.CreateLoad(elementType, address, "elem");
+    }
+    if (auto* unary = dynamic_cast<UnaryOpExpr*>(&expr)) {
+        llvm::Value* operand = generateArrayElement(*unary->operand, operands, index, elementType, isUnsigned);
+        return elementType->isFloatingPointTy() ? builder.CreateFNeg(operand, "negtmp") : builder.CreateNeg(operand, "negtmp");
+    }
+    auto& binary = static_cast<BinaryOpExpr&>(expr);
+    llvm::Value* left = generateArrayElement(*binary.left, operands, index, elementType, isUnsigned);
+    llvm::Value* right = generateArrayElement(*binary.right, operands, index, elementType, isUnsigned);
+    bool isFloat = elementType->isFloatingPointTy();
+    switch (binary.operator_) {
+        case BinaryOpExpr::BinOp::ADD:
+            return isFloat ? builder.CreateFAdd(left, right, "addtmp") : builder.CreateAdd(left, right, "addtmp");
+        case BinaryOpExpr::BinOp::SUB:
+            return isFloat ? builder.CreateFSub(left, right, "subtmp") : builder.CreateSub(left, right, "subtmp");
+        case BinaryOpExpr::BinOp::MUL:
+            return isFloat ? builder.CreateFMul(left, right, "multmp") : builder.CreateMul(left, right, "multmp");
+        case BinaryOpExpr::BinOp::DIV:
+            if (isFloat) {
+                return builder.CreateFDiv(left, right, "divtmp");
+            }
+            return isUnsigned ? builder.CreateUDiv(left, right, "divtmp") : builder.CreateSDiv(left, right, "divtmp");
+        default:
+            if (isFloat) {
+                return builder.CreateFRem(left, right, "modtmp");
+            }
+            return isUnsigned ? builder.CreateURem(left, right, "modtmp") : builder.CreateSRem(left, right, "modtmp");
+    }
+}
+
+llvm::Value* CGExpr::generateArrayOverlap(const ArrayOperands& operands, llvm::Value* data, llvm::Value* length,
+                                          llvm::Type* elementType) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* target = data->stripInBoundsOffsets();
+    llvm::Value* overlap = nullptr;
+    for (const auto& entry : operands) {
+        const ArrayOperand& operand = entry.second;
+        // Reading element i just before writing element i is safe, and distinct variables never overlap
+        if (!operand.data || operand.data == data) {
+            continue;
+        }
+        llvm::Value* source = operand.data->stripInBoundsOffsets();
+        bool isVariable = llvm::isa<llvm::AllocaInst>(source) || llvm::isa<llvm::GlobalVariable>(source);
+        bool isTargetVariable = llvm::isa<llvm::AllocaInst>(target) || llvm::isa<llvm::GlobalVariable>(target);
+        if (isVariable && isTargetVariable && source != target) {
+            continue;
+        }
+        llvm::Value* sourceEnd = builder.CreateInBoundsGEP(elementType, operand.data, operand.length, "srcend");
+        llvm::Value* targetEnd = builder.CreateInBoundsGEP(elementType, data, length, "dstend");
+        llvm::Value* partial = builder.CreateAnd(
+            builder.CreateICmpNE(operand.data, data, "moved"),
+            builder.CreateAnd(builder.CreateICmpULT(operand.data, targetEnd, "startsbefore"),
+                              builder.CreateICmpULT(data, sourceEnd, "endsafter")),
+            "overlaps");
+        overlap = overlap ? builder.CreateOr(overlap, partial, "overlap") : partial;
+    }
+    return overlap;
+}
+
+llvm::Value* CGExpr::generateArrayLoop(llvm::Value* length, llvm::Value* initial, 
+                                       const std::function<llvm::Value*(llvm::Value*, llvm::Value*)>& body) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* guardBB = builder.GetInsertBlock();
+    llvm::BasicBlock* loopBB = llvm::BasicBlock::Create(ctx, "arrayloop", function);
+    llvm::BasicBlock* afterBB = llvm::BasicBlock::Create(ctx, "arrayend", function);
+    builder.CreateCondBr(builder.CreateICmpSGT(length, builder.getInt64(0), "nonempty"), loopBB, afterBB);
+    
+    // A single-block loop with phi index and accumulator, so it is vectorizable before mem2reg
+    builder.SetInsertPoint(loopBB);
+    llvm::PHINode* index = builder.CreatePHI(builder.getInt64Ty(), 2, "i");
+    index->addIncoming(builder.getInt64(0), guardBB);
+    llvm::PHINode* accumulator = nullptr;
+    if (initial) {
+        accumulator = builder.CreatePHI(initial->getType(), 2, "acc");
+        accumulator->addIncoming(initial, guardBB);
+    }
+    llvm::Value* next = body(index, accumulator);
+    llvm::BasicBlock* latchBB = builder.GetInsertBlock();
+    if (accumulator) {
+        accumulator->addIncoming(next, latchBB);
+    }
+    llvm::Value* nextIndex = builder.CreateAdd(index, builder.getInt64(1), "i.next", true, true);
+    index->addIncoming(nextIndex, latchBB);
+    llvm::BranchInst* latch = builder.CreateCondBr(builder.CreateICmpEQ(nextIndex, length, "done"), afterBB, loopBB);
+    
+    // Ask for vectorization outright; the loop has no calls and one exit
+    llvm::Metadata* enable[] = {llvm::MDString::get(ctx, "llvm.loop.vectorize.enable"),
+                                llvm::ConstantAsMetadata::get(builder.getTrue())};
+    llvm::Metadata* loopOps[] = {nullptr, llvm::MDNode::get(ctx, enable)};
+    llvm::MDNode* loopID = llvm::MDNode::getDistinct(ctx, loopOps);
+    loopID->replaceOperandWith(0, loopID);
+    latch->setMetadata(llvm::LLVMContext::MD_loop, loopID);
+    
+    builder.SetInsertPoint(afterBB);
+    if (!accumulator) {
+        return nullptr;
+    }
+    llvm::PHINode* result = builder.CreatePHI(initial->getType(), 2, "sum");
+    result->addIncoming(initial, guardBB);
+    result->addIncoming(next, latchBB);
+    return result;
+}
+
+void CGExpr::generateArrayAssignment(AssignmentExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* address = nullptr;
+    std::string targetType;
+    if (!generateAddress(*node.target, address, targetType) || !address) {
+        error(CodegenErrorType::TypeMismatch, "Whole-array assignment requires an array or slice target");
+        return;
+    }
+    
+    std::string elementType;
+    uint64_t size = 0;
+    llvm::Value* data = address;
+    llvm::Value* length = nullptr;
+    if (ValueMap::splitArrayType(targetType, elementType, size)) {
+        length = builder.getInt64(size);
+    } else if (targetType.compare(0, 2, "[]") == 0) {
+        elementType = targetType.substr(2);
+        llvm::Value* slice = builder.CreateLoad(valueMap.getLLVMType(targetType, contextManager), address, "slice");
+        data = builder.CreateExtractValue(slice, {0}, "slicedata");
+        length = builder.CreateExtractValue(slice, {1}, "slicelen");
+    } else {
+        error(CodegenErrorType::TypeMismatch, "Whole-array assignment requires an array or slice target, got: " + targetType);
+        return;
+    }
+    
+    ArrayOperands operands;
+    if (!prepareArrayOperands(*node.value, operands)) {
+        return;
+    }
+    llvm::Type* elementLLVMType = valueMap.getLLVMType(elementType, contextManager);
+    finishArrayOperands(operands, length, elementLLVMType);
+    
+    // An operand viewing the target's memory at another offset would be read after it was
+    // overwritten, so then the elements are computed into a heap temporary and copied back
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    const llvm::DataLayout& dataLayout = module->getDataLayout();
+    llvm::Value* overlap = generateArrayOverlap(operands, data, length, elementLLVMType);
+    llvm::Value* out = data;
+    llvm::Value* bytes = nullptr;
+    if (overlap) {
+        bytes = builder.CreateMul(length, builder.getInt64(dataLayout.getTypeAllocSize(elementLLVMType)), "bytes",
+                                  true, true);
+        llvm::BasicBlock* directBB = builder.GetInsertBlock();
+        llvm::BasicBlock* tempBB = llvm::BasicBlock::Create(ctx, "overlap.temp", function);
+        llvm::BasicBlock* loopBB = llvm::BasicBlock::Create(ctx, "overlap.loop", function);
+        builder.CreateCondBr(overlap, tempBB, loopBB);
+        builder.SetInsertPoint(tempBB);
+        llvm::Value* temp = builder.CreateCall(module->getFunction("malloc"), {bytes}, "overlap.buf");
+        builder.CreateBr(loopBB);
+        builder.SetInsertPoint(loopBB);
+        llvm::PHINode* phi = builder.CreatePHI(data->getType(), 2, "out");
+        phi->addIncoming(data, directBB);
+        phi->addIncoming(temp, tempBB);
+        out = phi;
+    }
+    
+    // The whole tree is evaluated per element and stored straight into the target
+    generateArrayLoop(length, nullptr, [&](llvm::Value* index, llvm::Value*) -> llvm::Value* {
+        llvm::Value* value = generateArrayElement(*node.value, operands, index, elementLLVMType,
+                                                  isUnsignedType(elementType));
+        builder.CreateStore(value, builder.CreateInBoundsGEP(elementLLVMType, out, index, "dstptr"));
+        return nullptr;
+    });
+    
+    if (overlap) {
+        llvm::BasicBlock* copyBB = llvm::BasicBlock::Create(ctx, "overlap.copy", function);
+        llvm::BasicBlock* doneBB = llvm::BasicBlock::Create(ctx, "overlap.done", function);
+        builder.CreateCondBr(overlap, copyBB, doneBB);
+        builder.SetInsertPoint(copyBB);
+        llvm::Align align = dataLayout.getABITypeAlign(elementLLVMType);
+        builder.CreateMemCpy(data, align, out, align, bytes);
+        builder.CreateCall(module->getFunction("free"), {out});
+        builder.CreateBr(doneBB);
+        builder.SetInsertPoint(doneBB);
+    }
+    currentValue = nullptr;
+    currentExpressionType = targetType;
+}
+
+void CGExpr::generateArraySum(FunctionCallExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    Expression& argument = *node.arguments[0];
+    ArrayOperands operands;
+    if (!prepareArrayOperands(argument, operands)) {
+        return;
+    }
+    
+    // The first array operand sets the length
+    auto shape = std::find_if(operands.begin(), operands.end(), [](const auto& entry) { return entry.second.data; });
+    if (shape == operands.end()) {
+        error(CodegenErrorType::TypeMismatch, "sum requires an array or slice argument");
+        return;
+    }
+    std::string elementType = shape->second.elementType;
+    llvm::Value* length = shape->second.length;
+    llvm::Type* elementLLVMType = valueMap.getLLVMType(elementType, contextManager);
+    finishArrayOperands(operands, length, elementLLVMType);
+    
+    // Floating-point sums may be regrouped into partial sums, so the additions add the
+    // reassoc flag to the function's own fast-math flags; integer sums are exact in any order
+    llvm::Value* zero = llvm::Constant::getNullValue(elementLLVMType);
+    currentValue = generateArrayLoop(length, zero, [&](llvm::Value* index, llvm::Value* accumulator) -> llvm::Value* {
+        llvm::Value* value = generateArrayElement(argument, operands, index, elementLLVMType,
+                                                  isUnsignedType(elementType));
+        if (!elementLLVMType->isFloatingPointTy()) {
+            return builder.CreateAdd(accumulator, value, "acc.next");
+        }
+        llvm::Value* next = builder.CreateFAdd(accumulator, value, "acc.next");
+        llvm::FastMathFlags flags = builder.getFastMathFlags();
+        flags.setAllowReassoc();
+        llvm::cast<llvm::Instruction>(next)->setFastMathFlags(flags);
+        return next;
+    });
+    currentExpressionType = elementType;
+}
+
+/******************** Vector Lowering ********************/
+
+std::string CGExpr::vecElementType(const std::string& vecType) {
+    return vecType.substr(4, vecType.size() - 5);
+}
+
+llvm::FunctionCallee CGExpr::getVecRuntime(const std::string& name) {
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Module* module = contextManager.getModule();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+    llvm::Type* i32Ty = llvm::Type::getInt32Ty(ctx);
+    llvm::Type* voidTy = llvm::Type::getVoidTy(ctx);
+
+    llvm::FunctionType* funcType = nullptr;
+    if (name == "emlang_vec_new") {
+        funcType = llvm::FunctionType::get(ptrTy, {i64Ty}, false);
+    } else if (name == "emlang_vec_free" || name == "emlang_vec_shrink") {
+        funcType = llvm::FunctionType::get(voidTy, {ptrTy}, false);
+    } else if (name == "emlang_vec_grow" || name == "emlang_vec_reserve") {
+        funcType = llvm::FunctionType::get(i32Ty, {ptrTy, i64Ty}, false);
+    } else if (name == "emlang_vec_append") {
+        funcType = llvm::FunctionType::get(i32Ty, {ptrTy, ptrTy, i64Ty}, false);
+    } else if (name == "emlang_vec_index_fail") {
+        funcType = llvm::FunctionType::get(voidTy, {i64Ty, i64Ty}, false);
+    } else {
+        funcType = llvm::FunctionType::get(voidTy, {i64Ty}, false); // emlang_vec_alloc_fail
+    }
+
+    llvm::FunctionCallee callee = module->getOrInsertFunction(name, funcType);
+    if (name == "emlang_vec_index_fail" || name == "emlang_vec_alloc_fail") {
+        if (auto* function = llvm::dyn_cast<llvm::Function>(callee.getCallee())) {
+            function->setDoesNotReturn();
+            function->addFnAttr(llvm::Attribute::Cold);
+        }
+    }
+    return callee;
+}
+
+llvm::Value* CGExpr::generateVecInit(const std::string& vecType, Expression* initializer) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+
+    auto* arrayExpr = dynamic_cast<ArrayExpr*>(initializer);
+    if (initializer && !arrayExpr) {
+        initializer->accept(*this);
+        return currentValue;
+    }
+
+    std::string elementTypeStr = vecElementType(vecType);
+    llvm::Type* elementType = valueMap.getLLVMType(elementTypeStr, contextManager);
+    if (!elementType) {
+        error(CodegenErrorType::UnknownType, "Unknown vector element type: " + elementTypeStr);
+        return nullptr;
+    }
+
+    llvm::Value* elemSize = llvm::ConstantExpr::getSizeOf(elementType);
+    llvm::Value* vec = builder.CreateCall(getVecRuntime("emlang_vec_new"), {elemSize}, "vec");
+    if (!arrayExpr || arrayExpr->elements.empty()) {
+        currentValue = vec;
+        currentExpressionType = vecType;
+        return vec;
+    }
+
+    // Literal-only initializers are appended straight from read-only data
+    uint64_t count = arrayExpr->elements.size();
+    if (llvm::Constant* values = generateConstantArray(elementTypeStr, *arrayExpr)) {
+        builder.CreateCall(getVecRuntime("emlang_vec_append"),
+                           {vec, getArrayTable(values), llvm::ConstantInt::get(i64Ty, count)});
+        currentValue = vec;
+        currentExpressionType = vecType;
+        return vec;
+    }
+
+    // Otherwise materialize the literal as a T[N] temporary and copy it in with one append
+    llvm::ArrayType* arrayType = llvm::ArrayType::get(elementType, count);
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::IRBuilder<> tmpBuilder(&currentFunction->getEntryBlock(), currentFunction->getEntryBlock().begin());
+    llvm::Value* arrayAlloca = tmpBuilder.CreateAlloca(arrayType, nullptr, "vecinit");
+
+    for (uint64_t i = 0; i < count; ++i) {
+        arrayExpr->elements[i]->accept(*this);
+        if (!currentValue) {
+            error(CodegenErrorType::InternalError, "Invalid element in vector initializer");
+            return nullptr;
+        }
+        llvm::Value* elementPtr = builder.CreateConstInBoundsGEP2_64(arrayType, arrayAlloca, 0, i, "vecinitelem");
+        builder.CreateStore(convertValue(currentValue, elementType, isUnsignedType(currentExpressionType)), elementPtr);
+    }
+    builder.CreateCall(getVecRuntime("emlang_vec_append"),
+                       {vec, arrayAlloca, llvm::ConstantInt::get(i64Ty, count)});
+
+    currentValue = vec;
+    currentExpressionType = vecType;
+    return vec;
+}
+
+llvm::Value* CGExpr::generateVecElementPtr(llvm::Value* vec, llvm::Value* index, llvm::Type* elementType) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+    llvm::StructType* headerType = llvm::StructType::get(ctx, {ptrTy, i64Ty, i64Ty});
+
+    llvm::Value* dataPtr = builder.CreateStructGEP(headerType, vec, 0, "vecdataptr");
+    llvm::Value* lengthPtr = builder.CreateStructGEP(headerType, vec, 1, "veclenptr");
+    llvm::Value* data = builder.CreateLoad(ptrTy, dataPtr, "vecdata");
+    llvm::Value* length = builder.CreateLoad(i64Ty, lengthPtr, "veclen");
+    llvm::Value* index64 = convertValue(index, i64Ty);
+
+    // Unsigned compare rejects negative indices as well
+    llvm::Value* inBounds = builder.CreateICmpULT(index64, length, "inbounds");
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* okBB = llvm::BasicBlock::Create(ctx, "vecidx.ok", function);
+    llvm::BasicBlock* failBB = llvm::BasicBlock::Create(ctx, "vecidx.fail", function);
+    llvm::MDBuilder mdBuilder(ctx);
+    builder.CreateCondBr(inBounds, okBB, failBB, mdBuilder.createBranchWeights(2000, 1));
+
+    builder.SetInsertPoint(failBB);
+    builder.CreateCall(getVecRuntime("emlang_vec_index_fail"), {index64, length});
+    builder.CreateUnreachable();
+
+    builder.SetInsertPoint(okBB);
+    return builder.CreateInBoundsGEP(elementType, data, index64, "vecelem");
+}
+
+void CGExpr::generateVecIntrinsic(FunctionCallExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* ptrTy = llvm::PointerType::get(ctx, 0);
+    llvm::Type* i64Ty = llvm::Type::getInt64Ty(ctx);
+    llvm::StructType* headerType = llvm::StructType::get(ctx, {ptrTy, i64Ty, i64Ty});
+    const std::string& name = node.functionName;
+
+    if (node.arguments.empty()) {
+        error(CodegenErrorType::TypeMismatch, name + " expects a vector argument");
+        return;
+    }
+    node.arguments[0]->accept(*this);
+    llvm::Value* vec = currentValue;
+    std::string vecType = currentExpressionType;
+    if (!vec || vecType.compare(0, 4, "vec<") != 0) {
+        error(CodegenErrorType::TypeMismatch, name + " expects a vector argument");
+        return;
+    }
+    std::string elementTypeStr = vecElementType(vecType);
+    llvm::Type* elementType = valueMap.getLLVMType(elementTypeStr, contextManager);
+    if (!elementType) {
+        error(CodegenErrorType::UnknownType, "Unknown vector element type: " + elementTypeStr);
+        return;
+    }
+
+    if (name == "vec_push") {
+        if (node.arguments.size() != 2) {
+            error(CodegenErrorType::TypeMismatch, "vec_push expects 2 arguments");
+            return;
+        }
+        node.arguments[1]->accept(*this);
+        if (!currentValue) {
+            error(CodegenErrorType::InternalError, "Invalid value in vec_push");
+            return;
+        }
+        llvm::Value* value = convertValue(currentValue, elementType, isUnsignedType(currentExpressionType));
+
+        llvm::Value* lengthPtr = builder.CreateStructGEP(headerType, vec, 1, "veclenptr");
+        llvm::Value* capacityPtr = builder.CreateStructGEP(headerType, vec, 2, "veccapptr");
+        llvm::Value* length = builder.CreateLoad(i64Ty, lengthPtr, "veclen");
+        llvm::Value* capacity = builder.CreateLoad(i64Ty, capacityPtr, "veccap");
+        llvm::Value* newLength = builder.CreateAdd(length, llvm::ConstantInt::get(i64Ty, 1), "veclen.next");
+
+        // Only a full vector leaves generated code to grow its storage
+        llvm::Function* function = builder.GetInsertBlock()->getParent();
+        llvm::BasicBlock* growBB = llvm::BasicBlock::Create(ctx, "vecpush.grow", function);
+        llvm::BasicBlock* failBB = llvm::BasicBlock::Create(ctx, "vecpush.fail", function);
+        llvm::BasicBlock* storeBB = llvm::BasicBlock::Create(ctx, "vecpush.store", function);
+        llvm::MDBuilder mdBuilder(ctx);
+        llvm::Value* full = builder.CreateICmpEQ(length, capacity, "vecfull");
+        builder.CreateCondBr(full, growBB, storeBB, mdBuilder.createBranchWeights(1, 2000));
+
+        builder.SetInsertPoint(growBB);
+        llvm::Value* grown = builder.CreateCall(getVecRuntime("emlang_vec_grow"), {vec, newLength}, "grown");
+        builder.CreateCondBr(builder.CreateICmpNE(grown, llvm::ConstantInt::get(grown->getType(), 0)),
+                             storeBB, failBB, mdBuilder.createBranchWeights(2000, 1));
+
+        builder.SetInsertPoint(failBB);
+        builder.CreateCall(getVecRuntime("emlang_vec_alloc_fail"), {newLength});
+        builder.CreateUnreachable();
+
+        builder.SetInsertPoint(storeBB);
+        llvm::Value* dataPtr = builder.CreateStructGEP(headerType, vec, 0, "vecdataptr");
+        llvm::Value* data = builder.CreateLoad(ptrTy, dataPtr, "vecdata");
+        builder.CreateStore(value, builder.CreateInBoundsGEP(elementType, data, length, "vecslot"));
+        builder.CreateStore(newLength, lengthPtr);
+        currentValue = nullptr;
+        currentExpressionType = "void";
+        return;
+    }
+
+    if (name == "vec_pop") {
+        llvm::Value* lengthPtr = builder.CreateStructGEP(headerType, vec, 1, "veclenptr");
+        llvm::Value* length = builder.CreateLoad(i64Ty, lengthPtr, "veclen");
+        llvm::Value* last = builder.CreateSub(length, llvm::ConstantInt::get(i64Ty, 1), "veclast");
+        llvm::Value* elementPtr = generateVecElementPtr(vec, last, elementType);
+        currentValue = builder.CreateLoad(elementType, elementPtr, "vecpop");
+        builder.CreateStore(last, lengthPtr);
+        currentExpressionType = elementTypeStr;
+        return;
+    }
+
+    if (name == "vec_len") {
+        llvm::Value* lengthPtr = builder.CreateStructGEP(headerType, vec, 1, "veclenptr");
+        currentValue = builder.CreateLoad(i64Ty, lengthPtr, "veclen");
+        currentExpressionType = "int64";
+        return;
+    }
+
+    if (name == "vec_clear") {
+        builder.CreateStore(llvm::ConstantInt::get(i64Ty, 0), builder.CreateStructGEP(headerType, vec, 1, "veclenptr"));
+    } else if (name == "vec_reserve") {
+        if (node.arguments.size() != 2) {
+            error(CodegenErrorType::TypeMismatch, "vec_reserve expects 2 arguments");
+            return;
+        }
+        node.arguments[1]->accept(*this);
+        if (!currentValue) {
+            error(CodegenErrorType::InternalError, "Invalid capacity in vec_reserve");
+            return;
+        }
+        builder.CreateCall(getVecRuntime("emlang_vec_reserve"),
+                           {vec, convertValue(currentValue, i64Ty, isUnsignedType(currentExpressionType))});
+    } else if (name == "vec_shrink") {
+        builder.CreateCall(getVecRuntime("emlang_vec_shrink"), {vec});
+    } else if (name == "vec_free") {
+        builder.CreateCall(getVecRuntime("emlang_vec_free"), {vec});
+    }
+    currentValue = nullptr;
+    currentExpressionType = "void";
+}
+
+void CGExpr::generateHintIntrinsic(FunctionCallExpr& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Type* i1Ty = llvm::Type::getInt1Ty(ctx);
+    llvm::Type* i32Ty = llvm::Type::getInt32Ty(ctx);
+    const std::string& name = node.functionName;
+
+    if (name == "likely" || name == "unlikely") {
+        if (node.arguments.size() != 1) {
+            error(CodegenErrorType::TypeMismatch, name + " expects 1 argument");
+            return;
+        }
+        node.arguments[0]->accept(*this);
+        llvm::Value* condition = currentValue;
+        if (!condition) {
+            error(CodegenErrorType::InternalError, "Invalid condition in " + name);
+            return;
+        }
+        if (condition->getType() != i1Ty) {
+            condition = builder.CreateICmpNE(condition, llvm::ConstantInt::get(condition->getType(), 0), "tobool");
+        }
+        // Conditions of if/while take the branch-weight path in CGStmt; this covers other uses
+        currentValue = builder.CreateIntrinsic(llvm::Intrinsic::expect, {i1Ty},
+                                               {condition, llvm::ConstantInt::get(i1Ty, name == "likely")},
+                                               nullptr, name);
+        currentExpressionType = "bool";
+        return;
+    }
+
+    // prefetch(address, rw, locality)
+    if (node.arguments.size() != 3) {
+        error(CodegenErrorType::TypeMismatch, "prefetch expects 3 arguments");
+        return;
+    }
+    node.arguments[0]->accept(*this);
+    llvm::Value* address = currentValue;
+    if (!address || !address->getType()->isPointerTy()) {
+        error(CodegenErrorType::TypeMismatch, "prefetch expects a pointer address");
+        return;
+    }
+    llvm::Value* operands[2];
+    for (size_t i = 0; i < 2; ++i) {
+        node.arguments[i + 1]->accept(*this);
+        auto* constant = llvm::dyn_cast_or_null<llvm::ConstantInt>(currentValue);
+        if (!constant) {
+            error(CodegenErrorType::TypeMismatch, "prefetch rw and locality must be integer constants");
+            return;
+        }
+        operands[i] = llvm::ConstantInt::get(i32Ty, constant->getZExtValue());
+    }
+    // Cache type 1 selects the data cache
+    builder.CreateIntrinsic(llvm::Intrinsic::prefetch, {address->getType()},
+                            {address, operands[0], operands[1], llvm::ConstantInt::get(i32Ty, 1)});
+    currentValue = nullptr;
+    currentExpressionType = "void";
+}
 
 void CGExpr::setCurrentValue(llvm::Value* value, const std::string& type) {
     currentValue = value;
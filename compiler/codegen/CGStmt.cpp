@@ -10,13 +10,194 @@
 #include "codegen/CGStmt.h"
 #include "codegen/CGExpr.h"
 #include "ast.h"
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/MDBuilder.h>
+#include <set>
 
 namespace emlang {
 namespace codegen {
 
+namespace {
+
+/// Walks a loop body collecting a[counter] accesses and every variable the body writes
+class LoopBodyScanner {
+public:
+    LoopBodyScanner(const std::string& counter, const AssignmentExpr* increment)
+        : counter(counter), increment(increment) {}
+
+    std::vector<IndexExpr*> accesses;           // Candidate a[counter] accesses
+    std::set<std::string> written;              // Variables assigned or declared in the body
+    std::set<std::string> addressTaken;         // Variables whose address, or an element's, is taken
+    std::vector<FunctionCallExpr*> calls;       // Calls the body makes
+    bool containsLoop = false;                  // Whether the body nests another loop
+
+    /// @return false if the body contains a node the scan does not understand
+    bool scan(Statement* stmt) {
+        if (!stmt) {
+            return true;
+        }
+        if (auto* block = dynamic_cast<BlockStmt*>(stmt)) {
+            for (auto& inner : block->statements) {
+                if (!scan(inner.get())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (auto* exprStmt = dynamic_cast<ExpressionStmt*>(stmt)) {
+            return scan(exprStmt->expression.get());
+        }
+        if (auto* varDecl = dynamic_cast<VariableDecl*>(stmt)) {
+            written.insert(varDecl->name);
+            return scan(varDecl->initializer.get());
+        }
+        if (auto* ifStmt = dynamic_cast<IfStmt*>(stmt)) {
+            return scan(ifStmt->condition.get()) && scan(ifStmt->thenBranch.get()) && scan(ifStmt->elseBranch.get());
+        }
+        if (auto* whileStmt = dynamic_cast<WhileStmt*>(stmt)) {
+            containsLoop = true;
+            return scan(whileStmt->condition.get()) && scan(whileStmt->body.get());
+        }
+        if (auto* forStmt = dynamic_cast<ForStmt*>(stmt)) {
+            containsLoop = true;
+            if (forStmt->isRange()) {
+                written.insert(forStmt->variable);
+                return scan(forStmt->rangeStart.get()) && scan(forStmt->rangeEnd.get()) && scan(forStmt->body.get());
+            }
+            return scan(forStmt->initializer.get()) && scan(forStmt->condition.get()) &&
+                   scan(forStmt->increment.get()) && scan(forStmt->body.get());
+        }
+        if (auto* switchStmt = dynamic_cast<SwitchStmt*>(stmt)) {
+            if (!scan(switchStmt->discriminant.get())) {
+                return false;
+            }
+            for (auto& arm : switchStmt->cases) {
+                if (!scan(arm.body.get())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (auto* returnStmt = dynamic_cast<ReturnStmt*>(stmt)) {
+            return scan(returnStmt->value.get());
+        }
+        return false;
+    }
+
+    bool scan(Expression* expr) {
+        if (!expr || dynamic_cast<LiteralExpr*>(expr) || dynamic_cast<IdentifierExpr*>(expr)) {
+            return true;
+        }
+        if (auto* binary = dynamic_cast<BinaryOpExpr*>(expr)) {
+            return scan(binary->left.get()) && scan(binary->right.get());
+        }
+        if (auto* unary = dynamic_cast<UnaryOpExpr*>(expr)) {
+            return scan(unary->operand.get());
+        }
+        if (auto* assignment = dynamic_cast<AssignmentExpr*>(expr)) {
+            auto* target = dynamic_cast<IdentifierExpr*>(assignment->target.get());
+            if (target && assignment != increment) {
+                written.insert(target->name);
+            }
+            return scan(assignment->target.get()) && scan(assignment->value.get());
+        }
+        if (auto* call = dynamic_cast<FunctionCallExpr*>(expr)) {
+            calls.push_back(call);
+            for (auto& argument : call->arguments) {
+                if (!scan(argument.get())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (auto* member = dynamic_cast<MemberExpr*>(expr)) {
+            return scan(member->object.get());
+        }
+        if (auto* element = dynamic_cast<IndexExpr*>(expr)) {
+            auto* array = dynamic_cast<IdentifierExpr*>(element->array.get());
+            auto* index = dynamic_cast<IdentifierExpr*>(element->index.get());
+            if (array && index && index->name == counter) {
+                accesses.push_back(element);
+            }
+            return scan(element->array.get()) && scan(element->index.get());
+        }
+        if (auto* slice = dynamic_cast<SliceExpr*>(expr)) {
+            return scan(slice->array.get()) && scan(slice->start.get()) && scan(slice->end.get());
+        }
+        if (auto* array = dynamic_cast<ArrayExpr*>(expr)) {
+            for (auto& element : array->elements) {
+                if (!scan(element.get())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (auto* object = dynamic_cast<ObjectExpr*>(expr)) {
+            for (auto& field : object->fields) {
+                if (!scan(field.value.get())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+#ifdef EMLANG_FEATURE_POINTERS
+        if (auto* addressOf = dynamic_cast<AddressOfExpr*>(expr)) {
+            Expression* root = addressOf->operand.get();
+            while (true) {
+                if (auto* element = dynamic_cast<IndexExpr*>(root)) {
+                    root = element->array.get();
+                } else if (auto* member = dynamic_cast<MemberExpr*>(root)) {
+                    root = member->object.get();
+                } else {
+                    break;
+                }
+            }
+            if (auto* identifier = dynamic_cast<IdentifierExpr*>(root)) {
+                addressTaken.insert(identifier->name);
+            }
+            return scan(addressOf->operand.get());
+        }
+        if (auto* deref = dynamic_cast<DereferenceExpr*>(expr)) {
+            return scan(deref->operand.get());
+        }
+#endif // EMLANG_FEATURE_POINTERS
+        return false;
+    }
+
+private:
+    const std::string& counter;
+    const AssignmentExpr* increment;
+};
+
+/// Returns c for `counter = counter + c`, or 0 if the assignment has another shape
+int64_t countedStep(const AssignmentExpr& assignment, const std::string& counter) {
+    auto* target = dynamic_cast<IdentifierExpr*>(assignment.target.get());
+    auto* sum = dynamic_cast<BinaryOpExpr*>(assignment.value.get());
+    if (!target || target->name != counter || !sum || sum->operator_ != BinaryOpExpr::BinOp::ADD) {
+        return 0;
+    }
+    auto* base = dynamic_cast<IdentifierExpr*>(sum->left.get());
+    auto* step = dynamic_cast<LiteralExpr*>(sum->right.get());
+    if (!base || base->name != counter || !step || step->literalType != LiteralType::INT) {
+        return 0;
+    }
+    // A step too large for int64 leaves the loop to the per-element checks
+    try {
+        return std::stoll(step->value);
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+bool isSignedIntegerType(const std::string& type) {
+    return type == "int8" || type == "int16" || type == "int32" || type == "int64" || type == "isize" || type == "int";
+}
+
+} // namespace
+
 CGStmt::CGStmt(ContextManager& contextManager, ValueMap& valueMap, CodegenErrorReporter& errorReporter, CGExpr& exprGenerator)
     : CGBase(contextManager, valueMap, errorReporter), 
-      exprGenerator(exprGenerator), currentBlock(nullptr) {
+      exprGenerator(exprGenerator), currentBlock(nullptr), addressesKnown(false) {
 }
 
 void CGStmt::visit(BlockStmt& node) {
@@ -24,22 +205,32 @@ void CGStmt::visit(BlockStmt& node) {
 }
 
 void CGStmt::visit(IfStmt& node) {
+    emitLocation(node);
     generateIf(node);
 }
 
 void CGStmt::visit(WhileStmt& node) {
+    emitLocation(node);
     generateWhile(node);
 }
 
 void CGStmt::visit(ForStmt& node) {
+    emitLocation(node);
     generateFor(node);
 }
 
+void CGStmt::visit(SwitchStmt& node) {
+    emitLocation(node);
+    generateSwitch(node);
+}
+
 void CGStmt::visit(ReturnStmt& node) {
+    emitLocation(node);
     generateReturn(node);
 }
 
 void CGStmt::visit(ExpressionStmt& node) {
+    emitLocation(node);
     generateExpressionStmt(node);
 }
 
@@ -60,7 +251,8 @@ llvm::BasicBlock* CGStmt::generateBlock(BlockStmt& node) {
 
 llvm::BasicBlock* CGStmt::generateIf(IfStmt& node) {
     // Generate condition
-    node.condition->accept(*this);
+    llvm::MDNode* weights = nullptr;
+    stripBranchHint(*node.condition, weights)->accept(*this);
     llvm::Value* condV = currentValue;    if (!condV) {
         error(CodegenErrorType::InternalError, "Invalid condition in if statement");
         return nullptr;
@@ -79,9 +271,9 @@ llvm::BasicBlock* CGStmt::generateIf(IfStmt& node) {
     
     // Branch
     if (elseBB) {
-        builder.CreateCondBr(condV, thenBB, elseBB);
+        builder.CreateCondBr(condV, thenBB, elseBB, weights);
     } else {
-        builder.CreateCondBr(condV, thenBB, mergeBB);
+        builder.CreateCondBr(condV, thenBB, mergeBB, weights);
     }
     
     // Generate then block
@@ -109,24 +301,45 @@ llvm::BasicBlock* CGStmt::generateIf(IfStmt& node) {
 }
 
 llvm::BasicBlock* CGStmt::generateWhile(WhileStmt& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* afterBB = llvm::BasicBlock::Create(ctx, "afterloop");
+    
+    llvm::MDNode* weights = nullptr;
+    Expression* condition = stripBranchHint(*node.condition, weights);
+    
+    CountedLoop loop;
+    llvm::Value* inRange = nullptr;
+    if (contextManager.getOptions().boundsChecks && analyzeCountedLoop(node, *condition, loop)) {
+        inRange = generateHoistedCheck(loop);
+    }
+    generateVersionedLoop(inRange, loop, [&] { generateWhileLoop(node, *condition, weights, afterBB); });
+    
+    // Continue after loop
+    function->insert(function->end(), afterBB);
+    builder.SetInsertPoint(afterBB);
+    return afterBB;
+}
+
+void CGStmt::generateWhileLoop(WhileStmt& node, Expression& condition, llvm::MDNode* weights, llvm::BasicBlock* afterBB) {
     auto& builder = contextManager.getBuilder();
     llvm::Function* function = builder.GetInsertBlock()->getParent();
     
     // Create basic blocks
     llvm::BasicBlock* condBB = llvm::BasicBlock::Create(contextManager.getContext(), "whilecond", function);
     llvm::BasicBlock* loopBB = llvm::BasicBlock::Create(contextManager.getContext(), "whileloop", function);
-    llvm::BasicBlock* afterBB = llvm::BasicBlock::Create(contextManager.getContext(), "afterloop", function);
     
     // Jump to condition
     builder.CreateBr(condBB);
     
     // Generate condition block
     builder.SetInsertPoint(condBB);
-    node.condition->accept(*this);
+    condition.accept(*this);
     llvm::Value* condV = currentValue;    
     if (!condV) {
         error(CodegenErrorType::InternalError, "Invalid condition in while statement");
-        return nullptr;
+        return;
     }
     // Convert condition to boolean - simplified approach
     if (condV->getType() != llvm::Type::getInt1Ty(contextManager.getContext())) {
@@ -134,7 +347,7 @@ llvm::BasicBlock* CGStmt::generateWhile(WhileStmt& node) {
     }
     
     // Branch to loop or after
-    builder.CreateCondBr(condV, loopBB, afterBB);
+    builder.CreateCondBr(condV, loopBB, afterBB, weights);
     // Generate loop body
     builder.SetInsertPoint(loopBB);
     auto prevNamedValues = valueMap.saveScope(); // Enter scope for loop body
@@ -144,12 +357,13 @@ llvm::BasicBlock* CGStmt::generateWhile(WhileStmt& node) {
     if (!builder.GetInsertBlock()->getTerminator()) {
         builder.CreateBr(condBB); // Jump back to condition
     }
-      // Continue after loop
-    builder.SetInsertPoint(afterBB);
-    return afterBB;
 }
 
 llvm::BasicBlock* CGStmt::generateFor(ForStmt& node) {
+    if (node.isRange()) {
+        return generateRangeFor(node);
+    }
+    
     auto& builder = contextManager.getBuilder();
     llvm::Function* function = builder.GetInsertBlock()->getParent();
     
@@ -217,6 +431,169 @@ llvm::BasicBlock* CGStmt::generateFor(ForStmt& node) {
     return afterBB;
 }
 
+llvm::BasicBlock* CGStmt::generateRangeFor(ForStmt& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    
+    // Both bounds are evaluated once, before the loop
+    node.rangeStart->accept(*this);
+    llvm::Value* start = currentValue;
+    std::string variableType = exprGenerator.getCurrentExpressionType();
+    bool startUnsigned = CGExpr::isUnsignedType(variableType);
+    node.rangeEnd->accept(*this);
+    llvm::Value* end = currentValue;
+    bool endUnsigned = CGExpr::isUnsignedType(exprGenerator.getCurrentExpressionType());
+    if (!start || !end || !start->getType()->isIntegerTy() || !end->getType()->isIntegerTy()) {
+        error(CodegenErrorType::TypeMismatch, "For range bounds must be integers");
+        return nullptr;
+    }
+    
+    // The variable has the wider of the two bound types
+    llvm::Type* ivType = start->getType();
+    if (end->getType()->getIntegerBitWidth() > ivType->getIntegerBitWidth()) {
+        ivType = end->getType();
+        variableType = exprGenerator.getCurrentExpressionType();
+    }
+    start = convertValue(start, ivType, startUnsigned);
+    end = convertValue(end, ivType, endUnsigned);
+    int64_t stepValue = node.step ? std::stoll(static_cast<LiteralExpr*>(node.step.get())->value) : 1;
+    llvm::Value* step = llvm::ConstantInt::get(ivType, stepValue);
+    
+    llvm::BasicBlock* preheaderBB = llvm::BasicBlock::Create(ctx, "forpre", function);
+    llvm::BasicBlock* afterBB = llvm::BasicBlock::Create(ctx, "afterfor");
+    builder.CreateCondBr(builder.CreateICmpSLT(start, end, "fornonempty"), preheaderBB, afterBB);
+    
+    // With start < end, end - start is exact as an unsigned value, so the
+    // last value the variable takes (and with it the trip count) is known here
+    builder.SetInsertPoint(preheaderBB);
+    llvm::Value* last = nullptr;
+    if (stepValue == 1) {
+        last = builder.CreateNSWSub(end, step, "forlast");
+    } else {
+        llvm::Value* span = builder.CreateSub(builder.CreateSub(end, start), llvm::ConstantInt::get(ivType, 1), "forspan");
+        llvm::Value* offset = builder.CreateNUWMul(builder.CreateUDiv(span, step), step, "foroffset");
+        last = builder.CreateAdd(start, offset, "forlast");
+    }
+    
+    CountedLoop loop;
+    llvm::Value* inRange = nullptr;
+    std::set<std::string> written;
+    loop.counter = node.variable;
+    loop.step = stepValue;
+    if (contextManager.getOptions().boundsChecks && collectCountedAccesses(*node.body, nullptr, loop, written)) {
+        llvm::Type* i64Ty = builder.getInt64Ty();
+        inRange = generateAccessRangeCheck(loop.accesses, convertValue(start, i64Ty), convertValue(last, i64Ty), nullptr);
+    }
+    // The variable stays below end, so `i + 1` and the like need no overflow check
+    llvm::ConstantRange startRange = exprGenerator.getValueRange(start);
+    llvm::ConstantRange endRange = exprGenerator.getValueRange(end);
+    llvm::ConstantRange variableRange = llvm::ConstantRange::getNonEmpty(startRange.getSignedMin(), endRange.getSignedMax());
+    generateVersionedLoop(inRange, loop, [&] {
+        generateRangeLoop(node, start, last, step, variableType, variableRange, afterBB);
+    });
+    
+    function->insert(function->end(), afterBB);
+    builder.SetInsertPoint(afterBB);
+    return afterBB;
+}
+
+void CGStmt::generateRangeLoop(ForStmt& node, llvm::Value* start, llvm::Value* last, llvm::Value* step,
+                               const std::string& variableType, const llvm::ConstantRange& variableRange,
+                               llvm::BasicBlock* afterBB) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* preheaderBB = builder.GetInsertBlock();
+    llvm::BasicBlock* bodyBB = llvm::BasicBlock::Create(ctx, "forbody", function);
+    llvm::BasicBlock* latchBB = llvm::BasicBlock::Create(ctx, "forlatch");
+    builder.CreateBr(bodyBB);
+    
+    // The variable is bound to the phi itself; the analyzer keeps it read-only and unaddressable
+    builder.SetInsertPoint(bodyBB);
+    llvm::PHINode* variable = builder.CreatePHI(start->getType(), 2, node.variable);
+    variable->addIncoming(start, preheaderBB);
+    exprGenerator.setValueRange(variable, variableRange);
+    auto prevNamedValues = valueMap.saveScope();
+    valueMap.addVariable(node.variable, variable, variableType);
+    node.body->accept(*this);
+    valueMap.restoreScope(prevNamedValues);
+    if (!builder.GetInsertBlock()->getTerminator()) {
+        builder.CreateBr(latchBB);
+    }
+    
+    // The loop leaves after the iteration for last, so the stepped value
+    // is only used while it is at most last and the add cannot overflow
+    function->insert(function->end(), latchBB);
+    builder.SetInsertPoint(latchBB);
+    llvm::Value* next = builder.CreateNSWAdd(variable, step, node.variable + ".next");
+    builder.CreateCondBr(builder.CreateICmpEQ(variable, last, "fordone"), afterBB, bodyBB);
+    variable->addIncoming(next, latchBB);
+}
+
+llvm::BasicBlock* CGStmt::generateSwitch(SwitchStmt& node) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    
+    node.discriminant->accept(*this);
+    llvm::Value* switchV = currentValue;
+    if (!switchV || !switchV->getType()->isIntegerTy()) {
+        error(CodegenErrorType::TypeMismatch, "Switch value must be an integer");
+        return nullptr;
+    }
+    auto* switchType = llvm::cast<llvm::IntegerType>(switchV->getType());
+    
+    // Create one block per arm up front so the switch can name them all
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    std::vector<llvm::BasicBlock*> armBlocks;
+    llvm::BasicBlock* defaultBB = nullptr;
+    for (const auto& arm : node.cases) {
+        armBlocks.push_back(llvm::BasicBlock::Create(ctx, arm.isDefault ? "default" : "case", function));
+        if (arm.isDefault) {
+            defaultBB = armBlocks.back();
+        }
+    }
+    llvm::BasicBlock* afterBB = llvm::BasicBlock::Create(ctx, "switchend");
+    
+    llvm::SwitchInst* switchInst = builder.CreateSwitch(switchV, defaultBB ? defaultBB : afterBB, node.cases.size());
+    
+    std::set<int64_t> seenLabels;
+    for (size_t i = 0; i < node.cases.size(); ++i) {
+        for (auto& label : node.cases[i].labels) {
+            // Labels are literals, so the builder folds them to constants
+            label->accept(*this);
+            auto* labelV = llvm::dyn_cast_or_null<llvm::ConstantInt>(currentValue);
+            if (!labelV) {
+                error(CodegenErrorType::TypeMismatch, "Case label is not an integer constant: " + label->toString());
+                return nullptr;
+            }
+            int64_t labelValue = labelV->getBitWidth() == 1 ? labelV->getZExtValue() : labelV->getSExtValue();
+            if (!seenLabels.insert(labelValue).second) {
+                error(CodegenErrorType::InternalError, "Duplicate case label: " + label->toString());
+                return nullptr;
+            }
+            switchInst->addCase(llvm::ConstantInt::get(switchType, labelValue, true), armBlocks[i]);
+        }
+    }
+    
+    // Arms never fall through into each other
+    for (size_t i = 0; i < node.cases.size(); ++i) {
+        builder.SetInsertPoint(armBlocks[i]);
+        node.cases[i].body->accept(*this);
+        if (!builder.GetInsertBlock()->getTerminator()) {
+            builder.CreateBr(afterBB);
+        }
+    }
+    
+    function->insert(function->end(), afterBB);
+    builder.SetInsertPoint(afterBB);
+    if (llvm::pred_empty(afterBB)) {
+        // Every arm returned and a default exists; nothing after the switch is reachable
+        builder.CreateUnreachable();
+    }
+    return afterBB;
+}
+
 llvm::Value* CGStmt::generateReturn(ReturnStmt& node) {
     auto& builder = contextManager.getBuilder();
     
@@ -226,7 +603,17 @@ llvm::Value* CGStmt::generateReturn(ReturnStmt& node) {
             error(CodegenErrorType::InternalError, "Invalid return expression");
             return nullptr;
         }
-        currentValue = builder.CreateRet(currentValue);    
+    }
+    // Async functions leave the result in their promise for the awaiting task
+    if (exprGenerator.inCoroutine()) {
+        currentValue = exprGenerator.generateCoroutineReturn(node.value ? currentValue : nullptr);
+        return currentValue;
+    }
+    
+    if (node.value) {
+        llvm::Type* returnType = builder.GetInsertBlock()->getParent()->getReturnType();
+        bool isUnsigned = CGExpr::isUnsignedType(exprGenerator.getCurrentExpressionType());
+        currentValue = builder.CreateRet(convertValue(currentValue, returnType, isUnsigned));
     } else {
         currentValue = builder.CreateRetVoid();
     }
@@ -238,6 +625,215 @@ llvm::Value* CGStmt::generateExpressionStmt(ExpressionStmt& node) {
     return currentValue;
 }
 
+Expression* CGStmt::stripBranchHint(Expression& condition, llvm::MDNode*& weights) {
+    auto* call = dynamic_cast<FunctionCallExpr*>(&condition);
+    if (!call || call->arguments.size() != 1 ||
+        (call->functionName != "likely" && call->functionName != "unlikely") ||
+        contextManager.getModule()->getFunction(call->functionName)) {
+        return &condition;
+    }
+    // Same 2000:1 ratio LLVM's LowerExpectIntrinsic gives llvm.expect
+    llvm::MDBuilder mdBuilder(contextManager.getContext());
+    weights = call->functionName == "likely"
+        ? mdBuilder.createBranchWeights(2000, 1)
+        : mdBuilder.createBranchWeights(1, 2000);
+    return call->arguments[0].get();
+}
+
+/******************** Bounds Check Hoisting ********************/
+
+bool CGStmt::analyzeCountedLoop(WhileStmt& node, Expression& condition, CountedLoop& loop) {
+    auto* compare = dynamic_cast<BinaryOpExpr*>(&condition);
+    if (!compare || (compare->operator_ != BinaryOpExpr::BinOp::LT && compare->operator_ != BinaryOpExpr::BinOp::LE)) {
+        return false;
+    }
+    auto* counter = dynamic_cast<IdentifierExpr*>(compare->left.get());
+    auto* body = dynamic_cast<BlockStmt*>(node.body.get());
+    if (!counter || !body || body->statements.empty()) {
+        return false;
+    }
+    
+    // The counter is stepped last, so every access in the body sees a value the condition admitted
+    auto* last = dynamic_cast<ExpressionStmt*>(body->statements.back().get());
+    auto* increment = last ? dynamic_cast<AssignmentExpr*>(last->expression.get()) : nullptr;
+    loop.step = increment ? countedStep(*increment, counter->name) : 0;
+    if (loop.step <= 0) {
+        return false;
+    }
+    if (!llvm::isa_and_nonnull<llvm::AllocaInst>(valueMap.getVariable(counter->name)) ||
+        !isSignedIntegerType(valueMap.getVariableType(counter->name))) {
+        return false;
+    }
+    loop.counter = counter->name;
+    loop.bound = compare->right.get();
+    loop.inclusive = compare->operator_ == BinaryOpExpr::BinOp::LE;
+    std::set<std::string> written;
+    return collectCountedAccesses(*body, increment, loop, written) && isInvariantBound(*loop.bound, written);
+}
+
+void CGStmt::beginFunction(Statement& body) {
+    LoopBodyScanner scanner("", nullptr);
+    addressesKnown = scanner.scan(&body);
+    addressTaken = scanner.addressTaken;
+}
+
+bool CGStmt::collectCountedAccesses(Statement& body, const AssignmentExpr* increment, CountedLoop& loop,
+                                    std::set<std::string>& written) {
+    LoopBodyScanner scanner(loop.counter, increment);
+    if (!addressesKnown || !scanner.scan(&body) || scanner.written.count(loop.counter) ||
+        addressTaken.count(loop.counter)) {
+        return false;
+    }
+    written = scanner.written;
+    loop.innermost = !scanner.containsLoop;
+    
+    // A callee handed a reference could reach the counter or a slice through it
+    static const std::set<std::string> readOnlyIntrinsics = {"slice_len", "vec_len", "likely", "unlikely", "prefetch"};
+    for (FunctionCallExpr* call : scanner.calls) {
+        if (readOnlyIntrinsics.count(call->functionName) && !contextManager.getModule()->getFunction(call->functionName)) {
+            continue;
+        }
+        for (auto& argument : call->arguments) {
+            if (passesReference(*argument)) {
+                return false;
+            }
+        }
+    }
+    
+    for (IndexExpr* access : scanner.accesses) {
+        const std::string& array = static_cast<IdentifierExpr*>(access->array.get())->name;
+        if (written.count(array) || addressTaken.count(array)) {
+            continue;
+        }
+        // Fixed arrays never change length; a slice could only through its own variable
+        std::string arrayType = valueMap.getVariableType(array);
+        std::string elementType;
+        uint64_t size = 0;
+        bool isLocalSlice = arrayType.compare(0, 2, "[]") == 0 && llvm::isa_and_nonnull<llvm::AllocaInst>(valueMap.getVariable(array));
+        if (ValueMap::splitArrayType(arrayType, elementType, size) || isLocalSlice) {
+            loop.accesses.push_back(access);
+        }
+    }
+    return !loop.accesses.empty();
+}
+
+bool CGStmt::passesReference(Expression& argument) {
+    if (dynamic_cast<SliceExpr*>(&argument)) {
+        return true;
+    }
+#ifdef EMLANG_FEATURE_POINTERS
+    if (dynamic_cast<AddressOfExpr*>(&argument)) {
+        return true;
+    }
+#endif // EMLANG_FEATURE_POINTERS
+    auto* identifier = dynamic_cast<IdentifierExpr*>(&argument);
+    if (!identifier) {
+        return false;
+    }
+    std::string type = valueMap.getVariableType(identifier->name);
+    return type.compare(0, 2, "[]") == 0 || type.compare(0, 4, "vec<") == 0 ||
+           (!type.empty() && type.back() == '*');
+}
+
+bool CGStmt::isInvariantBound(Expression& bound, const std::set<std::string>& written) {
+    if (auto* literal = dynamic_cast<LiteralExpr*>(&bound)) {
+        return literal->literalType == LiteralType::INT;
+    }
+    auto* identifier = dynamic_cast<IdentifierExpr*>(&bound);
+    if (auto* call = dynamic_cast<FunctionCallExpr*>(&bound)) {
+        if (call->functionName == "slice_len" && call->arguments.size() == 1) {
+            identifier = dynamic_cast<IdentifierExpr*>(call->arguments[0].get());
+        }
+    }
+    // Globals could be changed by any call in the body
+    return identifier && !written.count(identifier->name) &&
+           llvm::isa_and_nonnull<llvm::AllocaInst>(valueMap.getVariable(identifier->name));
+}
+
+llvm::Value* CGStmt::generateHoistedCheck(const CountedLoop& loop) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Type* i64Ty = builder.getInt64Ty();
+    
+    auto* counter = llvm::cast<llvm::AllocaInst>(valueMap.getVariable(loop.counter));
+    llvm::Type* counterType = counter->getAllocatedType();
+    llvm::Value* start = convertValue(builder.CreateLoad(counterType, counter, loop.counter + ".start"), i64Ty);
+    loop.bound->accept(*this);
+    if (!currentValue) {
+        return nullptr;
+    }
+    llvm::Value* bound = convertValue(currentValue, i64Ty, CGExpr::isUnsignedType(exprGenerator.getCurrentExpressionType()));
+    
+    // Every access sees a counter in [start, last]
+    llvm::Value* last = loop.inclusive ? bound : builder.CreateSub(bound, builder.getInt64(1), "last");
+    int64_t counterMax = llvm::APInt::getSignedMaxValue(counterType->getIntegerBitWidth()).getSExtValue();
+    llvm::Value* noWrap = builder.CreateICmpSLE(last, builder.getInt64(counterMax - loop.step), "nowrap");
+    return generateAccessRangeCheck(loop.accesses, start, last, noWrap);
+}
+
+llvm::Value* CGStmt::generateAccessRangeCheck(const std::vector<IndexExpr*>& accesses, llvm::Value* first,
+                                              llvm::Value* last, llvm::Value* inRange) {
+    auto& builder = contextManager.getBuilder();
+    llvm::Value* startOk = builder.CreateICmpSGE(first, builder.getInt64(0), "startok");
+    inRange = inRange ? builder.CreateAnd(inRange, startOk) : startOk;
+    
+    std::set<std::string> seen;
+    for (IndexExpr* access : accesses) {
+        const std::string& array = static_cast<IdentifierExpr*>(access->array.get())->name;
+        if (!seen.insert(array).second) {
+            continue;
+        }
+        std::string arrayType = valueMap.getVariableType(array);
+        std::string elementType;
+        uint64_t size = 0;
+        llvm::Value* length = nullptr;
+        if (ValueMap::splitArrayType(arrayType, elementType, size)) {
+            length = builder.getInt64(size);
+        } else {
+            auto* slice = llvm::cast<llvm::AllocaInst>(valueMap.getVariable(array));
+            length = builder.CreateExtractValue(builder.CreateLoad(slice->getAllocatedType(), slice, array), {1}, 
+                                                array + ".len");
+        }
+        inRange = builder.CreateAnd(inRange, builder.CreateICmpSLT(last, length), "rangeok");
+    }
+    return inRange;
+}
+
+void CGStmt::generateVersionedLoop(llvm::Value* inRange, const CountedLoop& loop, const std::function<void()>& emitLoop) {
+    auto& builder = contextManager.getBuilder();
+    llvm::LLVMContext& ctx = contextManager.getContext();
+    llvm::Function* function = builder.GetInsertBlock()->getParent();
+    
+    // Only innermost loops get two copies, so nested loops grow linearly
+    if (inRange && !llvm::isa<llvm::ConstantInt>(inRange) && loop.innermost) {
+        // One range check picks a copy of the loop without per-element checks;
+        // the checked copy runs only when the check cannot vouch for every iteration
+        llvm::BasicBlock* uncheckedBB = llvm::BasicBlock::Create(ctx, "loop.unchecked", function);
+        llvm::BasicBlock* checkedBB = llvm::BasicBlock::Create(ctx, "loop.checked", function);
+        llvm::MDBuilder mdBuilder(ctx);
+        builder.CreateCondBr(inRange, uncheckedBB, checkedBB, mdBuilder.createBranchWeights(2000, 1));
+        
+        builder.SetInsertPoint(uncheckedBB);
+        exprGenerator.beginHoistedChecks(loop.accesses);
+        emitLoop();
+        exprGenerator.endHoistedChecks(loop.accesses);
+        
+        builder.SetInsertPoint(checkedBB);
+        emitLoop();
+        return;
+    }
+    
+    // A check that folded to true removes the per-element checks outright
+    auto* folded = llvm::dyn_cast_or_null<llvm::ConstantInt>(inRange);
+    bool proven = folded && folded->isOne();
+    if (proven) {
+        exprGenerator.beginHoistedChecks(loop.accesses);
+    }
+    emitLoop();
+    if (proven) {
+        exprGenerator.endHoistedChecks(loop.accesses);
+    }
+}
+
 llvm::BasicBlock* CGStmt::createBasicBlock(const std::string& name) {
     // TODO: Implement basic block creation
     error("Basic block creation not yet implemented");
@@ -23,6 +23,11 @@
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Transforms/IPO/ArgumentPromotion.h>
+#include <llvm/Transforms/IPO/DeadArgumentElimination.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/Transforms/IPO/Internalize.h>
 // PassManagerBuilder is deprecated in LLVM 20.x - using new pass manager instead
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/raw_ostream.h>
@@ -53,6 +58,7 @@ namespace codegen {
 
 AOTCompiler::AOTCompiler(const std::string& targetTriple)
     : optimizationLevel_(OptLevel::None),
+      wholeProgram_(false),
       targetTriple_(targetTriple.empty() ? llvm::sys::getDefaultTargetTriple() : targetTriple),
       targetMachine_(nullptr),
       isInitialized_(false),
@@ -103,6 +109,9 @@ llvm::Error AOTCompiler::setupTargetMachine() {
     // Setup target options
     llvm::TargetOptions targetOptions;
     targetOptions.EnableFastISel = true;
+    // One section per symbol lets the linker's --gc-sections drop what nothing references
+    targetOptions.FunctionSections = wholeProgram_;
+    targetOptions.DataSections = wholeProgram_;
     
     // Create target machine with appropriate optimization level
     llvm::CodeGenOptLevel codeGenOptLevel = getCodeGenOptLevel();
@@ -272,6 +281,14 @@ OptLevel AOTCompiler::getOptimizationLevel() const {
     return optimizationLevel_;
 }
 
+void AOTCompiler::setWholeProgram(bool enabled) {
+    wholeProgram_ = enabled;
+}
+
+bool AOTCompiler::isWholeProgram() const {
+    return wholeProgram_;
+}
+
 llvm::Error AOTCompiler::verifyModule(llvm::Module& module) {
     if (llvm::verifyModule(module, &llvm::errs())) {
         return llvm::createStringError(llvm::inconvertibleErrorCode(),
@@ -281,7 +298,10 @@ llvm::Error AOTCompiler::verifyModule(llvm::Module& module) {
 }
 
 llvm::Error AOTCompiler::applyOptimizations(llvm::Module& module) {
-    if (optimizationLevel_ == OptLevel::None) {
+    // Async functions are emitted as unsplit coroutines, which only the
+    // coroutine passes turn into code; unoptimized builds still need those
+    bool hasCoroutines = module.getFunction("llvm.coro.id") != nullptr;
+    if (optimizationLevel_ == OptLevel::None && !hasCoroutines && !wholeProgram_) {
         return llvm::Error::success();
     }
 
@@ -323,14 +343,36 @@ llvm::Error AOTCompiler::applyOptimizations(llvm::Module& module) {
         case OptLevel::Oz:
             llvmOptLevel = llvm::OptimizationLevel::Oz;
             break;
+        case OptLevel::None:
+            llvmOptLevel = llvm::OptimizationLevel::O0;
+            break;
         default:
             llvmOptLevel = llvm::OptimizationLevel::O2;
             break;
     }
 
-    // Build the optimization pipeline
-    llvm::ModulePassManager modulePassManager = 
-        passBuilder.buildPerModuleDefaultPipeline(llvmOptLevel);
+    // Under --whole-program codegen already decided which functions stay external (main and
+    // #[export]); every other definition, such as a global variable, is internal to the program
+    llvm::ModulePassManager modulePassManager;
+    if (wholeProgram_) {
+        modulePassManager.addPass(llvm::InternalizePass([](const llvm::GlobalValue& value) {
+            return llvm::isa<llvm::Function>(value);
+        }));
+    }
+    
+    // Build the optimization pipeline; the O0 one only lowers coroutines and always-inline calls
+    modulePassManager.addPass(llvmOptLevel == llvm::OptimizationLevel::O0
+        ? passBuilder.buildO0DefaultPipeline(llvmOptLevel)
+        : passBuilder.buildPerModuleDefaultPipeline(llvmOptLevel));
+
+    // With only main and exported functions external, whatever the pipeline
+    // left unreferenced is dead, and internal signatures can be rewritten
+    if (wholeProgram_) {
+        modulePassManager.addPass(llvm::GlobalDCEPass());
+        modulePassManager.addPass(llvm::createModuleToPostOrderCGSCCPassAdaptor(llvm::ArgumentPromotionPass()));
+        modulePassManager.addPass(llvm::DeadArgumentEliminationPass());
+        modulePassManager.addPass(llvm::GlobalDCEPass());
+    }
 
     // Run the optimization passes
     modulePassManager.run(module, moduleAnalysisManager);
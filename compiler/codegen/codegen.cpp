@@ -9,6 +9,7 @@
 
 #include "codegen/codegen.h"
 #include "codegen/aot_compiler.h"
+#include "codegen/debug_info.h"
 // JIT backend still experimental
 // #include "codegen/jit/jit_engine.h"
 #include "ast.h"
@@ -54,10 +55,10 @@ std::string toString(llvm::Error err) {
 * CONSTRUCTION AND LIFECYCLE
 ******************************/
 
-CodeGenerator::CodeGenerator(const std::string& moduleName) 
+CodeGenerator::CodeGenerator(const std::string& moduleName, const CodegenOptions& options) 
     : currentValue(nullptr) {
     // Initialize modular components
-    contextManager   = std::make_unique<ContextManager>(moduleName);
+    contextManager   = std::make_unique<ContextManager>(moduleName, options);
     valueMap         = std::make_unique<ValueMap>();
     errorReporter    = std::make_unique<CodegenErrorReporter>();
     
@@ -66,6 +67,11 @@ CodeGenerator::CodeGenerator(const std::string& moduleName)
     declGenerator    = std::make_unique<CGDecl>(*contextManager, *valueMap, *errorReporter);
     stmtGenerator    = std::make_unique<CGStmt>(*contextManager, *valueMap, *errorReporter, *exprGenerator);    
     
+    // Route nodes outside each generator's category to the generator that owns them
+    exprGenerator->setVisitors(exprGenerator.get(), declGenerator.get(), stmtGenerator.get());
+    declGenerator->setVisitors(exprGenerator.get(), declGenerator.get(), stmtGenerator.get());
+    stmtGenerator->setVisitors(exprGenerator.get(), declGenerator.get(), stmtGenerator.get());
+    
     // Initialize program orchestrator with specialized visitors
     programGenerator = std::make_unique<CGBase>(
         *contextManager, 
@@ -76,6 +82,7 @@ CodeGenerator::CodeGenerator(const std::string& moduleName)
     
     // Initialize AOT backend
     aotBackend = std::make_unique<AOTCompiler>();
+    aotBackend->setWholeProgram(options.wholeProgram);
     initializeAOTBackend();
     
     currentFunction = nullptr;
@@ -94,6 +101,26 @@ void CodeGenerator::generateIR(Program& program) {
     // Use the program orchestrator to generate IR using visitor pattern
     program.accept(*programGenerator);
     
+    if (contextManager->getOptions().heapProfile) {
+        exprGenerator->emitHeapProfileSites();
+    }
+    if (contextManager->getOptions().instrumentFunctions == CodegenOptions::FunctionInstrumentation::Hooks) {
+        declGenerator->emitInstrumentationTable();
+    }
+    if (contextManager->getOptions().framePointers) {
+        // Module constructors emitted above need the attribute too
+        llvm::Module* module = contextManager->getModule();
+        module->setFramePointer(llvm::FramePointerKind::All);
+        for (llvm::Function& function : *module) {
+            if (!function.isDeclaration()) {
+                function.addFnAttr("frame-pointer", "all");
+            }
+        }
+    }
+    if (DebugInfo* debugInfo = contextManager->getDebugInfo()) {
+        debugInfo->finalize();
+    }
+    
     // Verify the module - simplified approach
     if (llvm::verifyModule(*contextManager->getModule(), &llvm::errs())) {
         errorReporter->error(CodegenErrorType::InternalError, "Module verification failed");
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "codegen/context.h"
+#include "codegen/debug_info.h"
 
 // Disable LLVM warnings
 #ifdef _MSC_VER
@@ -31,9 +32,11 @@
 #include <llvm/Transforms/InstCombine/InstCombine.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/Transforms/Utils.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/TargetParser/Host.h>
 #include <llvm/TargetParser/Triple.h>
 
 #include <optional>
@@ -50,15 +53,23 @@ namespace codegen {
 
 /******************** CONSTRUCTION ********************/
 
-ContextManager::ContextManager(const std::string& moduleName)
+ContextManager::ContextManager(const std::string& moduleName, const CodegenOptions& options)
     : context(std::make_unique<llvm::LLVMContext>()),
       module(std::make_unique<llvm::Module>(moduleName, *context)),
-      builder(std::make_unique<llvm::IRBuilder<>>(*context)) {
+      builder(std::make_unique<llvm::IRBuilder<>>(*context)),
+      options(options) {
     
     initializeTargets();
     registerBuiltinFunctions();
+
+    if (options.debugInfo) {
+        debugInfo = std::make_unique<DebugInfo>(*module, *builder,
+                                                options.sourceFile.empty() ? moduleName : options.sourceFile);
+    }
 }
 
+ContextManager::~ContextManager() = default;
+
 /******************** ALLOCA HELPER ********************/
 
 llvm::Value* ContextManager::createEntryBlockAlloca(llvm::Function* function, 
@@ -68,6 +79,27 @@ llvm::Value* ContextManager::createEntryBlockAlloca(llvm::Function* function,
     return tmpBuilder.CreateAlloca(type, nullptr, varName);
 }
 
+/******************** MODULE HELPERS ********************/
+
+llvm::Constant* ContextManager::createPrivateString(const std::string& text, const std::string& name) {
+    llvm::Constant* data = llvm::ConstantDataArray::getString(*context, text);
+    auto* global = new llvm::GlobalVariable(*module, data->getType(), true,
+                                            llvm::GlobalValue::PrivateLinkage, data, name);
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    return global;
+}
+
+void ContextManager::addModuleInit(const std::string& name, llvm::FunctionCallee callee,
+                                   llvm::ArrayRef<llvm::Value*> args) {
+    llvm::Function* init = llvm::Function::Create(
+        llvm::FunctionType::get(llvm::Type::getVoidTy(*context), false),
+        llvm::GlobalValue::InternalLinkage, name, module.get());
+    llvm::IRBuilder<> initBuilder(llvm::BasicBlock::Create(*context, "entry", init));
+    initBuilder.CreateCall(callee, args);
+    initBuilder.CreateRetVoid();
+    llvm::appendToGlobalCtors(*module, init, 0);
+}
+
 /******************** IR HELPER ********************/
 
 void ContextManager::printIR() const {
@@ -80,6 +112,18 @@ void ContextManager::initializeTargets() {
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
     llvm::InitializeNativeTargetAsmParser();
+    
+    // Struct layout decisions need the host's type alignments, not LLVM's defaults
+    std::string triple = llvm::sys::getDefaultTargetTriple();
+    std::string error;
+    if (const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error)) {
+        std::unique_ptr<llvm::TargetMachine> machine(
+            target->createTargetMachine(triple, "generic", "", llvm::TargetOptions(), {}));
+        if (machine) {
+            module->setDataLayout(machine->createDataLayout());
+            module->setTargetTriple(triple);
+        }
+    }
 }
 
 void ContextManager::registerBuiltinFunctions() {    // Register printf function
@@ -0,0 +1,173 @@
+//===--- debug_info.cpp - Source-Level Debug Information --------*- C++ -*-===//
+//
+// Part of the RNR Project, under the Apache License v2.0 with LLVM Exceptions.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Implementation of debug information emission for EMLang code generation
+//===----------------------------------------------------------------------===//
+
+#include "codegen/debug_info.h"
+
+// Disable LLVM warnings
+#ifdef _MSC_VER
+    #pragma warning(push)
+    #pragma warning(disable: 4624) // destructor was implicitly deleted
+    #pragma warning(disable: 4244) // conversion warnings
+    #pragma warning(disable: 4267) // size_t conversion warnings
+#endif
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/BinaryFormat/Dwarf.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+
+// Re-enable warnings
+#ifdef _MSC_VER
+    #pragma warning(pop)
+#endif
+
+namespace emlang {
+namespace codegen {
+
+/******************** CONSTRUCTION ********************/
+
+DebugInfo::DebugInfo(llvm::Module& module, llvm::IRBuilder<>& builder, const std::string& sourceFile)
+    : module(module),
+      builder(builder),
+      diBuilder(std::make_unique<llvm::DIBuilder>(module)),
+      compileUnit(nullptr),
+      file(nullptr),
+      currentSubprogram(nullptr) {
+
+    // Record an absolute directory so tools find the source from any working directory
+    llvm::SmallString<256> path(sourceFile);
+    llvm::sys::fs::make_absolute(path);
+    file = diBuilder->createFile(llvm::sys::path::filename(path), llvm::sys::path::parent_path(path));
+    compileUnit = diBuilder->createCompileUnit(llvm::dwarf::DW_LANG_C, file, "emlang", false, "", 0);
+
+    module.addModuleFlag(llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+    if (llvm::Triple(llvm::sys::getDefaultTargetTriple()).isKnownWindowsMSVCEnvironment()) {
+        module.addModuleFlag(llvm::Module::Warning, "CodeView", 1);
+    } else {
+        module.addModuleFlag(llvm::Module::Warning, "Dwarf Version", 4);
+    }
+}
+
+/******************** FUNCTIONS ********************/
+
+void DebugInfo::beginFunction(llvm::Function* function, const std::string& returnType,
+                              const std::vector<std::string>& paramTypes, unsigned line) {
+    llvm::SmallVector<llvm::Metadata*, 8> signature;
+    signature.push_back(getType(returnType));
+    for (const auto& paramType : paramTypes) {
+        signature.push_back(getType(paramType));
+    }
+    llvm::DISubroutineType* functionType =
+        diBuilder->createSubroutineType(diBuilder->getOrCreateTypeArray(signature));
+
+    currentSubprogram = diBuilder->createFunction(
+        file, function->getName(), llvm::StringRef(), file, line, functionType, line,
+        llvm::DINode::FlagPrototyped, llvm::DISubprogram::SPFlagDefinition);
+    function->setSubprogram(currentSubprogram);
+
+    // Prologue code (parameter spills) belongs to the declaration line
+    setLocation(line, 0);
+}
+
+void DebugInfo::endFunction() {
+    if (currentSubprogram) {
+        diBuilder->finalizeSubprogram(currentSubprogram);
+    }
+    currentSubprogram = nullptr;
+    builder.SetCurrentDebugLocation(llvm::DebugLoc());
+}
+
+/******************** VARIABLES ********************/
+
+void DebugInfo::declareVariable(llvm::Value* storage, const std::string& name, const std::string& type,
+                                unsigned line, unsigned argNo) {
+    if (!currentSubprogram || !storage) {
+        return;
+    }
+    llvm::DIType* variableType = getType(type);
+    if (!variableType) {
+        return;
+    }
+
+    llvm::DILocalVariable* variable = argNo
+        ? diBuilder->createParameterVariable(currentSubprogram, name, argNo, file, line, variableType, true)
+        : diBuilder->createAutoVariable(currentSubprogram, name, file, line, variableType, true);
+    diBuilder->insertDeclare(storage, variable, diBuilder->createExpression(),
+                             getLocation(line, 0), builder.GetInsertBlock());
+}
+
+/******************** LOCATIONS ********************/
+
+void DebugInfo::setLocation(unsigned line, unsigned column) {
+    if (!currentSubprogram || line == 0) {
+        return;
+    }
+    builder.SetCurrentDebugLocation(getLocation(line, column));
+}
+
+llvm::DILocation* DebugInfo::getLocation(unsigned line, unsigned column) const {
+    if (!currentSubprogram) {
+        return nullptr;
+    }
+    return llvm::DILocation::get(module.getContext(), line, column, currentSubprogram);
+}
+
+/******************** FINALIZATION ********************/
+
+void DebugInfo::finalize() {
+    diBuilder->finalize();
+}
+
+/******************** TYPE MAPPING ********************/
+
+llvm::DIType* DebugInfo::getType(const std::string& typeName) {
+    auto cached = types.find(typeName);
+    if (cached != types.end()) {
+        return cached->second;
+    }
+
+    const uint64_t pointerBits = sizeof(void*) * 8;
+    llvm::DIType* type = nullptr;
+
+    if (!typeName.empty() && typeName.back() == '*') {
+        // Pointee first; void* gets a null pointee
+        llvm::DIType* pointee = getType(typeName.substr(0, typeName.size() - 1));
+        type = diBuilder->createPointerType(pointee, pointerBits, 0, {}, typeName);
+    }
+    else if (typeName == "int8") type = diBuilder->createBasicType(typeName, 8, llvm::dwarf::DW_ATE_signed);
+    else if (typeName == "int16") type = diBuilder->createBasicType(typeName, 16, llvm::dwarf::DW_ATE_signed);
+    else if (typeName == "int32" || typeName == "int") type = diBuilder->createBasicType(typeName, 32, llvm::dwarf::DW_ATE_signed);
+    else if (typeName == "int64") type = diBuilder->createBasicType(typeName, 64, llvm::dwarf::DW_ATE_signed);
+    else if (typeName == "size_t") type = diBuilder->createBasicType(typeName, pointerBits, llvm::dwarf::DW_ATE_signed);
+    else if (typeName == "uint8") type = diBuilder->createBasicType(typeName, 8, llvm::dwarf::DW_ATE_unsigned);
+    else if (typeName == "uint16") type = diBuilder->createBasicType(typeName, 16, llvm::dwarf::DW_ATE_unsigned);
+    else if (typeName == "uint32") type = diBuilder->createBasicType(typeName, 32, llvm::dwarf::DW_ATE_unsigned);
+    else if (typeName == "uint64") type = diBuilder->createBasicType(typeName, 64, llvm::dwarf::DW_ATE_unsigned);
+    else if (typeName == "usize_t") type = diBuilder->createBasicType(typeName, pointerBits, llvm::dwarf::DW_ATE_unsigned);
+    else if (typeName == "float") type = diBuilder->createBasicType(typeName, 32, llvm::dwarf::DW_ATE_float);
+    else if (typeName == "double" || typeName == "number") type = diBuilder->createBasicType(typeName, 64, llvm::dwarf::DW_ATE_float);
+    else if (typeName == "bool") type = diBuilder->createBasicType(typeName, 8, llvm::dwarf::DW_ATE_boolean);
+    else if (typeName == "char") type = diBuilder->createBasicType(typeName, 8, llvm::dwarf::DW_ATE_signed_char);
+    else if (typeName == "string" || typeName == "str") {
+        type = diBuilder->createPointerType(getType("char"), pointerBits, 0, {}, typeName);
+    }
+    // Vectors and tasks are handles to runtime objects, which have no debug description
+    else if (typeName.compare(0, 4, "vec<") == 0 || typeName.compare(0, 5, "task<") == 0) {
+        type = diBuilder->createPointerType(nullptr, pointerBits, 0, {}, typeName);
+    }
+
+    types[typeName] = type;
+    return type;
+}
+
+} // namespace codegen
+} // namespace emlang
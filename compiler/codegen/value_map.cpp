@@ -18,6 +18,7 @@
     #pragma warning(disable: 4267) // size_t conversion warnings
 #endif
 
+#include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/Type.h>
 
 // Re-enable warnings
@@ -62,7 +63,37 @@ llvm::Type* ValueMap::getLLVMType(const std::string& typeName, ContextManager& c
     if (typeName == "bool") return llvm::Type::getInt1Ty(ctx);
     if (typeName == "char") return llvm::Type::getInt8Ty(ctx);
     if (typeName == "str") return llvm::PointerType::get(ctx, 0);
-    if (typeName == "unit" || typeName == "()") return llvm::Type::getVoidTy(ctx);
+    if (typeName == "unit" || typeName == "()" || typeName == "void") return llvm::Type::getVoidTy(ctx);
+    if (typeName == "int") return llvm::Type::getInt32Ty(ctx);
+
+    // Vectors are handles to a runtime emlang_vec header
+    if (typeName.compare(0, 4, "vec<") == 0) return llvm::PointerType::get(ctx, 0);
+    
+    // Tasks are coroutine handles, the address of the async call's frame
+    if (typeName.compare(0, 5, "task<") == 0) return llvm::PointerType::get(ctx, 0);
+    
+    // Slices are passed by value as a {data, length} pair
+    if (typeName.size() > 2 && typeName.compare(0, 2, "[]") == 0) {
+        return llvm::StructType::get(ctx, {llvm::PointerType::get(ctx, 0), llvm::Type::getInt64Ty(ctx)});
+    }
+    
+    if (const StructLayout* layout = getStruct(typeName)) return layout->type;
+    
+    std::string elementTypeName;
+    uint64_t size = 0;
+    if (splitArrayType(typeName, elementTypeName, size)) {
+        const StructLayout* layout = getStruct(elementTypeName);
+        if (layout && layout->soa) {
+            // Struct of arrays: one [N x field] per field, in the struct's memory order
+            std::vector<llvm::Type*> columns;
+            for (llvm::Type* fieldType : layout->type->elements()) {
+                columns.push_back(llvm::ArrayType::get(fieldType, size));
+            }
+            return llvm::StructType::get(ctx, columns);
+        }
+        llvm::Type* elementType = getLLVMType(elementTypeName, contextManager);
+        return elementType ? llvm::ArrayType::get(elementType, size) : nullptr;
+    }
     
     // Default to number type for unrecognized numeric types
     if (typeName == "number") return llvm::Type::getDoubleTy(ctx);
@@ -72,16 +103,51 @@ llvm::Type* ValueMap::getLLVMType(const std::string& typeName, ContextManager& c
 }
 
 llvm::Type* ValueMap::getPointerType(const std::string& baseTypeName, ContextManager& contextManager) {
-    // Extract base type (remove *)
-    std::string cleanType = getPointeeType(baseTypeName);
-    
-    llvm::Type* baseType = getLLVMType(cleanType, contextManager);
-    if (baseType) {
-        return llvm::PointerType::get(baseType, 0);
+    // Pointers are opaque, so every pointee (including void) shares one pointer type
+    return llvm::PointerType::get(contextManager.getContext(), 0);
+}
+
+/******************** STRUCT LAYOUTS ********************/
+
+int ValueMap::StructLayout::fieldIndex(const std::string& fieldName) const {
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        if (fieldNames[i] == fieldName) {
+            return static_cast<int>(i);
+        }
     }
+    return -1;
+}
 
-    // Default to i8* for unknown types
-    return llvm::PointerType::get(contextManager.getContext(), 0);
+void ValueMap::addStruct(const std::string& name, StructLayout layout) {
+    structs[name] = std::move(layout);
+}
+
+const ValueMap::StructLayout* ValueMap::getStruct(const std::string& name) const {
+    auto it = structs.find(name);
+    return (it != structs.end()) ? &it->second : nullptr;
+}
+
+unsigned ValueMap::getAlignment(const std::string& typeName) const {
+    std::string elementTypeName;
+    uint64_t size = 0;
+    const StructLayout* layout = splitArrayType(typeName, elementTypeName, size) ? getStruct(elementTypeName)
+                                                                                 : getStruct(typeName);
+    return layout ? layout->alignment : 0;
+}
+
+bool ValueMap::splitArrayType(const std::string& typeName, std::string& elementType, uint64_t& size) {
+    size_t open = typeName.rfind('[');
+    if (open == std::string::npos || open == 0 || typeName.back() != ']' || open + 2 >= typeName.size() ||
+        typeName.compare(0, 2, "[]") == 0) {
+        return false;
+    }
+    std::string digits = typeName.substr(open + 1, typeName.size() - open - 2);
+    if (digits.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    elementType = typeName.substr(0, open);
+    size = std::stoull(digits);
+    return true;
 }
 
 /******************** POINTER TYPE HELPERS ********************/
@@ -104,7 +170,8 @@ llvm::Type* ValueMap::getElementTypeFromPointer(
 }
 
 std::string ValueMap::getPointeeType(const std::string& pointerType) {
-    size_t starPos = pointerType.find('*');
+    // Remove one level of indirection: int32** points to int32*
+    size_t starPos = pointerType.rfind('*');
     if (starPos != std::string::npos) {
         return pointerType.substr(0, starPos);
     }
@@ -178,5 +245,27 @@ void ValueMap::clearAll() {
     functions.clear();
 }
 
+/******************** RESTRICT POINTERS ********************/
+
+void ValueMap::addRestrictStorage(llvm::Value* storage, const std::string& name) {
+    if (restrictIndex.emplace(storage, restrictPointers.size()).second) {
+        restrictPointers.push_back({name, {}});
+    }
+}
+
+void ValueMap::recordRestrictAccess(llvm::Value* storage, llvm::Instruction* access) {
+    auto it = restrictIndex.find(storage);
+    if (it != restrictIndex.end() && access) {
+        restrictPointers[it->second].accesses.push_back(access);
+    }
+}
+
+std::vector<ValueMap::RestrictPointer> ValueMap::takeRestrictPointers() {
+    std::vector<RestrictPointer> pointers = std::move(restrictPointers);
+    restrictPointers.clear();
+    restrictIndex.clear();
+    return pointers;
+}
+
 } // namespace codegen
 } // namespace emlang
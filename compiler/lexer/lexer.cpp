@@ -1,7 +1,9 @@
 #include "lexer/lexer_core.h"
 #include "lexer/token.h"
+#include "emlang_utf8.h"
 #include <iostream>
 #include <cctype>
+#include <cstring>
 #include <map>
 #include <stdexcept>
 
@@ -17,14 +19,30 @@ void Lexer::advance() {
     if (currentChar == '\n') {
         line++;
         column = 1;
-    } else {
-        column++;
+    } else if ((static_cast<unsigned char>(currentChar) & 0xC0) != 0x80) {
+        column++; // Columns count codepoints, not continuation bytes
     }
     
     position++;
     currentChar = position < source.length() ? source[position] : '\0';
 }
 
+void Lexer::advanceBy(size_t count) {
+    size_t end = position + count < source.length() ? position + count : source.length();
+    const char* data = source.data();
+    
+    size_t lineStart = position;
+    while (const void* newline = std::memchr(data + lineStart, '\n', end - lineStart)) {
+        line++;
+        column = 1;
+        lineStart = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+    }
+    column += static_cast<size_t>(emlang_utf8_count(data + lineStart, static_cast<long long>(end - lineStart)));
+    
+    position = end;
+    currentChar = position < source.length() ? source[position] : '\0';
+}
+
 void Lexer::skipWhitespace() {
     while (currentChar != '\0' && std::isspace(currentChar) && currentChar != '\n') {
         advance();
@@ -58,7 +76,9 @@ std::string Lexer::readNumber() {
     std::string number;
     bool hasDot = false;
     
-    while (currentChar != '\0' && (std::isdigit(currentChar) || (currentChar == '.' && !hasDot))) {
+    // A dot followed by another dot is a range operator, not a decimal point
+    while (currentChar != '\0' && (std::isdigit(currentChar) || 
+           (currentChar == '.' && !hasDot && (position + 1 >= source.length() || source[position + 1] != '.')))) {
         if (currentChar == '.') {
             hasDot = true;
         }
@@ -150,7 +170,33 @@ std::string Lexer::readString() {
                     break;
             }
         } else {
-            str += currentChar;
+            // Copy the run up to the next quote or escape in one step,
+            // validating its UTF-8 in bulk rather than byte by byte
+            size_t runEnd = source.find_first_of(std::string("\"\\\0", 3), position);
+            if (runEnd == std::string::npos) {
+                runEnd = source.length();
+            }
+            size_t runLength = runEnd - position;
+            long long invalid = emlang_utf8_error_offset(source.data() + position, static_cast<long long>(runLength));
+            if (invalid >= 0) {
+                advanceBy(static_cast<size_t>(invalid));
+                std::string location = std::to_string(line) + ":" + std::to_string(column);
+                // Skip to the closing quote first: recovery resumes after it instead of
+                // lexing the rest of the literal as code
+                while (currentChar != '\0' && currentChar != '"') {
+                    if (currentChar == '\\') {
+                        advance();
+                        if (currentChar == '\0') {
+                            break;
+                        }
+                    }
+                    advance();
+                }
+                error("Invalid UTF-8 sequence in string literal at " + location);
+            }
+            str.append(source, position, runLength);
+            advanceBy(runLength);
+            continue;
         }
         advance();
     }
@@ -165,14 +211,26 @@ std::string Lexer::readString() {
 }
 
 std::string Lexer::readIdentifier() {
-    std::string identifier;
+    // Identifiers are ASCII letters, digits and '_' plus any non-ASCII
+    // codepoint; the non-ASCII bytes are validated as one run
+    size_t start = position;
+    size_t end = position;
+    while (end < source.length()) {
+        unsigned char c = static_cast<unsigned char>(source[end]);
+        if (!std::isalnum(c) && c != '_' && c < 0x80) {
+            break;
+        }
+        end++;
+    }
     
-    while (currentChar != '\0' && (std::isalnum(currentChar) || currentChar == '_')) {
-        identifier += currentChar;
-        advance();
+    long long invalid = emlang_utf8_error_offset(source.data() + start, static_cast<long long>(end - start));
+    if (invalid >= 0) {
+        advanceBy(static_cast<size_t>(invalid));
+        error("Invalid UTF-8 sequence in identifier");
     }
+    advanceBy(end - start);
     
-    return identifier;
+    return source.substr(start, end - start);
 }
 
 TokenType Lexer::getKeywordType(const std::string& identifier) {    
@@ -186,7 +244,7 @@ Token Lexer::nextToken() {
         size_t tokenColumn = column;
         
         // Skip whitespace
-        if (std::isspace(currentChar) && currentChar != '\n') {
+        if (std::isspace(static_cast<unsigned char>(currentChar)) && currentChar != '\n') {
             skipWhitespace();
             continue;
         }
@@ -236,7 +294,8 @@ Token Lexer::nextToken() {
         }
         
         // Identifiers and keywords
-        if (std::isalpha(currentChar) || currentChar == '_') {
+        if (std::isalpha(static_cast<unsigned char>(currentChar)) || currentChar == '_' ||
+            static_cast<unsigned char>(currentChar) >= 0x80) {
             std::string identifier = readIdentifier();
             
             // Special handling for boolean literals
@@ -287,6 +346,11 @@ Token Lexer::nextToken() {
                 advance(); advance();
                 return Token(TokenType::RIGHT_SHIFT, ">>", tokenLine, tokenColumn);
             }
+            // Range operator
+            else if (twoChar == "..") {
+                advance(); advance();
+                return Token(TokenType::DOT_DOT, "..", tokenLine, tokenColumn);
+            }
         }
         
         // Single-character tokens
@@ -323,6 +387,7 @@ Token Lexer::nextToken() {
             case '}': advance(); return Token(TokenType::RIGHT_BRACE, "}", tokenLine, tokenColumn);
             case '[': advance(); return Token(TokenType::LEFT_BRACKET, "[", tokenLine, tokenColumn);
             case ']': advance(); return Token(TokenType::RIGHT_BRACKET, "]", tokenLine, tokenColumn);
+            case '#': advance(); return Token(TokenType::HASH, "#", tokenLine, tokenColumn);
             
             // Invalid character handling
             default:
@@ -127,11 +127,26 @@ StatementPtr Parser::parseStatement() {
             return parseVariableDeclaration();
         }
         
-        if (match(TokenType::FUNCTION)) {
-            current--; // Back up to re-read the token
+        if (check(TokenType::FUNCTION) || check(TokenType::ASYNC)) {
             return parseFunctionDeclaration();
         }
         
+        if (check(TokenType::STRUCT)) {
+            return parseStructDeclaration();
+        }
+        
+        // Attributes attach to the declaration that follows them
+        if (check(TokenType::HASH)) {
+            auto attributes = parseAttributes();
+            if (check(TokenType::STRUCT)) {
+                return parseStructDeclaration(std::move(attributes));
+            }
+            if (!check(TokenType::FUNCTION) && !check(TokenType::ASYNC)) {
+                throw ParseError("Expected function or struct declaration after attributes", currentToken());
+            }
+            return parseFunctionDeclaration(std::move(attributes));
+        }
+        
         if (match(TokenType::EXTERN)) {
             current--; // Back up to re-read the token
             return parseExternFunctionDeclaration();
@@ -153,6 +168,11 @@ StatementPtr Parser::parseStatement() {
             return parseForStatement();
         }
         
+        if (match(TokenType::SWITCH)) {
+            current--; // Back up to re-read the token
+            return parseSwitchStatement();
+        }
+        
         // Return statements
         if (match(TokenType::RETURN)) {
             current--; // Back up to re-read the token
@@ -173,7 +193,7 @@ StatementPtr Parser::parseStatement() {
         // Default to expression statement - parse an expression followed by semicolon
         auto expr = parseExpression();
         consume(TokenType::SEMICOLON, "Expected ';' after expression");
-        return std::make_unique<ExpressionStmt>(std::move(expr));
+        return std::make_unique<ExpressionStmt>(std::move(expr), expr->line, expr->column);
         
     } catch (const ParseError& e) {
         synchronize();
@@ -193,8 +213,10 @@ StatementPtr Parser::parseVariableDeclaration() {
     
     Token name = consume(TokenType::IDENTIFIER, "Expected variable name");
     std::string type;
+    bool isRestrict = false;
     if (match(TokenType::COLON)) {
         type = parseType();
+        isRestrict = match(TokenType::RESTRICT);
     }
     
     ExpressionPtr initializer = nullptr;
@@ -236,13 +258,28 @@ StatementPtr Parser::parseVariableDeclaration() {
     
     consume(TokenType::SEMICOLON, "Expected ';' after variable declaration");
     
-    return std::make_unique<VariableDecl>(name.value, type, std::move(initializer), isConst, name.line, name.column);
+    return std::make_unique<VariableDecl>(name.value, type, std::move(initializer), isConst, name.line, name.column, isRestrict);
 }
 
-StatementPtr Parser::parseFunctionDeclaration() {
-    consume(TokenType::FUNCTION, "Expected 'function'");
+StatementPtr Parser::parseFunctionDeclaration(std::vector<Attribute> attributes) {
+    bool isAsync = match(TokenType::ASYNC);
+    consume(TokenType::FUNCTION, isAsync ? "Expected 'function' after 'async'" : "Expected 'function'");
     Token name = consume(TokenType::IDENTIFIER, "Expected function name");
     
+    // Type parameters: <T, U: numeric>
+    std::vector<TypeParameter> typeParameters;
+    if (match(TokenType::LESS_THAN)) {
+        do {
+            Token typeParam = consume(TokenType::IDENTIFIER, "Expected type parameter name");
+            std::string constraint;
+            if (match(TokenType::COLON)) {
+                constraint = consume(TokenType::IDENTIFIER, "Expected constraint after ':'").value;
+            }
+            typeParameters.emplace_back(typeParam.value, constraint);
+        } while (match(TokenType::COMMA));
+        consume(TokenType::GREATER_THAN, "Expected '>' after type parameters");
+    }
+    
     consume(TokenType::LEFT_PAREN, "Expected '(' after function name");
     auto parameters = parseParameterList();
     consume(TokenType::RIGHT_PAREN, "Expected ')' after parameters");
@@ -253,7 +290,10 @@ StatementPtr Parser::parseFunctionDeclaration() {
     
     auto body = parseBlockStatement();
     
-    return std::make_unique<FunctionDecl>(name.value, std::move(parameters), returnType, std::move(body), name.line, name.column);
+    auto decl = std::make_unique<FunctionDecl>(name.value, std::move(parameters), returnType, std::move(body), false, isAsync, false, name.line, name.column);
+    decl->attributes = std::move(attributes);
+    decl->typeParameters = std::move(typeParameters);
+    return decl;
 }
 
 StatementPtr Parser::parseExternFunctionDeclaration() {
@@ -280,6 +320,35 @@ StatementPtr Parser::parseExternFunctionDeclaration() {
     return std::make_unique<ExternFunctionDecl>(name.value, std::move(externParams), returnType, name.line, name.column);
 }
 
+StatementPtr Parser::parseStructDeclaration(std::vector<Attribute> attributes) {
+    consume(TokenType::STRUCT, "Expected 'struct'");
+    Token name = consume(TokenType::IDENTIFIER, "Expected struct name");
+    consume(TokenType::LEFT_BRACE, "Expected '{' after struct name");
+    
+    std::vector<StructField> fields;
+    while (match(TokenType::NEWLINE)) {}
+    while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+        Token fieldName = consume(TokenType::IDENTIFIER, "Expected field name");
+        consume(TokenType::COLON, "Expected ':' after field name");
+        std::string type = parseType();
+        fields.push_back({fieldName.value, type, fieldName.line, fieldName.column});
+        
+        // A comma, a line break or the closing brace ends a field
+        bool separated = match(TokenType::COMMA);
+        while (match(TokenType::NEWLINE)) {
+            separated = true;
+        }
+        if (!separated && !check(TokenType::RIGHT_BRACE)) {
+            throw ParseError("Expected ',' or newline after struct field", currentToken());
+        }
+    }
+    consume(TokenType::RIGHT_BRACE, "Expected '}' after struct fields");
+    
+    auto decl = std::make_unique<StructDecl>(name.value, std::move(fields), name.line, name.column);
+    decl->attributes = std::move(attributes);
+    return decl;
+}
+
 /* RESERVED - IMPORT_DECL */
 
 /****************************************
@@ -288,9 +357,7 @@ StatementPtr Parser::parseExternFunctionDeclaration() {
 
 StatementPtr Parser::parseIfStatement() {
     Token ifToken = consume(TokenType::IF, "Expected 'if'");
-    consume(TokenType::LEFT_PAREN, "Expected '(' after 'if'");
-    auto condition = parseExpression();
-    consume(TokenType::RIGHT_PAREN, "Expected ')' after if condition");
+    auto condition = parseCondition("if");
     
     auto thenBranch = parseStatement();
     
@@ -304,21 +371,127 @@ StatementPtr Parser::parseIfStatement() {
 
 StatementPtr Parser::parseWhileStatement() {
     Token whileToken = consume(TokenType::WHILE, "Expected 'while'");
-    consume(TokenType::LEFT_PAREN, "Expected '(' after 'while'");
-    auto condition = parseExpression();
-    consume(TokenType::RIGHT_PAREN, "Expected ')' after while condition");
+    auto condition = parseCondition("while");
     
     auto body = parseStatement();
     
     return std::make_unique<WhileStmt>(std::move(condition), std::move(body), whileToken.line, whileToken.column);
 }
 
+ExpressionPtr Parser::parseCondition(const std::string& keyword) {
+    // A branch hint call already brackets its condition: `if likely(x > 0)`. It may
+    // also be the first operand of a longer condition: `if likely(a) && b`
+    if (check(TokenType::IDENTIFIER) &&
+        (currentToken().value == "likely" || currentToken().value == "unlikely")) {
+        return parseExpression();
+    }
+    consume(TokenType::LEFT_PAREN, "Expected '(' after '" + keyword + "'");
+    auto condition = parseExpression();
+    consume(TokenType::RIGHT_PAREN, "Expected ')' after " + keyword + " condition");
+    return condition;
+}
+
 StatementPtr Parser::parseForStatement() {
-    // For now, just consume the token and return a placeholder
-    // TODO: Implement for loop parsing
-    consume(TokenType::FOR, "Expected 'for'");
-    error("For loops not yet implemented");
-    return nullptr;
+    Token forToken = consume(TokenType::FOR, "Expected 'for'");
+    
+    // C-style form: for (init; condition; update), each clause optional
+    if (match(TokenType::LEFT_PAREN)) {
+        StatementPtr initializer = nullptr;
+        if (check(TokenType::LET) || check(TokenType::CONST)) {
+            initializer = parseVariableDeclaration();
+        } else if (!match(TokenType::SEMICOLON)) {
+            initializer = parseExpressionStatement();
+        }
+        ExpressionPtr condition = check(TokenType::SEMICOLON) ? nullptr : parseExpression();
+        consume(TokenType::SEMICOLON, "Expected ';' after for condition");
+        ExpressionPtr increment = check(TokenType::RIGHT_PAREN) ? nullptr : parseExpression();
+        consume(TokenType::RIGHT_PAREN, "Expected ')' after for clauses");
+        
+        auto body = parseStatement();
+        
+        return std::make_unique<ForStmt>(std::move(initializer), std::move(condition), std::move(increment),
+                                         std::move(body), forToken.line, forToken.column);
+    }
+    
+    // `in` and `step` are contextual, so they stay usable as identifiers
+    Token variable = consume(TokenType::IDENTIFIER, "Expected loop variable after 'for'");
+    if (!check(TokenType::IDENTIFIER) || currentToken().value != "in") {
+        throw ParseError("Expected 'in' after loop variable", currentToken());
+    }
+    advance();
+    
+    auto start = parseExpression();
+    consume(TokenType::DOT_DOT, "Expected '..' in for range");
+    auto end = parseExpression();
+    
+    ExpressionPtr step = nullptr;
+    if (check(TokenType::IDENTIFIER) && currentToken().value == "step") {
+        advance();
+        step = parseExpression();
+    }
+    
+    auto body = parseStatement();
+    
+    return std::make_unique<ForStmt>(variable.value, std::move(start), std::move(end), std::move(step), std::move(body),
+                                     forToken.line, forToken.column);
+}
+
+StatementPtr Parser::parseSwitchStatement() {
+    Token switchToken = consume(TokenType::SWITCH, "Expected 'switch'");
+    consume(TokenType::LEFT_PAREN, "Expected '(' after 'switch'");
+    auto discriminant = parseExpression();
+    consume(TokenType::RIGHT_PAREN, "Expected ')' after switch value");
+    consume(TokenType::LEFT_BRACE, "Expected '{' after switch value");
+    
+    std::vector<SwitchCase> cases;
+    SwitchCase arm{{}, false, nullptr, 0, 0};
+    while (match(TokenType::NEWLINE)) {}
+    while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+        // Labels accumulate until the first statement of the arm
+        Token labelToken = currentToken();
+        if (match(TokenType::CASE)) {
+            do {
+                arm.labels.push_back(parseExpression());
+            } while (match(TokenType::COMMA));
+        } else if (match(TokenType::DEFAULT)) {
+            arm.isDefault = true;
+        } else {
+            throw ParseError("Expected 'case' or 'default' in switch", currentToken());
+        }
+        consume(TokenType::COLON, "Expected ':' after case label");
+        if (arm.line == 0) {
+            arm.line = labelToken.line;
+            arm.column = labelToken.column;
+        }
+        
+        while (match(TokenType::NEWLINE)) {}
+        if (check(TokenType::CASE) || check(TokenType::DEFAULT)) {
+            continue;
+        }
+        
+        std::vector<StatementPtr> statements;
+        while (!check(TokenType::CASE) && !check(TokenType::DEFAULT) && 
+               !check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+            auto stmt = parseStatement();
+            if (stmt) {
+                statements.push_back(std::move(stmt));
+            }
+            while (match(TokenType::NEWLINE)) {}
+        }
+        arm.body = std::make_unique<BlockStmt>(std::move(statements), arm.line, arm.column);
+        cases.push_back(std::move(arm));
+        arm = SwitchCase{{}, false, nullptr, 0, 0};
+    }
+    
+    // Trailing labels with no statements still select an (empty) arm
+    if (!arm.labels.empty() || arm.isDefault) {
+        arm.body = std::make_unique<BlockStmt>(std::vector<StatementPtr>(), arm.line, arm.column);
+        cases.push_back(std::move(arm));
+    }
+    
+    consume(TokenType::RIGHT_BRACE, "Expected '}' after switch cases");
+    
+    return std::make_unique<SwitchStmt>(std::move(discriminant), std::move(cases), switchToken.line, switchToken.column);
 }
 
 StatementPtr Parser::parseReturnStatement() {
@@ -366,7 +539,7 @@ ExpressionPtr Parser::parseExpression() {
         Token op = tokens[current - 1];
         ExpressionPtr right = parseExpression(); // Right-associative, recursive call
         
-        return std::make_unique<AssignmentExpr>(std::move(expr), std::move(right));
+        return std::make_unique<AssignmentExpr>(std::move(expr), std::move(right), op.line, op.column);
     }
     
     return expr;
@@ -451,6 +624,12 @@ ExpressionPtr Parser::parseUnary() {
         return std::make_unique<UnaryOpExpr>(tokenToBinOp(op), std::move(right), op.line, op.column);
     }
     
+    if (match(TokenType::AWAIT)) {
+        Token op = tokens[current - 1];
+        auto task = parseUnary();
+        return std::make_unique<AwaitExpr>(std::move(task), op.line, op.column);
+    }
+    
 #ifdef EMLANG_FEATURE_POINTERS
     // Pointer dereference (*ptr)
     if (match(TokenType::MULTIPLY)) {
@@ -459,8 +638,8 @@ ExpressionPtr Parser::parseUnary() {
         return std::make_unique<DereferenceExpr>(std::move(right), op.line, op.column);
     }
     
-    // Address-of operator (&var)
-    if (match(TokenType::AMPERSAND)) {
+    // Address-of operator (&var); the lexer reads every & as BITWISE_AND
+    if (match(TokenType::BITWISE_AND)) {
         Token op = tokens[current - 1];
         auto right = parseUnary();
         return std::make_unique<AddressOfExpr>(std::move(right), op.line, op.column);
@@ -568,6 +747,13 @@ ExpressionPtr Parser::parsePrimary() {
 std::string Parser::parseType() {
     std::string baseType;
     
+    // Slice: []T
+    if (check(TokenType::LEFT_BRACKET) && peekToken().type == TokenType::RIGHT_BRACKET) {
+        advance();
+        advance();
+        return "[]" + parseType();
+    }
+    
     // Check for primitive types
     if (check(TokenType::INT)) {
         advance();
@@ -588,15 +774,35 @@ std::string Parser::parseType() {
         // Custom types (structs, classes, etc.)
         Token typeToken = advance();
         baseType = typeToken.value;
+
+        // Growable vector: vec<T>
+        if (baseType == "vec" && match(TokenType::LESS_THAN)) {
+            std::string elementType = parseType();
+            consumeTypeArgumentClose("Expected '>' after vector element type");
+            baseType = "vec<" + elementType + ">";
+        }
+        // Pending result of an async call: task<T>
+        else if (baseType == "task" && match(TokenType::LESS_THAN)) {
+            std::string resultType = parseType();
+            consumeTypeArgumentClose("Expected '>' after task result type");
+            baseType = "task<" + resultType + ">";
+        }
     } else {
         error("Expected type name");
         throw ParseError("Expected type name", currentToken());
     }
     
+    // Fixed-size array: T[N]
+    if (check(TokenType::LEFT_BRACKET) && peekToken().type == TokenType::INT) {
+        advance();
+        Token size = advance();
+        consume(TokenType::RIGHT_BRACKET, "Expected ']' after array size");
+        baseType += "[" + size.value + "]";
+    }
+    
     //! Experimental feature: Pointers
     // Check for pointer modifiers (C-style: int32*, char**, etc.)
     while (check(TokenType::MULTIPLY)) {
-        error("Pointer types are not supported in this version of EMLang", currentToken().line, currentToken().column);
         advance();
         baseType += "*";
     }
@@ -604,6 +810,18 @@ std::string Parser::parseType() {
     return baseType;
 }
 
+void Parser::consumeTypeArgumentClose(const std::string& message) {
+    // In vec<vec<int32>> the lexer reads the two closing brackets as one >>
+    if (check(TokenType::RIGHT_SHIFT)) {
+        Token& token = tokens[current];
+        token.type = TokenType::GREATER_THAN;
+        token.value = ">";
+        token.column++;
+        return;
+    }
+    consume(TokenType::GREATER_THAN, message);
+}
+
 std::vector<Parameter> Parser::parseParameterList() {
     std::vector<Parameter> parameters;
     
@@ -612,14 +830,45 @@ std::vector<Parameter> Parser::parseParameterList() {
             Token name = consume(TokenType::IDENTIFIER, "Expected parameter name");
             consume(TokenType::COLON, "Expected ':' after parameter name");
             std::string type = parseType();
+            bool isRestrict = match(TokenType::RESTRICT);
             
-            parameters.push_back({name.value, type});
+            parameters.push_back({name.value, type, isRestrict});
         } while (match(TokenType::COMMA));
     }
     
     return parameters;
 }
 
+std::vector<Attribute> Parser::parseAttributes() {
+    std::vector<Attribute> attributes;
+    
+    while (match(TokenType::HASH)) {
+        consume(TokenType::LEFT_BRACKET, "Expected '[' after '#'");
+        do {
+            Token name = consume(TokenType::IDENTIFIER, "Expected attribute name");
+            std::vector<std::string> args;
+            if (match(TokenType::LEFT_PAREN)) {
+                if (!check(TokenType::RIGHT_PAREN)) {
+                    do {
+                        if (!match(TokenType::IDENTIFIER) && !match(TokenType::INT) && !match(TokenType::STR) &&
+                            !match(TokenType::DEFAULT)) {
+                            throw ParseError("Expected attribute argument", currentToken());
+                        }
+                        args.push_back(tokens[current - 1].value);
+                    } while (match(TokenType::COMMA));
+                }
+                consume(TokenType::RIGHT_PAREN, "Expected ')' after attribute arguments");
+            }
+            attributes.emplace_back(name.value, std::move(args), name.line, name.column);
+        } while (match(TokenType::COMMA));
+        consume(TokenType::RIGHT_BRACKET, "Expected ']' after attribute");
+        
+        while (match(TokenType::NEWLINE)) {}
+    }
+    
+    return attributes;
+}
+
 std::vector<ExpressionPtr> Parser::parseArgumentList() {
     std::vector<ExpressionPtr> arguments;
     
@@ -669,14 +918,15 @@ ExpressionPtr Parser::parseArrayLiteral() {
 }
 
 ExpressionPtr Parser::parseObjectLiteral() {
-    consume(TokenType::LEFT_BRACE, "Expected '{' to start object literal");
+    Token brace = consume(TokenType::LEFT_BRACE, "Expected '{' to start object literal");
     
     std::vector<ObjectField> fields;
+    while (match(TokenType::NEWLINE)) {}
     
     // Handle empty object
     if (check(TokenType::RIGHT_BRACE)) {
         advance(); // consume '}'
-        return std::make_unique<ObjectExpr>(std::move(fields));
+        return std::make_unique<ObjectExpr>(std::move(fields), brace.line, brace.column);
     }
     
     // Parse object fields
@@ -697,10 +947,17 @@ ExpressionPtr Parser::parseObjectLiteral() {
         ExpressionPtr value = parseExpression();
         
         fields.emplace_back(key, std::move(value));
-    } while (match(TokenType::COMMA));
+        
+        // Fields may be split across lines
+        while (match(TokenType::NEWLINE)) {}
+        if (!match(TokenType::COMMA)) {
+            break;
+        }
+        while (match(TokenType::NEWLINE)) {}
+    } while (!check(TokenType::RIGHT_BRACE));
     
     consume(TokenType::RIGHT_BRACE, "Expected '}' after object fields");    
-    return std::make_unique<ObjectExpr>(std::move(fields));
+    return std::make_unique<ObjectExpr>(std::move(fields), brace.line, brace.column);
 }
 
 /****************************************
@@ -733,7 +990,20 @@ ExpressionPtr Parser::parseMemberAccess(ExpressionPtr object) {
 ExpressionPtr Parser::parseIndexAccess(ExpressionPtr array) {
     consume(TokenType::LEFT_BRACKET, "Expected '[' for index access");
     
-    ExpressionPtr index = parseExpression();
+    ExpressionPtr index = check(TokenType::DOT_DOT) ? nullptr : parseExpression();
+    
+    // Sub-slice: a[start..end], either bound may be left out
+    if (match(TokenType::DOT_DOT)) {
+        ExpressionPtr end = check(TokenType::RIGHT_BRACKET) ? nullptr : parseExpression();
+        Token closeBracket = consume(TokenType::RIGHT_BRACKET, "Expected ']' after slice range");
+        return std::make_unique<SliceExpr>(
+            std::move(array), 
+            std::move(index), 
+            std::move(end),
+            closeBracket.line, 
+            closeBracket.column
+        );
+    }
     if (!index) {
         error("Expected index expression");
         return nullptr;
@@ -873,11 +1143,15 @@ void Parser::synchronize() {
         if (tokens[current - 1].type == TokenType::SEMICOLON) return;
         switch (currentToken().type) {
             case TokenType::FUNCTION:
+            case TokenType::ASYNC:
+            case TokenType::HASH:
+            case TokenType::STRUCT:
             case TokenType::LET:
             case TokenType::CONST:
             case TokenType::FOR:
             case TokenType::IF:
             case TokenType::WHILE:
+            case TokenType::SWITCH:
             case TokenType::RETURN:
                 return;
             default:
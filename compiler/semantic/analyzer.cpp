@@ -3,12 +3,17 @@
 #include "semantic/type_checker.h"
 #include "../../include/builtins.h"
 #include "ast.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <set>
 
 namespace emlang {
 
 
-Analyzer::Analyzer() : currentScope(nullptr), hasErrors(false) {
+Analyzer::Analyzer() : currentScope(nullptr), currentFunctionAsync(false), hasErrors(false), loopDepth(0),
+                       awaitOperand(nullptr) {
     // Initialize global scope
     scopes.push_back(std::make_unique<Scope>(nullptr));
     currentScope = scopes.back().get();
@@ -28,6 +33,16 @@ void Analyzer::enterScope() {
 
 void Analyzer::exitScope() {
     if (scopes.size() > 1) { // Don't exit global scope
+        // Forget the task variables that die with this scope before their symbols are freed
+        auto inExitingScope = [this](const Symbol* symbol) {
+            return currentScope->existsInCurrentScope(symbol->name) && currentScope->lookup(symbol->name) == symbol;
+        };
+        for (auto it = awaitedTasks.begin(); it != awaitedTasks.end();) {
+            it = inExitingScope(it->first) ? awaitedTasks.erase(it) : std::next(it);
+        }
+        for (auto it = taskLoopDepths.begin(); it != taskLoopDepths.end();) {
+            it = inExitingScope(it->first) ? taskLoopDepths.erase(it) : std::next(it);
+        }
         scopes.pop_back();
         currentScope = scopes.back().get();
     }
@@ -49,6 +64,570 @@ std::string Analyzer::getExpressionType(Expression& expr) {
     return resultType;
 }
 
+bool Analyzer::analyzeVecIntrinsic(FunctionCallExpr& node) {
+    if (!isVecIntrinsic(node.functionName)) {
+        return false;
+    }
+    
+    const std::string& name = node.functionName;
+    size_t expectedArgs = (name == "vec_push" || name == "vec_reserve") ? 2 : 1;
+    if (node.arguments.size() != expectedArgs) {
+        error(name + " expects " + std::to_string(expectedArgs) + " argument(s), got " +
+              std::to_string(node.arguments.size()), node.line, node.column);
+        currentExpressionType = "error";
+        return true;
+    }
+    
+    std::string vecType = getExpressionType(*node.arguments[0]);
+    if (!TypeChecker::isVecType(vecType)) {
+        error(name + " requires a vector argument, got: " + vecType, node.line, node.column);
+        currentExpressionType = "error";
+        return true;
+    }
+    std::string elementType = TypeChecker::getVecElementType(vecType);
+    
+    if (name == "vec_push") {
+        std::string valueType = getExpressionType(*node.arguments[1]);
+        if (!TypeChecker::isCompatibleType(elementType, valueType)) {
+            error("Cannot push " + valueType + " onto " + vecType, node.line, node.column);
+        }
+        currentExpressionType = "void";
+    } else if (name == "vec_reserve") {
+        std::string countType = getExpressionType(*node.arguments[1]);
+        if (!TypeChecker::isSignedInteger(countType) && !TypeChecker::isUnsignedInteger(countType)) {
+            error("vec_reserve capacity must be an integer type, got: " + countType, node.line, node.column);
+        }
+        currentExpressionType = "void";
+    } else if (name == "vec_len") {
+        currentExpressionType = "int64";
+    } else if (name == "vec_pop") {
+        currentExpressionType = elementType;
+    } else {
+        currentExpressionType = "void";
+    }
+    return true;
+}
+
+bool Analyzer::analyzeHintIntrinsic(FunctionCallExpr& node) {
+    if (!isHintIntrinsic(node.functionName)) {
+        return false;
+    }
+    
+    const std::string& name = node.functionName;
+    size_t expectedArgs = name == "prefetch" ? 3 : 1;
+    if (node.arguments.size() != expectedArgs) {
+        error(name + " expects " + std::to_string(expectedArgs) + " argument(s), got " +
+              std::to_string(node.arguments.size()), node.line, node.column);
+        currentExpressionType = "error";
+        return true;
+    }
+    
+    if (name != "prefetch") {
+        std::string conditionType = getExpressionType(*node.arguments[0]);
+        if (!TypeChecker::isBooleanType(conditionType) && !TypeChecker::isSignedInteger(conditionType) &&
+            !TypeChecker::isUnsignedInteger(conditionType)) {
+            error(name + " requires a bool or integer condition, got: " + conditionType, node.line, node.column);
+        }
+        currentExpressionType = "bool";
+        return true;
+    }
+    
+    std::string addressType = getExpressionType(*node.arguments[0]);
+    if (!TypeChecker::isPointerType(addressType) && !TypeChecker::isStringType(addressType)) {
+        error("prefetch address must be a pointer or string, got: " + addressType, node.line, node.column);
+    }
+    // llvm.prefetch takes rw and locality as immediates
+    static const char* const operandNames[] = {"rw", "locality"};
+    static const int operandLimits[] = {1, 3};
+    for (size_t i = 0; i < 2; ++i) {
+        Expression& operand = *node.arguments[i + 1];
+        getExpressionType(operand);
+        auto* literal = dynamic_cast<LiteralExpr*>(&operand);
+        int value = -1;
+        if (literal && literal->literalType == LiteralType::INT) {
+            try {
+                value = std::stoi(literal->value);
+            } catch (const std::exception&) {
+                value = -1;
+            }
+        }
+        if (value < 0 || value > operandLimits[i]) {
+            error(std::string("prefetch ") + operandNames[i] + " must be an integer constant from 0 to " +
+                  std::to_string(operandLimits[i]), operand.line, operand.column);
+        }
+    }
+    currentExpressionType = "void";
+    return true;
+}
+
+void Analyzer::checkFunctionAttributes(FunctionDecl& node) {
+    std::set<std::string> seen;
+    for (const auto& attribute : node.attributes) {
+        const std::string& name = attribute.name;
+        if (!seen.insert(name).second) {
+            error("Duplicate attribute: " + name, attribute.line, attribute.column);
+            continue;
+        }
+        
+        if (name == "inline") {
+            if (attribute.args.size() > 1 ||
+                (attribute.args.size() == 1 && attribute.args[0] != "always" && attribute.args[0] != "never")) {
+                error("inline takes no argument, 'always' or 'never'", attribute.line, attribute.column);
+            }
+        } else if (name == "opt") {
+            static const std::set<std::string> levels = {"0", "1", "2", "3", "s", "z"};
+            if (attribute.args.size() != 1 || !levels.count(attribute.args[0])) {
+                error("opt expects one of 0, 1, 2, 3, s, z", attribute.line, attribute.column);
+            }
+        } else if (name == "target_clones") {
+            static const std::set<std::string> features = {
+                "sse3", "ssse3", "sse4.1", "sse4.2", "popcnt", "aes", "avx", "f16c", "fma", "bmi", "bmi2",
+                "lzcnt", "avx2", "avx512f", "avx512dq", "avx512bw", "avx512vl"
+            };
+            std::set<std::string> targets;
+            for (const auto& target : attribute.args) {
+                if (!targets.insert(target).second) {
+                    error("Duplicate clone target: " + target, attribute.line, attribute.column);
+                    continue;
+                }
+                if (target == "default") {
+                    continue;
+                }
+                // A target is one feature or several joined with '+', e.g. "avx2+fma"
+                size_t start = 0;
+                size_t end;
+                do {
+                    end = target.find('+', start);
+                    std::string feature = target.substr(start, end == std::string::npos ? end : end - start);
+                    if (!features.count(feature)) {
+                        error("Unknown clone target feature: " + feature, attribute.line, attribute.column);
+                    }
+                    start = end + 1;
+                } while (end != std::string::npos);
+            }
+            if (!targets.count("default") || targets.size() < 2) {
+                error("target_clones needs \"default\" and at least one feature target", attribute.line, attribute.column);
+            }
+        } else if (name == "noinline" || name == "hot" || name == "cold" || name == "pure" || name == "optnone" ||
+                   name == "export" || name == "fast_math") {
+            if (!attribute.args.empty()) {
+                error(name + " takes no arguments", attribute.line, attribute.column);
+            }
+        } else {
+            error("Unknown function attribute: " + name, attribute.line, attribute.column);
+        }
+    }
+    
+    const Attribute* inlineAttr = node.findAttribute("inline");
+    const Attribute* optAttr = node.findAttribute("opt");
+    bool alwaysInline = inlineAttr && !inlineAttr->args.empty() && inlineAttr->args[0] == "always";
+    bool optNone = node.findAttribute("optnone") || (optAttr && !optAttr->args.empty() && optAttr->args[0] == "0");
+    if (alwaysInline && (node.findAttribute("noinline") || optNone)) {
+        error("inline(always) conflicts with noinline and optnone in function: " + node.name, node.line, node.column);
+    }
+    if (alwaysInline && node.findAttribute("target_clones")) {
+        error("inline(always) conflicts with target_clones in function: " + node.name, node.line, node.column);
+    }
+    if (node.findAttribute("hot") && node.findAttribute("cold")) {
+        error("Function cannot be both hot and cold: " + node.name, node.line, node.column);
+    }
+    if (node.findAttribute("optnone") && optAttr) {
+        error("optnone conflicts with opt in function: " + node.name, node.line, node.column);
+    }
+    // An async function allocates its frame, and its clones could not share one task ABI
+    if (node.isAsync && (node.findAttribute("pure") || node.findAttribute("target_clones"))) {
+        error("pure and target_clones do not apply to async function: " + node.name, node.line, node.column);
+    }
+}
+
+void Analyzer::checkStructAttributes(StructDecl& node) {
+    std::set<std::string> seen;
+    for (const auto& attribute : node.attributes) {
+        const std::string& name = attribute.name;
+        if (!seen.insert(name).second) {
+            error("Duplicate attribute: " + name, attribute.line, attribute.column);
+            continue;
+        }
+        
+        if (name == "align") {
+            unsigned long alignment = 0;
+            if (attribute.args.size() == 1 &&
+                attribute.args[0].find_first_not_of("0123456789") == std::string::npos) {
+                alignment = std::stoul(attribute.args[0]);
+            }
+            if (alignment == 0 || alignment > 4096 || (alignment & (alignment - 1)) != 0) {
+                error("align expects a power of two up to 4096", attribute.line, attribute.column);
+            }
+        } else if (name == "packed" || name == "reorder" || name == "soa") {
+            if (!attribute.args.empty()) {
+                error(name + " takes no arguments", attribute.line, attribute.column);
+            }
+        } else {
+            error("Unknown struct attribute: " + name, attribute.line, attribute.column);
+        }
+    }
+    
+    if (node.findAttribute("packed") && node.findAttribute("reorder")) {
+        error("packed structs have no padding to remove, reorder is redundant in struct: " + node.name,
+              node.line, node.column);
+    }
+}
+
+void Analyzer::checkStructLiteral(const std::string& structName, ObjectExpr& node) {
+    StructDecl* decl = structs[structName];
+    std::set<std::string> initialized;
+    for (auto& field : node.fields) {
+        std::string valueType = getExpressionType(*field.value);
+        const StructField* target = nullptr;
+        for (const auto& declared : decl->fields) {
+            if (declared.name == field.key) {
+                target = &declared;
+                break;
+            }
+        }
+        if (!target) {
+            error("Struct '" + structName + "' has no field '" + field.key + "'", node.line, node.column);
+            continue;
+        }
+        if (!initialized.insert(field.key).second) {
+            error("Field '" + field.key + "' initialized twice", node.line, node.column);
+            continue;
+        }
+        if (!TypeChecker::isCompatibleType(target->type, valueType)) {
+            error("Type mismatch for field '" + field.key + "': expected " + target->type + ", got " + valueType,
+                  node.line, node.column);
+        }
+    }
+}
+
+void Analyzer::checkArrayLiteral(const std::string& arrayType, ArrayExpr& node) {
+    std::string elementType = TypeChecker::getArrayElementType(arrayType);
+    uint64_t size = TypeChecker::getArraySize(arrayType);
+    if (node.elements.size() != size) {
+        error("Array literal has " + std::to_string(node.elements.size()) + " elements, expected " +
+              std::to_string(size) + " for " + arrayType, node.line, node.column);
+    }
+    for (auto& element : node.elements) {
+        std::string valueType = getExpressionType(*element);
+        // Numeric literals, also negated ones, take the element type
+        Expression* operand = element.get();
+        if (auto* unary = dynamic_cast<UnaryOpExpr*>(operand)) {
+            operand = unary->operator_ == BinaryOpExpr::BinOp::SUB ? unary->operand.get() : nullptr;
+        }
+        auto* literal = dynamic_cast<LiteralExpr*>(operand);
+        bool integerLiteral = literal && literal->literalType == LiteralType::INT &&
+                              (TypeChecker::isSignedInteger(elementType) ||
+                               (TypeChecker::isUnsignedInteger(elementType) && operand == element.get()));
+        bool floatLiteral = literal && literal->literalType == LiteralType::FLOAT &&
+                            TypeChecker::isFloatingPoint(elementType);
+        if (!integerLiteral && !floatLiteral && !TypeChecker::isCompatibleType(elementType, valueType)) {
+            error("Type mismatch in array literal: expected " + elementType + ", got " + valueType,
+                  element->line, element->column);
+        }
+        else if (integerLiteral &&
+                 !TypeChecker::integerLiteralFits(literal->value, operand != element.get(), elementType)) {
+            error("Array literal element " + std::string(operand != element.get() ? "-" : "") + literal->value +
+                  " does not fit in element type " + elementType, element->line, element->column);
+        }
+    }
+}
+
+bool Analyzer::isConstArray(const Expression& expr) {
+    auto* identifier = dynamic_cast<const IdentifierExpr*>(&expr);
+    Symbol* symbol = identifier ? currentScope->lookup(identifier->name) : nullptr;
+    return symbol && symbol->isConstant && TypeChecker::isArrayType(symbol->type);
+}
+
+bool Analyzer::isKnownType(const std::string& type) const {
+    if (TypeChecker::isPointerType(type)) {
+        return isKnownType(TypeChecker::getPointerBaseType(type));
+    }
+    if (TypeChecker::isVecType(type)) {
+        return isKnownType(TypeChecker::getVecElementType(type));
+    }
+    if (TypeChecker::isSliceType(type)) {
+        return isKnownType(TypeChecker::getSliceElementType(type));
+    }
+    if (TypeChecker::isTaskType(type)) {
+        std::string resultType = TypeChecker::getTaskResultType(type);
+        return resultType == "void" || isKnownType(resultType);
+    }
+    if (TypeChecker::isArrayType(type)) {
+        return TypeChecker::getArraySize(type) > 0 && isKnownType(TypeChecker::getArrayElementType(type));
+    }
+    return TypeChecker::isPrimitiveType(type) || type == "int" || type == "isize" || type == "usize" ||
+           type == "size_t" || structs.count(type) > 0;
+}
+
+void Analyzer::checkRestrictAliasing(FunctionCallExpr& node) {
+    auto it = restrictParameters.find(node.functionName);
+    if (it == restrictParameters.end()) {
+        return;
+    }
+    const std::vector<bool>& restrictFlags = it->second;
+    
+    // Only the obvious case is caught: the same variable (or its address) passed twice
+    std::vector<std::string> bases;
+    for (const auto& argument : node.arguments) {
+        std::string base;
+        if (auto* identifier = dynamic_cast<IdentifierExpr*>(argument.get())) {
+            base = identifier->name;
+        }
+#ifdef EMLANG_FEATURE_POINTERS
+        else if (auto* addressOf = dynamic_cast<AddressOfExpr*>(argument.get())) {
+            if (auto* target = dynamic_cast<IdentifierExpr*>(addressOf->operand.get())) {
+                base = "&" + target->name;
+            }
+        }
+#endif
+        bases.push_back(base);
+    }
+    
+    for (size_t i = 0; i < bases.size() && i < restrictFlags.size(); ++i) {
+        for (size_t j = i + 1; j < bases.size() && j < restrictFlags.size(); ++j) {
+            if (!bases[i].empty() && bases[i] == bases[j] && (restrictFlags[i] || restrictFlags[j])) {
+                error("Arguments " + std::to_string(i + 1) + " and " + std::to_string(j + 1) + " of call to '" +
+                      node.functionName + "' alias a restrict parameter", node.line, node.column);
+            }
+        }
+    }
+}
+
+void Analyzer::checkPureAccess(const std::string& what, size_t line, size_t column) {
+    if (!currentPureFunction.empty()) {
+        error("Pure function '" + currentPureFunction + "' cannot " + what, line, column);
+    }
+}
+
+void Analyzer::checkPureArrayRead(Expression& operand, const std::string& type) {
+    // Slice elements live in the caller's memory; nested expressions report their own operands
+    if (TypeChecker::isSliceType(type) && !dynamic_cast<BinaryOpExpr*>(&operand) &&
+        !dynamic_cast<UnaryOpExpr*>(&operand)) {
+        checkPureAccess("read memory through a slice", operand.line, operand.column);
+    }
+}
+
+/***************************************
+*  GENERIC FUNCTIONS
+***************************************/
+
+void Analyzer::declareGenericFunction(FunctionDecl& node) {
+    if (currentScope != scopes.front().get()) {
+        error("Generic functions must be declared at global scope: " + node.name, node.line, node.column);
+        return;
+    }
+    if (genericFunctions.count(node.name) || currentScope->existsInCurrentScope(node.name)) {
+        error("Function already declared: " + node.name, node.line, node.column);
+        return;
+    }
+    
+    std::set<std::string> names;
+    for (const auto& typeParam : node.typeParameters) {
+        if (!names.insert(typeParam.name).second) {
+            error("Duplicate type parameter '" + typeParam.name + "' in function: " + node.name, node.line, node.column);
+        }
+        if (isKnownType(typeParam.name)) {
+            error("Type parameter '" + typeParam.name + "' shadows an existing type", node.line, node.column);
+        }
+        if (!typeParam.constraint.empty() && typeParam.constraint != "numeric" &&
+            typeParam.constraint != "integer" && typeParam.constraint != "float") {
+            error("Unknown constraint '" + typeParam.constraint + "' on type parameter '" + typeParam.name + 
+                  "' (expected numeric, integer or float)", node.line, node.column);
+        }
+    }
+    checkFunctionAttributes(node);
+    genericFunctions[node.name] = &node;
+}
+
+std::string Analyzer::deduceTypeArgument(const std::string& pattern, const std::string& actual, const FunctionDecl& generic,
+                                         std::map<std::string, std::string>& bindings,
+                                         std::set<std::string>& literalBindings, bool fromLiteral) {
+    for (const auto& typeParam : generic.typeParameters) {
+        if (pattern != typeParam.name) {
+            continue;
+        }
+        auto it = bindings.find(pattern);
+        if (it == bindings.end()) {
+            bindings[pattern] = actual;
+            if (fromLiteral) {
+                literalBindings.insert(pattern);
+            }
+            return "";
+        }
+        if (it->second == actual) {
+            return "";
+        }
+        // Literals adapt to the other arguments, except that a float literal never becomes an integer:
+        // pick(2, 2.5) deduces float, while pick(n, 2.5) with n: int32 is a conflict
+        bool narrows = TypeChecker::isFloatingPoint(fromLiteral ? actual : it->second) &&
+                       !TypeChecker::isFloatingPoint(fromLiteral ? it->second : actual);
+        bool boundByLiteral = literalBindings.count(pattern) > 0;
+        if (fromLiteral && !narrows) {
+            return "";
+        }
+        if (boundByLiteral && (fromLiteral || !narrows)) {
+            it->second = actual;
+            if (!fromLiteral) {
+                literalBindings.erase(pattern);
+            }
+            return "";
+        }
+        return "conflicting types " + it->second + " and " + actual + " for type parameter '" + pattern + "'";
+    }
+    
+    // Composite types deduce through their element type
+    if (TypeChecker::isPointerType(pattern) && TypeChecker::isPointerType(actual)) {
+        return deduceTypeArgument(TypeChecker::getPointerBaseType(pattern), TypeChecker::getPointerBaseType(actual),
+                                  generic, bindings, literalBindings, false);
+    }
+    if (TypeChecker::isSliceType(pattern) && TypeChecker::isSliceType(actual)) {
+        return deduceTypeArgument(TypeChecker::getSliceElementType(pattern), TypeChecker::getSliceElementType(actual),
+                                  generic, bindings, literalBindings, false);
+    }
+    if (TypeChecker::isVecType(pattern) && TypeChecker::isVecType(actual)) {
+        return deduceTypeArgument(TypeChecker::getVecElementType(pattern), TypeChecker::getVecElementType(actual),
+                                  generic, bindings, literalBindings, false);
+    }
+    if (TypeChecker::isArrayType(pattern) && TypeChecker::isArrayType(actual) &&
+        TypeChecker::getArraySize(pattern) == TypeChecker::getArraySize(actual)) {
+        return deduceTypeArgument(TypeChecker::getArrayElementType(pattern), TypeChecker::getArrayElementType(actual),
+                                  generic, bindings, literalBindings, false);
+    }
+    
+    // Parameters that do not mention a type parameter take part in no deduction
+    ASTCloner probe([&] {
+        std::map<std::string, std::string> erase;
+        for (const auto& typeParam : generic.typeParameters) {
+            erase[typeParam.name] = "";
+        }
+        return erase;
+    }());
+    if (probe.substitute(pattern) == pattern) {
+        return "";
+    }
+    return "cannot match argument of type " + actual + " to parameter of type " + pattern;
+}
+
+std::string Analyzer::mangleInstanceName(const std::string& name, const std::vector<std::string>& typeArgs) {
+    std::string mangled = name;
+    for (const auto& type : typeArgs) {
+        mangled += ".";
+        for (size_t i = 0; i < type.size(); ++i) {
+            if (type[i] == '[' && i + 1 < type.size() && type[i + 1] == ']') {
+                mangled += "slice.";
+                ++i;
+            } else if (type[i] == '[') {
+                mangled += ".arr";
+            } else if (type[i] == '<') {
+                mangled += ".";
+            } else if (type[i] == '*') {
+                mangled += ".ptr";
+            } else if (type[i] != ']' && type[i] != '>') {
+                mangled += type[i];
+            }
+        }
+    }
+    return mangled;
+}
+
+void Analyzer::instantiateGenericCall(FunctionCallExpr& node, FunctionDecl& generic) {
+    currentExpressionType = "error";
+    if (node.arguments.size() != generic.parameters.size()) {
+        error(node.functionName + " expects " + std::to_string(generic.parameters.size()) + " argument(s), got " + 
+              std::to_string(node.arguments.size()), node.line, node.column);
+        return;
+    }
+    
+    std::map<std::string, std::string> bindings;
+    std::set<std::string> literalBindings;
+    for (size_t i = 0; i < node.arguments.size(); ++i) {
+        std::string argType = getExpressionType(*node.arguments[i]);
+        if (argType == "error") {
+            return;
+        }
+        Expression* arg = node.arguments[i].get();
+        auto* negated = dynamic_cast<UnaryOpExpr*>(arg);
+        bool fromLiteral = dynamic_cast<LiteralExpr*>(negated ? negated->operand.get() : arg) != nullptr;
+        std::string reason = deduceTypeArgument(generic.parameters[i].type, argType, generic, 
+                                                bindings, literalBindings, fromLiteral);
+        if (!reason.empty()) {
+            error("Cannot instantiate '" + generic.name + "': " + reason, node.arguments[i]->line, node.arguments[i]->column);
+            return;
+        }
+    }
+    
+    std::vector<std::string> typeArgs;
+    for (const auto& typeParam : generic.typeParameters) {
+        auto it = bindings.find(typeParam.name);
+        if (it == bindings.end()) {
+            error("Cannot deduce type parameter '" + typeParam.name + "' of '" + generic.name + "'", node.line, node.column);
+            return;
+        }
+        const std::string& type = it->second;
+        if ((typeParam.constraint == "numeric" && !TypeChecker::isNumericType(type)) ||
+            (typeParam.constraint == "integer" && !TypeChecker::isSignedInteger(type) && !TypeChecker::isUnsignedInteger(type)) ||
+            (typeParam.constraint == "float" && !TypeChecker::isFloatingPoint(type))) {
+            error("Type '" + type + "' does not satisfy constraint '" + typeParam.constraint + "' of type parameter '" + 
+                  typeParam.name + "' in '" + generic.name + "'", node.line, node.column);
+            return;
+        }
+        typeArgs.push_back(type);
+    }
+    
+    // One instance per distinct list of type arguments, shared by every call site
+    ASTCloner cloner(bindings);
+    std::string mangled = mangleInstanceName(generic.name, typeArgs);
+    if (genericInstances.insert(mangled).second) {
+        std::unique_ptr<FunctionDecl> instance(static_cast<FunctionDecl*>(cloner.clone(generic).release()));
+        instance->name = mangled;
+        instance->typeArguments = typeArgs;
+        pendingInstances.push_back(std::move(instance));
+    }
+    if (!currentInstance.empty()) {
+        instanceCalls[currentInstance].push_back(mangled);
+    }
+    
+    node.functionName = mangled;
+    node.genericArgs = typeArgs;
+    currentExpressionType = cloner.substitute(generic.returnType.value_or(""));
+    if (generic.isAsync) {
+        currentExpressionType = "task<" + currentExpressionType + ">";
+    }
+}
+
+std::vector<StatementPtr> Analyzer::analyzePendingInstances() {
+    // Analyzing an instance may create further instances
+    std::map<std::string, std::unique_ptr<FunctionDecl>> analyzed;
+    std::vector<std::string> order;
+    while (!pendingInstances.empty()) {
+        std::unique_ptr<FunctionDecl> instance = std::move(pendingInstances.front());
+        pendingInstances.erase(pendingInstances.begin());
+        currentInstance = instance->name;
+        instance->accept(*this);
+        currentInstance.clear();
+        order.push_back(instance->name);
+        analyzed[instance->name] = std::move(instance);
+    }
+    
+    // Functions are generated in program order, so callees must come first
+    std::vector<StatementPtr> instances;
+    std::function<void(const std::string&)> place = [&](const std::string& name) {
+        auto it = analyzed.find(name);
+        if (it == analyzed.end() || !it->second) {
+            return;
+        }
+        StatementPtr instance = std::move(it->second);
+        for (const auto& callee : instanceCalls[name]) {
+            place(callee);
+        }
+        instances.push_back(std::move(instance));
+    };
+    for (const auto& name : order) {
+        place(name);
+    }
+    return instances;
+}
+
 /***************************************
 *  ANALYZER MAIN
 ***************************************/
@@ -90,8 +669,14 @@ void Analyzer::registerBuiltinFunctions() {
 ***************************************/
 
 void Analyzer::visit(Program& node) {
-    for (auto& stmt : node.statements) {
-        stmt->accept(*this);
+    for (size_t i = 0; i < node.statements.size(); ++i) {
+        node.statements[i]->accept(*this);
+        
+        // Instances go in front of the statement that first needed them
+        std::vector<StatementPtr> instances = analyzePendingInstances();
+        node.statements.insert(node.statements.begin() + i, 
+                               std::make_move_iterator(instances.begin()), std::make_move_iterator(instances.end()));
+        i += instances.size();
     }
 }
 
@@ -130,6 +715,15 @@ void Analyzer::visit(IdentifierExpr& node) {
         return;
     }
     
+    if (!symbol->isFunction && scopes.front()->lookup(node.name) == symbol) {
+        checkPureAccess("access global variable '" + node.name + "'", node.line, node.column);
+    }
+    
+    // Awaiting a task destroys it, so a copy would outlive the task it refers to
+    if (!symbol->isFunction && TypeChecker::isTaskType(symbol->type) && &node != awaitOperand) {
+        error("Task variable '" + node.name + "' can only be awaited", node.line, node.column);
+    }
+    
     currentExpressionType = symbol->type;
 }
 
@@ -144,6 +738,10 @@ void Analyzer::visit(BinaryOpExpr& node) {
         node.operator_ == BinaryOpExpr::BinOp::DIV || 
         node.operator_ == BinaryOpExpr::BinOp::MOD) {
         
+        if (isWholeArrayType(leftType) || isWholeArrayType(rightType)) {
+            currentExpressionType = analyzeArrayArithmetic(node, leftType, rightType);
+            return;
+        }
         if (!TypeChecker::isNumericType(leftType) || !TypeChecker::isNumericType(rightType)) {
             error("Arithmetic operations require numeric types", node.line, node.column);
             currentExpressionType = "error";
@@ -191,6 +789,18 @@ void Analyzer::visit(UnaryOpExpr& node) {
     std::string operandType = getExpressionType(*node.operand);
     
     if (node.operator_ == BinaryOpExpr::BinOp::SUB) {
+        if (isWholeArrayType(operandType)) {
+            // Negating an array negates each element
+            currentExpressionType = arrayElementType(operandType);
+            if (!TypeChecker::isNumericType(currentExpressionType)) {
+                error("Whole-array operations require numeric elements, got: " + operandType, node.line, node.column);
+                currentExpressionType = "error";
+                return;
+            }
+            checkPureArrayRead(*node.operand, operandType);
+            currentExpressionType = operandType;
+            return;
+        }
         if (!TypeChecker::isNumericType(operandType)) {
             error("Unary minus requires numeric type", node.line, node.column);
             currentExpressionType = "error";
@@ -235,11 +845,50 @@ void Analyzer::visit(AssignmentExpr& node) {
         }
         isValidLvalue = true;
     }
+    else if (auto* indexExpr = dynamic_cast<IndexExpr*>(node.target.get())) {
+        // Vector, array and pointer elements are assignable in place
+        std::string containerType = getExpressionType(*indexExpr->array);
+        if (!TypeChecker::isVecType(containerType) && !TypeChecker::isArrayType(containerType) &&
+            !TypeChecker::isSliceType(containerType) && !TypeChecker::isPointerType(containerType)) {
+            error("Indexed assignment requires a vector, array, slice or pointer, got: " + containerType, node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+        if (isConstArray(*indexExpr->array)) {
+            error("Cannot assign to element of const array: " + static_cast<IdentifierExpr&>(*indexExpr->array).name,
+                  node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+        isValidLvalue = true;
+    }
+    else if (dynamic_cast<MemberExpr*>(node.target.get())) {
+        // Fields are assignable when the chain ends in a mutable variable or element
+        Expression* root = node.target.get();
+        while (true) {
+            if (auto* member = dynamic_cast<MemberExpr*>(root)) {
+                root = member->object.get();
+            } else if (auto* index = dynamic_cast<IndexExpr*>(root)) {
+                root = index->array.get();
+            } else {
+                break;
+            }
+        }
+        auto* rootIdent = dynamic_cast<IdentifierExpr*>(root);
+        Symbol* symbol = rootIdent ? currentScope->lookup(rootIdent->name) : nullptr;
+        if (symbol && symbol->isConstant) {
+            error("Cannot assign to field of const variable: " + rootIdent->name, node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+        isValidLvalue = rootIdent != nullptr;
+    }
 #ifdef EMLANG_FEATURE_POINTERS
-    else if (dynamic_cast<DereferenceExpr*>(node.target.get())) {
+    else if (auto* derefExpr = dynamic_cast<DereferenceExpr*>(node.target.get())) {
         // Target is a dereference expression, which is a valid lvalue
-        if (!TypeChecker::isPointerType(targetType)) {
-            error("Cannot dereference non-pointer type: " + targetType, node.line, node.column);
+        std::string pointerType = getExpressionType(*derefExpr->operand);
+        if (!TypeChecker::isPointerType(pointerType)) {
+            error("Cannot dereference non-pointer type: " + pointerType, node.line, node.column);
             currentExpressionType = "error";
             return;
         }
@@ -257,6 +906,29 @@ void Analyzer::visit(AssignmentExpr& node) {
     node.value->accept(*this);
     std::string valueType = currentExpressionType;
     
+    // Whole-array expressions are stored element by element into the target
+    if (isWholeArrayType(valueType) &&
+        (dynamic_cast<BinaryOpExpr*>(node.value.get()) || dynamic_cast<UnaryOpExpr*>(node.value.get()))) {
+        if (!isWholeArrayType(targetType) || arrayElementType(targetType) != arrayElementType(valueType)) {
+            error("Type mismatch in assignment: cannot assign " + valueType + " to " + targetType, 
+                  node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+        if (TypeChecker::isArrayType(targetType) && TypeChecker::isArrayType(valueType) &&
+            TypeChecker::getArraySize(targetType) != TypeChecker::getArraySize(valueType)) {
+            error("Array lengths differ in assignment: cannot assign " + valueType + " to " + targetType,
+                  node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+        if (TypeChecker::isSliceType(targetType)) {
+            checkPureAccess("write memory through a slice", node.line, node.column);
+        }
+        currentExpressionType = targetType;
+        return;
+    }
+    
     // Check type compatibility
     if (!TypeChecker::isCompatibleType(targetType, valueType)) {
         error("Type mismatch in assignment: cannot assign " + valueType + " to " + targetType, 
@@ -270,7 +942,77 @@ void Analyzer::visit(AssignmentExpr& node) {
 }
 
 void Analyzer::visit(FunctionCallExpr& node) {
-    Symbol* symbol = currentScope->lookup(node.functionName);
+    auto generic = genericFunctions.find(node.functionName);
+    bool pureGeneric = generic != genericFunctions.end() && generic->second->findAttribute("pure");
+    
+    // A function the program declares under an intrinsic's name takes precedence over it
+    Symbol* declared = currentScope->lookup(node.functionName);
+    bool shadowed = generic != genericFunctions.end() || (declared && declared->isFunction);
+    bool arrayIntrinsic = isArrayIntrinsic(node.functionName) && !shadowed;
+    bool hintIntrinsic = isHintIntrinsic(node.functionName) && !shadowed;
+    bool branchHint = hintIntrinsic && node.functionName != "prefetch";
+    
+    // Only other pure functions and branch hints keep a pure caller free of memory effects
+    if (!pureFunctions.count(node.functionName) && !pureGeneric && !branchHint &&
+        node.functionName != "slice_len" && !arrayIntrinsic) {
+        checkPureAccess("call impure function '" + node.functionName + "'", node.line, node.column);
+    }
+    
+    if (analyzeVecIntrinsic(node) || (hintIntrinsic && analyzeHintIntrinsic(node))) {
+        return;
+    }
+    
+    if (isSliceIntrinsic(node.functionName)) {
+        if (node.arguments.size() != 1) {
+            error("slice_len expects 1 argument(s), got " + std::to_string(node.arguments.size()), 
+                  node.line, node.column);
+        } else {
+            std::string sliceType = getExpressionType(*node.arguments[0]);
+            if (!TypeChecker::isSliceType(sliceType)) {
+                error("slice_len requires a slice argument, got: " + sliceType, node.line, node.column);
+            }
+        }
+        currentExpressionType = "int64";
+        return;
+    }
+    
+    if (isTaskIntrinsic(node.functionName)) {
+        // yield_now: lets the other ready tasks run before the caller continues
+        if (!node.arguments.empty()) {
+            error("yield_now expects 0 argument(s), got " + std::to_string(node.arguments.size()), 
+                  node.line, node.column);
+        }
+        if (!currentFunctionAsync) {
+            error("yield_now is only allowed inside an async function", node.line, node.column);
+        }
+        currentExpressionType = "void";
+        return;
+    }
+    
+    if (arrayIntrinsic) {
+        // sum: the elements of an array, slice or whole-array expression, added up
+        currentExpressionType = "error";
+        if (node.arguments.size() != 1) {
+            error("sum expects 1 argument(s), got " + std::to_string(node.arguments.size()), node.line, node.column);
+            return;
+        }
+        std::string arrayType = getExpressionType(*node.arguments[0]);
+        std::string elementType = isWholeArrayType(arrayType) ? arrayElementType(arrayType) : "";
+        if (!TypeChecker::isNumericType(elementType)) {
+            error("sum requires an array or slice of numbers, got: " + arrayType, node.line, node.column);
+            return;
+        }
+        checkPureArrayRead(*node.arguments[0], arrayType);
+        currentExpressionType = elementType;
+        return;
+    }
+    
+    if (generic != genericFunctions.end()) {
+        instantiateGenericCall(node, *generic->second);
+        return;
+    }
+    
+    Symbol* symbol = declared;
     if (!symbol) {
         error("Undefined function: " + node.functionName, node.line, node.column);
         currentExpressionType = "error";
@@ -283,24 +1025,46 @@ void Analyzer::visit(FunctionCallExpr& node) {
         return;
     }
     
+    checkRestrictAliasing(node);
+    
+    // Arguments may themselves call generic functions, which must be instantiated
+    for (auto& arg : node.arguments) {
+        getExpressionType(*arg);
+    }
+    
     // TODO: Check argument types and count
-    currentExpressionType = symbol->type;
+    // Built-ins carry a "returnType(params)" signature; the call yields the return type
+    std::string type = symbol->type;
+    size_t paren = type.find('(');
+    currentExpressionType = paren != std::string::npos ? type.substr(0, paren) : type;
 }
 
 void Analyzer::visit(MemberExpr& node) {
     // Analyze the object expression first
     std::string objectType = getExpressionType(*node.object);
     
-    // For now, set the expression type to unknown
-    // TODO: Implement proper member access type checking
-    currentExpressionType = "unknown";
+    auto it = structs.find(objectType);
+    if (it == structs.end()) {
+        if (objectType != "error") {
+            error("Member access requires a struct, got: " + objectType, node.line, node.column);
+        }
+        currentExpressionType = "error";
+        return;
+    }
     
-    // TODO: Add proper member resolution logic
-    // This would involve checking if the object type has the requested member
-    // and determining the member's type
+    for (const auto& field : it->second->fields) {
+        if (field.name == node.memberName) {
+            currentExpressionType = field.type;
+            return;
+        }
+    }
+    error("Struct '" + objectType + "' has no field '" + node.memberName + "'", node.line, node.column);
+    currentExpressionType = "error";
 }
 
 void Analyzer::visit(IndexExpr& node) {
+    checkPureAccess("read memory through an index", node.line, node.column);
+    
     // Analyze the array expression
     std::string arrayType = getExpressionType(*node.array);
     
@@ -314,11 +1078,97 @@ void Analyzer::visit(IndexExpr& node) {
               node.line, node.column);
     }
     
+    if (TypeChecker::isVecType(arrayType)) {
+        currentExpressionType = TypeChecker::getVecElementType(arrayType);
+        return;
+    }
+    
+    if (TypeChecker::isSliceType(arrayType)) {
+        currentExpressionType = TypeChecker::getSliceElementType(arrayType);
+        return;
+    }
+    
+    if (TypeChecker::isArrayType(arrayType)) {
+        auto* literal = dynamic_cast<LiteralExpr*>(node.index.get());
+        if (literal && literal->literalType == LiteralType::INT) {
+            // Literals too large for 64 bits are out of bounds of any array
+            bool inBounds = false;
+            try {
+                inBounds = std::stoull(literal->value) < TypeChecker::getArraySize(arrayType);
+            } catch (const std::exception&) {
+            }
+            if (!inBounds) {
+                error("Index " + literal->value + " is out of bounds for " + arrayType, node.line, node.column);
+            }
+        }
+        currentExpressionType = TypeChecker::getArrayElementType(arrayType);
+        return;
+    }
+    
+    // Pointers are indexed without a bounds check: p[i] is *(p + i)
+    if (TypeChecker::isPointerType(arrayType)) {
+        currentExpressionType = TypeChecker::getPointerBaseType(arrayType);
+        return;
+    }
+    
     // TODO: Extract element type from array type
     // For now, assume unknown type
     currentExpressionType = "unknown";
 }
 
+void Analyzer::visit(SliceExpr& node) {
+    std::string arrayType = getExpressionType(*node.array);
+    std::string elementType;
+    if (TypeChecker::isArrayType(arrayType)) {
+        elementType = TypeChecker::getArrayElementType(arrayType);
+    } else if (TypeChecker::isVecType(arrayType)) {
+        elementType = TypeChecker::getVecElementType(arrayType);
+    } else if (TypeChecker::isSliceType(arrayType)) {
+        elementType = TypeChecker::getSliceElementType(arrayType);
+    } else {
+        error("Slicing requires an array, vector or slice, got: " + arrayType, node.line, node.column);
+        currentExpressionType = "error";
+        return;
+    }
+    // Slices are writable views, so they cannot point into read-only data
+    if (isConstArray(*node.array)) {
+        error("Cannot slice const array: " + static_cast<IdentifierExpr&>(*node.array).name, node.line, node.column);
+        currentExpressionType = "error";
+        return;
+    }
+    
+    // Constant bounds of a fixed array are checked here rather than at run time
+    uint64_t limit = TypeChecker::isArrayType(arrayType) ? TypeChecker::getArraySize(arrayType) : UINT64_MAX;
+    uint64_t startValue = 0;
+    for (Expression* bound : {node.start.get(), node.end.get()}) {
+        if (!bound) {
+            continue;
+        }
+        std::string boundType = getExpressionType(*bound);
+        if (!TypeChecker::isSignedInteger(boundType) && !TypeChecker::isUnsignedInteger(boundType)) {
+            error("Slice bound must be an integer type, got: " + boundType, node.line, node.column);
+            continue;
+        }
+        auto* literal = dynamic_cast<LiteralExpr*>(bound);
+        if (!literal || literal->literalType != LiteralType::INT) {
+            continue;
+        }
+        uint64_t value = 0;
+        try {
+            value = std::stoull(literal->value);
+        } catch (const std::exception&) {
+            error("Slice bound " + literal->value + " is out of range for " + arrayType, node.line, node.column);
+            continue;
+        }
+        if (value > limit || (bound == node.end.get() && value < startValue)) {
+            error("Slice bound " + literal->value + " is out of range for " + arrayType, node.line, node.column);
+        }
+        startValue = value;
+    }
+    
+    currentExpressionType = "[]" + elementType;
+}
+
 void Analyzer::visit(ArrayExpr& node) {
     // Analyze all elements
     std::string elementType = "";
@@ -351,6 +1201,39 @@ void Analyzer::visit(ObjectExpr& node) {
     currentExpressionType = "object";
 }
 
+void Analyzer::visit(AwaitExpr& node) {
+    auto* variable = dynamic_cast<IdentifierExpr*>(node.operand.get());
+    awaitOperand = variable;
+    std::string taskType = getExpressionType(*node.operand);
+    awaitOperand = nullptr;
+    if (!TypeChecker::isTaskType(taskType)) {
+        if (taskType != "error") {
+            error("await requires a task, got: " + taskType, node.line, node.column);
+        }
+        currentExpressionType = "error";
+        return;
+    }
+    checkPureAccess("await a task", node.line, node.column);
+    
+    // The task is destroyed once awaited, so each task variable is awaited at most once on any path
+    const Symbol* symbol = variable ? currentScope->lookup(variable->name) : nullptr;
+    if (symbol && !symbol->isFunction) {
+        auto declared = taskLoopDepths.find(symbol);
+        // Expressions may be analyzed more than once; only another await is a second consumer
+        auto awaited = awaitedTasks.emplace(symbol, &node);
+        if (awaited.first->second != &node) {
+            error("Task variable '" + variable->name + "' has already been awaited", node.line, node.column);
+        } else if (loopDepth > (declared != taskLoopDepths.end() ? declared->second : 0)) {
+            error("Task variable '" + variable->name + "' cannot be awaited in a loop it was declared outside of",
+                  node.line, node.column);
+        }
+    }
+    
+    // Codegen reads the result out of the finished task with this type
+    node.resultType = TypeChecker::getTaskResultType(taskType);
+    currentExpressionType = node.resultType;
+}
+
 #ifdef EMLANG_FEATURE_CASTING
 void Analyzer::visit(CastExpr& node) {
     // Analyze the operand expression
@@ -366,6 +1249,7 @@ void Analyzer::visit(CastExpr& node) {
 
 #ifdef EMLANG_FEATURE_POINTERS
 void Analyzer::visit(DereferenceExpr& node) {
+    checkPureAccess("dereference a pointer", node.line, node.column);
     node.operand->accept(*this);
     std::string operandType = getExpressionType(*node.operand);
     
@@ -380,6 +1264,24 @@ void Analyzer::visit(DereferenceExpr& node) {
 }
 
 void Analyzer::visit(AddressOfExpr& node) {
+    if (auto* identifier = dynamic_cast<IdentifierExpr*>(node.operand.get())) {
+        if (inductionVariables.count(currentScope->lookup(identifier->name))) {
+            error("Cannot take the address of loop variable: " + identifier->name, node.line, node.column);
+            currentExpressionType = "error";
+            return;
+        }
+    }
+    // Pointers are writable, so they cannot point into a const array
+    Expression* target = node.operand.get();
+    if (auto* index = dynamic_cast<IndexExpr*>(target)) {
+        target = index->array.get();
+    }
+    if (isConstArray(*target)) {
+        error("Cannot take the address of const array: " + static_cast<IdentifierExpr*>(target)->name,
+              node.line, node.column);
+        currentExpressionType = "error";
+        return;
+    }
     node.operand->accept(*this);
     std::string operandType = getExpressionType(*node.operand);
     
@@ -399,11 +1301,37 @@ void Analyzer::visit(VariableDecl& node) {
         return;
     }
     
+    // The parser tags declarations without annotation and non-literal initializer as "object"
+    bool inferred = !node.type.has_value() || node.type->empty() || node.type.value() == "object";
+    std::string initType;
+
+    // Object literals take their struct type from the annotation
+    auto* objectInit = dynamic_cast<ObjectExpr*>(node.initializer.get());
+    if (objectInit && inferred) {
+        error("Object literal needs a struct type annotation: " + node.name, node.line, node.column);
+        return;
+    }
+    
+    auto* arrayInit = dynamic_cast<ArrayExpr*>(node.initializer.get());
+    if (objectInit && structs.count(node.type.value())) {
+        checkStructLiteral(node.type.value(), *objectInit);
+    }
+    else if (arrayInit && !inferred && TypeChecker::isArrayType(node.type.value())) {
+        checkArrayLiteral(node.type.value(), *arrayInit);
+    }
     // Type check initializer if present
-    if (node.initializer) {
-        std::string initType = getExpressionType(*node.initializer);
+    else if (node.initializer) {
+        initType = getExpressionType(*node.initializer);
         std::string value = node.type.has_value() ? node.type.value() : "void";
-        if (!value.empty() && !TypeChecker::isCompatibleType(value, initType)) {
+        // A non-negative integer literal also initializes unsigned integers
+        auto* literal = dynamic_cast<LiteralExpr*>(node.initializer.get());
+        bool unsignedLiteral = literal && literal->literalType == LiteralType::INT &&
+                               TypeChecker::isUnsignedInteger(value);
+        // Untyped array literals are fixed-size arrays of their element type
+        if (arrayInit && inferred) {
+            initType = initType.substr(0, initType.size() - 2) + "[" + std::to_string(arrayInit->elements.size()) + "]";
+        }
+        else if (!inferred && !unsignedLiteral && !TypeChecker::isCompatibleType(value, initType)) {
             error("Type mismatch in variable declaration: expected " + value + ", got " + initType, 
                   node.line, node.column);
             return;
@@ -411,31 +1339,71 @@ void Analyzer::visit(VariableDecl& node) {
     }
     
     // Define variable in current scope
-    std::string varType = node.type->empty() ? currentExpressionType : node.type.value();
+    std::string varType = inferred && !initType.empty() ? initType : node.type.value_or("object");
+    if (node.isRestrict && !TypeChecker::isPointerType(varType)) {
+        error("restrict requires a pointer type, got: " + varType, node.line, node.column);
+    }
     currentScope->define(node.name, varType, node.isConstant, false, node.line, node.column);
+    if (TypeChecker::isTaskType(varType)) {
+        taskLoopDepths[currentScope->lookup(node.name)] = loopDepth;
+    }
 }
 
 void Analyzer::visit(FunctionDecl& node) {
+    if (node.isGeneric()) {
+        declareGenericFunction(node);
+        return;
+    }
+    
     // Check if function already exists in current scope
-    if (currentScope->existsInCurrentScope(node.name)) {
+    if (currentScope->existsInCurrentScope(node.name) || genericFunctions.count(node.name)) {
         error("Function already declared: " + node.name, node.line, node.column);
         return;
     }
     
+    // Calling an async function starts it and yields a task for its result
+    std::string functionType = node.returnType.value();
+    if (node.isAsync) {
+        if (node.name == "main") {
+            error("main cannot be async", node.line, node.column);
+        }
+        functionType = "task<" + functionType + ">";
+    }
+    
     // Define function in current scope
-    currentScope->define(node.name, node.returnType.value(), false, true, node.line, node.column);
+    currentScope->define(node.name, functionType, false, true, node.line, node.column);
+    
+    checkFunctionAttributes(node);
+    std::string oldPureFunction = currentPureFunction;
+    if (node.findAttribute("pure")) {
+        // Registered before the body so pure functions may recurse
+        pureFunctions.insert(node.name);
+        currentPureFunction = node.name;
+    } else {
+        currentPureFunction.clear();
+    }
     
     // Enter function scope
     enterScope();
     
     // Define parameters
+    std::vector<bool> restrictFlags;
     for (const auto& param : node.parameters) {
+        if (param.isRestrict && !TypeChecker::isPointerType(param.type)) {
+            error("restrict requires a pointer type, got: " + param.type, node.line, node.column);
+        }
+        restrictFlags.push_back(param.isRestrict);
         currentScope->define(param.name, param.type, false, false, node.line, node.column);
     }
+    if (std::find(restrictFlags.begin(), restrictFlags.end(), true) != restrictFlags.end()) {
+        restrictParameters[node.name] = restrictFlags;
+    }
     
     // Set current function return type
     std::string oldReturnType = currentFunctionReturnType;
+    bool oldAsync = currentFunctionAsync;
     currentFunctionReturnType = node.returnType.value();
+    currentFunctionAsync = node.isAsync;
     
     // Analyze function body
     if (node.body) {
@@ -444,11 +1412,42 @@ void Analyzer::visit(FunctionDecl& node) {
     
     // Restore previous function return type
     currentFunctionReturnType = oldReturnType;
+    currentFunctionAsync = oldAsync;
+    currentPureFunction = oldPureFunction;
     
     // Exit function scope
     exitScope();
 }
 
+void Analyzer::visit(StructDecl& node) {
+    if (currentScope != scopes.front().get()) {
+        error("Structs must be declared at global scope: " + node.name, node.line, node.column);
+        return;
+    }
+    if (structs.count(node.name) || currentScope->existsInCurrentScope(node.name) || isKnownType(node.name)) {
+        error("Type already declared: " + node.name, node.line, node.column);
+        return;
+    }
+    
+    checkStructAttributes(node);
+    if (node.fields.empty()) {
+        error("Struct must have at least one field: " + node.name, node.line, node.column);
+    }
+    
+    std::set<std::string> fieldNames;
+    for (const auto& field : node.fields) {
+        if (!fieldNames.insert(field.name).second) {
+            error("Duplicate field '" + field.name + "' in struct: " + node.name, field.line, field.column);
+        }
+        // Only earlier structs are known here, so a struct cannot contain itself by value
+        if (!isKnownType(field.type)) {
+            error("Unknown type for field '" + field.name + "': " + field.type, field.line, field.column);
+        }
+    }
+    
+    structs[node.name] = &node;
+}
+
 void Analyzer::visit(ExternFunctionDecl& node) {
     // Check if function name already exists in current scope
     if (currentScope->lookup(node.name)) {
@@ -495,16 +1494,22 @@ void Analyzer::visit(IfStmt& node) {
         error("If condition must be boolean, numeric or pointer type", node.line, node.column);
     }
     
+    // Only one branch runs, so each may await the same task
+    std::map<const Symbol*, const AwaitExpr*> awaitedBefore = awaitedTasks;
     if (node.thenBranch) {
         node.thenBranch->accept(*this);
     }
+    std::map<const Symbol*, const AwaitExpr*> awaitedInThen = std::move(awaitedTasks);
+    awaitedTasks = std::move(awaitedBefore);
     
     if (node.elseBranch) {
         node.elseBranch->accept(*this);
     }
+    awaitedTasks.insert(awaitedInThen.begin(), awaitedInThen.end());
 }
 
 void Analyzer::visit(WhileStmt& node) {
+    ++loopDepth;
     std::string conditionType = getExpressionType(*node.condition);
     // While condition can be of boolean type or any value
     // Integer and pointer types are evaluated as boolean (0 = false, other = true)
@@ -515,9 +1520,15 @@ void Analyzer::visit(WhileStmt& node) {
     if (node.body) {
         node.body->accept(*this);
     }
+    --loopDepth;
 }
 
 void Analyzer::visit(ForStmt& node) {
+    if (node.isRange()) {
+        analyzeRangeFor(node);
+        return;
+    }
+    
     enterScope();
     
     // Analyze initializer if present
@@ -526,6 +1537,7 @@ void Analyzer::visit(ForStmt& node) {
     }
     
     // Analyze condition if present
+    ++loopDepth;
     if (node.condition) {
         std::string conditionType = getExpressionType(*node.condition);
         if (conditionType != "bool") {
@@ -541,10 +1553,231 @@ void Analyzer::visit(ForStmt& node) {
     
     // Analyze body
     node.body->accept(*this);
+    --loopDepth;
     
     exitScope();
 }
 
+bool Analyzer::isWholeArrayType(const std::string& type) {
+    return TypeChecker::isArrayType(type) || TypeChecker::isSliceType(type);
+}
+
+std::string Analyzer::arrayElementType(const std::string& type) {
+    return TypeChecker::isArrayType(type) ? TypeChecker::getArrayElementType(type) : TypeChecker::getSliceElementType(type);
+}
+
+std::string Analyzer::analyzeArrayArithmetic(BinaryOpExpr& node, const std::string& leftType, const std::string& rightType) {
+    std::string elementType;
+    std::string fixedType;      // Set while every array operand has a fixed length
+    bool allFixed = true;
+    const std::pair<Expression*, std::string> operands[] = {{node.left.get(), leftType}, {node.right.get(), rightType}};
+    for (const auto& operand : operands) {
+        const std::string& type = operand.second;
+        if (!isWholeArrayType(type)) {
+            continue;
+        }
+        // Codegen walks the tree once per element, so array operands must be cheap to revisit
+        Expression* expr = operand.first;
+        if (!dynamic_cast<IdentifierExpr*>(expr) && !dynamic_cast<SliceExpr*>(expr) &&
+            !dynamic_cast<BinaryOpExpr*>(expr) && !dynamic_cast<UnaryOpExpr*>(expr)) {
+            error("Whole-array operands must be array or slice variables, slices or array expressions", 
+                  expr->line, expr->column);
+            return "error";
+        }
+        std::string operandElement = arrayElementType(type);
+        if (!TypeChecker::isNumericType(operandElement)) {
+            error("Whole-array operations require numeric elements, got: " + type, node.line, node.column);
+            return "error";
+        }
+        checkPureArrayRead(*expr, type);
+        if (!elementType.empty() && operandElement != elementType) {
+            error("Element types differ in whole-array expression: " + elementType + " and " + operandElement, 
+                  node.line, node.column);
+            return "error";
+        }
+        elementType = operandElement;
+        if (!TypeChecker::isArrayType(type)) {
+            allFixed = false;
+        } else if (fixedType.empty()) {
+            fixedType = type;
+        } else if (TypeChecker::getArraySize(type) != TypeChecker::getArraySize(fixedType)) {
+            error("Array lengths differ in whole-array expression: " + fixedType + " and " + type, 
+                  node.line, node.column);
+            return "error";
+        }
+    }
+    
+    // Scalars are applied to every element
+    for (const auto& operand : operands) {
+        const std::string& type = operand.second;
+        if (isWholeArrayType(type)) {
+            continue;
+        }
+        if (!TypeChecker::isNumericType(type) || 
+            (TypeChecker::isFloatingPoint(type) && !TypeChecker::isFloatingPoint(elementType))) {
+            error("Cannot combine " + type + " with elements of type " + elementType, node.line, node.column);
+            return "error";
+        }
+    }
+    return allFixed ? fixedType : "[]" + elementType;
+}
+
+void Analyzer::analyzeRangeFor(ForStmt& node) {
+    std::string startType = getExpressionType(*node.rangeStart);
+    std::string endType = getExpressionType(*node.rangeEnd);
+    if (!TypeChecker::isSignedInteger(startType) || !TypeChecker::isSignedInteger(endType)) {
+        error("For range bounds must be signed integers, got: " + startType + ".." + endType, node.line, node.column);
+        return;
+    }
+    
+    // A constant step gives the loop a trip count known on entry
+    std::string variableType = TypeChecker::promoteNumericTypes(startType, endType);
+    if (node.step) {
+        auto* step = dynamic_cast<LiteralExpr*>(node.step.get());
+        if (!step || step->literalType != LiteralType::INT || step->value.find_first_not_of('0') == std::string::npos) {
+            error("For range step must be a positive integer constant", node.step->line, node.step->column);
+            return;
+        }
+        if (!TypeChecker::integerLiteralFits(step->value, false, variableType)) {
+            error("For range step " + step->value + " does not fit in the loop variable type " + variableType,
+                  node.step->line, node.step->column);
+            return;
+        }
+    }
+    
+    // The variable is read-only and cannot have its address taken, so it needs no storage
+    enterScope();
+    currentScope->define(node.variable, variableType, true, false, node.line, node.column);
+    const Symbol* variable = currentScope->lookup(node.variable);
+    inductionVariables.insert(variable);
+    ++loopDepth;
+    node.body->accept(*this);
+    --loopDepth;
+    inductionVariables.erase(variable);
+    exitScope();
+}
+
+/**
+ * @brief Gets a key identifying the value of a constant case label
+ * @return false if the label is not an integer, character or boolean constant
+ */
+static bool caseLabelKey(Expression& label, std::string& key) {
+    bool negate = false;
+    Expression* value = &label;
+    if (auto* unary = dynamic_cast<UnaryOpExpr*>(value)) {
+        if (unary->operator_ != BinaryOpExpr::BinOp::SUB) {
+            return false;
+        }
+        negate = true;
+        value = unary->operand.get();
+    }
+    auto* literal = dynamic_cast<LiteralExpr*>(value);
+    if (!literal) {
+        return false;
+    }
+    switch (literal->literalType) {
+        case LiteralType::INT:
+            try {
+                long long number = std::stoll(literal->value);
+                key = std::to_string(negate ? -number : number);
+            } catch (const std::exception&) {
+                return false;
+            }
+            return true;
+        case LiteralType::CHAR:
+            if (negate) {
+                return false;
+            }
+            // Plain characters compare by code; escapes by spelling
+            key = literal->value.length() == 1
+                ? std::to_string(static_cast<unsigned char>(literal->value[0]))
+                : "char " + literal->value;
+            return true;
+        case LiteralType::BOOL:
+            if (negate) {
+                return false;
+            }
+            key = literal->value == "true" ? "1" : "0";
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Checks that a case label converts to the switch value's type without changing
+ * @param label The label expression
+ * @param key The label's key from caseLabelKey
+ * @param type The switch value's type
+ */
+static bool caseLabelFits(Expression& label, const std::string& key, const std::string& type) {
+    auto* literal = dynamic_cast<LiteralExpr*>(&label);
+    bool boolLabel = literal && literal->literalType == LiteralType::BOOL;
+    if (TypeChecker::isBooleanType(type) || boolLabel) {
+        return TypeChecker::isBooleanType(type) && boolLabel;
+    }
+    if (key.compare(0, 5, "char ") == 0) {
+        return true;  // Escaped characters are a single byte
+    }
+    static const std::map<std::string, int> widths = {
+        {"int8", 8}, {"int16", 16}, {"int32", 32}, {"int", 32}, {"int64", 64}, {"isize", 64},
+        {"uint8", 8}, {"uint16", 16}, {"uint32", 32}, {"uint64", 64}, {"usize", 64}, {"char", 8}};
+    auto width = widths.find(type);
+    if (width == widths.end() || width->second == 64) {
+        return !TypeChecker::isUnsignedInteger(type) || key[0] != '-';
+    }
+    long long value = std::stoll(key);
+    long long limit = 1LL << width->second;
+    // Characters match both their signed byte and their code
+    if (TypeChecker::isCharType(type)) {
+        return value >= -limit / 2 && value < limit;
+    }
+    if (TypeChecker::isUnsignedInteger(type)) {
+        return value >= 0 && value < limit;
+    }
+    return value >= -limit / 2 && value < limit / 2;
+}
+
+void Analyzer::visit(SwitchStmt& node) {
+    std::string valueType = getExpressionType(*node.discriminant);
+    if (!TypeChecker::isSignedInteger(valueType) && !TypeChecker::isUnsignedInteger(valueType) &&
+        !TypeChecker::isCharType(valueType) && !TypeChecker::isBooleanType(valueType)) {
+        error("Switch value must be integer, char or bool type, got: " + valueType, node.line, node.column);
+    }
+    
+    std::set<std::string> seenLabels;
+    bool seenDefault = false;
+    const std::map<const Symbol*, const AwaitExpr*> awaitedBefore = awaitedTasks;
+    for (auto& arm : node.cases) {
+        if (arm.isDefault) {
+            if (seenDefault) {
+                error("Multiple default labels in switch", arm.line, arm.column);
+            }
+            seenDefault = true;
+        }
+        for (auto& label : arm.labels) {
+            std::string key;
+            if (!caseLabelKey(*label, key)) {
+                error("Case label must be an integer, char or bool constant", label->line, label->column);
+                continue;
+            }
+            if (!caseLabelFits(*label, key, valueType)) {
+                error("Case label out of range for switch value type " + valueType, label->line, label->column);
+                continue;
+            }
+            if (!seenLabels.insert(key).second) {
+                error("Duplicate case label", label->line, label->column);
+            }
+        }
+        // Only one arm runs, so each may await the same task
+        std::map<const Symbol*, const AwaitExpr*> awaitedInArm = awaitedBefore;
+        std::swap(awaitedTasks, awaitedInArm);
+        arm.body->accept(*this);
+        std::swap(awaitedTasks, awaitedInArm);
+        awaitedTasks.insert(awaitedInArm.begin(), awaitedInArm.end());
+    }
+}
+
 void Analyzer::visit(ReturnStmt& node) {
     if (currentFunctionReturnType.empty()) {
         error("Return statement outside of function", node.line, node.column);
@@ -564,6 +1797,10 @@ void Analyzer::visit(ReturnStmt& node) {
 
 void Analyzer::visit(ExpressionStmt& node) {
     node.expression->accept(*this);
+    // A task nobody awaits is never destroyed, so its frame outlives the program
+    if (TypeChecker::isTaskType(currentExpressionType)) {
+        warning("Task is never awaited", node.line, node.column);
+    }
 }
 
 /***************************************
@@ -1,6 +1,7 @@
 
 #include "semantic/type_checker.h"
 #include <iostream>
+#include <map>
 
 namespace emlang {
 
@@ -84,6 +85,61 @@ std::string TypeChecker::makePointerType(const std::string& baseType) {
     return baseType + "*";
 }
 
+bool TypeChecker::isVecType(const std::string& type) {
+    return type.size() > 5 && type.compare(0, 4, "vec<") == 0 && type.back() == '>';
+}
+
+std::string TypeChecker::getVecElementType(const std::string& vecType) {
+    if (!isVecType(vecType)) {
+        return "";
+    }
+    return vecType.substr(4, vecType.length() - 5);
+}
+
+bool TypeChecker::isSliceType(const std::string& type) {
+    return type.size() > 2 && type.compare(0, 2, "[]") == 0;
+}
+
+std::string TypeChecker::getSliceElementType(const std::string& sliceType) {
+    if (!isSliceType(sliceType)) {
+        return "";
+    }
+    return sliceType.substr(2);
+}
+
+bool TypeChecker::isTaskType(const std::string& type) {
+    return type.size() > 6 && type.compare(0, 5, "task<") == 0 && type.back() == '>';
+}
+
+std::string TypeChecker::getTaskResultType(const std::string& taskType) {
+    if (!isTaskType(taskType)) {
+        return "";
+    }
+    return taskType.substr(5, taskType.length() - 6);
+}
+
+bool TypeChecker::isArrayType(const std::string& type) {
+    // "[]T[N]" is a slice of arrays, not an array of slices
+    size_t open = type.rfind('[');
+    return !isSliceType(type) && open != std::string::npos && open > 0 && type.back() == ']' && open + 2 < type.size() &&
+           type.find_first_not_of("0123456789", open + 1) == type.size() - 1;
+}
+
+std::string TypeChecker::getArrayElementType(const std::string& arrayType) {
+    if (!isArrayType(arrayType)) {
+        return "";
+    }
+    return arrayType.substr(0, arrayType.rfind('['));
+}
+
+uint64_t TypeChecker::getArraySize(const std::string& arrayType) {
+    if (!isArrayType(arrayType)) {
+        return 0;
+    }
+    size_t open = arrayType.rfind('[');
+    return std::stoull(arrayType.substr(open + 1, arrayType.size() - open - 2));
+}
+
 bool TypeChecker::isCompatibleType(const std::string& expected, const std::string& actual) {
     // Check for exact match
     if (expected == actual) return true;
@@ -106,6 +162,11 @@ bool TypeChecker::isCompatibleType(const std::string& expected, const std::strin
     // Special case: allow "string" literals to be assigned to "char" (single character)
     if (actual == "string" && expected == "char") return true;
     
+    // Special case: allow array literals to initialize a vector of the same element type
+    if (isVecType(expected) && actual.size() > 2 && actual.compare(actual.size() - 2, 2, "[]") == 0) {
+        return isCompatibleType(getVecElementType(expected), actual.substr(0, actual.size() - 2));
+    }
+    
     // Special case: allow "null" literals to be assigned to any pointer type
     if (actual == "null" && isPointerType(expected)) return true;
     if (expected == "null" && isPointerType(actual)) return true;
@@ -187,18 +248,56 @@ std::string TypeChecker::getCommonType(const std::string& type1, const std::stri
 }
 
 std::string TypeChecker::promoteNumericTypes(const std::string& type1, const std::string& type2) {
-    // Simple promotion rules - return the "larger" type
+    // Any floating-point operand makes the operation floating-point
     if (type1 == "double" || type2 == "double") return "double";
     if (type1 == "float" || type2 == "float") return "float";
-    if (type1 == "int64" || type2 == "int64") return "int64";
-    if (type1 == "int32" || type2 == "int32") return "int32";
-    if (type1 == "int16" || type2 == "int16") return "int16";
-    if (type1 == "int8" || type2 == "int8") return "int8";
+    
+    // Integers meet at the wider width; at equal width an unsigned operand makes it unsigned, as in C
+    static const std::map<std::string, int> widths = {
+        {"int8", 8}, {"uint8", 8}, {"int16", 16}, {"uint16", 16},
+        {"int32", 32}, {"uint32", 32}, {"int", 32}, {"number", 32},
+        {"int64", 64}, {"uint64", 64}, {"isize", 64}, {"usize", 64}
+    };
+    auto width1 = widths.find(type1);
+    auto width2 = widths.find(type2);
+    if (width1 != widths.end() && width2 != widths.end()) {
+        if (width1->second != width2->second) {
+            return width1->second > width2->second ? type1 : type2;
+        }
+        if (isUnsignedInteger(type1) || isUnsignedInteger(type2)) {
+            return isUnsignedInteger(type1) ? type1 : type2;
+        }
+        return type1 == "int" || type1 == "number" ? type2 : type1;
+    }
     
     // Default fallback
     return type1;
 }
 
+bool TypeChecker::integerLiteralFits(const std::string& digits, bool negative, const std::string& type) {
+    static const std::map<std::string, int> widths = {
+        {"int8", 8}, {"uint8", 8}, {"int16", 16}, {"uint16", 16},
+        {"int32", 32}, {"uint32", 32}, {"int", 32}, {"number", 32},
+        {"int64", 64}, {"uint64", 64}, {"isize", 64}, {"usize", 64}
+    };
+    auto width = widths.find(type);
+    if (width == widths.end()) {
+        return false;
+    }
+    uint64_t value = 0;
+    try {
+        value = std::stoull(digits);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (isUnsignedInteger(type)) {
+        return (!negative || value == 0) && (width->second == 64 || value < (1ULL << width->second));
+    }
+    // Two's complement: one more negative value than positive
+    uint64_t limit = 1ULL << (width->second - 1);
+    return negative ? value <= limit : value < limit;
+}
+
 bool TypeChecker::areTypesCompatible(const std::string& type1, const std::string& type2) {
     return isCompatibleType(type1, type2);
 }
@@ -21,5 +21,6 @@
 #include "ast/decl.h"
 #include "ast/visitor.h"
 #include "ast/dumper.h"
+#include "ast/cloner.h"
 
 #endif // EM_LANG_AST_H
\ No newline at end of file
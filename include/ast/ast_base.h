@@ -48,8 +48,10 @@ enum class NodeType {
     CAST_EXPR,       // Type casting (cast<type>(expr) or foo as <type>)
 #endif
     INDEX_EXPR,      // Array indexing (arr[index])
+    SLICE_EXPR,      // Sub-slicing (arr[start..end])
     ARRAY_EXPR,      // Array literals ([1, 2, 3])
     OBJECT_EXPR,     // Object literals ({key: value})
+    AWAIT_EXPR,      // Await expressions (await task)
 #ifdef EMLANG_FEATURE_POINTERS
     DEREFERENCE,     // Dereference operator (*ptr)
     ADDRESS_OF,      // Address-of operator (&var)
@@ -68,6 +70,7 @@ enum class NodeType {
     VARIABLE_DECL,   // Variable declarations (let x: int32 = 42;)
     FUNCTION_DECL,   // Function declarations (function name(param1: type1): returnType { ... })
     EXTERN_FN_DECL,  // External function declarations (extern function name(param1: type1): returnType;)
+    STRUCT_DECL,     // Struct declarations (struct Name { field: type, ... })
 #ifdef EMLANG_FEATURE_IMPORTS
     IMPORT_DECL,      // Import declaration (DO NOT IMPLEMENT YET)
 #endif
@@ -93,8 +96,36 @@ enum class LiteralType {
 struct Parameter {
     std::string name;    // Parameter name
     std::string type;    // Parameter type
+    bool isRestrict;     // true if the pointer is qualified 'restrict'
     
-    Parameter(const std::string& n, const std::string& t) : name(n), type(t) {}
+    Parameter(const std::string& n, const std::string& t, bool r = false) : name(n), type(t), isRestrict(r) {}
+};
+
+/**
+ * @struct TypeParameter
+ * @brief Represents a type parameter of a generic function (<T: numeric>)
+ */
+struct TypeParameter {
+    std::string name;        // Type parameter name
+    std::string constraint;  // Constraint name (empty if unconstrained)
+    
+    TypeParameter(const std::string& n, const std::string& c = "") : name(n), constraint(c) {}
+};
+
+/**
+ * @struct Attribute
+ * @brief Represents a declaration attribute such as #[inline(always)]
+ */
+struct Attribute {
+    std::string name;               // Attribute name
+    std::vector<std::string> args;  // Arguments as written (identifiers or integers)
+    size_t line;                    // Line of the attribute name
+    size_t column;                  // Column of the attribute name
+    
+    Attribute(const std::string& n, std::vector<std::string> a, size_t l = 0, size_t c = 0)
+        : name(n), args(std::move(a)), line(l), column(c) {}
+    
+    std::string toString() const;
 };
 
 /**
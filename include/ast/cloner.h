@@ -0,0 +1,99 @@
+//===--- cloner.h - AST Deep Copy -------------------------------*- C++ -*-===//
+//
+// Part of the RNR Project, under the Apache License v2.0 with LLVM Exceptions.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Deep copy of AST subtrees with type substitution
+//===----------------------------------------------------------------------===//
+
+#ifndef EM_LANG_AST_CLONER_H
+#define EM_LANG_AST_CLONER_H
+
+#pragma once
+
+#include "ast_base.h"
+#include "visitor.h"
+#include <map>
+#include <memory>
+#include <string>
+
+namespace emlang {
+
+/**
+ * @class ASTCloner
+ * @brief Copies AST subtrees, replacing type names along the way
+ *
+ * Used to instantiate generic functions: every type written in the copy
+ * (variable, parameter and return types, cast targets) has the type
+ * parameters replaced by their arguments, also inside composite types such
+ * as T[4], []T, vec<T> or T*. Source locations are kept, so diagnostics in
+ * an instance point at the generic declaration.
+ */
+class ASTCloner : public ASTVisitor {
+public:
+    /// Substitutions map type parameter names to concrete types
+    explicit ASTCloner(std::map<std::string, std::string> substitutions = {});
+    virtual ~ASTCloner() = default;
+
+    /// Deep copies an expression
+    ExpressionPtr clone(Expression& expr);
+    /// Deep copies a statement or declaration
+    StatementPtr clone(Statement& stmt);
+
+    /// Applies the substitutions to a type string
+    std::string substitute(const std::string& type) const;
+
+    // Visitor interface implementation - matches visitor.h exactly
+    void visit(Program& node) override;
+
+    // Expression visitors
+    void visit(LiteralExpr& node) override;
+    void visit(IdentifierExpr& node) override;
+    void visit(BinaryOpExpr& node) override;
+    void visit(UnaryOpExpr& node) override;
+    void visit(AssignmentExpr& node) override;
+    void visit(FunctionCallExpr& node) override;
+    void visit(MemberExpr& node) override;
+#ifdef EMLANG_FEATURE_CASTING
+    void visit(CastExpr& node) override;
+#endif // EMLANG_FEATURE_CASTING
+    void visit(IndexExpr& node) override;
+    void visit(SliceExpr& node) override;
+    void visit(ArrayExpr& node) override;
+    void visit(ObjectExpr& node) override;
+    void visit(AwaitExpr& node) override;
+#ifdef EMLANG_FEATURE_POINTERS
+    void visit(DereferenceExpr& node) override;
+    void visit(AddressOfExpr& node) override;
+#endif
+
+    // Declaration visitors
+    void visit(VariableDecl& node) override;
+    void visit(FunctionDecl& node) override;
+    void visit(ExternFunctionDecl& node) override;
+    void visit(StructDecl& node) override;
+
+    // Statement visitors
+    void visit(BlockStmt& node) override;
+    void visit(IfStmt& node) override;
+    void visit(WhileStmt& node) override;
+    void visit(ForStmt& node) override;
+    void visit(SwitchStmt& node) override;
+    void visit(ReturnStmt& node) override;
+    void visit(ExpressionStmt& node) override;
+
+private:
+    std::map<std::string, std::string> substitutions_;
+    ExpressionPtr exprResult_;
+    StatementPtr stmtResult_;
+
+    /// Copies an optional expression
+    ExpressionPtr cloneOptional(const ExpressionPtr& expr);
+    /// Copies an optional statement
+    StatementPtr cloneOptional(const StatementPtr& stmt);
+};
+
+} // namespace emlang
+
+#endif // EM_LANG_AST_CLONER_H
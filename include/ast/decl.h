@@ -28,13 +28,15 @@ public:
     std::optional<std::string> type; // Variable type (optional)
     ExpressionPtr initializer;       // Optional initializer expression
     bool isConstant;                 // true for const, false for let
+    bool isRestrict;                 // true if the pointer is qualified 'restrict'
     
     VariableDecl(
         const std::string& name, 
         const std::string& type, 
         ExpressionPtr init = nullptr, 
         bool isConst = false, 
-        size_t line = 0, size_t column = 0);
+        size_t line = 0, size_t column = 0,
+        bool isRestrict = false);
     
     // Delete copy constructor and assignment operator
     VariableDecl(const VariableDecl&) = delete;
@@ -51,6 +53,10 @@ public:
 /**
  * @class FunctionDeclaration
  * @brief Represents function declarations
+ * 
+ * A declaration with type parameters is a template: it is never generated
+ * itself. The semantic analyzer adds one instance per distinct list of type
+ * arguments, with the type parameters substituted and typeArguments set.
  * IMPLEMENT: FunctionDecl -> FnDecl, combine with extern function decl
  */
 class FunctionDecl : public Statement {
@@ -63,6 +69,9 @@ public:
     bool isAsync;                          // true if this is an async function declaration
     bool isUnsafe;                         // true if this is an unsafe function declaration
     std::optional<std::string> abi;        // ABI name for the function (optional)
+    std::vector<Attribute> attributes;     // Attributes written before the declaration
+    std::vector<TypeParameter> typeParameters; // Type parameters of a generic function
+    std::vector<std::string> typeArguments;    // Concrete types of a generic instance
     
     FunctionDecl(
         const std::string& name, 
@@ -82,6 +91,18 @@ public:
     FunctionDecl(FunctionDecl&&) = default;
     FunctionDecl& operator=(FunctionDecl&&) = default;
     
+    /**
+     * @brief Finds an attribute by name
+     * @param attrName Attribute name
+     * @return The attribute, or nullptr if the function does not carry it
+     */
+    const Attribute* findAttribute(const std::string& attrName) const;
+    
+    /**
+     * @brief Checks whether this is a generic template
+     */
+    bool isGeneric() const { return !typeParameters.empty(); }
+    
     std::string toString() const override;
     void accept(ASTVisitor& visitor) override;
 };
@@ -102,6 +123,45 @@ public:
     void accept(ASTVisitor& visitor) override;
 };
 
+/**
+ * @struct StructField
+ * @brief One field of a struct declaration
+ */
+struct StructField {
+    std::string name;   // Field name
+    std::string type;   // Field type
+    size_t line;        // Line of the field name
+    size_t column;      // Column of the field name
+};
+
+/**
+ * @class StructDeclaration
+ * @brief Represents struct declarations
+ * 
+ * Fields are kept in source order; the code generator decides the memory
+ * order from the layout attributes (#[packed], #[align(N)], #[reorder]).
+ * #[soa] keeps single values unchanged but stores arrays of the struct as
+ * one array per field.
+ */
+class StructDecl : public Statement {
+public:
+    std::string name;                   // Struct name
+    std::vector<StructField> fields;    // Fields in source order
+    std::vector<Attribute> attributes;  // Attributes written before the declaration
+    
+    StructDecl(const std::string& name, std::vector<StructField> fields, size_t line = 0, size_t column = 0);
+    
+    /**
+     * @brief Finds an attribute by name
+     * @param attrName Attribute name
+     * @return The attribute, or nullptr if the struct does not carry it
+     */
+    const Attribute* findAttribute(const std::string& attrName) const;
+    
+    std::string toString() const override;
+    void accept(ASTVisitor& visitor) override;
+};
+
 } // namespace emlang
 
 #endif // EM_LANG_AST_DECL_H
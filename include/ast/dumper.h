@@ -44,8 +44,10 @@ public:
     void visit(CastExpr& node) override;
 #endif // EMLANG_FEATURE_CASTING
     void visit(IndexExpr& node) override;
+    void visit(SliceExpr& node) override;
     void visit(ArrayExpr& node) override;
     void visit(ObjectExpr& node) override;
+    void visit(AwaitExpr& node) override;
 #ifdef EMLANG_FEATURE_POINTERS
     void visit(DereferenceExpr& node) override;
     void visit(AddressOfExpr& node) override;
@@ -55,12 +57,14 @@ public:
     void visit(VariableDecl& node) override;
     void visit(FunctionDecl& node) override;
     void visit(ExternFunctionDecl& node) override;
+    void visit(StructDecl& node) override;
     
     // Statement visitors
     void visit(BlockStmt& node) override;
     void visit(IfStmt& node) override;
     void visit(WhileStmt& node) override;
     void visit(ForStmt& node) override;
+    void visit(SwitchStmt& node) override;
     void visit(ReturnStmt& node) override;
     void visit(ExpressionStmt& node) override;
 
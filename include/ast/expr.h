@@ -108,7 +108,7 @@ public:
     //ExpressionPtr callee;                 // The function being called
     std::string functionName;               // Name of the function being called
     std::vector<ExpressionPtr> arguments;   // Function arguments
-    //std::vector<> generic_args;           // Generic arguments (if any)
+    std::vector<std::string> genericArgs;   // Deduced type arguments of a generic callee (if any)
     
     FunctionCallExpr(const std::string& name, std::vector<ExpressionPtr> args, size_t line = 0, size_t column = 0);
     
@@ -185,6 +185,22 @@ public:
     void accept(ASTVisitor& visitor) override;
 };
 
+/**
+ * @class SliceExpression
+ * @brief Represents sub-slicing operations (arr[start..end])
+ */
+class SliceExpr : public Expression {
+public:
+    ExpressionPtr array;        // Array, vector or slice being sliced
+    ExpressionPtr start;        // First element (optional, defaults to 0)
+    ExpressionPtr end;          // One past the last element (optional, defaults to the length)
+    
+    SliceExpr(ExpressionPtr array, ExpressionPtr start, ExpressionPtr end, size_t line = 0, size_t column = 0);
+
+    std::string toString() const override;
+    void accept(ASTVisitor& visitor) override;
+};
+
 /**
  * @class ArrayExpression
  * @brief Represents array literals ([1, 2, 3])
@@ -248,6 +264,24 @@ public:
     void accept(ASTVisitor& visitor) override;
 };
 
+/**
+ * @class AwaitExpression
+ * @brief Represents waiting for a task (await task)
+ *
+ * Inside an async function the task suspends until the awaited one
+ * finishes; elsewhere the executor runs ready tasks until it does.
+ */
+class AwaitExpr : public Expression {
+public:
+    ExpressionPtr operand;      // Task being awaited
+    std::string resultType;     // Result type of the task, set by the analyzer
+    
+    AwaitExpr(ExpressionPtr operand, size_t line = 0, size_t column = 0);
+    
+    std::string toString() const override;
+    void accept(ASTVisitor& visitor) override;
+};
+
 #ifdef EMLANG_FEATURE_POINTERS
 /**
  * @class DereferenceExpression
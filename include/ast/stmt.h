@@ -89,6 +89,10 @@ public:
 /**
  * @class ForStatement
  * @brief Represents for loop statements
+ *
+ * Either C-style (initializer; condition; increment) or a counted range
+ * `for i in start..end step s`, whose variable takes each value from start
+ * up to but excluding end.
  */
 class ForStmt : public Statement {
 public:
@@ -97,7 +101,14 @@ public:
     ExpressionPtr increment;    // Loop increment (optional)
     StatementPtr body;          // Loop body
     
+    std::string variable;       // Range form: induction variable (empty for C-style loops)
+    ExpressionPtr rangeStart;   // Range form: first value
+    ExpressionPtr rangeEnd;     // Range form: exclusive upper bound
+    ExpressionPtr step;         // Range form: positive constant step (optional, defaults to 1)
+    
     ForStmt(StatementPtr init, ExpressionPtr cond, ExpressionPtr incr, StatementPtr body, size_t line = 0, size_t column = 0);
+    ForStmt(const std::string& variable, ExpressionPtr start, ExpressionPtr end, ExpressionPtr step, StatementPtr body,
+            size_t line = 0, size_t column = 0);
     
     // Delete copy constructor and assignment operator
     ForStmt(const ForStmt&) = delete;
@@ -107,6 +118,47 @@ public:
     ForStmt(ForStmt&&) = default;
     ForStmt& operator=(ForStmt&&) = default;
     
+    bool isRange() const { return !variable.empty(); }
+    
+    std::string toString() const override;
+    void accept(ASTVisitor& visitor) override;
+};
+
+/**
+ * @struct SwitchCase
+ * @brief One arm of a switch statement
+ */
+struct SwitchCase {
+    std::vector<ExpressionPtr> labels;  // Constant case labels (empty for a bare default)
+    bool isDefault;                     // True if this arm is also the default
+    StatementPtr body;                  // Block holding the arm's statements
+    size_t line;                        // Line of the first label
+    size_t column;                      // Column of the first label
+};
+
+/**
+ * @class SwitchStatement
+ * @brief Represents multi-way branch statements
+ *
+ * Arms do not fall through: control leaves the switch at the end of the
+ * matching arm. Labels written back to back with no statements between
+ * them share the following arm.
+ */
+class SwitchStmt : public Statement {
+public:
+    ExpressionPtr discriminant;         // Value being matched
+    std::vector<SwitchCase> cases;      // Arms in source order
+    
+    SwitchStmt(ExpressionPtr discriminant, std::vector<SwitchCase> cases, size_t line = 0, size_t column = 0);
+    
+    // Delete copy constructor and assignment operator
+    SwitchStmt(const SwitchStmt&) = delete;
+    SwitchStmt& operator=(const SwitchStmt&) = delete;
+    
+    // Enable move constructor and assignment operator
+    SwitchStmt(SwitchStmt&&) = default;
+    SwitchStmt& operator=(SwitchStmt&&) = default;
+    
     std::string toString() const override;
     void accept(ASTVisitor& visitor) override;
 };
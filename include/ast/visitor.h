@@ -29,15 +29,19 @@ class AddressOfExpr;
 class MemberExpr;
 class CastExpr;
 class IndexExpr;
+class SliceExpr;
 class ArrayExpr;
 class ObjectExpr;
+class AwaitExpr;
 class VariableDecl;
 class FunctionDecl;
 class ExternFunctionDecl;
+class StructDecl;
 class BlockStmt;
 class IfStmt;
 class WhileStmt;
 class ForStmt;
+class SwitchStmt;
 class ReturnStmt;
 class ExpressionStmt;
 
@@ -69,8 +73,10 @@ public:
     virtual void visit(CastExpr& node) = 0;
 #endif
     virtual void visit(IndexExpr& node) = 0;
+    virtual void visit(SliceExpr& node) = 0;
     virtual void visit(ArrayExpr& node) = 0;
     virtual void visit(ObjectExpr& node) = 0;
+    virtual void visit(AwaitExpr& node) = 0;
 #ifdef EMLANG_FEATURE_POINTERS
     virtual void visit(DereferenceExpr& node) = 0;
     virtual void visit(AddressOfExpr& node) = 0;
@@ -80,12 +86,14 @@ public:
     virtual void visit(VariableDecl& node) = 0;
     virtual void visit(FunctionDecl& node) = 0;
     virtual void visit(ExternFunctionDecl& node) = 0;
+    virtual void visit(StructDecl& node) = 0;
     
     // Statement visitors
     virtual void visit(BlockStmt& node) = 0;
     virtual void visit(IfStmt& node) = 0;
     virtual void visit(WhileStmt& node) = 0;
     virtual void visit(ForStmt& node) = 0;
+    virtual void visit(SwitchStmt& node) = 0;
     virtual void visit(ReturnStmt& node) = 0;
     virtual void visit(ExpressionStmt& node) = 0;
 };
@@ -53,6 +53,54 @@ bool isBuiltinFunction(const std::string& name);
  */
 const BuiltinFunction* getBuiltinFunction(const std::string& name);
 
+/**
+ * @brief Check if a function name is a vector intrinsic (vec_push, vec_len, ...)
+ * 
+ * Vector intrinsics are generic over the element type, so they are type
+ * checked and lowered by the compiler instead of being bound to a fixed
+ * runtime signature.
+ * @param name Function name to check
+ * @return True if it's a vector intrinsic
+ */
+bool isVecIntrinsic(const std::string& name);
+
+/**
+ * @brief Check if a function name is an optimizer hint (likely, unlikely, prefetch)
+ * 
+ * Hints have no runtime function behind them; they are lowered to LLVM
+ * intrinsics or branch-weight metadata by the compiler.
+ * @param name Function name to check
+ * @return True if it's an optimizer hint
+ */
+bool isHintIntrinsic(const std::string& name);
+
+/**
+ * @brief Check if a function name is a slice intrinsic (slice_len)
+ * @param name Function name to check
+ * @return True if it's a slice intrinsic
+ */
+bool isSliceIntrinsic(const std::string& name);
+
+/**
+ * @brief Check if a function name is a whole-array intrinsic (sum)
+ * 
+ * Whole-array intrinsics take an array, slice or whole-array expression
+ * and are lowered to a single loop over its elements.
+ * @param name Function name to check
+ * @return True if it's a whole-array intrinsic
+ */
+bool isArrayIntrinsic(const std::string& name);
+
+/**
+ * @brief Check if a function name is a task intrinsic (yield_now)
+ * 
+ * Task intrinsics suspend the calling async function, so they only exist
+ * inside async functions and are lowered to coroutine suspend points.
+ * @param name Function name to check
+ * @return True if it's a task intrinsic
+ */
+bool isTaskIntrinsic(const std::string& name);
+
 } // namespace emlang
 
 #endif // EMLANG_BUILTINS_H
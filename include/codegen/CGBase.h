@@ -108,6 +108,14 @@ public:
      */
     virtual void setCurrentValue(llvm::Value* value, const std::string& type);
 
+    /**
+     * @brief Wires the specialized visitors that nodes outside this visitor's category are routed to
+     * @param exprVisitor Expression visitor (can be null)
+     * @param declVisitor Declaration visitor (can be null)
+     * @param stmtVisitor Statement visitor (can be null)
+     */
+    void setVisitors(CGExpr* exprVisitor, CGDecl* declVisitor, CGStmt* stmtVisitor);
+
     /******************** Error Handling ********************/
     
     /**
@@ -131,37 +139,66 @@ public:
     // Program visitor - must be implemented by concrete classes
     void visit(Program& node) override;
 
-    // Expression visitors - default empty implementations for non-expression visitors
-    void visit(LiteralExpr& node) override {}
-    void visit(IdentifierExpr& node) override {}
-    void visit(BinaryOpExpr& node) override {}
-    void visit(UnaryOpExpr& node) override {}
-    void visit(AssignmentExpr& node) override {}
-    void visit(FunctionCallExpr& node) override {}
-    void visit(MemberExpr& node) override {}
+    // Expression visitors - default implementations forward to the expression visitor
+    void visit(LiteralExpr& node) override;
+    void visit(IdentifierExpr& node) override;
+    void visit(BinaryOpExpr& node) override;
+    void visit(UnaryOpExpr& node) override;
+    void visit(AssignmentExpr& node) override;
+    void visit(FunctionCallExpr& node) override;
+    void visit(MemberExpr& node) override;
 #ifdef EMLANG_FEATURE_CASTING
-    void visit(CastExpr& node) override {}
+    void visit(CastExpr& node) override;
 #endif
-    void visit(IndexExpr& node) override {}
-    void visit(ArrayExpr& node) override {}
-    void visit(ObjectExpr& node) override {}
+    void visit(IndexExpr& node) override;
+    void visit(SliceExpr& node) override;
+    void visit(ArrayExpr& node) override;
+    void visit(ObjectExpr& node) override;
+    void visit(AwaitExpr& node) override;
 #ifdef EMLANG_FEATURE_POINTERS
-    void visit(DereferenceExpr& node) override {}
-    void visit(AddressOfExpr& node) override {}
+    void visit(DereferenceExpr& node) override;
+    void visit(AddressOfExpr& node) override;
 #endif
 
-    // Declaration visitors - default empty implementations for non-declaration visitors
-    void visit(VariableDecl& node) override {}
-    void visit(FunctionDecl& node) override {}
-    void visit(ExternFunctionDecl& node) override {}
+    // Declaration visitors - default implementations forward to the declaration visitor
+    void visit(VariableDecl& node) override;
+    void visit(FunctionDecl& node) override;
+    void visit(ExternFunctionDecl& node) override;
+    void visit(StructDecl& node) override;
     
-    // Statement visitors - default empty implementations for non-statement visitors
-    void visit(BlockStmt& node) override {}
-    void visit(IfStmt& node) override {}
-    void visit(WhileStmt& node) override {}
-    void visit(ForStmt& node) override {}
-    void visit(ReturnStmt& node) override {}
-    void visit(ExpressionStmt& node) override {}
+    // Statement visitors - default implementations forward to the statement visitor
+    void visit(BlockStmt& node) override;
+    void visit(IfStmt& node) override;
+    void visit(WhileStmt& node) override;
+    void visit(ForStmt& node) override;
+    void visit(SwitchStmt& node) override;
+    void visit(ReturnStmt& node) override;
+    void visit(ExpressionStmt& node) override;
+
+protected:
+    /******************** Forwarding Helpers ********************/
+
+    /**
+     * @brief Visits a node with another specialized visitor and takes over its result
+     * @param node AST node to visit
+     * @param visitor Visitor to route to (ignored when null or this)
+     */
+    void forward(ASTNode& node, CGBase* visitor);
+
+    /**
+     * @brief Converts a value to the given LLVM type (int resize, int/float, float resize)
+     * @param value Value to convert
+     * @param type Destination type
+     * @param isUnsigned Whether the integer side is unsigned (zero-extend, uitofp/fptoui)
+     * @return Converted value, or the original value when no conversion applies
+     */
+    llvm::Value* convertValue(llvm::Value* value, llvm::Type* type, bool isUnsigned = false);
+
+    /**
+     * @brief Attributes instructions generated next to a node's source position (no-op without -g)
+     * @param node AST node being generated
+     */
+    void emitLocation(const ASTNode& node);
 };
 
 } // namespace codegen
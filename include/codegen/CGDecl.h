@@ -22,6 +22,7 @@
 #include "codegen_error.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Function.h>
@@ -33,6 +34,7 @@ namespace emlang {
 class VariableDecl;
 class FunctionDecl;
 class ExternFunctionDecl;
+class StructDecl;
 
 namespace codegen {
 
@@ -48,6 +50,7 @@ class CGDecl : public CGBase {
 private:
     llvm::Function* currentFunction;
     std::string currentExpressionType; // Tracks the type of the current expression
+    std::vector<std::string> instrumentedFunctions; // Function names by instrumentation ID
 
 public:
     /******************** Constructor ********************/
@@ -71,6 +74,7 @@ public:
     void visit(VariableDecl& node) override;
     void visit(FunctionDecl& node) override;
     void visit(ExternFunctionDecl& node) override;
+    void visit(StructDecl& node) override;
 
     /******************** Utility Methods ********************/
 
@@ -93,6 +97,13 @@ public:
      */
     void setCurrentValue(llvm::Value* value, const std::string& type) override;
 
+    /******************** Instrumentation ********************/
+
+    /**
+     * @brief Emits the instrumented-function name table and its registration constructor
+     */
+    void emitInstrumentationTable();
+
 private:
     /******************** Generation Methods ********************/
 
@@ -117,6 +128,18 @@ private:
      */
     llvm::Function* generateExternFunctionDecl(ExternFunctionDecl& node);
 
+    /**
+     * @brief Lays out a struct declaration and registers its LLVM type
+     * 
+     * Fields stay in source order unless #[reorder] sorts them by falling
+     * alignment, which removes interior padding. #[packed] drops padding
+     * altogether, and #[align(N)] pads the tail so array elements each
+     * start on an N-byte boundary.
+     * @param node The struct declaration AST node
+     * @return Generated LLVM struct type
+     */
+    llvm::StructType* generateStructDecl(StructDecl& node);
+
     /******************** Helper Methods ********************/
 
     /**
@@ -126,6 +149,55 @@ private:
      */
     void createFunctionParameters(llvm::Function* function, FunctionDecl& node);
 
+    /**
+     * @brief Translates #[...] attributes of a declaration into LLVM function attributes
+     * 
+     * inline(always) -> alwaysinline, noinline/inline(never) -> noinline,
+     * hot -> hot, cold -> cold + optsize, pure -> memory(none),
+     * optnone/opt(0) -> optnone + noinline, opt(s) -> optsize,
+     * opt(z) -> minsize + optsize. opt(1..3) keep the module pipeline and
+     * only suppress the size attributes cold would add. fast_math (or
+     * -ffast-math) sets the unsafe-fp-math family for the backend.
+     * @param function LLVM function to annotate
+     * @param node Function declaration AST node
+     */
+    void applyFunctionAttributes(llvm::Function* function, FunctionDecl& node);
+
+    /**
+     * @brief Gets the fast-math flags for floating-point operations in a function body
+     * 
+     * -ffast-math and #[fast_math] allow every flag; -ffp-contract=fast
+     * alone only allows contracting a*b+c into an FMA.
+     * @param node Function declaration AST node
+     * @return Flags the builder attaches to each floating-point instruction
+     */
+    llvm::FastMathFlags getFastMathFlags(FunctionDecl& node) const;
+
+    /**
+     * @brief Attaches scoped alias metadata to accesses through restrict pointers
+     * 
+     * Every restrict parameter or local gets its own alias scope; its loads
+     * and stores are tagged with that scope and marked noalias against all
+     * other restrict scopes of the function. Unlike the noalias argument
+     * attribute this also covers locals and survives inlining.
+     * @param function Function with a complete body
+     */
+    void emitAliasScopes(llvm::Function* function);
+
+    /**
+     * @brief Splits a finished #[target_clones] function into per-target clones
+     * 
+     * The generated body becomes the "default" clone and each feature target
+     * gets a copy compiled with those target features. The function's name
+     * goes to a dispatcher that tail-calls through a pointer, which a module
+     * constructor sets to the first target the running CPU supports. This
+     * works on every object format, unlike ELF ifuncs.
+     * @param function Function with a complete body
+     * @param node Function declaration AST node
+     * @return The dispatcher, which callers should use from now on
+     */
+    llvm::Function* emitTargetClones(llvm::Function* function, FunctionDecl& node);
+
     /**
      * @brief Validates function signature compatibility
      * @param node Function declaration AST node
@@ -139,6 +211,16 @@ private:
      * @return true if valid, false otherwise
      */
     bool validateExternFunctionDecl(ExternFunctionDecl& node);
+
+    /**
+     * @brief Adds entry/exit instrumentation to a finished function
+     * 
+     * Hooks mode calls emlang_funcprof_enter after the entry allocas and
+     * emlang_funcprof_exit before every return; XRay mode only marks the
+     * function so the backend emits patchable sleds.
+     * @param function Function with a complete body
+     */
+    void instrumentFunction(llvm::Function* function);
 };
 
 } // namespace codegen
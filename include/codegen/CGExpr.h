@@ -17,8 +17,14 @@
 
 #include <emlang_export.h>
 #include "CGBase.h"
+#include <llvm/IR/ConstantRange.h>
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace emlang {
 namespace codegen {
@@ -33,7 +39,45 @@ namespace codegen {
  */
 class CGExpr : public CGBase {
 private:
+    /**
+     * @struct ArrayOperand
+     * @brief A leaf of a whole-array expression, evaluated once before its loop
+     */
+    struct ArrayOperand {
+        llvm::Value* data = nullptr;        ///< First element, for array and slice operands
+        llvm::Value* length = nullptr;      ///< Element count (i64), for array and slice operands
+        llvm::Value* scalar = nullptr;      ///< Value applied to every element, for scalar operands
+        bool isUnsigned = false;            ///< Whether a scalar operand has an unsigned type
+        std::string elementType;            ///< EMLang element type, for array and slice operands
+    };
+    using ArrayOperands = std::vector<std::pair<const Expression*, ArrayOperand>>;
+
+    /**
+     * @struct Coroutine
+     * @brief The async function being generated, lowered to a switched-resume coroutine
+     */
+    struct Coroutine {
+        llvm::Value* id = nullptr;                  ///< Token from llvm.coro.id
+        llvm::Value* handle = nullptr;              ///< Frame address from llvm.coro.begin, returned as the task
+        llvm::AllocaInst* promise = nullptr;        ///< {waiter, result}; lives in the frame at a fixed offset
+        llvm::StructType* promiseType = nullptr;    ///< Type of the promise
+        llvm::BasicBlock* finalBlock = nullptr;     ///< Wakes the waiter and suspends for the last time
+        llvm::BasicBlock* cleanupBlock = nullptr;   ///< Frees the frame when the task is destroyed
+        llvm::BasicBlock* suspendBlock = nullptr;   ///< Returns to whoever started or resumed the task
+    };
+
     std::string currentExpressionType;
+    std::vector<std::pair<std::string, int>> heapProfileSites; ///< (function, line) per allocation site ID
+    std::set<const IndexExpr*> hoistedChecks;   ///< Element accesses whose range was checked before their loop
+    std::map<const llvm::Value*, llvm::ConstantRange> valueRanges; ///< Known ranges of integer values (--checked-arith)
+    std::map<llvm::Function*, llvm::PHINode*> overflowTraps;       ///< Shared overflow failure block of each function, by its line phi
+    unsigned overflowChecksEmitted = 0;         ///< Overflow checks emitted under --checked-arith
+    unsigned overflowChecksRemoved = 0;         ///< Overflow checks dropped because the result provably fits
+    Coroutine coroutine;                        ///< Async function being generated; handle is null outside one
+    static constexpr unsigned promiseAlignment = 8; ///< Alignment of every promise, which llvm.coro.promise relies on
+    std::map<std::string, std::string> taskTypes; ///< task<T> returned by each async function, by name
+    std::map<llvm::Constant*, llvm::GlobalVariable*> arrayTables; ///< Read-only copy of each distinct constant array literal
+    static constexpr size_t arrayFillLoopThreshold = 8; ///< Repeats of one runtime value stored by a loop instead of one by one
 
 public:
     /******************** Construction ********************/
@@ -68,8 +112,10 @@ public:
     void visit(CastExpr& node) override;
 #endif
     void visit(IndexExpr& node) override;
+    void visit(SliceExpr& node) override;
     void visit(ArrayExpr& node) override;
     void visit(ObjectExpr& node) override;
+    void visit(AwaitExpr& node) override;
 #ifdef EMLANG_FEATURE_POINTERS
     void visit(DereferenceExpr& node) override;
     void visit(AddressOfExpr& node) override;
@@ -92,6 +138,468 @@ public:
      * @return Current expression type as string
      */
     const std::string& getCurrentExpressionType() const { return currentExpressionType; }
+
+    /**
+     * @brief Checks whether an EMLang type is an unsigned integer
+     */
+    static bool isUnsignedType(const std::string& type);
+
+    /******************** Vector Lowering ********************/
+
+    /**
+     * @brief Generates the initial handle for a vec<T> variable
+     * 
+     * No initializer allocates an empty vector, an array literal allocates
+     * and bulk-appends its elements, anything else is evaluated as a handle.
+     * @param vecType Vector type string (e.g. "vec<int32>")
+     * @param initializer Optional initializer expression
+     * @return Vector handle (emlang_vec*)
+     */
+    llvm::Value* generateVecInit(const std::string& vecType, Expression* initializer);
+
+    /******************** Struct Lowering ********************/
+
+    /**
+     * @brief Builds a struct value from an object literal
+     * 
+     * Fields missing from the literal are zero. With constant field values
+     * the result folds to a constant, so it also initializes globals.
+     * @param structType Name of the struct
+     * @param node Object literal naming the fields
+     * @return Struct value, or nullptr on error
+     */
+    llvm::Value* generateStructLiteral(const std::string& structType, ObjectExpr& node);
+
+    /******************** Array Literals ********************/
+
+    /**
+     * @brief Folds an array literal whose elements are all literals to a constant
+     * @param elementType Element type, or empty to take the first element's type
+     * @param node Array literal
+     * @return Constant array, or nullptr if an element is computed at run time
+     */
+    llvm::Constant* generateConstantArray(const std::string& elementType, ArrayExpr& node);
+
+    /**
+     * @brief Gets the private unnamed_addr constant global holding an array
+     * 
+     * Equal arrays share one global.
+     * @param values Array contents
+     * @return Global in read-only data
+     */
+    llvm::GlobalVariable* getArrayTable(llvm::Constant* values);
+
+    /**
+     * @brief Initializes array storage from an array literal
+     * 
+     * The literal's constant elements are copied with one llvm.memcpy from a
+     * read-only template, in which runtime elements are zero. Runtime elements
+     * are then stored one by one, except that runs of one repeated variable
+     * are filled by a loop.
+     * @param arrayType Fixed array type string (e.g. "int32[4]")
+     * @param node Array literal with as many elements as the array
+     * @param storage Address of the array
+     */
+    void generateArrayInit(const std::string& arrayType, ArrayExpr& node, llvm::Value* storage);
+
+    /******************** Bounds Checks ********************/
+
+    /**
+     * @brief Marks element accesses whose range has been checked once before their loop
+     * 
+     * Until endHoistedChecks, these accesses skip their own bounds check
+     * under --bounds-checks.
+     * @param elements Index expressions covered by the loop's range check
+     */
+    void beginHoistedChecks(const std::vector<IndexExpr*>& elements);
+
+    /**
+     * @brief Restores the per-access bounds checks of beginHoistedChecks
+     * @param elements Index expressions passed to beginHoistedChecks
+     */
+    void endHoistedChecks(const std::vector<IndexExpr*>& elements);
+
+    /******************** Overflow Checks ********************/
+
+    /**
+     * @brief Records the values an integer can take, for --checked-arith
+     * 
+     * Arithmetic on values with known ranges skips its overflow check
+     * when the result provably fits, as for `i + 1` on a range-for variable.
+     * @param value Integer value
+     * @param range Values it can take
+     */
+    void setValueRange(llvm::Value* value, const llvm::ConstantRange& range);
+
+    /**
+     * @brief Gets the values an integer can take, as far as codegen knows
+     * 
+     * Constants, recorded values and extensions of narrower integers have
+     * a known range; anything else may take any value.
+     * @param value Integer value
+     */
+    llvm::ConstantRange getValueRange(llvm::Value* value) const;
+
+    /**
+     * @brief Gets the number of overflow checks emitted under --checked-arith
+     */
+    unsigned getOverflowChecksEmitted() const { return overflowChecksEmitted; }
+
+    /**
+     * @brief Gets the number of overflow checks the range analysis removed
+     */
+    unsigned getOverflowChecksRemoved() const { return overflowChecksRemoved; }
+
+    /******************** Coroutine Lowering ********************/
+
+    /**
+     * @brief Turns the function being generated into the coroutine of an async function
+     * 
+     * Emits the frame allocation and llvm.coro.begin at the insertion point,
+     * which must be in the entry block; the body follows. The function
+     * returns the frame address, which callers hold as the task. The frame
+     * comes from emlang_coro_alloc unless CoroElide places it in the
+     * awaiting caller's frame.
+     * @param function Function being generated, returning ptr
+     * @param resultType EMLang return type of the async function
+     * @return false if the result type is unknown; nothing has been emitted then
+     */
+    bool beginCoroutine(llvm::Function* function, const std::string& resultType);
+
+    /**
+     * @brief Checks whether an async function is being generated
+     */
+    bool inCoroutine() const { return coroutine.handle != nullptr; }
+
+    /**
+     * @brief Lowers `return` in an async function
+     * 
+     * Stores the result in the promise, where the awaiting task reads it,
+     * and branches to the final suspend point.
+     * @param value Returned value, just generated so its type is current, or nullptr for a void task
+     * @return The branch emitted
+     */
+    llvm::Value* generateCoroutineReturn(llvm::Value* value);
+
+    /**
+     * @brief Completes the coroutine begun by beginCoroutine after its body
+     * 
+     * Falling off the end of the body returns as from a void task.
+     */
+    void endCoroutine();
+
+    /******************** Heap Profiling ********************/
+
+    /**
+     * @brief Emits the call-site table and a constructor that registers it
+     * 
+     * Site IDs passed to emlang_heapprof_malloc index this table, which
+     * names the enclosing function and source line of each allocation.
+     */
+    void emitHeapProfileSites();
+
+private:
+    /******************** Arithmetic Helpers ********************/
+
+    /**
+     * @brief Emits a floating-point +, -, *, / or %
+     * 
+     * The instruction carries the builder's fast-math flags, which the
+     * enclosing function sets from -ffast-math, -ffp-contract=fast or
+     * #[fast_math].
+     * @param op ADD, SUB, MUL, DIV or MOD
+     * @param left Left operand
+     * @param right Right operand, of the same type
+     * @return Result of the operation
+     */
+    llvm::Value* generateFloatArithmetic(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right);
+
+    /**
+     * @brief Emits a comparison of two operands of the same type
+     * 
+     * Floats use ordered predicates, except != which also holds for NaN.
+     * @param op LT, GT, LE, GE, EQ or NE
+     * @param left Left operand
+     * @param right Right operand
+     * @param isFloat Whether the operands are floating-point
+     * @param isUnsigned Whether integer operands are unsigned
+     * @return i1 result
+     */
+    llvm::Value* generateComparison(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right,
+                                    bool isFloat, bool isUnsigned);
+
+    /**
+     * @brief Lowers a math builtin to the matching LLVM intrinsic under -fno-math-errno
+     * @param node Call to emlang_sin or emlang_cos
+     * @return true if the call was lowered, false if it must stay a runtime call
+     */
+    bool generateMathIntrinsic(FunctionCallExpr& node);
+
+    /******************** Array Literal Helpers ********************/
+
+    /**
+     * @brief Checks whether an array literal element is known without running code
+     * 
+     * Literals and negated numeric literals qualify.
+     */
+    static bool isConstantElement(Expression& element);
+    /// Evaluates a constant element converted to type, or to its own type if type is null
+    llvm::Constant* generateConstantElement(Expression& element, llvm::Type* type);
+
+    /******************** Address Helpers ********************/
+
+    /**
+     * @brief Computes the address of a variable, struct field or array/vector element
+     * 
+     * Fields of #[soa] array elements resolve straight into the field's
+     * column, so `a[i].x` touches only the x array.
+     * @param expr Expression to locate
+     * @param address Set to the address, or nullptr if an error was reported
+     * @param type Set to the EMLang type stored at the address
+     * @return false if expr is not addressable; nothing has been emitted then
+     */
+    bool generateAddress(Expression& expr, llvm::Value*& address, std::string& type);
+
+    /**
+     * @brief Computes the address of an element of a fixed-size array or vector
+     * @param element Index expression
+     * @param arrayPtr Address of the array (or of the variable holding the vector handle)
+     * @param arrayType EMLang type of the array or vector
+     * @param address Set to the element address, or nullptr if an error was reported
+     * @param type Set to the EMLang element type
+     * @return false if arrayType is neither an array nor a vector; nothing has been emitted then
+     */
+    bool generateElementAddress(IndexExpr& element, llvm::Value* arrayPtr, const std::string& arrayType,
+                                llvm::Value*& address, std::string& type);
+
+    /**
+     * @brief Computes the address of a slice element
+     * @param element Index expression
+     * @param slice Slice value ({data, length})
+     * @param sliceType EMLang slice type ("[]T")
+     * @param address Set to the element address, or nullptr if an error was reported
+     * @param type Set to the EMLang element type
+     */
+    void generateSliceElementAddress(IndexExpr& element, llvm::Value* slice, const std::string& sliceType,
+                                     llvm::Value*& address, std::string& type);
+
+    /**
+     * @brief Evaluates an element index, widened to i64 by the signedness of its type
+     * @param index Index expression
+     * @return i64 index, or nullptr on error
+     */
+    llvm::Value* generateIndex(Expression& index);
+
+    /**
+     * @brief Emits the bounds check of an element access under --bounds-checks
+     * 
+     * Accesses covered by a hoisted loop check, and builds without
+     * --bounds-checks, emit nothing.
+     * @param element Index expression being checked
+     * @param index Element index (any integer width)
+     * @param length Number of elements (i64)
+     */
+    void generateBoundsCheck(IndexExpr& element, llvm::Value* index, llvm::Value* length);
+
+    /**
+     * @brief Branches to a cold block calling a no-return failure handler unless inRange holds
+     * @param inRange Condition that holds for valid accesses
+     * @param failFunction Runtime function reporting the failure
+     * @param args Arguments passed to the failure handler
+     */
+    void generateRangeCheck(llvm::Value* inRange, const std::string& failFunction, llvm::ArrayRef<llvm::Value*> args);
+
+    /**
+     * @brief Declares (once) and returns a bounds-, length- or overflow-check failure handler
+     * @param name Runtime function name (see emlang_checks.h)
+     * @return Callee for the no-return handler
+     */
+    llvm::FunctionCallee getCheckRuntime(const std::string& name);
+
+    /******************** Overflow Check Helpers ********************/
+
+    /**
+     * @brief Emits +, - or * under --checked-arith
+     * 
+     * When the operand ranges prove the exact result fits, emits a plain
+     * nsw/nuw operation. Otherwise emits the matching with.overflow
+     * intrinsic and branches to the function's shared failure block.
+     * @param op ADD, SUB or MUL
+     * @param left Left operand
+     * @param right Right operand, of the same type
+     * @param isUnsigned Whether the operands are unsigned
+     * @param line Source line reported on overflow
+     * @return Result of the operation
+     */
+    llvm::Value* generateCheckedArithmetic(BinaryOpExpr::BinOp op, llvm::Value* left, llvm::Value* right,
+                                           bool isUnsigned, size_t line);
+
+    /**
+     * @brief Gets the current function's cold overflow failure block, creating it on first use
+     * @return Phi selecting the source line passed to emlang_overflow_fail
+     */
+    llvm::PHINode* getOverflowTrap();
+
+    /******************** Coroutine Helpers ********************/
+
+    /**
+     * @brief Declares (once) and returns an emlang_coro_* or emlang_task_* runtime function
+     * @param name Runtime function name
+     * @return Callee for the runtime function
+     */
+    llvm::FunctionCallee getTaskRuntime(const std::string& name);
+
+    /**
+     * @brief Suspends the current coroutine and continues where it is resumed
+     * 
+     * Destroying the task while suspended here runs the frame cleanup.
+     * @param save Token from llvm.coro.save, taken before the task was handed to another party
+     */
+    void generateSuspend(llvm::Value* save);
+
+    /**
+     * @brief Lowers yield_now() to rescheduling the current task and suspending
+     * @param node Function call node naming the intrinsic
+     */
+    void generateYield(FunctionCallExpr& node);
+
+    /******************** Whole-Array Helpers ********************/
+
+    /**
+     * @brief Checks whether an expression is arithmetic over arrays or slices
+     * 
+     * Such expressions are never evaluated as values; assignment and sum
+     * lower them to one loop over the elements.
+     */
+    bool isWholeArrayExpression(Expression& expr);
+
+    /**
+     * @brief Checks whether an operand is an array or slice, or a whole-array expression
+     */
+    bool hasArrayOperand(Expression& expr);
+
+    /**
+     * @brief Evaluates the leaves of a whole-array expression, left to right
+     * @param expr Whole-array expression or leaf
+     * @param operands Receives one entry per leaf
+     * @return false if a leaf failed to generate
+     */
+    bool prepareArrayOperands(Expression& expr, ArrayOperands& operands);
+
+    /**
+     * @brief Converts scalar operands to the element type and checks array lengths
+     * 
+     * Under --bounds-checks, every array operand whose length is not the
+     * loop's reports a mismatch; equal constant lengths emit nothing.
+     * @param operands Prepared operands
+     * @param length Trip count of the loop (i64)
+     * @param elementType LLVM element type
+     */
+    void finishArrayOperands(ArrayOperands& operands, llvm::Value* length, llvm::Type* elementType);
+
+    /**
+     * @brief Emits one element of a whole-array expression
+     * @param expr Whole-array expression or leaf
+     * @param operands Prepared operands
+     * @param index Element index (i64)
+     * @param elementType LLVM element type
+     * @param isUnsigned Whether integer division and remainder are unsigned
+     * @return Element value
+     */
+    llvm::Value* generateArrayElement(Expression& expr, const ArrayOperands& operands, llvm::Value* index,
+                                      llvm::Type* elementType, bool isUnsigned);
+
+    /**
+     * @brief Tests at run time whether an operand views the target's memory at another offset
+     * 
+     * Operands at the target's own address, and distinct array variables,
+     * are known not to overlap and emit nothing.
+     * @param operands Prepared operands
+     * @param data First element of the target
+     * @param length Element count of the target (i64)
+     * @param elementType LLVM element type
+     * @return i1 that holds when some operand partially overlaps the target, or nullptr if none can
+     */
+    llvm::Value* generateArrayOverlap(const ArrayOperands& operands, llvm::Value* data, llvm::Value* length,
+                                      llvm::Type* elementType);
+
+    /**
+     * @brief Emits a loop over [0, length) marked for vectorization
+     * @param length Element count (i64)
+     * @param initial Initial accumulator value, or nullptr for a loop without one
+     * @param body Emits one iteration given the index and accumulator; returns the next accumulator
+     * @return Final accumulator value, or nullptr without an accumulator
+     */
+    llvm::Value* generateArrayLoop(llvm::Value* length, llvm::Value* initial,
+                                   const std::function<llvm::Value*(llvm::Value*, llvm::Value*)>& body);
+
+    /**
+     * @brief Lowers `target = <whole-array expression>` to a single fused loop
+     * @param node Assignment whose value is a whole-array expression
+     */
+    void generateArrayAssignment(AssignmentExpr& node);
+
+    /**
+     * @brief Lowers sum(...) to a single fused reduction loop
+     * @param node Function call node naming the intrinsic
+     */
+    void generateArraySum(FunctionCallExpr& node);
+
+    /******************** Vector Helpers ********************/
+
+    /**
+     * @brief Gets the element type string of a vector type ("vec<T>" -> "T")
+     */
+    static std::string vecElementType(const std::string& vecType);
+
+    /**
+     * @brief Declares (once) and returns an emlang_vec_* runtime function
+     * @param name Runtime function name
+     * @return Callee for the runtime function
+     */
+    llvm::FunctionCallee getVecRuntime(const std::string& name);
+
+    /**
+     * @brief Computes the address of a vector element with an inline bounds check
+     * 
+     * Loads data and length from the header, compares the index unsigned
+     * against the length and branches to a cold block that reports the
+     * failure, so in-range accesses never call into the runtime.
+     * @param vec Vector handle
+     * @param index Element index (any integer width)
+     * @param elementType LLVM element type
+     * @return Element address
+     */
+    llvm::Value* generateVecElementPtr(llvm::Value* vec, llvm::Value* index, llvm::Type* elementType);
+
+    /**
+     * @brief Lowers a vector intrinsic call (vec_push, vec_len, ...)
+     * @param node Function call node naming the intrinsic
+     */
+    void generateVecIntrinsic(FunctionCallExpr& node);
+
+    /**
+     * @brief Lowers likely/unlikely to llvm.expect and prefetch to llvm.prefetch
+     * @param node Function call node naming the hint
+     */
+    void generateHintIntrinsic(FunctionCallExpr& node);
+
+    /**
+     * @brief Declares a builtin library function on first use
+     * @param name EMLang-level builtin name
+     * @return Declared function, or nullptr if name is not a builtin
+     */
+    llvm::Function* declareBuiltinFunction(const std::string& name);
+
+    /******************** Heap Profiling Helpers ********************/
+
+    /**
+     * @brief Lowers an emlang_malloc/emlang_free call to its profiled runtime variant
+     * @param node Function call node
+     * @param args Already generated arguments
+     * @return true if the call was lowered, false if it is not an allocation builtin
+     */
+    bool generateProfiledAllocation(FunctionCallExpr& node, const std::vector<llvm::Value*>& args);
 };
 
 } // namespace codegen
@@ -20,11 +20,16 @@
 #include "context.h"
 #include "value_map.h"
 #include "codegen_error.h"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <llvm/IR/Value.h>
 #include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/ConstantRange.h>
 
 namespace emlang {
 
@@ -33,8 +38,13 @@ class BlockStmt;
 class IfStmt;
 class WhileStmt;
 class ForStmt;
+class SwitchStmt;
 class ReturnStmt;
 class ExpressionStmt;
+class Statement;
+class Expression;
+class AssignmentExpr;
+class IndexExpr;
 
 namespace codegen {
 
@@ -53,6 +63,21 @@ class CGStmt : public CGBase {
 private:
     CGExpr& exprGenerator;
     llvm::BasicBlock* currentBlock;
+    std::set<std::string> addressTaken;     ///< Variables of the current function whose address is taken
+    bool addressesKnown;                    ///< false if the function body could not be scanned for them
+
+    /**
+     * @struct CountedLoop
+     * @brief A loop stepping a counter up to an invariant bound, with the a[i] accesses it makes
+     */
+    struct CountedLoop {
+        std::string counter;                ///< Local signed integer counter
+        Expression* bound = nullptr;        ///< Upper bound, unchanged by the loop
+        bool inclusive = false;             ///< true for counter <= bound, false for counter < bound
+        int64_t step = 0;                   ///< Positive constant added once per iteration
+        std::vector<IndexExpr*> accesses;   ///< Accesses a[counter] whose array keeps its length in the loop
+        bool innermost = true;              ///< false if the body nests another loop
+    };
 
 public:
     /******************** Construction ********************/
@@ -78,9 +103,19 @@ public:
     void visit(IfStmt& node) override;
     void visit(WhileStmt& node) override;
     void visit(ForStmt& node) override;
+    void visit(SwitchStmt& node) override;
     void visit(ReturnStmt& node) override;
     void visit(ExpressionStmt& node) override;
 
+    /**
+     * @brief Prepares for the body of a new function
+     * 
+     * Records the variables whose address the body takes anywhere, since a
+     * pointer made before or after a loop can still reach it from a call.
+     * @param body Function body
+     */
+    void beginFunction(Statement& body);
+
     /******************** Utility Methods ********************/
 
     /**
@@ -119,6 +154,15 @@ private:
      */
     llvm::BasicBlock* generateWhile(WhileStmt& node);
 
+    /**
+     * @brief Generates one copy of a while loop that exits to afterBB
+     * @param node The while statement AST node
+     * @param condition Loop condition with any branch hint stripped
+     * @param weights Branch weights of the hint, or nullptr
+     * @param afterBB Block the loop exits to
+     */
+    void generateWhileLoop(WhileStmt& node, Expression& condition, llvm::MDNode* weights, llvm::BasicBlock* afterBB);
+
     /**
      * @brief Generates LLVM IR for a for loop statement
      * @param node The for statement AST node
@@ -126,6 +170,44 @@ private:
      */
     llvm::BasicBlock* generateFor(ForStmt& node);
 
+    /**
+     * @brief Generates LLVM IR for a `for i in start..end step s` loop
+     * 
+     * Emits a canonical counted loop: the bounds are evaluated once, an
+     * entry guard skips empty ranges, and the preheader computes the last
+     * value of the variable, which the latch compares against.
+     * @param node The for statement AST node in its range form
+     * @return Last generated LLVM basic block
+     */
+    llvm::BasicBlock* generateRangeFor(ForStmt& node);
+
+    /**
+     * @brief Generates one copy of a range loop that exits to afterBB
+     * 
+     * The variable is a phi stepped with an nsw add, so the loop needs no
+     * alloca and its trip count is visible before mem2reg.
+     * @param node The for statement AST node in its range form
+     * @param start First value of the variable
+     * @param last Last value of the variable
+     * @param step Constant step
+     * @param variableType EMLang type of the variable
+     * @param variableRange Values the variable takes, for overflow check elimination
+     * @param afterBB Block the loop exits to
+     */
+    void generateRangeLoop(ForStmt& node, llvm::Value* start, llvm::Value* last, llvm::Value* step,
+                           const std::string& variableType, const llvm::ConstantRange& variableRange,
+                           llvm::BasicBlock* afterBB);
+
+    /**
+     * @brief Generates LLVM IR for a switch statement
+     * 
+     * Emits a single LLVM switch instruction, so the backend can choose a
+     * jump table, bit tests or a balanced compare tree for the labels.
+     * @param node The switch statement AST node
+     * @return Last generated LLVM basic block
+     */
+    llvm::BasicBlock* generateSwitch(SwitchStmt& node);
+
     /**
      * @brief Generates LLVM IR for a return statement
      * @param node The return statement AST node
@@ -142,6 +224,94 @@ private:
 
     /******************** Helper Methods ********************/
 
+    /**
+     * @brief Unwraps a likely()/unlikely() branch condition
+     * 
+     * The wrapped expression becomes the branch condition and the hint
+     * becomes branch-weight metadata, so the hint holds at -O0 as well.
+     * @param condition Condition of an if or while statement
+     * @param weights Set to the branch weights when the condition is a hint
+     * @return Expression to evaluate as the condition
+     */
+    Expression* stripBranchHint(Expression& condition, llvm::MDNode*& weights);
+
+    /******************** Bounds Check Hoisting ********************/
+
+    /**
+     * @brief Recognizes `while (i < n) { ...; i = i + c; }` loops whose element checks can be hoisted
+     * @param node The while statement AST node
+     * @param condition Loop condition with any branch hint stripped
+     * @param loop Filled with the counter, bound, step and hoistable accesses
+     * @return true if the loop has at least one hoistable access
+     */
+    bool analyzeCountedLoop(WhileStmt& node, Expression& condition, CountedLoop& loop);
+
+    /**
+     * @brief Collects the a[counter] accesses of a loop body that can share one range check
+     * 
+     * Fails when the body writes the counter anywhere but in the given
+     * increment, hands a call a pointer, slice or vector, or contains a
+     * construct it does not understand, and when the function takes the
+     * counter's address. Arrays whose address is taken are not hoisted.
+     * @param body Loop body
+     * @param increment The counter's own increment, or nullptr
+     * @param loop Counted loop; its counter must be set, accesses are filled in
+     * @param written Set to the variables the body assigns or declares
+     * @return true if the loop has at least one hoistable access
+     */
+    bool collectCountedAccesses(Statement& body, const AssignmentExpr* increment, CountedLoop& loop,
+                                std::set<std::string>& written);
+
+    /**
+     * @brief Checks whether a call argument hands the callee a pointer, slice or vector
+     * @param argument Call argument
+     * @return true if the callee could write memory the caller's loop depends on
+     */
+    bool passesReference(Expression& argument);
+
+    /**
+     * @brief Checks that a loop bound cannot change while the loop runs
+     * @param bound Bound expression
+     * @param written Variables the loop body assigns or declares
+     * @return true for literals, unwritten locals and slice_len of unwritten local slices
+     */
+    bool isInvariantBound(Expression& bound, const std::set<std::string>& written);
+
+    /**
+     * @brief Emits the single range check that covers every iteration of a counted loop
+     * 
+     * Holds when the counter starts non-negative, its last value is below
+     * the length of every accessed array and stepping past it cannot wrap.
+     * Must be emitted before the loop, while the counter holds its start value.
+     * @param loop The counted loop
+     * @return i1 condition (folded to a constant when provable), or nullptr on error
+     */
+    llvm::Value* generateHoistedCheck(const CountedLoop& loop);
+
+    /**
+     * @brief Emits the check that counter values in [first, last] index every accessed array
+     * @param accesses Hoistable a[counter] accesses
+     * @param first First counter value (i64)
+     * @param last Last counter value (i64)
+     * @param inRange Further condition the check must include, or nullptr
+     * @return i1 condition (folded to a constant when provable)
+     */
+    llvm::Value* generateAccessRangeCheck(const std::vector<IndexExpr*>& accesses, llvm::Value* first,
+                                          llvm::Value* last, llvm::Value* inRange);
+
+    /**
+     * @brief Emits a loop, versioned on its hoisted range check
+     * 
+     * A check that is not constant selects between a copy of the loop
+     * without per-element checks and the checked original; a check folded
+     * to true drops the per-element checks. Loops that nest another loop
+     * are never copied, so only their inner loops are versioned.
+     * @param inRange Hoisted range check, or nullptr if there is none
+     * @param loop Counted loop whose accesses the check covers
+     * @param emitLoop Emits one copy of the loop at the insertion point
+     */
+    void generateVersionedLoop(llvm::Value* inRange, const CountedLoop& loop, const std::function<void()>& emitLoop);
+
     /**
      * @brief Creates a new basic block in the current function
      * @param name Name for the basic block
@@ -79,6 +79,7 @@ namespace codegen {
 class AOTCompiler {
 private:
     OptLevel optimizationLevel_;
+    bool wholeProgram_;
     std::string targetTriple_;
     std::unique_ptr<llvm::TargetMachine> targetMachine_;
 
@@ -168,6 +169,20 @@ public:
     /** @return Current optimization level */
     OptLevel getOptimizationLevel() const;
 
+    /**
+     * @brief Treats each module as the whole program
+     *
+     * Emits every function and global in its own section, so the linker can
+     * drop unused ones with --gc-sections, and runs the interprocedural
+     * cleanup passes (GlobalDCE, argument promotion, dead argument
+     * elimination) at every optimization level. Must be set before
+     * initialize().
+     */
+    void setWholeProgram(bool enabled);
+
+    /** @return true if modules are compiled as whole programs */
+    bool isWholeProgram() const;
+
     /**
      * @brief Verifies a module for correctness
      * @param module Module to verify
@@ -93,9 +93,9 @@ public:
     /**
      * @brief Constructs a new CodeGenerator instance
      * @param moduleName Name for the LLVM module
-     * @param optLevel Optimization level to apply
+     * @param options Code generation switches
      */
-    CodeGenerator(const std::string& moduleName);
+    CodeGenerator(const std::string& moduleName, const CodegenOptions& options = CodegenOptions());
 
     /**
      * @brief Default destructor
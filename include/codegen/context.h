@@ -30,6 +30,33 @@
 namespace emlang {
 namespace codegen {
 
+class DebugInfo;
+
+/**
+ * @struct CodegenOptions
+ * @brief Compiler switches that change the generated IR
+ */
+struct CodegenOptions {
+    /** @brief How function entry and exit are instrumented */
+    enum class FunctionInstrumentation {
+        None,                                    ///< No instrumentation
+        Hooks,                                   ///< Calls to emlang_funcprof_enter/exit
+        XRay                                     ///< XRay sleds, patched at run time by the XRay runtime
+    };
+
+    bool heapProfile = false;                    ///< Route emlang_malloc/emlang_free through the sampling heap profiler
+    FunctionInstrumentation instrumentFunctions = FunctionInstrumentation::None; ///< Function entry/exit instrumentation
+    std::string sourceFile;                      ///< Source file name recorded in profiles and debug info
+    bool debugInfo = false;                      ///< Emit source-level debug info (-g)
+    bool framePointers = false;                  ///< Keep the frame pointer in every function (-fno-omit-frame-pointer)
+    bool boundsChecks = false;                   ///< Check fixed-array and slice indices at run time (--bounds-checks)
+    bool checkedArith = false;                   ///< Abort on signed/unsigned overflow of + - * (--checked-arith)
+    bool fastMath = false;                       ///< All fast-math flags on floating-point operations (-ffast-math)
+    bool mathErrno = true;                       ///< Math builtins may set errno, so they stay opaque calls (-fno-math-errno)
+    bool fpContractFast = false;                 ///< Fuse multiply-adds across statements into FMAs (-ffp-contract=fast)
+    bool wholeProgram = false;                   ///< Only main and #[export] functions stay visible to the linker (--whole-program)
+};
+
 /**
  * @class ContextManager
  * @brief Manages LLVM context, module, and type mapping
@@ -43,6 +70,8 @@ private:
     std::unique_ptr<llvm::LLVMContext> context;  ///< LLVM context managing global state
     std::unique_ptr<llvm::Module> module;        ///< LLVM module containing all generated functions and globals
     std::unique_ptr<llvm::IRBuilder<>> builder;  ///< LLVM IR builder for convenient instruction generation
+    CodegenOptions options;                      ///< Switches selected on the command line
+    std::unique_ptr<DebugInfo> debugInfo;        ///< Debug metadata emitter, null unless options.debugInfo
 
     /******************** INITIALIZATION HELPERS ********************/
 
@@ -53,14 +82,14 @@ public:
     /**
      * @brief Constructs LLVM context manager
      * @param moduleName Name for the LLVM module
-     * @param optLevel Optimization level
+     * @param options Code generation switches
      */
-    ContextManager(const std::string& moduleName);
+    ContextManager(const std::string& moduleName, const CodegenOptions& options = CodegenOptions());
 
     /**
-     * @brief Default destructor
+     * @brief Destructor
      */
-    ~ContextManager() = default;
+    ~ContextManager();
 
     /******************** LLVM COMPONENT ACCESS ********************/
 
@@ -81,6 +110,18 @@ public:
      * @return Reference to IR builder
      */
     llvm::IRBuilder<>& getBuilder() const { return *builder; }    
+
+    /**
+     * @brief Gets the code generation switches
+     * @return Reference to the options
+     */
+    const CodegenOptions& getOptions() const { return options; }
+
+    /**
+     * @brief Gets the debug metadata emitter
+     * @return Debug info emitter, or nullptr when debug info is disabled
+     */
+    DebugInfo* getDebugInfo() const { return debugInfo.get(); }
     
     /******************** ALLOCA HELPER ********************/
 
@@ -93,6 +134,24 @@ public:
      */
     llvm::Value* createEntryBlockAlloca(llvm::Function* function, const std::string& varName, llvm::Type* type);
 
+    /******************** MODULE HELPERS ********************/
+
+    /**
+     * @brief Creates a private NUL-terminated string constant
+     * @param text String contents
+     * @param name Global name (uniqued by LLVM)
+     * @return The global holding the string
+     */
+    llvm::Constant* createPrivateString(const std::string& text, const std::string& name);
+
+    /**
+     * @brief Emits an internal function that makes one call and runs it as a module constructor
+     * @param name Name of the constructor function
+     * @param callee Function to call
+     * @param args Constant arguments for the call
+     */
+    void addModuleInit(const std::string& name, llvm::FunctionCallee callee, llvm::ArrayRef<llvm::Value*> args);
+
     /******************** OUTPUT GENERATION ********************/
 
     /**
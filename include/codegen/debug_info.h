@@ -0,0 +1,128 @@
+//===--- debug_info.h - Source-Level Debug Information ----------*- C++ -*-===//
+//
+// Part of the RNR Project, under the Apache License v2.0 with LLVM Exceptions.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Debug information emission for EMLang code generation
+//
+// This file contains the DebugInfo class, which wraps LLVM's DIBuilder
+// to describe the compile unit, functions, variables and source locations
+// of the generated module.
+//===----------------------------------------------------------------------===//
+
+#ifndef EM_CODEGEN_DEBUG_INFO_H
+#define EM_CODEGEN_DEBUG_INFO_H
+
+#pragma once
+
+#include <emlang_export.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+
+namespace emlang {
+namespace codegen {
+
+/**
+ * @class DebugInfo
+ * @brief Emits DWARF (or CodeView on Windows) metadata for generated code
+ *
+ * One compile unit is created for the source file. Each function body
+ * gets a subprogram, parameters and locals get variable records bound to
+ * their allocas, and the IR builder's current location follows the AST
+ * node being generated, so profilers and debuggers resolve machine code
+ * to .em lines.
+ */
+class EMLANG_API DebugInfo {
+private:
+    llvm::Module& module;                        ///< Module receiving the metadata
+    llvm::IRBuilder<>& builder;                  ///< Builder whose current location is updated
+    std::unique_ptr<llvm::DIBuilder> diBuilder;  ///< LLVM debug metadata builder
+    llvm::DICompileUnit* compileUnit;            ///< Compile unit for the source file
+    llvm::DIFile* file;                          ///< Source file
+    llvm::DISubprogram* currentSubprogram;       ///< Function being generated, null outside functions
+    std::map<std::string, llvm::DIType*> types;  ///< Debug types by EMLang type name
+
+public:
+    /**
+     * @brief Creates the compile unit for a source file
+     * @param module Module receiving the metadata
+     * @param builder IR builder used for code generation
+     * @param sourceFile Path of the source file
+     */
+    DebugInfo(llvm::Module& module, llvm::IRBuilder<>& builder, const std::string& sourceFile);
+
+    /******************** FUNCTIONS ********************/
+
+    /**
+     * @brief Attaches a subprogram to a function and makes it the current scope
+     * @param function Function whose body is about to be generated
+     * @param returnType EMLang return type name
+     * @param paramTypes EMLang parameter type names
+     * @param line Line of the declaration
+     */
+    void beginFunction(llvm::Function* function, const std::string& returnType,
+                       const std::vector<std::string>& paramTypes, unsigned line);
+
+    /**
+     * @brief Leaves the current function and clears the builder location
+     */
+    void endFunction();
+
+    /******************** VARIABLES ********************/
+
+    /**
+     * @brief Describes a parameter or local variable stored in an alloca
+     * @param storage Alloca holding the variable
+     * @param name Variable name
+     * @param type EMLang type name
+     * @param line Line of the declaration
+     * @param argNo 1-based parameter position, 0 for locals
+     */
+    void declareVariable(llvm::Value* storage, const std::string& name, const std::string& type,
+                         unsigned line, unsigned argNo = 0);
+
+    /******************** LOCATIONS ********************/
+
+    /**
+     * @brief Sets the location of instructions generated next
+     * @param line Source line (1-based, 0 keeps the current location)
+     * @param column Source column (1-based)
+     */
+    void setLocation(unsigned line, unsigned column);
+
+    /**
+     * @brief Gets the location of a line in the current function
+     * @param line Source line
+     * @param column Source column
+     * @return Location, or null outside functions
+     */
+    llvm::DILocation* getLocation(unsigned line, unsigned column) const;
+
+    /******************** FINALIZATION ********************/
+
+    /**
+     * @brief Resolves pending metadata; call once after the whole module is generated
+     */
+    void finalize();
+
+private:
+    /**
+     * @brief Maps an EMLang type name to a debug type
+     * @param typeName EMLang type name
+     * @return Debug type, or null for void
+     */
+    llvm::DIType* getType(const std::string& typeName);
+};
+
+} // namespace codegen
+} // namespace emlang
+
+#endif // EM_CODEGEN_DEBUG_INFO_H
@@ -25,10 +25,14 @@
 namespace llvm {
     class Value;
     class Function;
+    class Instruction;
+    class StructType;
 }
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace emlang {
 namespace codegen {
@@ -162,6 +166,57 @@ public:
      */
     llvm::Type* getPointerType(const std::string& baseTypeName, class ContextManager& contextManager);
 
+    /******************** STRUCT LAYOUTS ********************/
+
+    /**
+     * @struct StructLayout
+     * @brief Memory layout chosen for a declared struct
+     */
+    struct StructLayout {
+        llvm::StructType* type = nullptr;     ///< LLVM body, fields in memory order
+        std::vector<std::string> fieldNames;  ///< Field names in memory order
+        std::vector<std::string> fieldTypes;  ///< EMLang field types in memory order
+        unsigned alignment = 0;               ///< Minimum alignment from #[align(N)], 0 if none
+        bool soa = false;                     ///< Arrays of the struct store one array per field
+
+        /**
+         * @brief Finds the element index of a field
+         * @param fieldName Field name
+         * @return Index into the LLVM body, or -1 if there is no such field
+         */
+        int fieldIndex(const std::string& fieldName) const;
+    };
+
+    /**
+     * @brief Registers the layout of a struct type
+     * @param name Struct name
+     * @param layout Chosen layout
+     */
+    void addStruct(const std::string& name, StructLayout layout);
+
+    /**
+     * @brief Looks up a struct layout
+     * @param name Struct name
+     * @return Layout, or nullptr if name is not a struct
+     */
+    const StructLayout* getStruct(const std::string& name) const;
+
+    /**
+     * @brief Gets the #[align(N)] requirement of a struct or array-of-struct type
+     * @param typeName EMLang type name
+     * @return Required alignment in bytes, or 0 if the type has none
+     */
+    unsigned getAlignment(const std::string& typeName) const;
+
+    /**
+     * @brief Splits a fixed-size array type
+     * @param typeName EMLang type name such as "Point[16]"
+     * @param elementType Set to the element type
+     * @param size Set to the element count
+     * @return true if typeName is a fixed-size array type
+     */
+    static bool splitArrayType(const std::string& typeName, std::string& elementType, uint64_t& size);
+
     /******************** POINTER TYPE HELPERS ********************/
 
     /**
@@ -180,10 +235,44 @@ public:
      */
     std::string getPointeeType(const std::string& pointerType);
 
+    /******************** RESTRICT POINTERS ********************/
+
+    /**
+     * @struct RestrictPointer
+     * @brief A restrict-qualified variable and the memory accesses made through it
+     */
+    struct RestrictPointer {
+        std::string name;                        ///< Variable name, used to name its alias scope
+        std::vector<llvm::Instruction*> accesses; ///< Loads and stores through the pointer
+    };
+
+    /**
+     * @brief Marks a variable's storage as holding a restrict pointer
+     * @param storage Alloca of the parameter or local
+     * @param name Variable name
+     */
+    void addRestrictStorage(llvm::Value* storage, const std::string& name);
+
+    /**
+     * @brief Records a load or store through the pointer held in storage
+     * @param storage Alloca holding the dereferenced pointer
+     * @param access Load or store; ignored unless storage is restrict
+     */
+    void recordRestrictAccess(llvm::Value* storage, llvm::Instruction* access);
+
+    /**
+     * @brief Hands over the restrict pointers of the finished function and forgets them
+     * @return Restrict pointers in declaration order
+     */
+    std::vector<RestrictPointer> takeRestrictPointers();
+
 private:
     std::map<std::string, llvm::Value*> namedValues;
     std::map<std::string, std::string> namedTypes;
     std::map<std::string, llvm::Function*> functions;
+    std::map<std::string, StructLayout> structs;      // Declared structs by name
+    std::map<llvm::Value*, size_t> restrictIndex;     // Restrict storage to its restrictPointers slot
+    std::vector<RestrictPointer> restrictPointers;    // Restrict pointers of the current function
 };
 
 } // namespace codegen
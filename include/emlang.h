@@ -30,7 +30,7 @@
 /***************************************
 *  Feature flags
 ***************************************/
-#define EMLANG_FEATURE_POINTERS          0
+#define EMLANG_FEATURE_POINTERS          1
 #define EMLANG_FEATURE_CASTING           0
 #define EMLANG_FEATURE_IMPORTS           0
 #define EMLANG_FEATURE_EXTERN_FUNCTIONS  0
@@ -38,6 +38,11 @@ private:
      */
     void advance();
     
+    /**
+     * @brief Advances over count bytes at once, keeping line and column in sync
+     */
+    void advanceBy(size_t count);
+    
     /**
      * @brief Skips over whitespace characters (spaces, tabs, etc.)
      */
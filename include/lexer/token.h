@@ -54,6 +54,13 @@ enum class TokenType {
     WHILE =                 39,    // while loop statement
     FOR =                   40,    // for loop statement
     RETURN =                41,    // return statement
+    SWITCH =                42,    // switch statement
+    CASE =                  43,    // case label in a switch
+    DEFAULT =               44,    // default label in a switch
+    RESTRICT =              45,    // restrict pointer qualifier
+    STRUCT =                46,    // struct declaration
+    ASYNC =                 47,    // async function modifier
+    AWAIT =                 48,    // await expression
 
     // Operators (0x50-0x6F)
     PLUS =                  80,    // + addition operator
@@ -92,6 +99,8 @@ enum class TokenType {
     RIGHT_BRACE =           119,   // } right brace
     LEFT_BRACKET =          120,   // [ left bracket
     RIGHT_BRACKET =         121,   // ] right bracket
+    HASH =                  122,   // # attribute introducer
+    DOT_DOT =               123,   // .. range operator
     
     // Reserved (0x8F-0xFE)
     RESERVED_START =        0x8F,   // Start of reserved range
@@ -130,6 +139,13 @@ static const std::map<TokenType, std::string> tokenNames = {
     {TokenType::WHILE, "WHILE"},
     {TokenType::FOR, "FOR"},
     {TokenType::RETURN, "RETURN"},
+    {TokenType::SWITCH, "SWITCH"},
+    {TokenType::CASE, "CASE"},
+    {TokenType::DEFAULT, "DEFAULT"},
+    {TokenType::RESTRICT, "RESTRICT"},
+    {TokenType::STRUCT, "STRUCT"},
+    {TokenType::ASYNC, "ASYNC"},
+    {TokenType::AWAIT, "AWAIT"},
     
     /// Operators
     {TokenType::PLUS, "PLUS"},
@@ -168,6 +184,8 @@ static const std::map<TokenType, std::string> tokenNames = {
     {TokenType::RIGHT_BRACE, "RIGHT_BRACE"},
     {TokenType::LEFT_BRACKET, "LEFT_BRACKET"},
     {TokenType::RIGHT_BRACKET, "RIGHT_BRACKET"},
+    {TokenType::HASH, "HASH"},
+    {TokenType::DOT_DOT, "DOT_DOT"},
 
     {TokenType::INVALID, "INVALID"}
     
@@ -183,6 +201,13 @@ static const std::map<std::string, TokenType> keywords = {
     {"while", TokenType::WHILE},
     {"for", TokenType::FOR},
     {"return", TokenType::RETURN},
+    {"switch", TokenType::SWITCH},
+    {"case", TokenType::CASE},
+    {"default", TokenType::DEFAULT},
+    {"restrict", TokenType::RESTRICT},
+    {"struct", TokenType::STRUCT},
+    {"async", TokenType::ASYNC},
+    {"await", TokenType::AWAIT},
     
     {"int", TokenType::INT},
     {"float", TokenType::FLOAT},
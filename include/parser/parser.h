@@ -48,8 +48,12 @@ namespace emlang {
  * **Grammar Hierarchy:**
  * ```
  * Program -> Statement*
- * Statement -> VarDecl | FuncDecl | IfStmt | WhileStmt | ForStmt | 
- *              ReturnStmt | BlockStmt | ExprStmt
+ * Statement -> VarDecl | FuncDecl | StructDecl | IfStmt | WhileStmt | ForStmt | 
+ *              SwitchStmt | ReturnStmt | BlockStmt | ExprStmt
+ * FuncDecl -> Attributes? 'function' IDENTIFIER '(' Params? ')' (':' Type)? Block
+ * StructDecl -> Attributes? 'struct' IDENTIFIER '{' (IDENTIFIER ':' Type ','?)* '}'
+ * ForStmt -> 'for' IDENTIFIER 'in' Expression '..' Expression ('step' Expression)? Statement
+ * Attributes -> ('#' '[' Attribute (',' Attribute)* ']')+
  * Expression -> LogicalOr
  * LogicalOr -> LogicalAnd ('||' LogicalAnd)*
  * LogicalAnd -> Equality ('&&' Equality)*
@@ -244,16 +248,22 @@ private:
      * function name(param1: type1, param2: type2): returnType {
      *     // body
      * }
+     * function max<T: numeric>(a: T, b: T): T { ... }
+     * async function fetch(id: int64): int64 { ... }
      * ```
      * 
      * The method parses:
+     * - Optional async modifier
      * - Function name identifier
+     * - Optional type parameter list, each with an optional constraint
      * - Parameter list with types
      * - Optional return type annotation
      * - Function body as a block statement
      * - Creates FunctionDeclaration AST node
+     * 
+     * @param attributes Attributes already parsed in front of the declaration
      */
-    StatementPtr parseFunctionDeclaration();
+    StatementPtr parseFunctionDeclaration(std::vector<Attribute> attributes = {});
     
     /**
      * @brief Parses external function declarations
@@ -273,6 +283,25 @@ private:
      */
     StatementPtr parseExternFunctionDeclaration();
     
+    /**
+     * @brief Parses struct declarations
+     * @return StatementPtr to StructDeclaration AST node
+     * 
+     * Handles struct declaration syntax:
+     * ```
+     * #[align(64)]
+     * struct Particle {
+     *     x: float,
+     *     y: float
+     * }
+     * ```
+     * 
+     * Fields are separated by commas, newlines or both.
+     * 
+     * @param attributes Attributes already parsed in front of the declaration
+     */
+    StatementPtr parseStructDeclaration(std::vector<Attribute> attributes = {});
+    
     /**
      * @brief Parses if/else conditional statements
      * @return StatementPtr to IfStatement AST node
@@ -281,6 +310,7 @@ private:
      * ```
      * if (condition) statement
      * if (condition) statement else statement
+     * if likely(condition) statement
      * ```
      * 
      * The method:
@@ -298,6 +328,7 @@ private:
      * Handles while loop syntax:
      * ```
      * while (condition) statement
+     * while unlikely(condition) statement
      * ```
      * 
      * The method:
@@ -307,24 +338,59 @@ private:
      */
     StatementPtr parseWhileStatement();
     
+    /**
+     * @brief Parses the condition of an if or while statement
+     * @param keyword Statement keyword, used in error messages
+     * @return ExpressionPtr to the condition
+     * 
+     * Accepts a parenthesized expression, or a bare likely(...)/unlikely(...)
+     * call whose own parentheses delimit the condition.
+     */
+    ExpressionPtr parseCondition(const std::string& keyword);
+    
     /**
      * @brief Parses for loop statements
      * @return StatementPtr to ForStatement AST node
      * 
-     * Handles for loop syntax:
+     * Handles counted range loops and C-style loops:
      * ```
+     * for name in start..end statement
+     * for name in start..end step s statement
      * for (init; condition; update) statement
      * ```
      * 
      * The method parses:
-     * - Optional initialization statement
-     * - Optional condition expression
-     * - Optional update expression
+     * - Loop variable name and the contextual keyword 'in'
+     * - Start and exclusive end expressions separated by '..'
+     * - Optional step expression after the contextual keyword 'step'
+     * - Or a parenthesized initializer, condition and update, each optional
      * - Loop body statement
-     * - Creates ForStatement AST node
+     * - Creates ForStatement AST node in its range or C-style form
      */
     StatementPtr parseForStatement();
     
+    /**
+     * @brief Parses switch statements
+     * @return StatementPtr to SwitchStatement AST node
+     * 
+     * Handles switch statement syntax:
+     * ```
+     * switch (expression) {
+     *     case 1, 2: statements
+     *     case 3:
+     *     case 4: statements
+     *     default: statements
+     * }
+     * ```
+     * 
+     * The method:
+     * - Parses the switch value in parentheses
+     * - Collects each arm's labels and statements up to the next label
+     * - Merges labels with no statements between them into the next arm
+     * - Creates SwitchStatement AST node
+     */
+    StatementPtr parseSwitchStatement();
+    
     /**
      * @brief Parses return statements
      * @return StatementPtr to ReturnStatement AST node
@@ -488,6 +554,7 @@ private:
      * !expression    // logical NOT
      * -expression    // arithmetic negation
      * &expression    // address-of
+     * await task     // wait for an async call's result
      * ```
      * 
      * Right-associative, higher precedence than binary operators.
@@ -537,15 +604,33 @@ private:
      * ()                                   // empty parameter list
      * (param: type)                        // single parameter
      * (param1: type1, param2: type2, ...)  // multiple parameters
+     * (dst: int32* restrict)               // pointer that aliases no other
      * ```
      * 
      * Each parameter includes:
      * - Parameter name (identifier)
      * - Parameter type (including pointer types)
+     * - Optional restrict qualifier
      * - Optional default values (if supported)
      */
     std::vector<Parameter> parseParameterList();
     
+    /**
+     * @brief Parses attribute lists in front of a declaration
+     * @return Vector of Attribute objects in source order
+     * 
+     * Parses attribute syntax:
+     * ```
+     * #[cold]                      // bare attribute
+     * #[inline(always)]            // attribute with arguments
+     * #[hot, noinline]             // several attributes in one list
+     * ```
+     * 
+     * Arguments are identifiers, integers or strings; their meaning is
+     * checked by the semantic analyzer.
+     */
+    std::vector<Attribute> parseAttributes();
+    
     /**
      * @brief Parses function call argument lists
      * @return Vector of ExpressionPtr objects representing the arguments
@@ -572,12 +657,25 @@ private:
      * str             // string type
      * bool            // boolean type
      * MyType          // user-defined types
+     * vec<int32>      // growable vector of T
+     * vec<vec<int32>> // nested type arguments
+     * Point[64]       // fixed-size array of T
+     * []int32         // slice (pointer and length) of T
      * ```
      * 
      * The method validates that the type is recognized and properly formed.
      */
     std::string parseType();
     
+    /**
+     * @brief Consumes the '>' closing a type argument list
+     * @param message Error message if no '>' follows
+     * 
+     * A '>>' token is split: its first half closes this list and the
+     * second half stays as the current token for the enclosing list.
+     */
+    void consumeTypeArgumentClose(const std::string& message);
+    
     /**
      * @brief Converts a Token to BinaryOpExpr::BinOp enum
      * @param token The token to convert
@@ -630,13 +728,14 @@ private:
     
     /**
      * @brief Parses array/object indexing expressions (arr[index])
-     * @return ExpressionPtr to IndexExpression AST node
+     * @return ExpressionPtr to IndexExpression or SliceExpression AST node
      * 
      * Handles indexing syntax:
      * ```
      * array[index]
      * map[key]
      * matrix[row][col]  // chained indexing
+     * array[lo..hi]     // sub-slice, either bound optional
      * ```
      * 
      * The method:
@@ -35,6 +35,8 @@
 #include "ast/visitor.h"
 #include <string>
 #include <memory>
+#include <map>
+#include <set>
 
 namespace emlang {
 
@@ -74,8 +76,23 @@ private:
     std::vector<std::unique_ptr<Scope>> scopes;     // Stack of active scopes
     Scope* currentScope;                            // Currently active scope
     std::string currentFunctionReturnType;          // Return type of current function being analyzed
+    bool currentFunctionAsync;                      // Whether the current function is async
     std::string currentExpressionType;              // Type of currently analyzed expression
     bool hasErrors;                                 // Flag indicating if semantic errors were found
+    std::string currentPureFunction;                // #[pure] function being analyzed, empty otherwise
+    std::set<std::string> pureFunctions;            // Functions declared #[pure]
+    std::map<std::string, std::vector<bool>> restrictParameters; // Restrict flags per parameter of each function
+    std::map<std::string, StructDecl*> structs;     // Declared structs by name
+    std::set<const Symbol*> inductionVariables;     // Range-for variables, which must not escape their loop
+    std::map<const Symbol*, const AwaitExpr*> awaitedTasks; // Task variables awaited on the path being analyzed, by await
+    std::map<const Symbol*, unsigned> taskLoopDepths; // Loops enclosing each task variable's declaration
+    unsigned loopDepth;                             // Loops enclosing the code being analyzed
+    const Expression* awaitOperand;                 // Task variable being awaited, its one permitted use
+    std::map<std::string, FunctionDecl*> genericFunctions;          // Generic function templates by name
+    std::set<std::string> genericInstances;                         // Mangled names of instances already created
+    std::vector<std::unique_ptr<FunctionDecl>> pendingInstances;    // Instances created but not yet analyzed
+    std::map<std::string, std::vector<std::string>> instanceCalls;  // Instances called from each instance body
+    std::string currentInstance;                                    // Instance being analyzed, empty otherwise
 
     // ======================== SCOPE MANAGEMENT METHODS ========================
     
@@ -96,6 +113,162 @@ private:
      */
     std::string getExpressionType(Expression& expr);
     
+    /**
+     * @brief Type checks a call to one of the vec_* intrinsics
+     * @param node The call expression
+     * @return true if the call was an intrinsic and has been analyzed
+     */
+    bool analyzeVecIntrinsic(FunctionCallExpr& node);
+    
+    /**
+     * @brief Type checks a call to likely, unlikely or prefetch
+     * @param node The call expression
+     * @return true if the call was a hint and has been analyzed
+     */
+    bool analyzeHintIntrinsic(FunctionCallExpr& node);
+    
+    /**
+     * @brief Validates the attributes of a function declaration
+     * @param node The function declaration
+     */
+    void checkFunctionAttributes(FunctionDecl& node);
+    
+    /**
+     * @brief Reports a memory access inside a #[pure] function
+     * @param what Description of the access
+     * @param line Source line
+     * @param column Source column
+     */
+    void checkPureAccess(const std::string& what, size_t line, size_t column);
+    
+    /**
+     * @brief Reports a whole-array operand inside a #[pure] function that reads through a slice
+     * @param operand Operand of a whole-array expression or of sum
+     * @param type The operand's type
+     */
+    void checkPureArrayRead(Expression& operand, const std::string& type);
+    
+    /**
+     * @brief Rejects calls passing the same pointer to a restrict parameter and another parameter
+     * @param node The call expression
+     */
+    void checkRestrictAliasing(FunctionCallExpr& node);
+    
+    /**
+     * @brief Validates the layout attributes of a struct declaration
+     * @param node The struct declaration
+     */
+    void checkStructAttributes(StructDecl& node);
+    
+    /**
+     * @brief Type checks an object literal initializing a struct
+     * @param structName Name of the struct being initialized
+     * @param node The object literal
+     */
+    void checkStructLiteral(const std::string& structName, ObjectExpr& node);
+    
+    /**
+     * @brief Type checks an array literal initializing a fixed-size array
+     * @param arrayType The array type (e.g., "uint8[4]")
+     * @param node The array literal
+     */
+    void checkArrayLiteral(const std::string& arrayType, ArrayExpr& node);
+    
+    /**
+     * @brief Checks whether an expression names a const array, which may live in read-only data
+     */
+    bool isConstArray(const Expression& expr);
+    
+    /**
+     * @brief Checks whether a type is a fixed-size array or a slice
+     */
+    static bool isWholeArrayType(const std::string& type);
+    
+    /**
+     * @brief Gets the element type of a fixed-size array or slice type
+     */
+    static std::string arrayElementType(const std::string& type);
+    
+    /**
+     * @brief Type checks an arithmetic operation with an array or slice operand
+     * 
+     * Array operands must agree on element type and, when both have a
+     * fixed size, on length; scalar operands apply to every element.
+     * @param node The binary operation
+     * @param leftType Type of the left operand
+     * @param rightType Type of the right operand
+     * @return T[N] when every array operand is fixed, []T otherwise, or "error"
+     */
+    std::string analyzeArrayArithmetic(BinaryOpExpr& node, const std::string& leftType, const std::string& rightType);
+    
+    /**
+     * @brief Analyzes a `for i in start..end step s` loop
+     * 
+     * The variable takes the promoted type of the bounds and is read-only
+     * within the body.
+     * @param node The for statement in its range form
+     */
+    void analyzeRangeFor(ForStmt& node);
+    
+    /**
+     * @brief Checks a generic function template and registers it by name
+     * 
+     * The body is only analyzed in the instances, once the type
+     * parameters have been replaced by concrete types.
+     * @param node Function declaration with type parameters
+     */
+    void declareGenericFunction(FunctionDecl& node);
+    
+    /**
+     * @brief Deduces type arguments by matching a parameter type against an argument type
+     * 
+     * Composite types (T*, T[N], []T, vec<T>) match through their element
+     * type. A literal argument only binds a parameter not yet deduced from
+     * another argument, and gives way if one is deduced later.
+     * @param pattern Parameter type as written in the template
+     * @param actual Argument type
+     * @param generic The template
+     * @param bindings Deduced types per type parameter
+     * @param literalBindings Type parameters deduced from literals only
+     * @param fromLiteral Whether the argument is a literal
+     * @return Empty on success, otherwise why deduction failed
+     */
+    std::string deduceTypeArgument(const std::string& pattern, const std::string& actual, const FunctionDecl& generic,
+                                   std::map<std::string, std::string>& bindings,
+                                   std::set<std::string>& literalBindings, bool fromLiteral);
+    
+    /**
+     * @brief Resolves a call to a generic function to its instance
+     * 
+     * Instances are cached by mangled name (name.type1.type2...), so every
+     * call with the same type arguments shares one specialized copy. The
+     * call is rewritten to name the instance directly.
+     * @param node The call
+     * @param generic The called template
+     */
+    void instantiateGenericCall(FunctionCallExpr& node, FunctionDecl& generic);
+    
+    /**
+     * @brief Analyzes the instances created so far, and those they create in turn
+     * @return The instances, callees before their callers
+     */
+    std::vector<StatementPtr> analyzePendingInstances();
+    
+    /**
+     * @brief Builds the symbol name of a generic instance
+     * @param name Template name
+     * @param typeArgs Concrete type per type parameter
+     * @return name.type1.type2, with types spelled using [A-Za-z0-9_.] only
+     */
+    static std::string mangleInstanceName(const std::string& name, const std::vector<std::string>& typeArgs);
+    
+    /**
+     * @brief Checks whether a type names a primitive, pointer, vector, array or declared struct
+     * @param type The type string to check
+     * @return true if the type is usable in a declaration
+     */
+    bool isKnownType(const std::string& type) const;
+    
 public:
     /**
      * @brief Constructs a new Analyzer
@@ -151,8 +324,10 @@ public:
         void visit(CastExpr& node) override;
 #endif
     void visit(IndexExpr& node) override;
+    void visit(SliceExpr& node) override;
     void visit(ArrayExpr& node) override;
     void visit(ObjectExpr& node) override;
+    void visit(AwaitExpr& node) override;
 #ifdef EMLANG_FEATURE_POINTERS
     void visit(DereferenceExpr& node) override;
     void visit(AddressOfExpr& node) override;
@@ -162,12 +337,14 @@ public:
     void visit(VariableDecl& node) override;
     void visit(FunctionDecl& node) override;
     void visit(ExternFunctionDecl& node) override;
+    void visit(StructDecl& node) override;
 
     // Statement
     void visit(BlockStmt& node) override;
     void visit(IfStmt& node) override;
     void visit(WhileStmt& node) override;
     void visit(ForStmt& node) override;
+    void visit(SwitchStmt& node) override;
     void visit(ReturnStmt& node) override;
     void visit(ExpressionStmt& node) override;
 
@@ -11,6 +11,7 @@
 #define EM_LANG_TYPE_CHECKER_H
 
 #include "semantic.h"
+#include <cstdint>
 #include <string>
 
 namespace emlang {
@@ -68,6 +69,69 @@ public:
      */
     static std::string makePointerType(const std::string& baseType);
     
+    /**
+     * @brief Checks if a type is a growable vector type
+     * @param type The type string to check
+     * @return true if type has the form vec<T>, false otherwise
+     */
+    static bool isVecType(const std::string& type);
+    
+    /**
+     * @brief Extracts the element type from a vector type
+     * @param vecType The vector type (e.g., "vec<int32>")
+     * @return The element type (e.g., "int32"), or empty if not a vector
+     */
+    static std::string getVecElementType(const std::string& vecType);
+    
+    /**
+     * @brief Checks if a type is a slice type
+     * @param type The type string to check
+     * @return true if type has the form []T, false otherwise
+     */
+    static bool isSliceType(const std::string& type);
+    
+    /**
+     * @brief Extracts the element type from a slice type
+     * @param sliceType The slice type (e.g., "[]int32")
+     * @return The element type (e.g., "int32"), or empty if not a slice
+     */
+    static std::string getSliceElementType(const std::string& sliceType);
+    
+    /**
+     * @brief Checks if a type is a task type, the result of calling an async function
+     * @param type The type string to check
+     * @return true if type has the form task<T>, false otherwise
+     */
+    static bool isTaskType(const std::string& type);
+    
+    /**
+     * @brief Extracts the result type from a task type
+     * @param taskType The task type (e.g., "task<int64>")
+     * @return The result type (e.g., "int64"), or empty if not a task
+     */
+    static std::string getTaskResultType(const std::string& taskType);
+    
+    /**
+     * @brief Checks if a type is a fixed-size array type
+     * @param type The type string to check
+     * @return true if type has the form T[N], false otherwise
+     */
+    static bool isArrayType(const std::string& type);
+    
+    /**
+     * @brief Extracts the element type from a fixed-size array type
+     * @param arrayType The array type (e.g., "int32[8]")
+     * @return The element type (e.g., "int32"), or empty if not an array
+     */
+    static std::string getArrayElementType(const std::string& arrayType);
+    
+    /**
+     * @brief Extracts the element count from a fixed-size array type
+     * @param arrayType The array type (e.g., "int32[8]")
+     * @return The element count (e.g., 8), or 0 if not an array
+     */
+    static uint64_t getArraySize(const std::string& arrayType);
+    
     /**
      * @brief Checks if a type is the string type
      * @param type The type string to check
@@ -141,6 +205,15 @@ public:
      */
     static std::string promoteNumericTypes(const std::string& type1, const std::string& type2);
     
+    /**
+     * @brief Checks if an integer literal is representable in an integer type
+     * @param digits The literal's digits, without sign
+     * @param negative true if the literal is negated
+     * @param type The integer type to check against
+     * @return true if the value fits, false if it does not or type is not an integer type
+     */
+    static bool integerLiteralFits(const std::string& digits, bool negative, const std::string& type);
+    
     /**
      * @brief Checks if two types are compatible (alternative name for isCompatibleType)
      * @param type1 First type
@@ -0,0 +1,151 @@
+//===--- hashmap_bench.cpp - Hash map benchmark ---------------------------===//
+//
+// Part of the RNR Project, under the Apache License v2.0 with LLVM Exceptions.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+// Compares emlang_hashmap against std::unordered_map for int64 and string
+// keys: insert, successful lookup, failed lookup and erase.
+//===----------------------------------------------------------------------===//
+
+#include "emlang_hashmap.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Prevents the optimizer from discarding lookup results
+volatile long long sink = 0;
+
+double elapsedNs(Clock::time_point start, size_t operations) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    return static_cast<double>(ns) / static_cast<double>(operations);
+}
+
+void report(const char* name, double emlangNs, double stdNs) {
+    std::printf("  %-16s emlang %7.2f ns/op   std %7.2f ns/op   speedup %.2fx\n",
+                name, emlangNs, stdNs, stdNs / emlangNs);
+}
+
+std::vector<long long> makeIntKeys(size_t count, unsigned long long seed) {
+    std::vector<long long> keys(count);
+    unsigned long long state = seed;
+    for (auto& key : keys) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<long long>(state);
+    }
+    return keys;
+}
+
+std::vector<std::string> makeStringKeys(const std::vector<long long>& ints) {
+    std::vector<std::string> keys;
+    keys.reserve(ints.size());
+    for (long long value : ints) {
+        keys.push_back("key_" + std::to_string(value));
+    }
+    return keys;
+}
+
+void benchIntKeys(size_t count) {
+    auto keys = makeIntKeys(count, 0x9E3779B97F4A7C15ull);
+    auto missing = makeIntKeys(count, 0xD1B54A32D192ED03ull);
+    std::printf("int64 keys (%zu entries)\n", count);
+
+    emlang_hashmap* map = emlang_hashmap_new();
+    std::unordered_map<long long, long long> ref;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) emlang_hashmap_insert(map, keys[i], static_cast<long long>(i));
+    double emInsert = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) ref[keys[i]] = static_cast<long long>(i);
+    double stdInsert = elapsedNs(start, count);
+    report("insert", emInsert, stdInsert);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += *emlang_hashmap_find(map, keys[i]);
+    double emHit = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += ref.find(keys[i])->second;
+    double stdHit = elapsedNs(start, count);
+    report("find (hit)", emHit, stdHit);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += emlang_hashmap_contains(map, missing[i]);
+    double emMiss = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += ref.count(missing[i]);
+    double stdMiss = elapsedNs(start, count);
+    report("find (miss)", emMiss, stdMiss);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) emlang_hashmap_erase(map, keys[i]);
+    double emErase = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) ref.erase(keys[i]);
+    double stdErase = elapsedNs(start, count);
+    report("erase", emErase, stdErase);
+
+    emlang_hashmap_free(map);
+}
+
+void benchStringKeys(size_t count) {
+    auto keys = makeStringKeys(makeIntKeys(count, 0x9E3779B97F4A7C15ull));
+    auto missing = makeStringKeys(makeIntKeys(count, 0xD1B54A32D192ED03ull));
+    std::printf("string keys (%zu entries)\n", count);
+
+    emlang_hashmap* map = emlang_hashmap_new_str();
+    std::unordered_map<std::string, long long> ref;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; i++) emlang_hashmap_insert_str(map, keys[i].c_str(), static_cast<long long>(i));
+    double emInsert = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) ref[keys[i]] = static_cast<long long>(i);
+    double stdInsert = elapsedNs(start, count);
+    report("insert", emInsert, stdInsert);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += *emlang_hashmap_find_str(map, keys[i].c_str());
+    double emHit = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += ref.find(keys[i])->second;
+    double stdHit = elapsedNs(start, count);
+    report("find (hit)", emHit, stdHit);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += emlang_hashmap_contains_str(map, missing[i].c_str());
+    double emMiss = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) sink += ref.count(missing[i]);
+    double stdMiss = elapsedNs(start, count);
+    report("find (miss)", emMiss, stdMiss);
+
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) emlang_hashmap_erase_str(map, keys[i].c_str());
+    double emErase = elapsedNs(start, count);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i++) ref.erase(keys[i]);
+    double stdErase = elapsedNs(start, count);
+    report("erase", emErase, stdErase);
+
+    emlang_hashmap_free(map);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    benchIntKeys(count);
+    benchStringKeys(count);
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef EMLANG_BENCH_H
+#define EMLANG_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Micro-benchmark harness
+ *
+ * Drive a kernel with
+ *
+ *     let b = emlang_bench_begin("name");
+ *     while (emlang_bench_iteration(b) != 0) { kernel(); }
+ *     emlang_bench_end(b);
+ *
+ * Iterations run in batches and the clock is read only between batches,
+ * so emlang_bench_iteration costs a decrement inside a batch. The batch
+ * size doubles until one batch takes EMLANG_BENCH_BATCH_NS, the kernel
+ * then warms up for EMLANG_BENCH_WARMUP_NS, and each measured batch gives
+ * one per-iteration sample. Samples outside Tukey's fences (1.5 IQR) are
+ * rejected before the median and p99 are reported.
+ */
+
+#define EMLANG_BENCH_BATCH_NS   (1000LL * 1000)         // Target duration of one batch
+#define EMLANG_BENCH_WARMUP_NS  (50LL * 1000 * 1000)    // Warmup after calibration
+#define EMLANG_BENCH_SAMPLES    100                     // Measured batches
+#define EMLANG_BENCH_MAX_NS     (2000LL * 1000 * 1000)  // Stop measuring after this long
+
+typedef struct emlang_bench emlang_bench;
+
+// ======================== RUNNING ========================
+emlang_bench* emlang_bench_begin(const char* name);     // Start a benchmark (NULL on allocation failure)
+int emlang_bench_iteration(emlang_bench* bench);        // 1 if the kernel should run once more, 0 when done
+double emlang_bench_end(emlang_bench* bench);           // Print the report, free bench, return median ns per iteration
+
+// ======================== HELPERS ========================
+void emlang_bench_consume(long long value);             // Keep a result alive so the kernel is not optimized away
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_BENCH_H
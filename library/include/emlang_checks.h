@@ -0,0 +1,29 @@
+#ifndef EMLANG_CHECKS_H
+#define EMLANG_CHECKS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Failure handlers for run-time checks emitted by the compiler
+ *
+ * Compiled code tests indices, slice bounds, whole-array lengths and
+ * (under --checked-arith) integer overflow inline, and only calls into
+ * the runtime from the cold path when a check fails. Every handler
+ * reports the failure on stderr and aborts; none of them returns.
+ */
+
+// ======================== ARRAYS AND SLICES ========================
+void emlang_bounds_fail(long long index, long long length);     // Report out-of-range array/slice index and abort
+void emlang_slice_range_fail(long long start, long long end, long long length); // Report invalid sub-slice and abort
+void emlang_length_fail(long long length, long long expected); // Report mismatched whole-array operand and abort
+
+// ======================== ARITHMETIC ========================
+void emlang_overflow_fail(long long line);                      // Report integer overflow under --checked-arith and abort
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_CHECKS_H
@@ -0,0 +1,29 @@
+#ifndef EMLANG_CPU_H
+#define EMLANG_CPU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run-time CPU feature detection
+ *
+ * Feature names follow LLVM's target feature spelling (sse4.2, avx2,
+ * avx512f, fma, bmi2, ...). Detection uses cpuid once per process and
+ * honours the OS: AVX and AVX-512 features are only reported when XCR0
+ * shows their register state is saved on context switch. Off x86 every
+ * query returns 0.
+ *
+ * Functions declared with #[target_clones] call this from a module
+ * constructor to select the clone used for the rest of the run.
+ */
+
+// ======================== FEATURE QUERIES ========================
+int emlang_cpu_supports(const char* feature);           // 1 if the running CPU and OS support the feature
+const char* emlang_cpu_features(void);                  // Comma-separated list of detected features
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_CPU_H
@@ -0,0 +1,39 @@
+#ifndef EMLANG_FUNCPROF_H
+#define EMLANG_FUNCPROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function entry/exit collector
+ *
+ * Programs compiled with --instrument-functions call the enter and exit
+ * hooks with a per-module function ID, and register the ID-to-name table
+ * from a module constructor. Each thread keeps a shadow stack and a
+ * calling-context tree charged in cycle-counter ticks, so a hook costs a
+ * counter read and a few stores and never takes a lock. Threads fold
+ * their trees into the global profile when they exit.
+ *
+ * At exit, folded stacks (one "a;b;c ticks" line per call path, the
+ * input format of flamegraph.pl and speedscope) go to
+ * EMLANG_FUNCPROF_FOLDED (default emlang-functions.folded), and a
+ * per-function self/total table goes to EMLANG_FUNCPROF_TABLE, or to
+ * stderr if that is not set.
+ */
+
+// ======================== HOOKS ========================
+void emlang_funcprof_enter(int function);               // Called first in an instrumented function
+void emlang_funcprof_exit(int function);                // Called before each return
+
+// ======================== FUNCTIONS ========================
+void emlang_funcprof_register(const char* const* names, int count); // Name function IDs 0..count-1
+
+// ======================== OUTPUT ========================
+int emlang_funcprof_write(const char* folded_path, const char* table_path); // Write the profile so far, NULL table_path for stderr; returns 0 on failure
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_FUNCPROF_H
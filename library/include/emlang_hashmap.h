@@ -0,0 +1,54 @@
+#ifndef EMLANG_HASHMAP_H
+#define EMLANG_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Open-addressing hash map (opaque)
+ *
+ * Swiss-table layout: one control byte per slot holding 7 bits of the hash,
+ * scanned 16 at a time so most lookups touch a single group of metadata
+ * before comparing any key. A map is created for either int64 or string
+ * keys; string keys are copied into the map. Values are int64.
+ */
+typedef struct emlang_hashmap emlang_hashmap;
+
+// ======================== HASHING ========================
+unsigned long long emlang_hash_bytes(const void* data, long long len, unsigned long long seed); // wyhash-style, 8 bytes per step
+unsigned long long emlang_hash_int64(long long value);                  // Full-avalanche 64-bit integer hash
+
+// ======================== CONSTRUCTION ========================
+emlang_hashmap* emlang_hashmap_new(void);                               // Map with int64 keys
+emlang_hashmap* emlang_hashmap_new_str(void);                           // Map with string keys
+void emlang_hashmap_free(emlang_hashmap* map);                          // Free map, its slots and copied keys
+void emlang_hashmap_clear(emlang_hashmap* map);                         // Remove all entries, keep capacity
+int emlang_hashmap_reserve(emlang_hashmap* map, int count);             // Presize for count entries, returns 0 on failure
+int emlang_hashmap_size(const emlang_hashmap* map);                     // Number of entries
+
+// ======================== INT64 KEYS ========================
+int emlang_hashmap_insert(emlang_hashmap* map, long long key, long long value);   // Insert or overwrite, returns 0 on failure
+long long* emlang_hashmap_find(emlang_hashmap* map, long long key);              // Pointer to value or NULL, valid until next insert
+long long emlang_hashmap_get(emlang_hashmap* map, long long key, long long fallback); // Value or fallback if absent
+int emlang_hashmap_contains(emlang_hashmap* map, long long key);                 // 1 if key present
+int emlang_hashmap_erase(emlang_hashmap* map, long long key);                    // 1 if key was removed
+
+// ======================== STRING KEYS ========================
+int emlang_hashmap_insert_str(emlang_hashmap* map, const char* key, long long value);   // Insert or overwrite, returns 0 on failure
+long long* emlang_hashmap_find_str(emlang_hashmap* map, const char* key);              // Pointer to value or NULL, valid until next insert
+long long emlang_hashmap_get_str(emlang_hashmap* map, const char* key, long long fallback); // Value or fallback if absent
+int emlang_hashmap_contains_str(emlang_hashmap* map, const char* key);                 // 1 if key present
+int emlang_hashmap_erase_str(emlang_hashmap* map, const char* key);                    // 1 if key was removed
+
+// ======================== ITERATION ========================
+int emlang_hashmap_next(const emlang_hashmap* map, int slot);           // First occupied slot >= slot, or -1 when done
+long long emlang_hashmap_key_at(const emlang_hashmap* map, int slot);   // Int64 key stored in slot
+const char* emlang_hashmap_key_str_at(const emlang_hashmap* map, int slot); // String key stored in slot
+long long emlang_hashmap_value_at(const emlang_hashmap* map, int slot); // Value stored in slot
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_HASHMAP_H
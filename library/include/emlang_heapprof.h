@@ -0,0 +1,43 @@
+#ifndef EMLANG_HEAPPROF_H
+#define EMLANG_HEAPPROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling heap profiler
+ *
+ * Programs compiled with --heap-profile call the profiled allocators with
+ * a call-site ID assigned by the compiler, and register a table naming
+ * each site from a module constructor. Allocations are sampled by a
+ * Poisson process over allocated bytes: every thread counts down a random
+ * byte interval with mean EMLANG_HEAPPROF_RATE (default 512 KiB, 0 turns
+ * sampling off), so unsampled allocations cost one thread-local subtract.
+ * Sampled allocations are weighted by the inverse of their sampling
+ * probability, which keeps per-site estimates unbiased for any size.
+ *
+ * The profile is written in pprof's protobuf format to EMLANG_HEAPPROF_FILE
+ * (default emlang-heap.pb) at exit, on SIGUSR2 (at the next sampled
+ * allocation, outside the signal handler) and on emlang_heapprof_dump.
+ */
+
+#define EMLANG_HEAPPROF_DEFAULT_RATE (512 * 1024)   // Mean bytes between samples
+
+// ======================== PROFILED ALLOCATION ========================
+void* emlang_heapprof_malloc(int size, int site);   // emlang_malloc attributed to a call site
+void emlang_heapprof_free(void* ptr);               // emlang_free that retires sampled blocks
+
+// ======================== SITES ========================
+void emlang_heapprof_register(const char* const* functions, const int* lines,
+                              int count, const char* file); // Name call sites 0..count-1
+
+// ======================== PROFILE ========================
+int emlang_heapprof_dump(const char* path);         // Write a pprof profile, NULL for the default path; returns 0 on failure
+void emlang_heapprof_set_rate(long long rate);      // Change the mean sampling interval (0 disables)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_HEAPPROF_H
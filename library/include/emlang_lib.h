@@ -7,6 +7,18 @@
 #include "emlang_string.h"
 #include "emlang_memory.h"
 #include "emlang_utility.h"
+#include "emlang_strbuf.h"
+#include "emlang_hashmap.h"
+#include "emlang_vec.h"
+#include "emlang_utf8.h"
+#include "emlang_number.h"
+#include "emlang_heapprof.h"
+#include "emlang_bench.h"
+#include "emlang_funcprof.h"
+#include "emlang_perf.h"
+#include "emlang_cpu.h"
+#include "emlang_task.h"
+#include "emlang_checks.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +21,10 @@ int emlang_fibonacci(int n);
 int emlang_is_prime(int n);    // Returns 1 if prime, 0 otherwise
 int emlang_mod(int a, int b);  // Modulo operation
 
+// Floating-point math (lowered to LLVM intrinsics under -fno-math-errno)
+double emlang_sin(double x);
+double emlang_cos(double x);
+
 #ifdef __cplusplus
 }
 #endif
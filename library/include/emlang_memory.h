@@ -18,6 +18,8 @@ void* emlang_memcpy(void* dest, const void* src, int size);      // Copy memory
 void* emlang_memmove(void* dest, const void* src, int size);     // Safe copy (overlapping)
 long emlang_memory_usage(void);                                  // Get current memory usage
 void emlang_memory_stats(long* total_bytes, long* allocation_count); // Get memory statistics
+void* emlang_tracked_malloc(int size);                           // Allocate and count toward memory usage
+void emlang_tracked_free(void* ptr);                             // Free a tracked block and subtract its size
 
 #ifdef __cplusplus
 }
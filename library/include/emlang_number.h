@@ -0,0 +1,53 @@
+#ifndef EMLANG_NUMBER_H
+#define EMLANG_NUMBER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number parsing and formatting
+ *
+ * Parsers read a prefix of [str, str + len) in the C locale and return the
+ * number of bytes consumed, or 0 if no number starts there. Doubles are
+ * parsed with the Eisel-Lemire algorithm and rounded correctly; values
+ * with more than 19 significant digits that the fast path cannot settle
+ * fall back to strtod. Formatters write into caller buffers without a
+ * terminating NUL and return the number of bytes written, or 0 if the
+ * buffer is too small. Doubles are printed with the fewest digits that
+ * parse back to the same value (Ryu).
+ */
+
+#define EMLANG_NUMBER_BUFFER_SIZE 32    // Large enough for any single formatted number
+
+// ======================== PARSING ========================
+long long emlang_parse_int64(const char* str, long long len, long long* out);   // Bytes consumed, 0 if invalid or out of range
+long long emlang_parse_double(const char* str, long long len, double* out);     // Bytes consumed, 0 if invalid (accepts inf/nan)
+
+// ======================== FORMATTING ========================
+int emlang_format_int64(long long value, char* buf, int size);                  // Bytes written, 0 if buf is too small
+int emlang_format_double(double value, char* buf, int size);                    // Shortest round-trip form, 0 if buf is too small
+
+// ======================== BATCH ========================
+// Lists are fields separated by delimiter or newlines; surrounding spaces
+// and tabs are skipped. Parsing stops at the first malformed field.
+long long emlang_parse_int64_list(const char* str, long long len, char delimiter,
+                                  long long* out, long long capacity, long long* consumed);   // Values stored, bytes read in *consumed
+long long emlang_parse_double_list(const char* str, long long len, char delimiter,
+                                   double* out, long long capacity, long long* consumed);     // Values stored, bytes read in *consumed
+long long emlang_format_int64_list(const long long* values, long long count, char delimiter,
+                                   char* buf, long long size);                                // Bytes written, -1 if buf is too small
+long long emlang_format_double_list(const double* values, long long count, char delimiter,
+                                    char* buf, long long size);                               // Bytes written, -1 if buf is too small
+
+// ======================== STRING CONVENIENCE ========================
+long long emlang_str_to_int64(const char* str);                                 // Whole string as int64, 0 if invalid
+double emlang_str_to_double(const char* str);                                   // Whole string as double, 0.0 if invalid
+char* emlang_int64_to_str(long long value);                                     // New string (free with emlang_free)
+char* emlang_double_to_str(double value);                                       // New string, shortest form (free with emlang_free)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_NUMBER_H
@@ -0,0 +1,38 @@
+#ifndef EMLANG_PERF_H
+#define EMLANG_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Hardware performance counters around named regions
+ *
+ * Each thread opens one perf_event_open counter group on its first
+ * emlang_perf_begin: cycles, instructions, cache references and misses,
+ * branches and branch misses. The group is read in a single system call
+ * at region boundaries and scaled when the kernel multiplexes it. When
+ * hardware events are unavailable or not permitted (perf_event_paranoid,
+ * containers, VMs) the group falls back to software counters: task
+ * clock, page faults, context switches and CPU migrations. Off Linux only
+ * wall time is recorded.
+ *
+ * Regions nest and may repeat; results are accumulated by name across
+ * calls and threads. A summary is printed to stderr at exit, and the
+ * same data is written as JSON to EMLANG_PERF_JSON if that is set.
+ */
+
+// ======================== REGIONS ========================
+void emlang_perf_begin(const char* region);             // Snapshot counters at region start
+void emlang_perf_end(const char* region);               // Accumulate counters since the matching begin
+
+// ======================== REPORTING ========================
+int emlang_perf_hardware(void);                         // 1 if hardware counters are in use on this thread
+void emlang_perf_summary(void);                         // Print accumulated regions to stderr
+int emlang_perf_export_json(const char* path);          // Write accumulated regions as JSON, returns 0 on failure
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_PERF_H
@@ -0,0 +1,66 @@
+#ifndef EMLANG_STRBUF_H
+#define EMLANG_STRBUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes stored inline before the builder spills to the heap
+#define EMLANG_STRBUF_INLINE_CAPACITY 32
+
+/**
+ * @brief Growable, always NUL-terminated string builder
+ *
+ * Short strings live in inline_buf; longer ones move to a heap block that
+ * grows geometrically, so N appends cost O(N) in total instead of the
+ * O(N^2) of repeated emlang_strcat calls.
+ */
+typedef struct emlang_strbuf {
+    char* data;                                     // Points at inline_buf or a heap block
+    int length;                                     // Bytes used, excluding the terminator
+    int capacity;                                   // Usable bytes, excluding the terminator
+    char inline_buf[EMLANG_STRBUF_INLINE_CAPACITY + 1];
+} emlang_strbuf;
+
+/**
+ * @brief Rope for large documents (opaque)
+ *
+ * Text is kept in bounded chunks inside a randomized balanced tree, so
+ * insertions and indexing at arbitrary positions cost O(log n).
+ */
+typedef struct emlang_rope emlang_rope;
+
+// ======================== STRING BUILDER ========================
+void emlang_strbuf_init(emlang_strbuf* sb);                             // Initialize caller-owned builder
+void emlang_strbuf_destroy(emlang_strbuf* sb);                          // Release heap storage of caller-owned builder
+emlang_strbuf* emlang_strbuf_new(void);                                 // Allocate a new empty builder
+void emlang_strbuf_free(emlang_strbuf* sb);                             // Free builder allocated with emlang_strbuf_new
+int emlang_strbuf_reserve(emlang_strbuf* sb, int capacity);             // Ensure capacity, returns 0 on failure
+void emlang_strbuf_shrink(emlang_strbuf* sb);                           // Release unused heap capacity
+void emlang_strbuf_clear(emlang_strbuf* sb);                            // Reset length, keep capacity
+void emlang_strbuf_append_str(emlang_strbuf* sb, const char* str);      // Append NUL-terminated string
+void emlang_strbuf_append_n(emlang_strbuf* sb, const char* str, int n); // Append n bytes
+void emlang_strbuf_append_char(emlang_strbuf* sb, char c);              // Append single character
+void emlang_strbuf_append_int(emlang_strbuf* sb, long long value);      // Append decimal integer
+void emlang_strbuf_append_float(emlang_strbuf* sb, double value);       // Append floating point (%.6f)
+const char* emlang_strbuf_view(const emlang_strbuf* sb);                // Zero-copy view, valid until next mutation
+int emlang_strbuf_length(const emlang_strbuf* sb);                      // Current length in bytes
+char* emlang_strbuf_detach(emlang_strbuf* sb);                          // Take ownership of contents (free with emlang_free)
+
+// ======================== ROPE ========================
+emlang_rope* emlang_rope_new(void);                                     // Allocate an empty rope
+emlang_rope* emlang_rope_from_str(const char* str);                     // Build rope from string
+void emlang_rope_free(emlang_rope* rope);                               // Free rope and all chunks
+long long emlang_rope_length(const emlang_rope* rope);                  // Total length in bytes
+int emlang_rope_insert(emlang_rope* rope, long long pos, const char* str); // Insert at byte offset, returns 0 on failure
+int emlang_rope_append(emlang_rope* rope, const char* str);             // Append at end, returns 0 on failure
+int emlang_rope_erase(emlang_rope* rope, long long pos, long long len); // Remove byte range, returns 0 on failure
+char emlang_rope_char_at(const emlang_rope* rope, long long pos);       // Byte at offset, '\0' if out of range
+long long emlang_rope_copy(const emlang_rope* rope, char* dest, long long max_len); // Flatten into buffer, returns bytes written
+void emlang_rope_to_strbuf(const emlang_rope* rope, emlang_strbuf* sb); // Append rope contents to builder
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_STRBUF_H
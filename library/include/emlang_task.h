@@ -0,0 +1,35 @@
+#ifndef EMLANG_TASK_H
+#define EMLANG_TASK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Single-threaded executor and frame allocator for async functions
+ *
+ * An async function compiles to an LLVM switched-resume coroutine. Its
+ * frame holds the locals that live across suspension points, so a
+ * suspended task costs its frame (tens to hundreds of bytes) instead of
+ * a thread stack. Frames are recycled through per-size free lists.
+ *
+ * Calling an async function runs it until it first suspends and returns
+ * the task, the address of its frame. Tasks that can continue are queued
+ * with emlang_task_schedule and resumed in FIFO order by
+ * emlang_task_block_on, which `await` calls outside async functions.
+ * Each thread has its own queue and frame pool.
+ */
+
+// ======================== FRAMES ========================
+void* emlang_coro_alloc(long long size);                // Frame for an async call, aborts when out of memory
+void emlang_coro_free(void* frame, long long size);     // Return a frame of the size it was allocated with
+
+// ======================== EXECUTOR ========================
+void emlang_task_schedule(void* task);                  // Queue a suspended task to be resumed
+void emlang_task_block_on(void* task);                  // Resume queued tasks until task has finished
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_TASK_H
@@ -0,0 +1,39 @@
+#ifndef EMLANG_UTF8_H
+#define EMLANG_UTF8_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UTF-8 kernels
+ *
+ * Validation classifies 16 bytes at a time with three nibble lookup tables
+ * (the simdutf "lookup" algorithm) when SSSE3 is available, and falls back
+ * to a scalar decoder otherwise. Counting and slicing only need to find
+ * lead bytes, which SSE2 does directly. Lengths are in bytes, indices and
+ * counts of codepoints are named as such.
+ */
+
+// ======================== VALIDATION ========================
+int emlang_utf8_validate(const char* data, long long len);              // 1 if data is well-formed UTF-8
+long long emlang_utf8_error_offset(const char* data, long long len);    // Offset of first invalid byte, or -1 if valid
+
+// ======================== COUNTING ========================
+long long emlang_utf8_count(const char* data, long long len);           // Codepoints in valid UTF-8
+long long emlang_utf8_strlen(const char* str);                          // Codepoints in a NUL-terminated string
+long long emlang_utf8_offset(const char* data, long long len, long long index); // Byte offset of codepoint index, len if past the end
+
+// ======================== TRANSCODING ========================
+long long emlang_utf8_to_utf32(const char* src, long long len, unsigned int* dst);           // Codepoints written, -1 if invalid
+long long emlang_utf32_utf8_length(const unsigned int* src, long long count);                // Bytes needed, -1 on invalid codepoint
+long long emlang_utf32_to_utf8(const unsigned int* src, long long count, char* dst);         // Bytes written, -1 on invalid codepoint
+
+// ======================== SLICING ========================
+char* emlang_utf8_slice(const char* str, long long start, long long count); // Copy of count codepoints from start (free with emlang_free)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_UTF8_H
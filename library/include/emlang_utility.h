@@ -30,6 +30,25 @@ int emlang_current_month(void);
  */
 int emlang_current_day(void);
 
+// ======================== HIGH-RESOLUTION TIMERS ========================
+/**
+ * @brief Get monotonic time in nanoseconds
+ * @return Nanoseconds since an arbitrary fixed point (not the epoch)
+ */
+long long emlang_now_ns(void);
+
+/**
+ * @brief Read the CPU cycle counter (rdtsc on x86, cntvct on AArch64)
+ * @return Raw counter value; falls back to emlang_now_ns elsewhere
+ */
+long long emlang_cycles(void);
+
+/**
+ * @brief Get the cycle counter rate, calibrated once against emlang_now_ns
+ * @return Counter ticks per nanosecond
+ */
+double emlang_cycles_per_ns(void);
+
 // ======================== SYSTEM UTILITIES ========================
 /**
  * @brief Sleep for specified milliseconds
@@ -0,0 +1,46 @@
+#ifndef EMLANG_VEC_H
+#define EMLANG_VEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Growable array of fixed-size elements
+ *
+ * Compiled code reads data, length and capacity directly, so the first
+ * three fields are part of the ABI and must stay in this order. Only the
+ * grow path of push and out-of-range indexing call into the runtime.
+ */
+typedef struct emlang_vec {
+    void* data;                                                 // Element storage
+    long long length;                                           // Elements in use
+    long long capacity;                                         // Elements allocated
+    long long elem_size;                                        // Bytes per element
+} emlang_vec;
+
+// ======================== LIFETIME ========================
+emlang_vec* emlang_vec_new(long long elem_size);                // Allocate an empty vector
+void emlang_vec_free(emlang_vec* vec);                          // Free vector and its storage
+
+// ======================== CAPACITY ========================
+int emlang_vec_reserve(emlang_vec* vec, long long capacity);    // Ensure exact minimum capacity, returns 0 on failure
+int emlang_vec_grow(emlang_vec* vec, long long min_capacity);   // Geometric growth to at least min_capacity, returns 0 on failure
+void emlang_vec_shrink(emlang_vec* vec);                        // Release unused capacity
+int emlang_vec_resize(emlang_vec* vec, long long length);       // Set length, zero-filling new elements
+void emlang_vec_clear(emlang_vec* vec);                         // Set length to zero, keep capacity
+
+// ======================== ELEMENTS ========================
+long long emlang_vec_length(const emlang_vec* vec);             // Number of elements
+int emlang_vec_push(emlang_vec* vec, const void* elem);         // Append one element, returns 0 on failure
+int emlang_vec_append(emlang_vec* vec, const void* elems, long long count); // Append count elements in one copy
+int emlang_vec_pop(emlang_vec* vec, void* out);                 // Remove last element into out, returns 0 if empty
+void* emlang_vec_at(const emlang_vec* vec, long long index);    // Checked element address, NULL if out of range
+void emlang_vec_index_fail(long long index, long long length);  // Report out-of-range index and abort
+void emlang_vec_alloc_fail(long long capacity);                 // Report failed growth and abort
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EMLANG_VEC_H
@@ -0,0 +1,166 @@
+#include "emlang_bench.h"
+#include "emlang_utility.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    BENCH_CALIBRATE,
+    BENCH_WARMUP,
+    BENCH_MEASURE,
+    BENCH_DONE
+} BenchPhase;
+
+struct emlang_bench {
+    long long remaining;                    // Iterations left in the current batch
+    long long batch;                        // Iterations per batch
+    long long batch_start;                  // Clock at the start of the current batch
+    long long phase_start;                  // Clock when the current phase began
+    BenchPhase phase;
+    int started;
+    int sample_count;
+    double samples[EMLANG_BENCH_SAMPLES];   // Nanoseconds per iteration, one per measured batch
+    char* name;
+};
+
+static volatile long long bench_sink;
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *static_cast<const double*>(a);
+    double y = *static_cast<const double*>(b);
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Linear-interpolated percentile of sorted values, p in [0, 1]
+ */
+static double percentile(const double* sorted, int count, double p) {
+    if (count <= 0) return 0.0;
+    double position = p * (count - 1);
+    int index = static_cast<int>(position);
+    if (index + 1 >= count) return sorted[count - 1];
+    double fraction = position - index;
+    return sorted[index] + (sorted[index + 1] - sorted[index]) * fraction;
+}
+
+/**
+ * @brief Close the batch that just ran, advance the phase and open the next batch
+ * @return 1 to keep iterating, 0 when measurement is complete
+ */
+static int bench_next_batch(emlang_bench* bench) {
+    long long now = emlang_now_ns();
+
+    if (!bench->started) {
+        bench->started = 1;
+        bench->phase_start = now;
+    } else {
+        long long elapsed = now - bench->batch_start;
+        switch (bench->phase) {
+            case BENCH_CALIBRATE:
+                if (elapsed < EMLANG_BENCH_BATCH_NS && bench->batch < (1LL << 40)) {
+                    bench->batch *= 2;
+                } else {
+                    bench->phase = BENCH_WARMUP;
+                    bench->phase_start = now;
+                }
+                break;
+            case BENCH_WARMUP:
+                if (now - bench->phase_start >= EMLANG_BENCH_WARMUP_NS) {
+                    bench->phase = BENCH_MEASURE;
+                    bench->phase_start = now;
+                }
+                break;
+            case BENCH_MEASURE:
+                bench->samples[bench->sample_count++] = static_cast<double>(elapsed) / bench->batch;
+                if (bench->sample_count == EMLANG_BENCH_SAMPLES ||
+                    now - bench->phase_start >= EMLANG_BENCH_MAX_NS) {
+                    bench->phase = BENCH_DONE;
+                }
+                break;
+            case BENCH_DONE:
+                break;
+        }
+    }
+
+    if (bench->phase == BENCH_DONE) return 0;
+
+    // This call accounts for the first iteration of the new batch
+    bench->remaining = bench->batch - 1;
+    bench->batch_start = emlang_now_ns();
+    return 1;
+}
+
+extern "C" {
+
+// ======================== RUNNING ========================
+
+emlang_bench* emlang_bench_begin(const char* name) {
+    emlang_bench* bench = static_cast<emlang_bench*>(calloc(1, sizeof(emlang_bench)));
+    if (!bench) return nullptr;
+
+    const char* label = name ? name : "bench";
+    size_t length = strlen(label);
+    bench->name = static_cast<char*>(malloc(length + 1));
+    if (!bench->name) {
+        free(bench);
+        return nullptr;
+    }
+    memcpy(bench->name, label, length + 1);
+    bench->batch = 1;
+    bench->phase = BENCH_CALIBRATE;
+    return bench;
+}
+
+int emlang_bench_iteration(emlang_bench* bench) {
+    if (!bench) return 0;
+    if (bench->remaining > 0) {
+        bench->remaining--;
+        return 1;
+    }
+    return bench_next_batch(bench);
+}
+
+double emlang_bench_end(emlang_bench* bench) {
+    if (!bench) return 0.0;
+
+    int count = bench->sample_count;
+    double* sorted = bench->samples;
+    qsort(sorted, static_cast<size_t>(count), sizeof(double), compare_doubles);
+
+    // Tukey's fences drop batches disturbed by interrupts, migrations or page faults
+    double q1 = percentile(sorted, count, 0.25);
+    double q3 = percentile(sorted, count, 0.75);
+    double low = q1 - 1.5 * (q3 - q1);
+    double high = q3 + 1.5 * (q3 - q1);
+    int first = 0;
+    int last = count;
+    while (first < last && sorted[first] < low) first++;
+    while (last > first && sorted[last - 1] > high) last--;
+    int kept = last - first;
+
+    double median = percentile(sorted + first, kept, 0.5);
+    double p99 = percentile(sorted + first, kept, 0.99);
+    double minimum = kept > 0 ? sorted[first] : 0.0;
+
+    if (count == 0) {
+        printf("bench %s: no samples\n", bench->name);
+    } else {
+        printf("bench %s: median %.2f ns, p99 %.2f ns, min %.2f ns, ~%.1f cycles/iter "
+               "[%d samples x %lld iters, %d outliers]\n",
+               bench->name, median, p99, minimum, median * emlang_cycles_per_ns(),
+               count, bench->batch, count - kept);
+    }
+    fflush(stdout);
+
+    free(bench->name);
+    free(bench);
+    return median;
+}
+
+// ======================== HELPERS ========================
+
+void emlang_bench_consume(long long value) {
+    bench_sink = value;
+}
+
+} // extern "C"
@@ -0,0 +1,35 @@
+#include "emlang_checks.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+extern "C" {
+
+// ======================== ARRAYS AND SLICES ========================
+
+void emlang_bounds_fail(long long index, long long length) {
+    fprintf(stderr, "Runtime Error: index %lld out of range for length %lld\n", index, length);
+    fflush(stderr);
+    abort();
+}
+
+void emlang_slice_range_fail(long long start, long long end, long long length) {
+    fprintf(stderr, "Runtime Error: slice [%lld..%lld] out of range for length %lld\n", start, end, length);
+    fflush(stderr);
+    abort();
+}
+
+void emlang_length_fail(long long length, long long expected) {
+    fprintf(stderr, "Runtime Error: array of length %lld where length %lld was expected\n", length, expected);
+    fflush(stderr);
+    abort();
+}
+
+// ======================== ARITHMETIC ========================
+
+void emlang_overflow_fail(long long line) {
+    fprintf(stderr, "Runtime Error: integer overflow at line %lld\n", line);
+    fflush(stderr);
+    abort();
+}
+
+} // extern "C"
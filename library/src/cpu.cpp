@@ -0,0 +1,152 @@
+#include "emlang_cpu.h"
+#include <string>
+#include <string.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define EMLANG_HAS_CPUID 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define EMLANG_HAS_CPUID 1
+#endif
+
+/**
+ * @brief A feature name and where cpuid reports it
+ */
+struct FeatureBit {
+    const char* name;
+    unsigned leaf;          // cpuid leaf (subleaf 0)
+    int reg;                // 1 = ebx, 2 = ecx, 3 = edx
+    unsigned bit;
+    int state;              // 0 = none, 1 = needs AVX state, 2 = needs AVX-512 state
+};
+
+static const FeatureBit FEATURE_BITS[] = {
+    {"sse3",     1,          2, 0,  0},
+    {"ssse3",    1,          2, 9,  0},
+    {"fma",      1,          2, 12, 1},
+    {"sse4.1",   1,          2, 19, 0},
+    {"sse4.2",   1,          2, 20, 0},
+    {"popcnt",   1,          2, 23, 0},
+    {"aes",      1,          2, 25, 0},
+    {"avx",      1,          2, 28, 1},
+    {"f16c",     1,          2, 29, 1},
+    {"bmi",      7,          1, 3,  0},
+    {"avx2",     7,          1, 5,  1},
+    {"bmi2",     7,          1, 8,  0},
+    {"avx512f",  7,          1, 16, 2},
+    {"avx512dq", 7,          1, 17, 2},
+    {"avx512bw", 7,          1, 30, 2},
+    {"avx512vl", 7,          1, 31, 2},
+    {"lzcnt",    0x80000001, 2, 5,  0},
+};
+
+static const size_t FEATURE_COUNT = sizeof(FEATURE_BITS) / sizeof(FEATURE_BITS[0]);
+
+#ifdef EMLANG_HAS_CPUID
+static void cpuid(unsigned leaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), 0);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned>(out[i]);
+    }
+#else
+    __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long read_xcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+/**
+ * @brief Detected features as a bit per FEATURE_BITS entry
+ */
+static unsigned long long detect_features() {
+    unsigned long long mask = 0;
+#ifdef EMLANG_HAS_CPUID
+    unsigned regs[4];
+    cpuid(0, regs);
+    unsigned maxLeaf = regs[0];
+    cpuid(0x80000000, regs);
+    unsigned maxExtendedLeaf = regs[0];
+
+    unsigned leaf1[4] = {0, 0, 0, 0};
+    unsigned leaf7[4] = {0, 0, 0, 0};
+    unsigned extended1[4] = {0, 0, 0, 0};
+    cpuid(1, leaf1);
+    if (maxLeaf >= 7) {
+        cpuid(7, leaf7);
+    }
+    if (maxExtendedLeaf >= 0x80000001) {
+        cpuid(0x80000001, extended1);
+    }
+
+    // Register state the OS saves: XMM|YMM for AVX, plus opmask and ZMM for AVX-512
+    bool avxState = false;
+    bool avx512State = false;
+    if (leaf1[2] & (1u << 27)) {
+        unsigned long long xcr0 = read_xcr0();
+        avxState = (xcr0 & 0x6) == 0x6;
+        avx512State = (xcr0 & 0xE6) == 0xE6;
+    }
+
+    for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+        const FeatureBit& feature = FEATURE_BITS[i];
+        const unsigned* regsForLeaf = feature.leaf == 1 ? leaf1 : feature.leaf == 7 ? leaf7 : extended1;
+        if (!(regsForLeaf[feature.reg] & (1u << feature.bit))) {
+            continue;
+        }
+        if ((feature.state == 1 && !avxState) || (feature.state == 2 && !avx512State)) {
+            continue;
+        }
+        mask |= 1ULL << i;
+    }
+#endif
+    return mask;
+}
+
+static unsigned long long feature_mask() {
+    static const unsigned long long mask = detect_features();
+    return mask;
+}
+
+extern "C" {
+
+int emlang_cpu_supports(const char* feature) {
+    if (!feature) {
+        return 0;
+    }
+    for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+        if (strcmp(FEATURE_BITS[i].name, feature) == 0) {
+            return (feature_mask() >> i) & 1 ? 1 : 0;
+        }
+    }
+    return 0;
+}
+
+const char* emlang_cpu_features(void) {
+    static const std::string* list = [] {
+        std::string* features = new std::string();
+        for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+            if ((feature_mask() >> i) & 1) {
+                if (!features->empty()) {
+                    *features += ",";
+                }
+                *features += FEATURE_BITS[i].name;
+            }
+        }
+        return features;
+    }();
+    return list->c_str();
+}
+
+} // extern "C"
@@ -0,0 +1,38 @@
+#ifndef EMLANG_CYCLES_H
+#define EMLANG_CYCLES_H
+
+#include <time.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define EMLANG_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define EMLANG_HAS_TSC 1
+#elif defined(_WIN32)
+#include <chrono>
+#endif
+
+/**
+ * @brief Raw cycle counter (rdtsc on x86, cntvct on AArch64), nanoseconds elsewhere
+ *
+ * Inline so that instrumentation hooks read the counter without a call.
+ */
+static inline unsigned long long emlang_read_cycles(void) {
+#if defined(EMLANG_HAS_TSC)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    unsigned long long ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#elif defined(_WIN32)
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL + static_cast<unsigned long long>(ts.tv_nsec);
+#endif
+}
+
+#endif // EMLANG_CYCLES_H
@@ -0,0 +1,290 @@
+#include "emlang_funcprof.h"
+#include "emlang_utility.h"
+#include "cycles.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FUNCPROF_DEFAULT_FOLDED "emlang-functions.folded"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FUNCPROF_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define FUNCPROF_TLS_MODEL
+#endif
+
+/**
+ * @brief Calling-context tree node: one function reached through one call path
+ */
+struct CallNode {
+    int function;
+    int parent;
+    int first_child;
+    int next_sibling;
+    unsigned long long self;            // Ticks spent in this node excluding callees
+};
+
+/**
+ * @brief Shadow stack entry for an active call
+ */
+struct Frame {
+    int function;
+    int node;
+    unsigned long long start;
+    unsigned long long children;        // Ticks spent in callees so far
+};
+
+/**
+ * @brief Per-function totals; total only counts the outermost activation of recursive calls
+ */
+struct FunctionTotals {
+    unsigned long long self;
+    unsigned long long total;
+    unsigned long long calls;
+    int depth;
+};
+
+struct ThreadProfile {
+    std::vector<CallNode> nodes;        // nodes[0] is the root
+    std::vector<Frame> stack;
+    std::vector<FunctionTotals> functions;
+
+    ThreadProfile() {
+        nodes.push_back(CallNode{-1, -1, -1, -1, 0});
+        stack.reserve(64);
+    }
+};
+
+static void fold_thread(ThreadProfile* profile);
+
+/**
+ * @brief Folds the thread's profile into the global one when the thread exits
+ */
+struct ThreadProfileOwner {
+    ~ThreadProfileOwner();
+};
+
+static thread_local ThreadProfile* thread_profile FUNCPROF_TLS_MODEL = nullptr;
+static thread_local bool thread_finished FUNCPROF_TLS_MODEL = false;
+
+// Guarded by profile_mutex. The containers are created on first use and never
+// destroyed, so they outlive static destructors and the atexit writer.
+static std::mutex profile_mutex;
+static const char* const* function_names = nullptr;
+static int function_count = 0;
+static std::map<std::string, unsigned long long>* folded_stacks = nullptr;
+static std::vector<FunctionTotals>* function_totals = nullptr;
+
+// ======================== THREAD STATE ========================
+
+ThreadProfileOwner::~ThreadProfileOwner() {
+    if (thread_profile) {
+        fold_thread(thread_profile);
+        delete thread_profile;
+        thread_profile = nullptr;
+    }
+    thread_finished = true;
+}
+
+static ThreadProfile* create_thread_profile(void) {
+    static thread_local ThreadProfileOwner owner;
+    (void)owner;
+    thread_profile = new ThreadProfile();
+    return thread_profile;
+}
+
+static int child_node(ThreadProfile* profile, int parent, int function) {
+    for (int child = profile->nodes[parent].first_child; child >= 0; child = profile->nodes[child].next_sibling) {
+        if (profile->nodes[child].function == function) return child;
+    }
+    int node = static_cast<int>(profile->nodes.size());
+    profile->nodes.push_back(CallNode{function, parent, -1, profile->nodes[parent].first_child, 0});
+    profile->nodes[parent].first_child = node;
+    return node;
+}
+
+static FunctionTotals& totals_for(std::vector<FunctionTotals>& totals, int function) {
+    if (static_cast<size_t>(function) >= totals.size()) {
+        totals.resize(static_cast<size_t>(function) + 1, FunctionTotals{0, 0, 0, 0});
+    }
+    return totals[static_cast<size_t>(function)];
+}
+
+static void pop_frame(ThreadProfile* profile, unsigned long long now) {
+    Frame frame = profile->stack.back();
+    profile->stack.pop_back();
+
+    unsigned long long total = now - frame.start;
+    unsigned long long self = total > frame.children ? total - frame.children : 0;
+    profile->nodes[frame.node].self += self;
+
+    FunctionTotals& totals = totals_for(profile->functions, frame.function);
+    totals.self += self;
+    totals.calls++;
+    if (--totals.depth == 0) totals.total += total;
+
+    if (!profile->stack.empty()) profile->stack.back().children += total;
+}
+
+// ======================== FOLDING ========================
+
+static std::string function_name(int function) {
+    if (function >= 0 && function < function_count && function_names && function_names[function]) {
+        return function_names[function];
+    }
+    return "fn#" + std::to_string(function);
+}
+
+/**
+ * @brief Close any open frames and add the thread's tree and totals to the global profile
+ */
+static void fold_thread(ThreadProfile* profile) {
+    unsigned long long now = emlang_read_cycles();
+    while (!profile->stack.empty()) pop_frame(profile, now);
+
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    if (!folded_stacks) {
+        folded_stacks = new std::map<std::string, unsigned long long>();
+        function_totals = new std::vector<FunctionTotals>();
+    }
+    std::vector<std::string> paths(profile->nodes.size());
+    // Children are always created after their parent, so one forward pass builds every path
+    for (size_t i = 1; i < profile->nodes.size(); i++) {
+        const CallNode& node = profile->nodes[i];
+        std::string name = function_name(node.function);
+        paths[i] = node.parent > 0 ? paths[static_cast<size_t>(node.parent)] + ";" + name : name;
+        if (node.self) (*folded_stacks)[paths[i]] += node.self;
+    }
+    for (size_t function = 0; function < profile->functions.size(); function++) {
+        const FunctionTotals& source = profile->functions[function];
+        FunctionTotals& target = totals_for(*function_totals, static_cast<int>(function));
+        target.self += source.self;
+        target.total += source.total;
+        target.calls += source.calls;
+    }
+}
+
+static int write_folded(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return 0;
+    if (folded_stacks) {
+        for (const auto& entry : *folded_stacks) {
+            fprintf(file, "%s %llu\n", entry.first.c_str(), entry.second);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+static int write_table(const char* path) {
+    FILE* file = path ? fopen(path, "w") : stderr;
+    if (!file) return 0;
+
+    if (!function_totals) function_totals = new std::vector<FunctionTotals>();
+    const std::vector<FunctionTotals>& totalsByFunction = *function_totals;
+    std::vector<int> order;
+    unsigned long long selfSum = 0;
+    for (size_t function = 0; function < totalsByFunction.size(); function++) {
+        if (totalsByFunction[function].calls) order.push_back(static_cast<int>(function));
+        selfSum += totalsByFunction[function].self;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return totalsByFunction[static_cast<size_t>(a)].self > totalsByFunction[static_cast<size_t>(b)].self;
+    });
+
+    double ticksPerMs = emlang_cycles_per_ns() * 1e6;
+    fprintf(file, "%7s %12s %12s %12s  %s\n", "self%", "self ms", "total ms", "calls", "function");
+    for (int function : order) {
+        const FunctionTotals& totals = totalsByFunction[static_cast<size_t>(function)];
+        fprintf(file, "%6.2f%% %12.3f %12.3f %12llu  %s\n",
+                selfSum ? 100.0 * static_cast<double>(totals.self) / static_cast<double>(selfSum) : 0.0,
+                static_cast<double>(totals.self) / ticksPerMs,
+                static_cast<double>(totals.total) / ticksPerMs,
+                totals.calls, function_name(function).c_str());
+    }
+    if (file == stderr) {
+        fflush(file);
+        return 1;
+    }
+    return fclose(file) == 0;
+}
+
+static int write_profile(const char* folded_path, const char* table_path) {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    int ok = write_folded(folded_path);
+    return write_table(table_path) && ok;
+}
+
+static void write_at_exit(void) {
+    const char* folded = getenv("EMLANG_FUNCPROF_FOLDED");
+    const char* table = getenv("EMLANG_FUNCPROF_TABLE");
+    // The exiting thread's profile was folded by its thread_local destructor, which runs first
+    write_profile(folded && *folded ? folded : FUNCPROF_DEFAULT_FOLDED, table && *table ? table : nullptr);
+}
+
+extern "C" {
+
+// ======================== HOOKS ========================
+
+void emlang_funcprof_enter(int function) {
+    ThreadProfile* profile = thread_profile;
+    if (!profile) {
+        if (thread_finished || function < 0) return;
+        profile = create_thread_profile();
+    }
+    int parent = profile->stack.empty() ? 0 : profile->stack.back().node;
+    int node = child_node(profile, parent, function);
+    totals_for(profile->functions, function).depth++;
+    profile->stack.push_back(Frame{function, node, emlang_read_cycles(), 0});
+}
+
+void emlang_funcprof_exit(int function) {
+    unsigned long long now = emlang_read_cycles();
+    ThreadProfile* profile = thread_profile;
+    if (!profile || profile->stack.empty()) return;
+
+    // Frames skipped by a non-local exit end here too
+    while (profile->stack.size() > 1 && profile->stack.back().function != function) {
+        pop_frame(profile, now);
+    }
+    pop_frame(profile, now);
+}
+
+// ======================== FUNCTIONS ========================
+
+void emlang_funcprof_register(const char* const* names, int count) {
+    static bool hooks_installed = false;
+    {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        function_names = names;
+        function_count = count > 0 ? count : 0;
+        if (hooks_installed) return;
+        hooks_installed = true;
+    }
+    atexit(write_at_exit);
+}
+
+// ======================== OUTPUT ========================
+
+int emlang_funcprof_write(const char* folded_path, const char* table_path) {
+    // Fold the caller's finished calls now; its open frames keep running
+    ThreadProfile* profile = thread_profile;
+    if (profile) {
+        ThreadProfile finished;
+        finished.nodes = profile->nodes;
+        finished.functions = profile->functions;
+        for (CallNode& node : profile->nodes) node.self = 0;
+        for (FunctionTotals& totals : profile->functions) {
+            totals.self = 0;
+            totals.total = 0;
+            totals.calls = 0;
+        }
+        fold_thread(&finished);
+    }
+    return write_profile(folded_path ? folded_path : FUNCPROF_DEFAULT_FOLDED, table_path);
+}
+
+} // extern "C"
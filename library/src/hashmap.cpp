@@ -0,0 +1,568 @@
+#include "emlang_hashmap.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EMLANG_HASHMAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Control bytes: full slots hold the low 7 hash bits (0..127), special
+// states are negative so a single signed compare separates them
+static const signed char CTRL_EMPTY = -128;
+static const signed char CTRL_DELETED = -2;
+static const signed char CTRL_SENTINEL = -1;
+
+// Number of control bytes inspected per probe step
+static const size_t GROUP_WIDTH = 16;
+
+// Smallest table allocated on first insert
+static const size_t MIN_CAPACITY = 16;
+
+/**
+ * @brief Heap copy of a string key, with its hash cached for rehashing
+ */
+struct StrKey {
+    uint64_t hash;
+    size_t len;
+    char text[1];
+};
+
+struct Slot {
+    union {
+        long long i;
+        StrKey* s;
+    } key;
+    long long value;
+};
+
+struct emlang_hashmap {
+    signed char* ctrl;      // capacity + GROUP_WIDTH bytes, tail mirrors the head
+    Slot* slots;
+    size_t capacity;        // Zero or a power of two >= MIN_CAPACITY
+    size_t size;
+    size_t growth_left;     // Inserts into empty slots allowed before rehash
+    int string_keys;
+};
+
+// ======================== HASH PRIMITIVES ========================
+
+static const uint64_t WY_SECRET[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/**
+ * @brief 64x64 -> 128 multiply, low half in *a and high half in *b
+ */
+static inline void wy_mum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(*a) * *b;
+    *a = static_cast<uint64_t>(r);
+    *b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = static_cast<uint32_t>(*a), lb = static_cast<uint32_t>(*b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t wy_read8(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t wy_read4(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t wy_read3(const unsigned char* p, size_t k) {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+static uint64_t wy_hash(const void* key, size_t len, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(key);
+    seed ^= wy_mix(seed ^ WY_SECRET[0], WY_SECRET[1]);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wy_read4(p) << 32) | wy_read4(p + ((len >> 3) << 2));
+            b = (wy_read4(p + len - 4) << 32) | wy_read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = wy_read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = wy_mix(wy_read8(p) ^ WY_SECRET[1], wy_read8(p + 8) ^ seed);
+                see1 = wy_mix(wy_read8(p + 16) ^ WY_SECRET[2], wy_read8(p + 24) ^ see1);
+                see2 = wy_mix(wy_read8(p + 32) ^ WY_SECRET[3], wy_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wy_mix(wy_read8(p) ^ WY_SECRET[1], wy_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wy_read8(p + i - 16);
+        b = wy_read8(p + i - 8);
+    }
+
+    a ^= WY_SECRET[1];
+    b ^= seed;
+    wy_mum(&a, &b);
+    return wy_mix(a ^ WY_SECRET[0] ^ len, b ^ WY_SECRET[1]);
+}
+
+static inline uint64_t hash_int(long long value) {
+    return wy_mix(static_cast<uint64_t>(value) ^ WY_SECRET[0], WY_SECRET[1]);
+}
+
+// ======================== CONTROL GROUPS ========================
+
+static inline unsigned int trailing_zeros(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+static inline unsigned int leading_zeros16(unsigned int mask) {
+    unsigned int count = 0;
+    for (unsigned int bit = 1u << 15; bit && !(mask & bit); bit >>= 1) {
+        count++;
+    }
+    return count;
+}
+
+#if defined(EMLANG_HASHMAP_SSE2)
+
+static inline unsigned int group_match(const signed char* group, signed char h2) {
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+}
+
+static inline unsigned int group_match_empty(const signed char* group) {
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(CTRL_EMPTY), ctrl)));
+}
+
+static inline unsigned int group_match_empty_or_deleted(const signed char* group) {
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), ctrl)));
+}
+
+#else
+
+static inline unsigned int group_match(const signed char* group, signed char h2) {
+    unsigned int mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= static_cast<unsigned int>(group[i] == h2) << i;
+    }
+    return mask;
+}
+
+static inline unsigned int group_match_empty(const signed char* group) {
+    return group_match(group, CTRL_EMPTY);
+}
+
+static inline unsigned int group_match_empty_or_deleted(const signed char* group) {
+    unsigned int mask = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= static_cast<unsigned int>(group[i] < CTRL_SENTINEL) << i;
+    }
+    return mask;
+}
+
+#endif
+
+// ======================== TABLE HELPERS ========================
+
+static inline signed char hash_h2(uint64_t hash) {
+    return static_cast<signed char>(hash & 0x7F);
+}
+
+static inline void set_ctrl(emlang_hashmap* map, size_t index, signed char value) {
+    map->ctrl[index] = value;
+    // Keep the cloned tail in sync so a group load never needs to wrap
+    if (index < GROUP_WIDTH) {
+        map->ctrl[map->capacity + index] = value;
+    }
+}
+
+static inline size_t max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+static inline uint64_t slot_hash(const emlang_hashmap* map, const Slot& slot) {
+    return map->string_keys ? slot.key.s->hash : hash_int(slot.key.i);
+}
+
+/**
+ * @brief Probe for a slot whose key satisfies eq
+ *
+ * Groups are visited along a triangular sequence, which covers every group
+ * of a power-of-two table. The search stops at the first group containing
+ * an empty slot, since an insert would have used it.
+ */
+template <typename Eq>
+static long long probe_find(const emlang_hashmap* map, uint64_t hash, Eq eq) {
+    if (map->capacity == 0) return -1;
+
+    size_t mask = map->capacity - 1;
+    size_t pos = static_cast<size_t>(hash >> 7) & mask;
+    size_t step = 0;
+    signed char h2 = hash_h2(hash);
+
+    while (true) {
+        const signed char* group = map->ctrl + pos;
+        for (unsigned int bits = group_match(group, h2); bits; bits &= bits - 1) {
+            size_t index = (pos + trailing_zeros(bits)) & mask;
+            if (eq(map->slots[index])) return static_cast<long long>(index);
+        }
+        if (group_match_empty(group)) return -1;
+
+        step += GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+}
+
+static size_t probe_insert_slot(const emlang_hashmap* map, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t pos = static_cast<size_t>(hash >> 7) & mask;
+    size_t step = 0;
+
+    while (true) {
+        unsigned int bits = group_match_empty_or_deleted(map->ctrl + pos);
+        if (bits) return (pos + trailing_zeros(bits)) & mask;
+
+        step += GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+}
+
+static int map_resize(emlang_hashmap* map, size_t new_capacity) {
+    signed char* ctrl = static_cast<signed char*>(malloc(new_capacity + GROUP_WIDTH));
+    Slot* slots = static_cast<Slot*>(malloc(new_capacity * sizeof(Slot)));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return 0;
+    }
+    memset(ctrl, CTRL_EMPTY, new_capacity + GROUP_WIDTH);
+
+    signed char* old_ctrl = map->ctrl;
+    Slot* old_slots = map->slots;
+    size_t old_capacity = map->capacity;
+
+    map->ctrl = ctrl;
+    map->slots = slots;
+    map->capacity = new_capacity;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] < 0) continue;
+
+        uint64_t hash = slot_hash(map, old_slots[i]);
+        size_t index = probe_insert_slot(map, hash);
+        set_ctrl(map, index, hash_h2(hash));
+        slots[index] = old_slots[i];
+    }
+
+    map->growth_left = max_load(new_capacity) - map->size;
+    free(old_ctrl);
+    free(old_slots);
+    return 1;
+}
+
+/**
+ * @brief Make room for one more entry
+ *
+ * A table that is mostly tombstones is rehashed in place at the same
+ * capacity; otherwise it doubles.
+ */
+static int map_grow(emlang_hashmap* map) {
+    if (map->capacity == 0) return map_resize(map, MIN_CAPACITY);
+    if (map->size + 1 <= max_load(map->capacity) / 2) return map_resize(map, map->capacity);
+    return map_resize(map, map->capacity * 2);
+}
+
+static void map_erase_at(emlang_hashmap* map, size_t index) {
+    if (map->string_keys) {
+        free(map->slots[index].key.s);
+    }
+    map->size--;
+
+    // If no probe window can span this slot without also seeing an empty
+    // slot, it can become empty again instead of leaving a tombstone
+    size_t mask = map->capacity - 1;
+    size_t index_before = (index - GROUP_WIDTH) & mask;
+    unsigned int empty_after = group_match_empty(map->ctrl + index);
+    unsigned int empty_before = group_match_empty(map->ctrl + index_before);
+    if (empty_before && empty_after &&
+        trailing_zeros(empty_after) + leading_zeros16(empty_before) < GROUP_WIDTH) {
+        set_ctrl(map, index, CTRL_EMPTY);
+        map->growth_left++;
+    } else {
+        set_ctrl(map, index, CTRL_DELETED);
+    }
+}
+
+static emlang_hashmap* map_new(int string_keys) {
+    emlang_hashmap* map = static_cast<emlang_hashmap*>(malloc(sizeof(emlang_hashmap)));
+    if (!map) return nullptr;
+
+    map->ctrl = nullptr;
+    map->slots = nullptr;
+    map->capacity = 0;
+    map->size = 0;
+    map->growth_left = 0;
+    map->string_keys = string_keys;
+    return map;
+}
+
+static long long find_int(const emlang_hashmap* map, long long key) {
+    return probe_find(map, hash_int(key), [key](const Slot& slot) {
+        return slot.key.i == key;
+    });
+}
+
+static long long find_str(const emlang_hashmap* map, const char* key, size_t len, uint64_t hash) {
+    return probe_find(map, hash, [key, len, hash](const Slot& slot) {
+        const StrKey* s = slot.key.s;
+        return s->hash == hash && s->len == len && memcmp(s->text, key, len) == 0;
+    });
+}
+
+/**
+ * @brief Claim a slot for a key known to be absent
+ * @return Slot index, or -1 if the table could not grow
+ */
+static long long claim_slot(emlang_hashmap* map, uint64_t hash) {
+    if (map->growth_left == 0 && !map_grow(map)) return -1;
+
+    size_t index = probe_insert_slot(map, hash);
+    if (map->ctrl[index] == CTRL_EMPTY) {
+        map->growth_left--;
+    }
+    set_ctrl(map, index, hash_h2(hash));
+    map->size++;
+    return static_cast<long long>(index);
+}
+
+extern "C" {
+
+// ======================== HASHING ========================
+
+unsigned long long emlang_hash_bytes(const void* data, long long len, unsigned long long seed) {
+    if (!data || len <= 0) return wy_hash("", 0, seed);
+    return wy_hash(data, static_cast<size_t>(len), seed);
+}
+
+unsigned long long emlang_hash_int64(long long value) {
+    return hash_int(value);
+}
+
+// ======================== CONSTRUCTION ========================
+
+emlang_hashmap* emlang_hashmap_new(void) {
+    return map_new(0);
+}
+
+emlang_hashmap* emlang_hashmap_new_str(void) {
+    return map_new(1);
+}
+
+void emlang_hashmap_free(emlang_hashmap* map) {
+    if (!map) return;
+
+    emlang_hashmap_clear(map);
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
+
+void emlang_hashmap_clear(emlang_hashmap* map) {
+    if (!map || map->capacity == 0) return;
+
+    if (map->string_keys) {
+        for (size_t i = 0; i < map->capacity; i++) {
+            if (map->ctrl[i] >= 0) free(map->slots[i].key.s);
+        }
+    }
+    memset(map->ctrl, CTRL_EMPTY, map->capacity + GROUP_WIDTH);
+    map->size = 0;
+    map->growth_left = max_load(map->capacity);
+}
+
+int emlang_hashmap_reserve(emlang_hashmap* map, int count) {
+    if (!map || count < 0) return 0;
+
+    size_t capacity = MIN_CAPACITY;
+    while (max_load(capacity) < static_cast<size_t>(count)) {
+        capacity *= 2;
+    }
+    if (capacity <= map->capacity) return 1;
+    return map_resize(map, capacity);
+}
+
+int emlang_hashmap_size(const emlang_hashmap* map) {
+    return map ? static_cast<int>(map->size) : 0;
+}
+
+// ======================== INT64 KEYS ========================
+
+int emlang_hashmap_insert(emlang_hashmap* map, long long key, long long value) {
+    if (!map || map->string_keys) return 0;
+
+    long long index = find_int(map, key);
+    if (index < 0) {
+        index = claim_slot(map, hash_int(key));
+        if (index < 0) return 0;
+        map->slots[index].key.i = key;
+    }
+    map->slots[index].value = value;
+    return 1;
+}
+
+long long* emlang_hashmap_find(emlang_hashmap* map, long long key) {
+    if (!map || map->string_keys) return nullptr;
+
+    long long index = find_int(map, key);
+    return index < 0 ? nullptr : &map->slots[index].value;
+}
+
+long long emlang_hashmap_get(emlang_hashmap* map, long long key, long long fallback) {
+    long long* value = emlang_hashmap_find(map, key);
+    return value ? *value : fallback;
+}
+
+int emlang_hashmap_contains(emlang_hashmap* map, long long key) {
+    return emlang_hashmap_find(map, key) != nullptr;
+}
+
+int emlang_hashmap_erase(emlang_hashmap* map, long long key) {
+    if (!map || map->string_keys) return 0;
+
+    long long index = find_int(map, key);
+    if (index < 0) return 0;
+
+    map_erase_at(map, static_cast<size_t>(index));
+    return 1;
+}
+
+// ======================== STRING KEYS ========================
+
+int emlang_hashmap_insert_str(emlang_hashmap* map, const char* key, long long value) {
+    if (!map || !map->string_keys || !key) return 0;
+
+    size_t len = strlen(key);
+    uint64_t hash = wy_hash(key, len, 0);
+    long long index = find_str(map, key, len, hash);
+    if (index < 0) {
+        StrKey* copy = static_cast<StrKey*>(malloc(offsetof(StrKey, text) + len + 1));
+        if (!copy) return 0;
+        copy->hash = hash;
+        copy->len = len;
+        memcpy(copy->text, key, len + 1);
+
+        index = claim_slot(map, hash);
+        if (index < 0) {
+            free(copy);
+            return 0;
+        }
+        map->slots[index].key.s = copy;
+    }
+    map->slots[index].value = value;
+    return 1;
+}
+
+long long* emlang_hashmap_find_str(emlang_hashmap* map, const char* key) {
+    if (!map || !map->string_keys || !key) return nullptr;
+
+    size_t len = strlen(key);
+    long long index = find_str(map, key, len, wy_hash(key, len, 0));
+    return index < 0 ? nullptr : &map->slots[index].value;
+}
+
+long long emlang_hashmap_get_str(emlang_hashmap* map, const char* key, long long fallback) {
+    long long* value = emlang_hashmap_find_str(map, key);
+    return value ? *value : fallback;
+}
+
+int emlang_hashmap_contains_str(emlang_hashmap* map, const char* key) {
+    return emlang_hashmap_find_str(map, key) != nullptr;
+}
+
+int emlang_hashmap_erase_str(emlang_hashmap* map, const char* key) {
+    if (!map || !map->string_keys || !key) return 0;
+
+    size_t len = strlen(key);
+    long long index = find_str(map, key, len, wy_hash(key, len, 0));
+    if (index < 0) return 0;
+
+    map_erase_at(map, static_cast<size_t>(index));
+    return 1;
+}
+
+// ======================== ITERATION ========================
+
+int emlang_hashmap_next(const emlang_hashmap* map, int slot) {
+    if (!map || slot < 0) return -1;
+
+    for (size_t i = static_cast<size_t>(slot); i < map->capacity; i++) {
+        if (map->ctrl[i] >= 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+long long emlang_hashmap_key_at(const emlang_hashmap* map, int slot) {
+    if (!map || map->string_keys || slot < 0 || static_cast<size_t>(slot) >= map->capacity) return 0;
+    return map->slots[slot].key.i;
+}
+
+const char* emlang_hashmap_key_str_at(const emlang_hashmap* map, int slot) {
+    if (!map || !map->string_keys || slot < 0 || static_cast<size_t>(slot) >= map->capacity) return nullptr;
+    if (map->ctrl[slot] < 0) return nullptr;
+    return map->slots[slot].key.s->text;
+}
+
+long long emlang_hashmap_value_at(const emlang_hashmap* map, int slot) {
+    if (!map || slot < 0 || static_cast<size_t>(slot) >= map->capacity) return 0;
+    return map->slots[slot].value;
+}
+
+} // extern "C"
@@ -0,0 +1,469 @@
+#include "emlang_heapprof.h"
+#include <atomic>
+#include <mutex>
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEAPPROF_DEFAULT_FILE "emlang-heap.pb"
+#define HEAPPROF_FILTER_SIZE 4096       // Counters guarding the free path, power of two
+
+// The countdown is touched on every allocation; keep PIC builds off __tls_get_addr
+#if defined(__GNUC__) || defined(__clang__)
+#define HEAPPROF_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define HEAPPROF_TLS_MODEL
+#endif
+
+/**
+ * @brief Estimated totals for one call site (weighted by inverse sampling probability)
+ */
+typedef struct {
+    double alloc_objects;
+    double alloc_bytes;
+    double inuse_objects;
+    double inuse_bytes;
+} SiteStats;
+
+/**
+ * @brief A sampled block that has not been freed yet
+ */
+typedef struct {
+    void* ptr;                          // NULL for empty, TOMBSTONE for deleted
+    int site;
+    double objects;
+    double bytes;
+} LiveBlock;
+
+/**
+ * @brief Per-thread countdown to the next sample
+ */
+typedef struct {
+    long long remaining;
+    uint64_t rng;
+    int ready;
+} Sampler;
+
+static void* const TOMBSTONE = reinterpret_cast<void*>(1);
+
+static std::mutex profile_mutex;
+static std::atomic<long long> sample_rate(-1);     // -1 until read from the environment
+static std::atomic<int> dump_requested(0);
+static std::atomic<uint64_t> samplers_started(0);
+static std::atomic<unsigned int> live_filter[HEAPPROF_FILTER_SIZE];
+static thread_local Sampler sampler HEAPPROF_TLS_MODEL;
+
+// Guarded by profile_mutex
+static const char* const* site_functions = nullptr;
+static const int* site_lines = nullptr;
+static const char* site_file = "";
+static int site_count = 0;
+static SiteStats* site_stats = nullptr;     // site_count + 1 entries, the last for unknown IDs
+static LiveBlock* live_blocks = nullptr;
+static size_t live_capacity = 0;
+static size_t live_used = 0;                // Including tombstones
+
+// ======================== SAMPLING ========================
+
+static long long current_rate(void) {
+    long long rate = sample_rate.load(std::memory_order_relaxed);
+    if (rate < 0) {
+        rate = EMLANG_HEAPPROF_DEFAULT_RATE;
+        const char* env = getenv("EMLANG_HEAPPROF_RATE");
+        if (env && *env) {
+            rate = atoll(env);
+            if (rate < 0) rate = 0;
+        }
+        sample_rate.store(rate, std::memory_order_relaxed);
+    }
+    return rate;
+}
+
+/**
+ * @brief xorshift64* step, good enough for sampling intervals
+ */
+static inline uint64_t next_random(Sampler* s) {
+    s->rng ^= s->rng >> 12;
+    s->rng ^= s->rng << 25;
+    s->rng ^= s->rng >> 27;
+    return s->rng * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Exponentially distributed byte interval with mean rate
+ */
+static long long next_interval(Sampler* s, long long rate) {
+    if (rate == 0) return 0x7FFFFFFFFFFFFFFFLL;
+    // 53 random bits mapped to (0, 1]
+    double u = (static_cast<double>(next_random(s) >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+    double interval = -log(u) * static_cast<double>(rate);
+    return interval < 1.0 ? 1 : static_cast<long long>(interval);
+}
+
+static void init_sampler(Sampler* s) {
+    // TLS blocks of successive threads can reuse one address within a second, so a
+    // per-thread counter keeps their sequences apart; splitmix64 spreads the bits
+    uint64_t seed = reinterpret_cast<uintptr_t>(s) ^ (static_cast<uint64_t>(time(nullptr)) << 20);
+    seed += (samplers_started.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+    s->rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    s->ready = 1;
+}
+
+static inline size_t filter_index(const void* ptr) {
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h >> 52) & (HEAPPROF_FILTER_SIZE - 1);
+}
+
+// ======================== LIVE TABLE ========================
+
+static inline size_t live_slot(const void* ptr, size_t mask) {
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h >> 32) & mask;
+}
+
+/**
+ * @brief Double the live table (or drop tombstones), returns 0 on allocation failure
+ */
+static int live_rehash(void) {
+    size_t live = 0;
+    for (size_t i = 0; i < live_capacity; i++) {
+        if (live_blocks[i].ptr && live_blocks[i].ptr != TOMBSTONE) live++;
+    }
+    size_t capacity = live_capacity ? live_capacity : 64;
+    while (live * 2 >= capacity) capacity *= 2;
+
+    LiveBlock* blocks = static_cast<LiveBlock*>(calloc(capacity, sizeof(LiveBlock)));
+    if (!blocks) return 0;
+    for (size_t i = 0; i < live_capacity; i++) {
+        LiveBlock* block = &live_blocks[i];
+        if (!block->ptr || block->ptr == TOMBSTONE) continue;
+        size_t slot = live_slot(block->ptr, capacity - 1);
+        while (blocks[slot].ptr) slot = (slot + 1) & (capacity - 1);
+        blocks[slot] = *block;
+    }
+    free(live_blocks);
+    live_blocks = blocks;
+    live_capacity = capacity;
+    live_used = live;
+    return 1;
+}
+
+static int live_insert(void* ptr, int site, double objects, double bytes) {
+    if ((live_used + 1) * 10 > live_capacity * 7 && !live_rehash()) return 0;
+    size_t mask = live_capacity - 1;
+    size_t slot = live_slot(ptr, mask);
+    while (live_blocks[slot].ptr && live_blocks[slot].ptr != TOMBSTONE) slot = (slot + 1) & mask;
+    if (!live_blocks[slot].ptr) live_used++;
+    live_blocks[slot].ptr = ptr;
+    live_blocks[slot].site = site;
+    live_blocks[slot].objects = objects;
+    live_blocks[slot].bytes = bytes;
+    return 1;
+}
+
+static LiveBlock* live_find(const void* ptr) {
+    if (!live_capacity) return nullptr;
+    size_t mask = live_capacity - 1;
+    for (size_t slot = live_slot(ptr, mask); live_blocks[slot].ptr; slot = (slot + 1) & mask) {
+        if (live_blocks[slot].ptr == ptr) return &live_blocks[slot];
+    }
+    return nullptr;
+}
+
+// ======================== RECORDING ========================
+
+static SiteStats* stats_for(int site) {
+    if (!site_stats) {
+        site_stats = static_cast<SiteStats*>(calloc(static_cast<size_t>(site_count) + 1, sizeof(SiteStats)));
+        if (!site_stats) return nullptr;
+    }
+    return &site_stats[(site >= 0 && site < site_count) ? site : site_count];
+}
+
+/**
+ * @brief Slow path of emlang_heapprof_malloc, taken when the countdown runs out
+ */
+static void record_sample(void* ptr, int size, int site) {
+    long long rate = current_rate();
+    if (!sampler.ready) {
+        init_sampler(&sampler);
+        sampler.remaining = next_interval(&sampler, rate) - size;
+        if (sampler.remaining > 0) return;
+    }
+    sampler.remaining = next_interval(&sampler, rate);
+    if (rate == 0) return;
+
+    // P(sampled) = 1 - exp(-size / rate); weighting by its inverse keeps estimates unbiased
+    double probability = -expm1(-static_cast<double>(size) / static_cast<double>(rate));
+    double objects = probability > 0.0 ? 1.0 / probability : 1.0;
+    double bytes = objects * size;
+
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    SiteStats* stats = stats_for(site);
+    if (!stats || !live_insert(ptr, site, objects, bytes)) return;
+    stats->alloc_objects += objects;
+    stats->alloc_bytes += bytes;
+    stats->inuse_objects += objects;
+    stats->inuse_bytes += bytes;
+    live_filter[filter_index(ptr)].fetch_add(1, std::memory_order_relaxed);
+}
+
+static void retire_sample(void* ptr) {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    LiveBlock* block = live_find(ptr);
+    if (!block) return;
+    SiteStats* stats = stats_for(block->site);
+    if (stats) {
+        stats->inuse_objects -= block->objects;
+        stats->inuse_bytes -= block->bytes;
+    }
+    block->ptr = TOMBSTONE;
+    live_filter[filter_index(ptr)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ======================== PPROF ENCODING ========================
+
+/**
+ * @brief Growable byte buffer for protobuf encoding
+ */
+typedef struct {
+    unsigned char* data;
+    size_t length;
+    size_t capacity;
+    int failed;
+} ProtoBuffer;
+
+static void proto_reserve(ProtoBuffer* buf, size_t extra) {
+    if (buf->failed || buf->length + extra <= buf->capacity) return;
+    size_t capacity = buf->capacity ? buf->capacity * 2 : 256;
+    while (capacity < buf->length + extra) capacity *= 2;
+    unsigned char* data = static_cast<unsigned char*>(realloc(buf->data, capacity));
+    if (!data) {
+        buf->failed = 1;
+        return;
+    }
+    buf->data = data;
+    buf->capacity = capacity;
+}
+
+static void proto_varint(ProtoBuffer* buf, uint64_t value) {
+    proto_reserve(buf, 10);
+    if (buf->failed) return;
+    while (value >= 0x80) {
+        buf->data[buf->length++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    buf->data[buf->length++] = static_cast<unsigned char>(value);
+}
+
+static void proto_uint(ProtoBuffer* buf, int field, uint64_t value) {
+    proto_varint(buf, static_cast<uint64_t>(field) << 3);
+    proto_varint(buf, value);
+}
+
+static void proto_bytes(ProtoBuffer* buf, int field, const void* data, size_t length) {
+    proto_varint(buf, (static_cast<uint64_t>(field) << 3) | 2);
+    proto_varint(buf, length);
+    proto_reserve(buf, length);
+    if (buf->failed) return;
+    memcpy(buf->data + buf->length, data, length);
+    buf->length += length;
+}
+
+/**
+ * @brief Append a finished submessage as a length-delimited field and reset it
+ */
+static void proto_message(ProtoBuffer* buf, int field, ProtoBuffer* message) {
+    if (message->failed) buf->failed = 1;
+    proto_bytes(buf, field, message->data, message->length);
+    message->length = 0;
+}
+
+static void proto_value_type(ProtoBuffer* buf, ProtoBuffer* scratch, int field, int type, int unit) {
+    proto_uint(scratch, 1, static_cast<uint64_t>(type));
+    proto_uint(scratch, 2, static_cast<uint64_t>(unit));
+    proto_message(buf, field, scratch);
+}
+
+static inline uint64_t rounded(double value) {
+    return value > 0.0 ? static_cast<uint64_t>(value + 0.5) : 0;
+}
+
+/**
+ * @brief Encode the current profile as a perftools.profiles.Profile message
+ */
+static void encode_profile(ProtoBuffer* out, long long rate) {
+    // Fixed strings first, then the file and one name per site
+    enum { STR_EMPTY, STR_ALLOC_OBJECTS, STR_COUNT, STR_ALLOC_SPACE, STR_BYTES,
+           STR_INUSE_OBJECTS, STR_INUSE_SPACE, STR_SPACE, STR_UNKNOWN, STR_FILE, STR_SITES };
+    static const char* const fixed[] = {
+        "", "alloc_objects", "count", "alloc_space", "bytes",
+        "inuse_objects", "inuse_space", "space", "<unknown>"
+    };
+
+    ProtoBuffer scratch = { nullptr, 0, 0, 0 };
+    ProtoBuffer inner = { nullptr, 0, 0, 0 };
+
+    // sample_type = 1
+    proto_value_type(out, &scratch, 1, STR_ALLOC_OBJECTS, STR_COUNT);
+    proto_value_type(out, &scratch, 1, STR_ALLOC_SPACE, STR_BYTES);
+    proto_value_type(out, &scratch, 1, STR_INUSE_OBJECTS, STR_COUNT);
+    proto_value_type(out, &scratch, 1, STR_INUSE_SPACE, STR_BYTES);
+
+    for (int site = 0; site <= site_count; site++) {
+        const SiteStats* stats = site_stats ? &site_stats[site] : nullptr;
+        uint64_t id = static_cast<uint64_t>(site) + 1;
+
+        // sample = 2 (location_id = 1, value = 2, both packed)
+        if (stats && stats->alloc_objects > 0.0) {
+            proto_varint(&inner, id);
+            proto_message(&scratch, 1, &inner);
+            proto_varint(&inner, rounded(stats->alloc_objects));
+            proto_varint(&inner, rounded(stats->alloc_bytes));
+            proto_varint(&inner, rounded(stats->inuse_objects));
+            proto_varint(&inner, rounded(stats->inuse_bytes));
+            proto_message(&scratch, 2, &inner);
+            proto_message(out, 2, &scratch);
+        }
+
+        // location = 4 (id = 1, line = 4 { function_id = 1, line = 2 })
+        proto_uint(&scratch, 1, id);
+        proto_uint(&inner, 1, id);
+        if (site < site_count && site_lines) proto_uint(&inner, 2, static_cast<uint64_t>(site_lines[site]));
+        proto_message(&scratch, 4, &inner);
+        proto_message(out, 4, &scratch);
+
+        // function = 5 (id = 1, name = 2, system_name = 3, filename = 4)
+        uint64_t name = site < site_count ? static_cast<uint64_t>(STR_SITES + site) : static_cast<uint64_t>(STR_UNKNOWN);
+        proto_uint(&scratch, 1, id);
+        proto_uint(&scratch, 2, name);
+        proto_uint(&scratch, 3, name);
+        proto_uint(&scratch, 4, STR_FILE);
+        proto_message(out, 5, &scratch);
+    }
+
+    // string_table = 6
+    for (size_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++) {
+        proto_bytes(out, 6, fixed[i], strlen(fixed[i]));
+    }
+    proto_bytes(out, 6, site_file, strlen(site_file));
+    for (int site = 0; site < site_count; site++) {
+        const char* function = site_functions[site] ? site_functions[site] : "";
+        proto_bytes(out, 6, function, strlen(function));
+    }
+
+    // time_nanos = 9, period_type = 11, period = 12, default_sample_type = 14
+    proto_uint(out, 9, static_cast<uint64_t>(time(nullptr)) * 1000000000ULL);
+    proto_value_type(out, &scratch, 11, STR_SPACE, STR_BYTES);
+    proto_uint(out, 12, static_cast<uint64_t>(rate));
+    proto_uint(out, 14, STR_INUSE_SPACE);
+
+    if (scratch.failed || inner.failed) out->failed = 1;
+    free(scratch.data);
+    free(inner.data);
+}
+
+// ======================== EXIT AND SIGNAL ========================
+
+static void dump_at_exit(void) {
+    emlang_heapprof_dump(nullptr);
+}
+
+#ifdef SIGUSR2
+static void request_dump(int) {
+    dump_requested.store(1, std::memory_order_relaxed);
+}
+#endif
+
+extern "C" {
+
+// ======================== PROFILED ALLOCATION ========================
+
+void* emlang_heapprof_malloc(int size, int site) {
+    if (size <= 0) return nullptr;
+    void* ptr = malloc(static_cast<size_t>(size));
+    if (!ptr) return nullptr;
+
+    sampler.remaining -= size;
+    if (sampler.remaining > 0) return ptr;
+
+    record_sample(ptr, size, site);
+    if (dump_requested.exchange(0, std::memory_order_relaxed)) {
+        emlang_heapprof_dump(nullptr);
+    }
+    return ptr;
+}
+
+void emlang_heapprof_free(void* ptr) {
+    if (!ptr) return;
+    // Unsampled blocks almost always land on a zero counter and skip the lock
+    if (live_filter[filter_index(ptr)].load(std::memory_order_relaxed) != 0) {
+        retire_sample(ptr);
+    }
+    free(ptr);
+}
+
+// ======================== SITES ========================
+
+void emlang_heapprof_register(const char* const* functions, const int* lines, int count, const char* file) {
+    static int hooks_installed = 0;
+    {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        free(site_stats);
+        site_stats = nullptr;
+        site_functions = functions;
+        site_lines = lines;
+        site_count = count > 0 ? count : 0;
+        site_file = file ? file : "";
+        if (hooks_installed) return;
+        hooks_installed = 1;
+    }
+    atexit(dump_at_exit);
+#ifdef SIGUSR2
+    signal(SIGUSR2, request_dump);
+#endif
+}
+
+// ======================== PROFILE ========================
+
+int emlang_heapprof_dump(const char* path) {
+    if (!path) {
+        path = getenv("EMLANG_HEAPPROF_FILE");
+        if (!path || !*path) path = HEAPPROF_DEFAULT_FILE;
+    }
+
+    ProtoBuffer profile = { nullptr, 0, 0, 0 };
+    long long rate = current_rate();
+    {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        encode_profile(&profile, rate);
+    }
+    if (profile.failed) {
+        free(profile.data);
+        return 0;
+    }
+
+    FILE* file = fopen(path, "wb");
+    int ok = file != nullptr;
+    if (file) {
+        ok = fwrite(profile.data, 1, profile.length, file) == profile.length;
+        ok = (fclose(file) == 0) && ok;
+    }
+    free(profile.data);
+    return ok;
+}
+
+void emlang_heapprof_set_rate(long long rate) {
+    sample_rate.store(rate < 0 ? 0 : rate, std::memory_order_relaxed);
+    // Let the calling thread pick up the new interval immediately
+    sampler.remaining = 0;
+}
+
+} // extern "C"
@@ -1,4 +1,5 @@
 #include "emlang_math.h"
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -144,4 +145,12 @@ int emlang_mod(int a, int b) {
     return result;
 }
 
+double emlang_sin(double x) {
+    return sin(x);
+}
+
+double emlang_cos(double x) {
+    return cos(x);
+}
+
 } // extern "C"
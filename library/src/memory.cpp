@@ -1,6 +1,7 @@
 #include "emlang_memory.h"
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
 
 #ifdef _WIN32
 #include <malloc.h>
@@ -108,35 +109,41 @@ void* emlang_memmove(void* dest, const void* src, int size) {
     return dest;
 }
 
-// Simple memory tracking variables
-static long total_allocated = 0;
-static long allocation_count = 0;
+// Memory tracking counters, updated from any thread
+static std::atomic<long> total_allocated(0);
+static std::atomic<long> allocation_count(0);
+
+// Tracked blocks carry their size in a header sized to keep malloc's alignment
+static const size_t TRACKED_HEADER = 16;
 
 long emlang_memory_usage(void) {
-    return total_allocated;
+    return total_allocated.load(std::memory_order_relaxed);
 }
 
 void emlang_memory_stats(long* total_bytes, long* allocation_count_out) {
-    if (total_bytes) *total_bytes = total_allocated;
-    if (allocation_count_out) *allocation_count_out = allocation_count;
+    if (total_bytes) *total_bytes = total_allocated.load(std::memory_order_relaxed);
+    if (allocation_count_out) *allocation_count_out = allocation_count.load(std::memory_order_relaxed);
 }
 
-// Override malloc/free to track memory usage
 void* emlang_tracked_malloc(int size) {
-    void* ptr = emlang_malloc(size);
-    if (ptr) {
-        total_allocated += size;
-        allocation_count++;
-    }
-    return ptr;
+    if (size <= 0) return nullptr;
+    unsigned char* block = static_cast<unsigned char*>(malloc(TRACKED_HEADER + static_cast<size_t>(size)));
+    if (!block) return nullptr;
+    
+    memcpy(block, &size, sizeof(size));
+    total_allocated.fetch_add(size, std::memory_order_relaxed);
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return block + TRACKED_HEADER;
 }
 
 void emlang_tracked_free(void* ptr) {
     if (ptr) {
-        // In a real implementation, we'd need to track allocation sizes
-        // For simplicity, we'll just decrement the count
-        allocation_count--;
-        emlang_free(ptr);
+        unsigned char* block = static_cast<unsigned char*>(ptr) - TRACKED_HEADER;
+        int size;
+        memcpy(&size, block, sizeof(size));
+        total_allocated.fetch_sub(size, std::memory_order_relaxed);
+        allocation_count.fetch_sub(1, std::memory_order_relaxed);
+        free(block);
     }
 }
 
@@ -0,0 +1,878 @@
+#include "emlang_number.h"
+#include "number_tables.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// SWAR digit parsing reads eight ASCII digits as one little-endian word
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define EMLANG_NUMBER_SWAR 0
+#else
+#define EMLANG_NUMBER_SWAR 1
+#endif
+
+static const int DOUBLE_MANTISSA_BITS = 52;
+static const int DOUBLE_EXPONENT_BITS = 11;
+static const int DOUBLE_BIAS = 1023;
+
+// ======================== 128-BIT HELPERS ========================
+
+struct U128 {
+    uint64_t high;
+    uint64_t low;
+};
+
+static inline U128 full_multiplication(uint64_t a, uint64_t b) {
+    U128 result;
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    result.high = static_cast<uint64_t>(product >> 64);
+    result.low = static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    result.low = _umul128(a, b, &result.high);
+#else
+    uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+    uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+    uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    result.low = (mid << 32) | (ll & 0xFFFFFFFFu);
+    result.high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    return result;
+}
+
+static inline int leading_zeroes(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    for (uint64_t bit = 1ULL << 63; bit && !(value & bit); bit >>= 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline double bits_to_double(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline uint64_t double_to_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// ======================== DIGIT SCANNING ========================
+
+static inline bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline uint64_t read_eight(const char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline bool is_eight_digits(uint64_t value) {
+    return !(((value + 0x4646464646464646ULL) | (value - 0x3030303030303030ULL)) & 0x8080808080808080ULL);
+}
+
+/**
+ * @brief Value of eight ASCII digits read as a little-endian word
+ */
+static inline uint32_t parse_eight_digits(uint64_t value) {
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+    value -= 0x3030303030303030ULL;
+    value = (value * 10) + (value >> 8);
+    value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(value);
+}
+
+/**
+ * @brief Accumulate a run of digits into value, eight at a time where possible
+ * @return End of the digit run
+ */
+static inline const char* scan_digits(const char* p, const char* end, uint64_t* value) {
+    uint64_t v = *value;
+#if EMLANG_NUMBER_SWAR
+    while (end - p >= 8) {
+        uint64_t word = read_eight(p);
+        if (!is_eight_digits(word)) break;
+        v = v * 100000000 + parse_eight_digits(word);
+        p += 8;
+    }
+#endif
+    while (p < end && is_digit(*p)) {
+        v = v * 10 + static_cast<uint64_t>(*p - '0');
+        p++;
+    }
+    *value = v;
+    return p;
+}
+
+// ======================== INTEGER PARSING ========================
+
+static long long parse_int64(const char* str, const char* end, long long* out) {
+    const char* p = str;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    const char* digits = p;
+    while (p < end && *p == '0') p++;
+    const char* significant = p;
+
+    uint64_t value = 0;
+    p = scan_digits(p, end, &value);
+    if (p == digits) return 0;
+
+    // 19 digits always fit in uint64; 20 may have wrapped, so check against the limit
+    ptrdiff_t count = p - significant;
+    if (count > 19) return 0;
+    uint64_t limit = negative ? 9223372036854775808ULL : 9223372036854775807ULL;
+    if (value > limit) return 0;
+
+    if (out) {
+        *out = negative ? static_cast<long long>(0 - value) : static_cast<long long>(value);
+    }
+    return p - str;
+}
+
+// ======================== DOUBLE PARSING ========================
+
+/**
+ * @brief Decimal significand and exponent of a literal (value = mantissa * 10^exponent)
+ */
+struct DecimalNumber {
+    uint64_t mantissa;
+    int64_t exponent;
+    bool negative;
+    bool tooManyDigits;
+};
+
+static const char* parse_decimal(const char* str, const char* end, DecimalNumber* number) {
+    const char* p = str;
+    number->negative = false;
+    number->tooManyDigits = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        number->negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    const char* integerStart = p;
+    p = scan_digits(p, end, &mantissa);
+    const char* integerEnd = p;
+    int64_t digitCount = integerEnd - integerStart;
+
+    int64_t exponent = 0;
+    const char* fractionStart = p;
+    const char* fractionEnd = p;
+    if (p < end && *p == '.') {
+        p++;
+        fractionStart = p;
+        p = scan_digits(p, end, &mantissa);
+        fractionEnd = p;
+        exponent = fractionStart - fractionEnd;
+        digitCount -= exponent;
+    }
+    if (digitCount == 0) return str;
+
+    int64_t explicitExponent = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* exponentStart = p;
+        p++;
+        bool exponentNegative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exponentNegative = *p == '-';
+            p++;
+        }
+        if (p < end && is_digit(*p)) {
+            while (p < end && is_digit(*p)) {
+                if (explicitExponent < 0x10000000) {
+                    explicitExponent = explicitExponent * 10 + (*p - '0');
+                }
+                p++;
+            }
+            if (exponentNegative) explicitExponent = -explicitExponent;
+        } else {
+            // "1e" or "1e+" is the number 1 followed by other text
+            p = exponentStart;
+        }
+    }
+    exponent += explicitExponent;
+
+    // More than 19 significant digits: keep the first 19 and remember the truncation
+    if (digitCount > 19) {
+        const char* s = integerStart;
+        while (s < end && (*s == '0' || *s == '.')) {
+            if (*s == '0') digitCount--;
+            s++;
+        }
+        if (digitCount > 19) {
+            number->tooManyDigits = true;
+            const uint64_t minNineteenDigits = 1000000000000000000ULL;
+            mantissa = 0;
+            const char* q = integerStart;
+            while (mantissa < minNineteenDigits && q != integerEnd) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*q - '0');
+                q++;
+            }
+            if (mantissa >= minNineteenDigits) {
+                exponent = (integerEnd - q) + explicitExponent;
+            } else {
+                q = fractionStart;
+                while (mantissa < minNineteenDigits && q != fractionEnd) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*q - '0');
+                    q++;
+                }
+                exponent = (fractionStart - q) + explicitExponent;
+            }
+        }
+    }
+
+    number->mantissa = mantissa;
+    number->exponent = exponent;
+    return p;
+}
+
+/**
+ * @brief Binary significand and biased exponent produced by Eisel-Lemire
+ */
+struct AdjustedMantissa {
+    uint64_t mantissa;
+    int32_t power2;
+};
+
+static inline int32_t binary_power(int32_t q) {
+    return (((152170 + 65536) * q) >> 16) + 63;
+}
+
+/**
+ * @brief Eisel-Lemire: w * 10^q rounded to nearest-even binary64
+ *
+ * Multiplies the normalized significand by a 128-bit approximation of 5^q;
+ * the product is always precise enough to decide rounding when w is exact.
+ */
+static AdjustedMantissa compute_float(int64_t q, uint64_t w) {
+    const int infinitePower = (1 << DOUBLE_EXPONENT_BITS) - 1;
+    AdjustedMantissa answer;
+    if (w == 0 || q < POW5_128_MIN_EXPONENT) {
+        answer.mantissa = 0;
+        answer.power2 = 0;
+        return answer;
+    }
+    if (q > POW5_128_MAX_EXPONENT) {
+        answer.mantissa = 0;
+        answer.power2 = infinitePower;
+        return answer;
+    }
+
+    int lz = leading_zeroes(w);
+    w <<= lz;
+
+    // Only look at the second half of 5^q when the first product leaves the low bits ambiguous
+    const int index = static_cast<int>(q - POW5_128_MIN_EXPONENT);
+    const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFULL >> (DOUBLE_MANTISSA_BITS + 3);
+    U128 product = full_multiplication(w, POW5_128[index][0]);
+    if ((product.high & precisionMask) == precisionMask) {
+        U128 second = full_multiplication(w, POW5_128[index][1]);
+        product.low += second.high;
+        if (second.high > product.low) product.high++;
+    }
+
+    int upperBit = static_cast<int>(product.high >> 63);
+    int shift = upperBit + 64 - DOUBLE_MANTISSA_BITS - 3;
+    answer.mantissa = product.high >> shift;
+    answer.power2 = binary_power(static_cast<int32_t>(q)) + upperBit - lz + DOUBLE_BIAS;
+
+    if (answer.power2 <= 0) {
+        // Subnormal
+        if (-answer.power2 + 1 >= 64) {
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += (answer.mantissa & 1);
+        answer.mantissa >>= 1;
+        answer.power2 = (answer.mantissa < (1ULL << DOUBLE_MANTISSA_BITS)) ? 0 : 1;
+        return answer;
+    }
+
+    // Exactly halfway between two doubles: round to even instead of up
+    if (product.low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1) {
+        if ((answer.mantissa << shift) == product.high) {
+            answer.mantissa &= ~1ULL;
+        }
+    }
+
+    answer.mantissa += (answer.mantissa & 1);
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (2ULL << DOUBLE_MANTISSA_BITS)) {
+        answer.mantissa = 1ULL << DOUBLE_MANTISSA_BITS;
+        answer.power2++;
+    }
+    answer.mantissa &= ~(1ULL << DOUBLE_MANTISSA_BITS);
+    if (answer.power2 >= infinitePower) {
+        answer.mantissa = 0;
+        answer.power2 = infinitePower;
+    }
+    return answer;
+}
+
+static bool match_word(const char* p, const char* end, const char* word) {
+    for (; *word; word++, p++) {
+        if (p >= end || (*p | 0x20) != *word) return false;
+    }
+    return true;
+}
+
+static long long parse_special(const char* str, const char* end, double* out) {
+    const char* p = str;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    const uint64_t sign = negative ? (1ULL << 63) : 0;
+    if (match_word(p, end, "nan")) {
+        *out = bits_to_double(sign | 0x7FF8000000000000ULL);
+        return (p + 3) - str;
+    }
+    if (match_word(p, end, "infinity")) {
+        *out = bits_to_double(sign | 0x7FF0000000000000ULL);
+        return (p + 8) - str;
+    }
+    if (match_word(p, end, "inf")) {
+        *out = bits_to_double(sign | 0x7FF0000000000000ULL);
+        return (p + 3) - str;
+    }
+    return 0;
+}
+
+static long long parse_double(const char* str, const char* end, double* out) {
+    DecimalNumber number;
+    const char* p = parse_decimal(str, end, &number);
+    if (p == str) {
+        double special;
+        long long consumed = parse_special(str, end, &special);
+        if (consumed && out) *out = special;
+        return consumed;
+    }
+
+    static const double exactPowers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    double value;
+    if (!number.tooManyDigits && number.exponent >= -22 && number.exponent <= 22 &&
+        number.mantissa <= (1ULL << 53)) {
+        // Clinger's fast path: both operands are exact, so one rounding is correct
+        value = static_cast<double>(number.mantissa);
+        value = number.exponent < 0 ? value / exactPowers[-number.exponent] : value * exactPowers[number.exponent];
+        if (number.negative) value = -value;
+    } else {
+        AdjustedMantissa am = compute_float(number.exponent, number.mantissa);
+        bool exact = true;
+        if (number.tooManyDigits) {
+            // Truncated digits matter only if w and w+1 round differently
+            AdjustedMantissa upper = compute_float(number.exponent, number.mantissa + 1);
+            exact = am.mantissa == upper.mantissa && am.power2 == upper.power2;
+        }
+        if (exact) {
+            uint64_t bits = am.mantissa | (static_cast<uint64_t>(am.power2) << DOUBLE_MANTISSA_BITS);
+            if (number.negative) bits |= 1ULL << 63;
+            value = bits_to_double(bits);
+        } else {
+            char stackBuffer[128];
+            size_t length = static_cast<size_t>(p - str);
+            char* copy = length < sizeof(stackBuffer) ? stackBuffer : static_cast<char*>(malloc(length + 1));
+            if (!copy) return 0;
+            memcpy(copy, str, length);
+            copy[length] = '\0';
+            value = strtod(copy, nullptr);
+            if (copy != stackBuffer) free(copy);
+        }
+    }
+
+    if (out) *out = value;
+    return p - str;
+}
+
+// ======================== INTEGER FORMATTING ========================
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Write the decimal digits of value ending at end, returns the first digit
+ */
+static inline char* write_digits_backward(uint64_t value, char* end) {
+    char* p = end;
+    while (value >= 100) {
+        unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+        value /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+        unsigned int pair = static_cast<unsigned int>(value) * 2;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+    return p;
+}
+
+static int format_int64(long long value, char* out) {
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    char* p = write_digits_backward(magnitude, end);
+    if (value < 0) *--p = '-';
+    int length = static_cast<int>(end - p);
+    memcpy(out, p, static_cast<size_t>(length));
+    return length;
+}
+
+// ======================== DOUBLE FORMATTING (RYU) ========================
+
+static inline uint32_t pow5_bits(int32_t e) {
+    return static_cast<uint32_t>(((e * 1217359) >> 19) + 1);
+}
+
+static inline uint32_t log10_pow2(int32_t e) {
+    return static_cast<uint32_t>((e * 78913) >> 18);
+}
+
+static inline uint32_t log10_pow5(int32_t e) {
+    return static_cast<uint32_t>((e * 732923) >> 20);
+}
+
+static inline uint32_t pow5_factor(uint64_t value) {
+    uint32_t count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count;
+}
+
+static inline bool multiple_of_pow5(uint64_t value, uint32_t p) {
+    return pow5_factor(value) >= p;
+}
+
+static inline bool multiple_of_pow2(uint64_t value, uint32_t p) {
+    return (value & ((1ULL << p) - 1)) == 0;
+}
+
+/**
+ * @brief (m * mul) >> j for a 128-bit multiplier given as {low, high}, j >= 64
+ */
+static inline uint64_t mul_shift64(uint64_t m, const uint64_t* mul, int32_t j) {
+    U128 b0 = full_multiplication(m, mul[0]);
+    U128 b2 = full_multiplication(m, mul[1]);
+    // (b0 >> 64) + b2 as a 128-bit sum, then shift by j - 64
+    uint64_t low = b2.low + b0.high;
+    uint64_t high = b2.high + (low < b2.low);
+    int32_t shift = j - 64;
+    if (shift >= 64) return high >> (shift - 64);
+    if (shift == 0) return low;
+    return (high << (64 - shift)) | (low >> shift);
+}
+
+/**
+ * @brief Shortest decimal digits and exponent of a finite positive double
+ *
+ * Computes the decimal interval of values that round to the input and
+ * removes digits until the interval no longer contains a shorter number.
+ */
+static void ryu_shortest(uint64_t ieeeMantissa, uint32_t ieeeExponent, uint64_t* digits, int32_t* exponent) {
+    int32_t e2;
+    uint64_t m2;
+    if (ieeeExponent == 0) {
+        e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieeeMantissa;
+    } else {
+        e2 = static_cast<int32_t>(ieeeExponent) - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1ULL << DOUBLE_MANTISSA_BITS) | ieeeMantissa;
+    }
+    const bool acceptBounds = (m2 & 1) == 0;
+
+    const uint64_t mv = 4 * m2;
+    const uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    if (e2 >= 0) {
+        const uint32_t q = log10_pow2(e2) - (e2 > 3);
+        e10 = static_cast<int32_t>(q);
+        const int32_t k = DOUBLE_POW5_INV_BITCOUNT + static_cast<int32_t>(pow5_bits(static_cast<int32_t>(q))) - 1;
+        const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+        vr = mul_shift64(4 * m2, DOUBLE_POW5_INV_SPLIT[q], i);
+        vp = mul_shift64(4 * m2 + 2, DOUBLE_POW5_INV_SPLIT[q], i);
+        vm = mul_shift64(4 * m2 - 1 - mmShift, DOUBLE_POW5_INV_SPLIT[q], i);
+        if (q <= 21) {
+            if (mv % 5 == 0) {
+                vrIsTrailingZeros = multiple_of_pow5(mv, q);
+            } else if (acceptBounds) {
+                vmIsTrailingZeros = multiple_of_pow5(mv - 1 - mmShift, q);
+            } else {
+                vp -= multiple_of_pow5(mv + 2, q);
+            }
+        }
+    } else {
+        const uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+        e10 = static_cast<int32_t>(q) + e2;
+        const int32_t i = -e2 - static_cast<int32_t>(q);
+        const int32_t k = static_cast<int32_t>(pow5_bits(i)) - DOUBLE_POW5_BITCOUNT;
+        const int32_t j = static_cast<int32_t>(q) - k;
+        vr = mul_shift64(4 * m2, DOUBLE_POW5_SPLIT[i], j);
+        vp = mul_shift64(4 * m2 + 2, DOUBLE_POW5_SPLIT[i], j);
+        vm = mul_shift64(4 * m2 - 1 - mmShift, DOUBLE_POW5_SPLIT[i], j);
+        if (q <= 1) {
+            vrIsTrailingZeros = true;
+            if (acceptBounds) {
+                vmIsTrailingZeros = mmShift == 1;
+            } else {
+                --vp;
+            }
+        } else if (q < 63) {
+            vrIsTrailingZeros = multiple_of_pow2(mv, q);
+        }
+    }
+
+    int32_t removed = 0;
+    uint8_t lastRemovedDigit = 0;
+    uint64_t output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        // Rare path: exact bounds need the removed digits tracked
+        for (;;) {
+            const uint64_t vpDiv10 = vp / 10;
+            const uint64_t vmDiv10 = vm / 10;
+            if (vpDiv10 <= vmDiv10) break;
+            const uint32_t vmMod10 = static_cast<uint32_t>(vm - 10 * vmDiv10);
+            const uint64_t vrDiv10 = vr / 10;
+            const uint32_t vrMod10 = static_cast<uint32_t>(vr - 10 * vrDiv10);
+            vmIsTrailingZeros &= vmMod10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = static_cast<uint8_t>(vrMod10);
+            vr = vrDiv10;
+            vp = vpDiv10;
+            vm = vmDiv10;
+            ++removed;
+        }
+        if (vmIsTrailingZeros) {
+            for (;;) {
+                const uint64_t vmDiv10 = vm / 10;
+                const uint32_t vmMod10 = static_cast<uint32_t>(vm - 10 * vmDiv10);
+                if (vmMod10 != 0) break;
+                const uint64_t vpDiv10 = vp / 10;
+                const uint64_t vrDiv10 = vr / 10;
+                const uint32_t vrMod10 = static_cast<uint32_t>(vr - 10 * vrDiv10);
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = static_cast<uint8_t>(vrMod10);
+                vr = vrDiv10;
+                vp = vpDiv10;
+                vm = vmDiv10;
+                ++removed;
+            }
+        }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            lastRemovedDigit = 4; // Round half to even
+        }
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    } else {
+        // Common path
+        bool roundUp = false;
+        const uint64_t vpDiv100 = vp / 100;
+        const uint64_t vmDiv100 = vm / 100;
+        if (vpDiv100 > vmDiv100) {
+            const uint64_t vrDiv100 = vr / 100;
+            const uint32_t vrMod100 = static_cast<uint32_t>(vr - 100 * vrDiv100);
+            roundUp = vrMod100 >= 50;
+            vr = vrDiv100;
+            vp = vpDiv100;
+            vm = vmDiv100;
+            removed += 2;
+        }
+        for (;;) {
+            const uint64_t vpDiv10 = vp / 10;
+            const uint64_t vmDiv10 = vm / 10;
+            if (vpDiv10 <= vmDiv10) break;
+            const uint64_t vrDiv10 = vr / 10;
+            const uint32_t vrMod10 = static_cast<uint32_t>(vr - 10 * vrDiv10);
+            roundUp = vrMod10 >= 5;
+            vr = vrDiv10;
+            vp = vpDiv10;
+            vm = vmDiv10;
+            ++removed;
+        }
+        output = vr + (vr == vm || roundUp);
+    }
+
+    *digits = output;
+    *exponent = e10 + removed;
+}
+
+/**
+ * @brief Format a double, returns bytes written (out holds EMLANG_NUMBER_BUFFER_SIZE)
+ *
+ * Fixed notation for decimal exponents in [-6, 21), scientific otherwise,
+ * matching the ranges JavaScript uses for Number#toString.
+ */
+static int format_double(double value, char* out) {
+    const uint64_t bits = double_to_bits(value);
+    const bool negative = (bits >> 63) != 0;
+    const uint64_t ieeeMantissa = bits & ((1ULL << DOUBLE_MANTISSA_BITS) - 1);
+    const uint32_t ieeeExponent = static_cast<uint32_t>((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+
+    char* p = out;
+    if (ieeeExponent == (1u << DOUBLE_EXPONENT_BITS) - 1) {
+        if (ieeeMantissa) {
+            memcpy(p, "nan", 3);
+            return 3;
+        }
+        if (negative) *p++ = '-';
+        memcpy(p, "inf", 3);
+        return static_cast<int>(p - out) + 3;
+    }
+    if (negative) *p++ = '-';
+    if (ieeeExponent == 0 && ieeeMantissa == 0) {
+        *p++ = '0';
+        return static_cast<int>(p - out);
+    }
+
+    uint64_t digits;
+    int32_t exponent;
+    ryu_shortest(ieeeMantissa, ieeeExponent, &digits, &exponent);
+
+    char digitBuffer[24];
+    char* digitEnd = digitBuffer + sizeof(digitBuffer);
+    char* digitStart = write_digits_backward(digits, digitEnd);
+    const int32_t length = static_cast<int32_t>(digitEnd - digitStart);
+    // Position of the decimal point relative to the first digit
+    const int32_t point = length + exponent;
+
+    if (point > 0 && point <= 21) {
+        if (exponent >= 0) {
+            memcpy(p, digitStart, static_cast<size_t>(length));
+            p += length;
+            memset(p, '0', static_cast<size_t>(exponent));
+            p += exponent;
+        } else {
+            memcpy(p, digitStart, static_cast<size_t>(point));
+            p += point;
+            *p++ = '.';
+            memcpy(p, digitStart + point, static_cast<size_t>(length - point));
+            p += length - point;
+        }
+    } else if (point <= 0 && point > -6) {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', static_cast<size_t>(-point));
+        p += -point;
+        memcpy(p, digitStart, static_cast<size_t>(length));
+        p += length;
+    } else {
+        *p++ = digitStart[0];
+        if (length > 1) {
+            *p++ = '.';
+            memcpy(p, digitStart + 1, static_cast<size_t>(length - 1));
+            p += length - 1;
+        }
+        int32_t scientific = point - 1;
+        *p++ = 'e';
+        *p++ = scientific < 0 ? '-' : '+';
+        if (scientific < 0) scientific = -scientific;
+        char exponentBuffer[8];
+        char* exponentEnd = exponentBuffer + sizeof(exponentBuffer);
+        char* exponentStart = write_digits_backward(static_cast<uint64_t>(scientific), exponentEnd);
+        memcpy(p, exponentStart, static_cast<size_t>(exponentEnd - exponentStart));
+        p += exponentEnd - exponentStart;
+    }
+    return static_cast<int>(p - out);
+}
+
+// ======================== LIST HELPERS ========================
+
+static inline const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+/**
+ * @brief Step over the separator after a field
+ * @return Start of the next field, or nullptr if the field is followed by junk
+ */
+static inline const char* next_field(const char* p, const char* end, char delimiter) {
+    p = skip_blanks(p, end);
+    if (p == end) return p;
+    if (*p == delimiter || *p == '\n') return p + 1;
+    return nullptr;
+}
+
+extern "C" {
+
+// ======================== PARSING ========================
+
+long long emlang_parse_int64(const char* str, long long len, long long* out) {
+    if (!str || len <= 0) return 0;
+    return parse_int64(str, str + len, out);
+}
+
+long long emlang_parse_double(const char* str, long long len, double* out) {
+    if (!str || len <= 0) return 0;
+    return parse_double(str, str + len, out);
+}
+
+// ======================== FORMATTING ========================
+
+int emlang_format_int64(long long value, char* buf, int size) {
+    char scratch[EMLANG_NUMBER_BUFFER_SIZE];
+    int length = format_int64(value, scratch);
+    if (!buf || size < length) return 0;
+    memcpy(buf, scratch, static_cast<size_t>(length));
+    return length;
+}
+
+int emlang_format_double(double value, char* buf, int size) {
+    char scratch[EMLANG_NUMBER_BUFFER_SIZE];
+    int length = format_double(value, scratch);
+    if (!buf || size < length) return 0;
+    memcpy(buf, scratch, static_cast<size_t>(length));
+    return length;
+}
+
+// ======================== BATCH ========================
+
+long long emlang_parse_int64_list(const char* str, long long len, char delimiter,
+                                  long long* out, long long capacity, long long* consumed) {
+    long long count = 0;
+    const char* p = str;
+    const char* end = str ? str + (len > 0 ? len : 0) : str;
+    while (p && p < end && count < capacity) {
+        const char* field = skip_blanks(p, end);
+        if (field == end) {
+            p = end;
+            break;
+        }
+        long long used = parse_int64(field, end, out ? &out[count] : nullptr);
+        if (used == 0) break;
+        const char* next = next_field(field + used, end, delimiter);
+        if (!next) break;
+        count++;
+        p = next;
+    }
+    if (consumed) *consumed = str ? p - str : 0;
+    return count;
+}
+
+long long emlang_parse_double_list(const char* str, long long len, char delimiter,
+                                   double* out, long long capacity, long long* consumed) {
+    long long count = 0;
+    const char* p = str;
+    const char* end = str ? str + (len > 0 ? len : 0) : str;
+    while (p && p < end && count < capacity) {
+        const char* field = skip_blanks(p, end);
+        if (field == end) {
+            p = end;
+            break;
+        }
+        long long used = parse_double(field, end, out ? &out[count] : nullptr);
+        if (used == 0) break;
+        const char* next = next_field(field + used, end, delimiter);
+        if (!next) break;
+        count++;
+        p = next;
+    }
+    if (consumed) *consumed = str ? p - str : 0;
+    return count;
+}
+
+long long emlang_format_int64_list(const long long* values, long long count, char delimiter,
+                                   char* buf, long long size) {
+    if (!buf || (count > 0 && !values)) return -1;
+
+    long long written = 0;
+    for (long long i = 0; i < count; i++) {
+        // Format straight into the output while a whole number plus delimiter fits
+        char scratch[EMLANG_NUMBER_BUFFER_SIZE];
+        char* target = size - written >= EMLANG_NUMBER_BUFFER_SIZE + 1 ? buf + written + (i > 0) : scratch;
+        int length = format_int64(values[i], target);
+        if (written + (i > 0) + length > size) return -1;
+        if (i > 0) buf[written++] = delimiter;
+        if (target == scratch) memcpy(buf + written, scratch, static_cast<size_t>(length));
+        written += length;
+    }
+    return written;
+}
+
+long long emlang_format_double_list(const double* values, long long count, char delimiter,
+                                    char* buf, long long size) {
+    if (!buf || (count > 0 && !values)) return -1;
+
+    long long written = 0;
+    for (long long i = 0; i < count; i++) {
+        char scratch[EMLANG_NUMBER_BUFFER_SIZE];
+        char* target = size - written >= EMLANG_NUMBER_BUFFER_SIZE + 1 ? buf + written + (i > 0) : scratch;
+        int length = format_double(values[i], target);
+        if (written + (i > 0) + length > size) return -1;
+        if (i > 0) buf[written++] = delimiter;
+        if (target == scratch) memcpy(buf + written, scratch, static_cast<size_t>(length));
+        written += length;
+    }
+    return written;
+}
+
+// ======================== STRING CONVENIENCE ========================
+
+long long emlang_str_to_int64(const char* str) {
+    if (!str) return 0;
+    long long len = static_cast<long long>(strlen(str));
+    long long value = 0;
+    return emlang_parse_int64(str, len, &value) == len ? value : 0;
+}
+
+double emlang_str_to_double(const char* str) {
+    if (!str) return 0.0;
+    long long len = static_cast<long long>(strlen(str));
+    double value = 0.0;
+    return emlang_parse_double(str, len, &value) == len ? value : 0.0;
+}
+
+char* emlang_int64_to_str(long long value) {
+    char* result = static_cast<char*>(malloc(EMLANG_NUMBER_BUFFER_SIZE));
+    if (!result) return nullptr;
+    result[format_int64(value, result)] = '\0';
+    return result;
+}
+
+char* emlang_double_to_str(double value) {
+    char* result = static_cast<char*>(malloc(EMLANG_NUMBER_BUFFER_SIZE));
+    if (!result) return nullptr;
+    result[format_double(value, result)] = '\0';
+    return result;
+}
+
+} // extern "C"
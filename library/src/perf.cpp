@@ -0,0 +1,369 @@
+#include "emlang_perf.h"
+#include "emlang_utility.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PERF_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define PERF_TLS_MODEL
+#endif
+
+enum PerfEvent {
+    EV_CYCLES,
+    EV_INSTRUCTIONS,
+    EV_CACHE_REFERENCES,
+    EV_CACHE_MISSES,
+    EV_BRANCHES,
+    EV_BRANCH_MISSES,
+    EV_TASK_CLOCK,
+    EV_PAGE_FAULTS,
+    EV_CONTEXT_SWITCHES,
+    EV_CPU_MIGRATIONS,
+    EV_COUNT
+};
+
+static const int HARDWARE_FIRST = EV_CYCLES;
+static const int HARDWARE_LAST = EV_BRANCH_MISSES;
+static const int SOFTWARE_FIRST = EV_TASK_CLOCK;
+static const int SOFTWARE_LAST = EV_CPU_MIGRATIONS;
+
+static const char* const EVENT_NAMES[EV_COUNT] = {
+    "cycles", "instructions", "cache_references", "cache_misses", "branches", "branch_misses",
+    "task_clock_ns", "page_faults", "context_switches", "cpu_migrations"
+};
+
+/**
+ * @brief Counter values at one region boundary
+ */
+struct Snapshot {
+    std::string region;
+    long long wall_ns;
+    double values[EV_COUNT];
+};
+
+/**
+ * @brief Per-thread counter group and open regions
+ */
+struct ThreadCounters {
+    int leader;                         // Group leader fd, -1 if no group could be opened
+    int fds[EV_COUNT];
+    int slot_event[EV_COUNT];           // Event at each position of a group read
+    int slots;
+    bool hardware;
+    std::vector<Snapshot> open;
+};
+
+/**
+ * @brief Closes the thread's counter group when the thread exits
+ */
+struct ThreadCountersOwner {
+    ~ThreadCountersOwner();
+};
+
+/**
+ * @brief Totals for one region name
+ */
+struct RegionStats {
+    unsigned long long calls;
+    long long wall_ns;
+    double values[EV_COUNT];
+    bool present[EV_COUNT];
+};
+
+static thread_local ThreadCounters* thread_counters PERF_TLS_MODEL = nullptr;
+static thread_local bool thread_finished PERF_TLS_MODEL = false;
+
+// Guarded by perf_mutex. The region map is never destroyed, so it is still
+// valid in the atexit summary.
+static std::mutex perf_mutex;
+static std::map<std::string, RegionStats>* regions = nullptr;
+static bool exit_hook_installed = false;
+static bool hardware_seen = false;
+
+// ======================== COUNTER GROUPS ========================
+
+#ifdef __linux__
+static int open_event(int event, int group) {
+    static const struct { unsigned int type; unsigned long long config; } EVENTS[EV_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS },
+    };
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = EVENTS[event].type;
+    attr.config = EVENTS[event].config;
+    attr.disabled = group == -1;        // The leader starts the whole group
+    attr.exclude_kernel = 1;            // Allowed at perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+}
+
+/**
+ * @brief Open events [first, last] as one group; members that fail are left out
+ * @return true if at least the leader opened
+ */
+static bool open_group(ThreadCounters* c, int first, int last) {
+    c->leader = open_event(first, -1);
+    if (c->leader < 0) return false;
+    c->fds[first] = c->leader;
+    c->slot_event[c->slots++] = first;
+    for (int event = first + 1; event <= last; event++) {
+        int fd = open_event(event, c->leader);
+        if (fd < 0) continue;
+        c->fds[event] = fd;
+        c->slot_event[c->slots++] = event;
+    }
+    ioctl(c->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(c->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+#endif
+
+// ======================== THREAD STATE ========================
+
+ThreadCountersOwner::~ThreadCountersOwner() {
+    if (thread_counters) {
+#ifdef __linux__
+        for (int i = 0; i < EV_COUNT; i++) {
+            if (thread_counters->fds[i] >= 0) close(thread_counters->fds[i]);
+        }
+#endif
+        delete thread_counters;
+        thread_counters = nullptr;
+    }
+    thread_finished = true;
+}
+
+/**
+ * @brief Open this thread's group, hardware events first and software events if those are refused
+ */
+static ThreadCounters* create_thread_counters(void) {
+    static thread_local ThreadCountersOwner owner;
+    (void)owner;
+    ThreadCounters* c = new ThreadCounters();
+    c->leader = -1;
+    c->slots = 0;
+    c->hardware = false;
+    for (int i = 0; i < EV_COUNT; i++) c->fds[i] = -1;
+#ifdef __linux__
+    if (open_group(c, HARDWARE_FIRST, HARDWARE_LAST)) {
+        c->hardware = true;
+    } else {
+        open_group(c, SOFTWARE_FIRST, SOFTWARE_LAST);
+    }
+#endif
+    thread_counters = c;
+    return c;
+}
+
+/**
+ * @brief Read the group once; events not in the group read as -1
+ *
+ * Counts are scaled by enabled/running time in case the kernel had to
+ * multiplex the group with other users of the PMU.
+ */
+static void read_counters(ThreadCounters* c, double* values) {
+    for (int i = 0; i < EV_COUNT; i++) values[i] = -1.0;
+#ifdef __linux__
+    if (c->leader < 0) return;
+    unsigned long long buffer[3 + EV_COUNT];
+    ssize_t bytes = read(c->leader, buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3 * sizeof(unsigned long long))) return;
+
+    unsigned long long count = buffer[0];
+    unsigned long long enabled = buffer[1];
+    unsigned long long running = buffer[2];
+    if (running == 0) return;
+    double scale = static_cast<double>(enabled) / static_cast<double>(running);
+    for (unsigned long long i = 0; i < count && static_cast<int>(i) < c->slots; i++) {
+        values[c->slot_event[i]] = static_cast<double>(buffer[3 + i]) * scale;
+    }
+#else
+    (void)c;
+#endif
+}
+
+// ======================== REPORTING ========================
+
+static void print_summary(FILE* out) {
+    if (!regions || regions->empty()) return;
+    fprintf(out, "perf regions (%s counters):\n", hardware_seen ? "hardware" : "software");
+    for (const auto& entry : *regions) {
+        const RegionStats& stats = entry.second;
+        fprintf(out, "  %s: %llu calls, %.3f ms\n", entry.first.c_str(), stats.calls, stats.wall_ns / 1e6);
+        fprintf(out, "   ");
+        for (int event = 0; event < EV_COUNT; event++) {
+            if (stats.present[event]) fprintf(out, " %s %.0f", EVENT_NAMES[event], stats.values[event]);
+        }
+        fprintf(out, "\n");
+
+        const double* v = stats.values;
+        bool derived = false;
+        if (stats.present[EV_CYCLES] && stats.present[EV_INSTRUCTIONS] && v[EV_CYCLES] > 0) {
+            fprintf(out, "    IPC %.2f", v[EV_INSTRUCTIONS] / v[EV_CYCLES]);
+            derived = true;
+        }
+        if (stats.present[EV_CACHE_REFERENCES] && stats.present[EV_CACHE_MISSES] && v[EV_CACHE_REFERENCES] > 0) {
+            fprintf(out, "%scache miss %.2f%%", derived ? ", " : "    ", 100.0 * v[EV_CACHE_MISSES] / v[EV_CACHE_REFERENCES]);
+            derived = true;
+        }
+        if (stats.present[EV_BRANCHES] && stats.present[EV_BRANCH_MISSES] && v[EV_BRANCHES] > 0) {
+            fprintf(out, "%sbranch miss %.2f%%", derived ? ", " : "    ", 100.0 * v[EV_BRANCH_MISSES] / v[EV_BRANCHES]);
+            derived = true;
+        }
+        if (derived) fprintf(out, "\n");
+    }
+    fflush(out);
+}
+
+static void write_json_string(FILE* out, const std::string& text) {
+    fputc('"', out);
+    for (unsigned char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            fputc('\\', out);
+            fputc(ch, out);
+        } else if (ch < 0x20) {
+            fprintf(out, "\\u%04x", ch);
+        } else {
+            fputc(ch, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static int write_json(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) return 0;
+    fprintf(out, "{\"hardware\": %s, \"regions\": [", hardware_seen ? "true" : "false");
+    bool first = true;
+    if (regions) {
+        for (const auto& entry : *regions) {
+            const RegionStats& stats = entry.second;
+            fprintf(out, "%s\n  {\"name\": ", first ? "" : ",");
+            write_json_string(out, entry.first);
+            fprintf(out, ", \"calls\": %llu, \"wall_ns\": %lld, \"counters\": {", stats.calls, stats.wall_ns);
+            bool firstCounter = true;
+            for (int event = 0; event < EV_COUNT; event++) {
+                if (!stats.present[event]) continue;
+                fprintf(out, "%s\"%s\": %.0f", firstCounter ? "" : ", ", EVENT_NAMES[event], stats.values[event]);
+                firstCounter = false;
+            }
+            fprintf(out, "}}");
+            first = false;
+        }
+    }
+    fprintf(out, "\n]}\n");
+    return fclose(out) == 0;
+}
+
+static void report_at_exit(void) {
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    print_summary(stderr);
+    const char* path = getenv("EMLANG_PERF_JSON");
+    if (path && *path) write_json(path);
+}
+
+/**
+ * @brief This thread's counters, opened on first use together with the shared region table and exit report
+ */
+static ThreadCounters* current_thread_counters(void) {
+    ThreadCounters* c = thread_counters;
+    if (c || thread_finished) return c;
+    c = create_thread_counters();
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    hardware_seen = hardware_seen || c->hardware;
+    if (!exit_hook_installed) {
+        exit_hook_installed = true;
+        regions = new std::map<std::string, RegionStats>();
+        atexit(report_at_exit);
+    }
+    return c;
+}
+
+extern "C" {
+
+// ======================== REGIONS ========================
+
+void emlang_perf_begin(const char* region) {
+    ThreadCounters* c = current_thread_counters();
+    if (!c) return;
+
+    c->open.emplace_back();
+    Snapshot& snapshot = c->open.back();
+    snapshot.region = region ? region : "";
+    snapshot.wall_ns = emlang_now_ns();
+    // Read last so setting up the snapshot is not counted
+    read_counters(c, snapshot.values);
+}
+
+void emlang_perf_end(const char* region) {
+    ThreadCounters* c = thread_counters;
+    if (!c) return;
+    double values[EV_COUNT];
+    read_counters(c, values);
+    long long now = emlang_now_ns();
+
+    std::string name = region ? region : "";
+    size_t index = c->open.size();
+    while (index > 0 && c->open[index - 1].region != name) index--;
+    if (index == 0) return;                 // No matching begin
+    const Snapshot& start = c->open[index - 1];
+
+    {
+        std::lock_guard<std::mutex> lock(perf_mutex);
+        RegionStats& stats = (*regions)[name];
+        stats.calls++;
+        stats.wall_ns += now - start.wall_ns;
+        for (int event = 0; event < EV_COUNT; event++) {
+            if (values[event] < 0.0 || start.values[event] < 0.0) continue;
+            stats.values[event] += values[event] - start.values[event];
+            stats.present[event] = true;
+        }
+    }
+    // Regions opened inside this one and never closed end with it
+    c->open.resize(index - 1);
+}
+
+// ======================== REPORTING ========================
+
+int emlang_perf_hardware(void) {
+    ThreadCounters* c = current_thread_counters();
+    return c && c->hardware ? 1 : 0;
+}
+
+void emlang_perf_summary(void) {
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    print_summary(stderr);
+}
+
+int emlang_perf_export_json(const char* path) {
+    if (!path) return 0;
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    return write_json(path);
+}
+
+} // extern "C"
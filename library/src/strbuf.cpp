@@ -0,0 +1,502 @@
+#include "emlang_strbuf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Rope leaves are split so that no chunk exceeds this many bytes
+static const int ROPE_CHUNK_SIZE = 512;
+
+/**
+ * @brief Rope node: one text chunk plus treap links
+ *
+ * The tree is an implicit treap keyed by position. weight holds the total
+ * byte count of the subtree, which makes position lookups O(log n).
+ */
+struct RopeNode {
+    RopeNode* left;
+    RopeNode* right;
+    unsigned int priority;
+    long long weight;
+    int len;
+    char* text;
+};
+
+struct emlang_rope {
+    RopeNode* root;
+};
+
+static unsigned int rope_seed = 2463534242u;
+
+/**
+ * @brief xorshift32 generator for treap priorities
+ */
+static unsigned int rope_random() {
+    rope_seed ^= rope_seed << 13;
+    rope_seed ^= rope_seed >> 17;
+    rope_seed ^= rope_seed << 5;
+    return rope_seed;
+}
+
+/**
+ * @brief Grow builder so that it can hold at least needed bytes
+ *
+ * Capacity at least doubles on every spill, keeping appends amortized O(1).
+ */
+static int strbuf_grow(emlang_strbuf* sb, long long needed) {
+    if (needed <= sb->capacity) return 1;
+    if (needed > 0x7FFFFFFE) return 0;
+
+    long long new_capacity = sb->capacity > 0 ? sb->capacity : EMLANG_STRBUF_INLINE_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > 0x7FFFFFFE) new_capacity = 0x7FFFFFFE;
+
+    char* block;
+    if (sb->data == sb->inline_buf) {
+        block = static_cast<char*>(malloc(static_cast<size_t>(new_capacity) + 1));
+        if (!block) return 0;
+        memcpy(block, sb->inline_buf, static_cast<size_t>(sb->length) + 1);
+    } else {
+        block = static_cast<char*>(realloc(sb->data, static_cast<size_t>(new_capacity) + 1));
+        if (!block) return 0;
+    }
+
+    sb->data = block;
+    sb->capacity = static_cast<int>(new_capacity);
+    return 1;
+}
+
+static long long rope_weight(const RopeNode* node) {
+    return node ? node->weight : 0;
+}
+
+static void rope_update(RopeNode* node) {
+    node->weight = rope_weight(node->left) + rope_weight(node->right) + node->len;
+}
+
+static RopeNode* rope_node_new(const char* text, int len) {
+    RopeNode* node = static_cast<RopeNode*>(malloc(sizeof(RopeNode)));
+    if (!node) return nullptr;
+
+    node->text = static_cast<char*>(malloc(static_cast<size_t>(len > 0 ? len : 1)));
+    if (!node->text) {
+        free(node);
+        return nullptr;
+    }
+    if (len > 0) memcpy(node->text, text, static_cast<size_t>(len));
+
+    node->left = nullptr;
+    node->right = nullptr;
+    node->priority = rope_random();
+    node->len = len;
+    node->weight = len;
+    return node;
+}
+
+static void rope_node_free(RopeNode* node) {
+    // Iterative teardown: rotate left children up so the stack never grows
+    while (node) {
+        if (node->left) {
+            RopeNode* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            RopeNode* right = node->right;
+            free(node->text);
+            free(node);
+            node = right;
+        }
+    }
+}
+
+static RopeNode* rope_merge(RopeNode* a, RopeNode* b) {
+    if (!a) return b;
+    if (!b) return a;
+
+    if (a->priority > b->priority) {
+        a->right = rope_merge(a->right, b);
+        rope_update(a);
+        return a;
+    }
+    b->left = rope_merge(a, b->left);
+    rope_update(b);
+    return b;
+}
+
+/**
+ * @brief Split tree at byte offset pos into [0, pos) and [pos, end)
+ *
+ * A chunk straddling pos is cut in two. Returns 0 if that allocation fails,
+ * in which case the tree is left as a valid (l, r) pair split at the chunk
+ * boundary preceding pos.
+ */
+static int rope_split(RopeNode* node, long long pos, RopeNode** l, RopeNode** r) {
+    if (!node) {
+        *l = nullptr;
+        *r = nullptr;
+        return 1;
+    }
+
+    long long left_weight = rope_weight(node->left);
+    int ok = 1;
+
+    if (pos <= left_weight) {
+        ok = rope_split(node->left, pos, l, &node->left);
+        rope_update(node);
+        *r = node;
+    } else if (pos >= left_weight + node->len) {
+        ok = rope_split(node->right, pos - left_weight - node->len, &node->right, r);
+        rope_update(node);
+        *l = node;
+    } else {
+        int offset = static_cast<int>(pos - left_weight);
+        RopeNode* tail = rope_node_new(node->text + offset, node->len - offset);
+        if (!tail) {
+            *r = node->right;
+            node->right = nullptr;
+            rope_update(node);
+            *l = node;
+            return 0;
+        }
+        node->len = offset;
+        *r = rope_merge(tail, node->right);
+        node->right = nullptr;
+        rope_update(node);
+        *l = node;
+    }
+    return ok;
+}
+
+/**
+ * @brief Build a balanced subtree from a string, chunked to ROPE_CHUNK_SIZE
+ */
+static RopeNode* rope_build(const char* str, long long len, int* ok) {
+    RopeNode* tree = nullptr;
+    long long offset = 0;
+    while (offset < len) {
+        int chunk = static_cast<int>(len - offset < ROPE_CHUNK_SIZE ? len - offset : ROPE_CHUNK_SIZE);
+        RopeNode* node = rope_node_new(str + offset, chunk);
+        if (!node) {
+            *ok = 0;
+            break;
+        }
+        tree = rope_merge(tree, node);
+        offset += chunk;
+    }
+    return tree;
+}
+
+static long long rope_copy_node(const RopeNode* node, char* dest, long long max_len) {
+    long long written = 0;
+    while (node && written < max_len) {
+        if (node->left) {
+            written += rope_copy_node(node->left, dest + written, max_len - written);
+            if (written >= max_len) break;
+        }
+        long long n = node->len < max_len - written ? node->len : max_len - written;
+        memcpy(dest + written, node->text, static_cast<size_t>(n));
+        written += n;
+        node = node->right;
+    }
+    return written;
+}
+
+static void rope_append_node(const RopeNode* node, emlang_strbuf* sb) {
+    while (node) {
+        rope_append_node(node->left, sb);
+        emlang_strbuf_append_n(sb, node->text, node->len);
+        node = node->right;
+    }
+}
+
+extern "C" {
+
+// ======================== STRING BUILDER ========================
+
+void emlang_strbuf_init(emlang_strbuf* sb) {
+    if (!sb) return;
+
+    sb->data = sb->inline_buf;
+    sb->length = 0;
+    sb->capacity = EMLANG_STRBUF_INLINE_CAPACITY;
+    sb->inline_buf[0] = '\0';
+}
+
+void emlang_strbuf_destroy(emlang_strbuf* sb) {
+    if (!sb) return;
+
+    if (sb->data != sb->inline_buf) {
+        free(sb->data);
+    }
+    emlang_strbuf_init(sb);
+}
+
+emlang_strbuf* emlang_strbuf_new(void) {
+    emlang_strbuf* sb = static_cast<emlang_strbuf*>(malloc(sizeof(emlang_strbuf)));
+    if (sb) {
+        emlang_strbuf_init(sb);
+    }
+    return sb;
+}
+
+void emlang_strbuf_free(emlang_strbuf* sb) {
+    if (!sb) return;
+
+    emlang_strbuf_destroy(sb);
+    free(sb);
+}
+
+int emlang_strbuf_reserve(emlang_strbuf* sb, int capacity) {
+    if (!sb) return 0;
+    return strbuf_grow(sb, capacity);
+}
+
+void emlang_strbuf_shrink(emlang_strbuf* sb) {
+    if (!sb || sb->data == sb->inline_buf) return;
+
+    if (sb->length <= EMLANG_STRBUF_INLINE_CAPACITY) {
+        char* block = sb->data;
+        memcpy(sb->inline_buf, block, static_cast<size_t>(sb->length) + 1);
+        free(block);
+        sb->data = sb->inline_buf;
+        sb->capacity = EMLANG_STRBUF_INLINE_CAPACITY;
+        return;
+    }
+
+    char* block = static_cast<char*>(realloc(sb->data, static_cast<size_t>(sb->length) + 1));
+    if (block) {
+        sb->data = block;
+        sb->capacity = sb->length;
+    }
+}
+
+void emlang_strbuf_clear(emlang_strbuf* sb) {
+    if (!sb) return;
+
+    sb->length = 0;
+    sb->data[0] = '\0';
+}
+
+void emlang_strbuf_append_n(emlang_strbuf* sb, const char* str, int n) {
+    if (!sb || !str || n <= 0) return;
+    if (!strbuf_grow(sb, static_cast<long long>(sb->length) + n)) return;
+
+    memcpy(sb->data + sb->length, str, static_cast<size_t>(n));
+    sb->length += n;
+    sb->data[sb->length] = '\0';
+}
+
+void emlang_strbuf_append_str(emlang_strbuf* sb, const char* str) {
+    if (!sb || !str) return;
+
+    size_t len = strlen(str);
+    if (len > 0x7FFFFFFE) return;
+    emlang_strbuf_append_n(sb, str, static_cast<int>(len));
+}
+
+void emlang_strbuf_append_char(emlang_strbuf* sb, char c) {
+    if (!sb) return;
+    if (!strbuf_grow(sb, static_cast<long long>(sb->length) + 1)) return;
+
+    sb->data[sb->length++] = c;
+    sb->data[sb->length] = '\0';
+}
+
+void emlang_strbuf_append_int(emlang_strbuf* sb, long long value) {
+    if (!sb) return;
+
+    // Work on the magnitude as unsigned so LLONG_MIN does not overflow
+    unsigned long long magnitude = value < 0
+        ? 0ull - static_cast<unsigned long long>(value)
+        : static_cast<unsigned long long>(value);
+
+    int digits = 1;
+    for (unsigned long long v = magnitude; v >= 10; v /= 10) {
+        digits++;
+    }
+    int total = digits + (value < 0 ? 1 : 0);
+    if (!strbuf_grow(sb, static_cast<long long>(sb->length) + total)) return;
+
+    // Write digits straight into the buffer, back to front
+    char* out = sb->data + sb->length;
+    if (value < 0) *out++ = '-';
+    char* p = out + digits;
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    sb->length += total;
+    sb->data[sb->length] = '\0';
+}
+
+void emlang_strbuf_append_float(emlang_strbuf* sb, double value) {
+    if (!sb) return;
+
+    // Format directly into the spare capacity; grow once and retry if short
+    int spare = sb->capacity - sb->length;
+    int needed = snprintf(sb->data + sb->length, static_cast<size_t>(spare) + 1, "%.6f", value);
+    if (needed < 0) {
+        sb->data[sb->length] = '\0';
+        return;
+    }
+    if (needed > spare) {
+        if (!strbuf_grow(sb, static_cast<long long>(sb->length) + needed)) {
+            sb->data[sb->length] = '\0';
+            return;
+        }
+        snprintf(sb->data + sb->length, static_cast<size_t>(needed) + 1, "%.6f", value);
+    }
+    sb->length += needed;
+}
+
+const char* emlang_strbuf_view(const emlang_strbuf* sb) {
+    if (!sb) return "";
+    return sb->data;
+}
+
+int emlang_strbuf_length(const emlang_strbuf* sb) {
+    return sb ? sb->length : 0;
+}
+
+char* emlang_strbuf_detach(emlang_strbuf* sb) {
+    if (!sb) return nullptr;
+
+    char* result;
+    if (sb->data == sb->inline_buf) {
+        result = static_cast<char*>(malloc(static_cast<size_t>(sb->length) + 1));
+        if (!result) return nullptr;
+        memcpy(result, sb->inline_buf, static_cast<size_t>(sb->length) + 1);
+    } else {
+        result = sb->data;
+    }
+
+    emlang_strbuf_init(sb);
+    return result;
+}
+
+// ======================== ROPE ========================
+
+emlang_rope* emlang_rope_new(void) {
+    emlang_rope* rope = static_cast<emlang_rope*>(malloc(sizeof(emlang_rope)));
+    if (rope) {
+        rope->root = nullptr;
+    }
+    return rope;
+}
+
+emlang_rope* emlang_rope_from_str(const char* str) {
+    emlang_rope* rope = emlang_rope_new();
+    if (rope && str) {
+        emlang_rope_append(rope, str);
+    }
+    return rope;
+}
+
+void emlang_rope_free(emlang_rope* rope) {
+    if (!rope) return;
+
+    rope_node_free(rope->root);
+    free(rope);
+}
+
+long long emlang_rope_length(const emlang_rope* rope) {
+    return rope ? rope_weight(rope->root) : 0;
+}
+
+int emlang_rope_insert(emlang_rope* rope, long long pos, const char* str) {
+    if (!rope || !str) return 0;
+
+    long long total = rope_weight(rope->root);
+    if (pos < 0 || pos > total) return 0;
+
+    long long len = static_cast<long long>(strlen(str));
+    if (len == 0) return 1;
+
+    int ok = 1;
+    RopeNode* middle = rope_build(str, len, &ok);
+    if (!ok) {
+        rope_node_free(middle);
+        return 0;
+    }
+
+    RopeNode* left = nullptr;
+    RopeNode* right = nullptr;
+    if (!rope_split(rope->root, pos, &left, &right)) {
+        rope->root = rope_merge(left, right);
+        rope_node_free(middle);
+        return 0;
+    }
+    rope->root = rope_merge(rope_merge(left, middle), right);
+    return 1;
+}
+
+int emlang_rope_append(emlang_rope* rope, const char* str) {
+    if (!rope) return 0;
+    return emlang_rope_insert(rope, rope_weight(rope->root), str);
+}
+
+int emlang_rope_erase(emlang_rope* rope, long long pos, long long len) {
+    if (!rope || pos < 0 || len < 0) return 0;
+
+    long long total = rope_weight(rope->root);
+    if (pos > total) return 0;
+    if (len > total - pos) len = total - pos;
+    if (len == 0) return 1;
+
+    RopeNode* left = nullptr;
+    RopeNode* rest = nullptr;
+    if (!rope_split(rope->root, pos, &left, &rest)) {
+        rope->root = rope_merge(left, rest);
+        return 0;
+    }
+
+    RopeNode* middle = nullptr;
+    RopeNode* right = nullptr;
+    if (!rope_split(rest, len, &middle, &right)) {
+        rope->root = rope_merge(left, rope_merge(middle, right));
+        return 0;
+    }
+
+    rope_node_free(middle);
+    rope->root = rope_merge(left, right);
+    return 1;
+}
+
+char emlang_rope_char_at(const emlang_rope* rope, long long pos) {
+    if (!rope || pos < 0) return '\0';
+
+    const RopeNode* node = rope->root;
+    while (node) {
+        long long left_weight = rope_weight(node->left);
+        if (pos < left_weight) {
+            node = node->left;
+        } else if (pos < left_weight + node->len) {
+            return node->text[pos - left_weight];
+        } else {
+            pos -= left_weight + node->len;
+            node = node->right;
+        }
+    }
+    return '\0';
+}
+
+long long emlang_rope_copy(const emlang_rope* rope, char* dest, long long max_len) {
+    if (!rope || !dest || max_len <= 0) return 0;
+
+    long long written = rope_copy_node(rope->root, dest, max_len - 1);
+    dest[written] = '\0';
+    return written;
+}
+
+void emlang_rope_to_strbuf(const emlang_rope* rope, emlang_strbuf* sb) {
+    if (!rope || !sb) return;
+
+    long long total = rope_weight(rope->root);
+    if (!strbuf_grow(sb, sb->length + total)) return;
+    rope_append_node(rope->root, sb);
+}
+
+} // extern "C"
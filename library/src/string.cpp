@@ -165,12 +165,19 @@ int emlang_is_numeric(const char* str) {
     if (*str == '+' || *str == '-') str++;
     
     // Must have at least one digit
-    if (!(*str >= '0' && *str <= '9')) return 0;
-    
-    // Check all remaining characters are digits
-    while (*str) {
-        if (!(*str >= '0' && *str <= '9')) return 0;
-        str++;
+    size_t len = strlen(str);
+    if (len == 0) return 0;
+    
+    // Check eight characters per step: a byte is a digit iff adding 0x46
+    // and subtracting 0x30 both leave its high bit clear
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        unsigned long long word;
+        memcpy(&word, str + i, sizeof(word));
+        if (((word + 0x4646464646464646ULL) | (word - 0x3030303030303030ULL)) & 0x8080808080808080ULL) return 0;
+    }
+    for (; i < len; i++) {
+        if (!(str[i] >= '0' && str[i] <= '9')) return 0;
     }
     
     return 1;
@@ -0,0 +1,92 @@
+#include "emlang_task.h"
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Frame sizes are rounded up to a granule; larger frames bypass the pool
+static const long long TASK_FRAME_GRANULE = 16;
+static const long long TASK_POOLED_FRAME_MAX = 1024;
+
+/**
+ * @brief Start of every frame under LLVM's switched-resume lowering
+ *
+ * The resume function is cleared at the final suspend point, which is
+ * how a finished task is recognized.
+ */
+struct CoroFrame {
+    void (*resume)(void*);
+    void (*destroy)(void*);
+};
+
+/**
+ * @brief A pooled frame waiting to be reused
+ */
+struct FreeFrame {
+    FreeFrame* next;
+};
+
+static thread_local FreeFrame* free_frames[TASK_POOLED_FRAME_MAX / TASK_FRAME_GRANULE + 1];
+static thread_local std::deque<void*> ready_tasks;
+
+/**
+ * @brief Free list index of a frame size, or -1 if it is not pooled
+ */
+static long long frame_class(long long size) {
+    long long granules = (size + TASK_FRAME_GRANULE - 1) / TASK_FRAME_GRANULE;
+    return granules * TASK_FRAME_GRANULE <= TASK_POOLED_FRAME_MAX ? granules : -1;
+}
+
+extern "C" {
+
+// ======================== FRAMES ========================
+
+void* emlang_coro_alloc(long long size) {
+    long long index = frame_class(size);
+    if (index >= 0 && free_frames[index]) {
+        FreeFrame* frame = free_frames[index];
+        free_frames[index] = frame->next;
+        return frame;
+    }
+
+    size_t bytes = static_cast<size_t>(index >= 0 ? index * TASK_FRAME_GRANULE : size);
+    void* frame = malloc(bytes > 0 ? bytes : 1);
+    if (!frame) {
+        fprintf(stderr, "Runtime Error: failed to allocate a %lld-byte task frame\n", size);
+        fflush(stderr);
+        abort();
+    }
+    return frame;
+}
+
+void emlang_coro_free(void* frame, long long size) {
+    long long index = frame_class(size);
+    if (index < 0) {
+        free(frame);
+        return;
+    }
+    FreeFrame* pooled = static_cast<FreeFrame*>(frame);
+    pooled->next = free_frames[index];
+    free_frames[index] = pooled;
+}
+
+// ======================== EXECUTOR ========================
+
+void emlang_task_schedule(void* task) {
+    ready_tasks.push_back(task);
+}
+
+void emlang_task_block_on(void* task) {
+    const CoroFrame* awaited = static_cast<const CoroFrame*>(task);
+    while (awaited->resume) {
+        if (ready_tasks.empty()) {
+            fprintf(stderr, "Runtime Error: awaited task can never finish\n");
+            fflush(stderr);
+            abort();
+        }
+        void* next = ready_tasks.front();
+        ready_tasks.pop_front();
+        static_cast<CoroFrame*>(next)->resume(next);
+    }
+}
+
+} // extern "C"
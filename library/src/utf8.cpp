@@ -0,0 +1,452 @@
+#include "emlang_utf8.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EMLANG_UTF8_SSE2 1
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// The validator needs pshufb (SSSE3), which is not part of the x86-64
+// baseline: build it for SSSE3 and pick it at runtime unless the whole
+// library is already compiled for SSSE3
+#if defined(EMLANG_UTF8_SSE2)
+#if defined(__SSSE3__) || defined(__AVX__)
+#define EMLANG_UTF8_SSSE3_ALWAYS 1
+#define EMLANG_UTF8_SSSE3_TARGET
+#elif defined(__GNUC__) || defined(__clang__)
+#define EMLANG_UTF8_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define EMLANG_UTF8_SSSE3_TARGET
+#endif
+#endif
+
+/**
+ * @brief Number of set bits in a 16-bit movemask
+ */
+static inline unsigned int popcount16(unsigned int mask) {
+    mask = mask - ((mask >> 1) & 0x5555u);
+    mask = (mask & 0x3333u) + ((mask >> 2) & 0x3333u);
+    mask = (mask + (mask >> 4)) & 0x0F0Fu;
+    return (mask + (mask >> 8)) & 0x1Fu;
+}
+
+static inline bool is_lead_byte(unsigned char c) {
+    return (c & 0xC0) != 0x80;
+}
+
+// ======================== SCALAR PATH ========================
+
+/**
+ * @brief Offset of the first byte that does not start a well-formed sequence, or -1
+ *
+ * Follows the well-formed byte sequence table of the Unicode standard:
+ * no overlong forms, no surrogates, nothing above U+10FFFF.
+ */
+static long long scalar_error_offset(const unsigned char* s, long long len) {
+    long long i = 0;
+    while (i < len) {
+        // Skip ASCII eight bytes at a time
+        if (len - i >= 8) {
+            uint64_t word;
+            memcpy(&word, s + i, sizeof(word));
+            if ((word & 0x8080808080808080ULL) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+
+        long long extra;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            extra = 1;
+        } else if (c == 0xE0) {
+            extra = 2; low = 0xA0;
+        } else if (c == 0xED) {
+            extra = 2; high = 0x9F;
+        } else if (c >= 0xE1 && c <= 0xEF) {
+            extra = 2;
+        } else if (c == 0xF0) {
+            extra = 3; low = 0x90;
+        } else if (c >= 0xF1 && c <= 0xF3) {
+            extra = 3;
+        } else if (c == 0xF4) {
+            extra = 3; high = 0x8F;
+        } else {
+            return i;
+        }
+
+        if (len - i <= extra) return i;
+        if (s[i + 1] < low || s[i + 1] > high) return i;
+        for (long long k = 2; k <= extra; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) return i;
+        }
+        i += extra + 1;
+    }
+    return -1;
+}
+
+// ======================== SIMD PATH ========================
+
+#if defined(EMLANG_UTF8_SSE2)
+
+// Error classes of the lookup algorithm; a byte pair is invalid when the
+// classes selected by its three nibbles share a bit
+#define UTF8_TOO_SHORT      (1 << 0)
+#define UTF8_TOO_LONG       (1 << 1)
+#define UTF8_OVERLONG_3     (1 << 2)
+#define UTF8_TOO_LARGE      (1 << 3)
+#define UTF8_SURROGATE      (1 << 4)
+#define UTF8_OVERLONG_2     (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4     (1 << 6)
+#define UTF8_TWO_CONTS      (1 << 7)
+#define UTF8_CARRY          (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static int cpu_has_ssse3() {
+#if defined(EMLANG_UTF8_SSSE3_ALWAYS)
+    return 1;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] >> 9) & 1;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+/**
+ * @brief Lookup-table validation over 16-byte blocks
+ *
+ * Each byte is classified together with the byte before it by the high
+ * nibble of the previous byte, the low nibble of the previous byte and the
+ * high nibble of the current byte. Third and fourth bytes of long sequences
+ * are checked separately from the lead byte two or three positions back.
+ */
+EMLANG_UTF8_SSSE3_TARGET
+static int ssse3_validate(const unsigned char* s, long long len) {
+    const __m128i byte1High = _mm_setr_epi8(
+        // 0_______ ASCII
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        // 10______ continuation
+        (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS, (char)UTF8_TWO_CONTS,
+        // 1100____ / 1101____ two-byte lead
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        UTF8_TOO_SHORT,
+        // 1110____ three-byte lead
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        // 1111____ four-byte lead
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4);
+
+    const __m128i byte1Low = _mm_setr_epi8(
+        (char)(UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4),
+        (char)(UTF8_CARRY | UTF8_OVERLONG_2),
+        (char)UTF8_CARRY,
+        (char)UTF8_CARRY,
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000),
+        (char)(UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000));
+
+    const __m128i byte2High = _mm_setr_epi8(
+        // 0_______ ASCII after a lead byte
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        // 1000____
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4),
+        // 1001____
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE),
+        // 101_____
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        (char)(UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE),
+        // 11______ lead byte after a lead byte
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+
+    // A block may not end inside a sequence unless the next block finishes it
+    const __m128i incompleteMax = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i thirdByteBias = _mm_set1_epi8((char)(0xE0 - 0x80));
+    const __m128i fourthByteBias = _mm_set1_epi8((char)(0xF0 - 0x80));
+    const __m128i highBit = _mm_set1_epi8((char)0x80);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+
+    long long i = 0;
+    unsigned char tail[16];
+    while (i < len) {
+        __m128i input;
+        if (len - i >= 16) {
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        } else {
+            // Zero padding is ASCII, so a truncated final sequence still reports
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, s + i, static_cast<size_t>(len - i));
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+        }
+        i += 16;
+
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, prevIncomplete);
+            prevIncomplete = _mm_setzero_si128();
+            prev = input;
+            continue;
+        }
+
+        __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+        __m128i special = _mm_and_si128(
+            _mm_and_si128(
+                _mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask)),
+                _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibbleMask))),
+            _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask)));
+
+        __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+        __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+        __m128i mustContinue = _mm_and_si128(
+            _mm_or_si128(_mm_subs_epu8(prev2, thirdByteBias), _mm_subs_epu8(prev3, fourthByteBias)),
+            highBit);
+
+        error = _mm_or_si128(error, _mm_xor_si128(mustContinue, special));
+        prevIncomplete = _mm_subs_epu8(input, incompleteMax);
+        prev = input;
+    }
+
+    error = _mm_or_si128(error, prevIncomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#endif // EMLANG_UTF8_SSE2
+
+/**
+ * @brief Number of lead bytes (codepoints) in a byte range
+ */
+static long long count_lead_bytes(const unsigned char* s, long long len) {
+    long long count = 0;
+    long long i = 0;
+#if defined(EMLANG_UTF8_SSE2)
+    // Continuation bytes are 0x80..0xBF, i.e. -128..-65 as signed bytes
+    const __m128i lastContinuation = _mm_set1_epi8(-65);
+    for (; len - i >= 16; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        count += popcount16(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(block, lastContinuation))));
+    }
+#endif
+    for (; i < len; i++) {
+        count += is_lead_byte(s[i]);
+    }
+    return count;
+}
+
+/**
+ * @brief Encode one codepoint, returns bytes written or 0 if not a scalar value
+ */
+static int encode_utf8(unsigned int cp, char* out) {
+    if (cp < 0x80) {
+        out[0] = static_cast<char>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (cp >> 6));
+        out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        if (cp >= 0xD800 && cp <= 0xDFFF) return 0;
+        out[0] = static_cast<char>(0xE0 | (cp >> 12));
+        out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    if (cp <= 0x10FFFF) {
+        out[0] = static_cast<char>(0xF0 | (cp >> 18));
+        out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+        return 4;
+    }
+    return 0;
+}
+
+extern "C" {
+
+// ======================== VALIDATION ========================
+
+int emlang_utf8_validate(const char* data, long long len) {
+    if (len <= 0) return 1;
+    if (!data) return 0;
+
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(data);
+#if defined(EMLANG_UTF8_SSE2)
+    static const int useSSSE3 = cpu_has_ssse3();
+    if (useSSSE3) {
+        return ssse3_validate(s, len);
+    }
+#endif
+    return scalar_error_offset(s, len) < 0;
+}
+
+long long emlang_utf8_error_offset(const char* data, long long len) {
+    if (!data || len <= 0) return -1;
+
+    // Validate at full speed first, locate the error only when there is one
+    if (emlang_utf8_validate(data, len)) return -1;
+    return scalar_error_offset(reinterpret_cast<const unsigned char*>(data), len);
+}
+
+// ======================== COUNTING ========================
+
+long long emlang_utf8_count(const char* data, long long len) {
+    if (!data || len <= 0) return 0;
+    return count_lead_bytes(reinterpret_cast<const unsigned char*>(data), len);
+}
+
+long long emlang_utf8_strlen(const char* str) {
+    if (!str) return 0;
+    return emlang_utf8_count(str, static_cast<long long>(strlen(str)));
+}
+
+long long emlang_utf8_offset(const char* data, long long len, long long index) {
+    if (!data || len <= 0 || index <= 0) return 0;
+
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(data);
+    long long i = 0;
+#if defined(EMLANG_UTF8_SSE2)
+    // Skip whole blocks that end before the wanted codepoint
+    const __m128i lastContinuation = _mm_set1_epi8(-65);
+    for (; len - i >= 16; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        long long leads = popcount16(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(block, lastContinuation))));
+        if (leads > index) break;
+        index -= leads;
+    }
+#endif
+    for (; i < len; i++) {
+        if (is_lead_byte(s[i])) {
+            if (index == 0) return i;
+            index--;
+        }
+    }
+    return len;
+}
+
+// ======================== TRANSCODING ========================
+
+long long emlang_utf8_to_utf32(const char* src, long long len, unsigned int* dst) {
+    if (!src || len <= 0) return 0;
+    if (!dst || !emlang_utf8_validate(src, len)) return -1;
+
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(src);
+    unsigned int* out = dst;
+    long long i = 0;
+    while (i < len) {
+#if defined(EMLANG_UTF8_SSE2)
+        // Widen runs of 16 ASCII bytes straight to 32-bit codepoints
+        if (len - i >= 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            if (_mm_movemask_epi8(block) == 0) {
+                const __m128i zero = _mm_setzero_si128();
+                __m128i low = _mm_unpacklo_epi8(block, zero);
+                __m128i high = _mm_unpackhi_epi8(block, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+                out += 16;
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            *out++ = c;
+            i += 1;
+        } else if (c < 0xE0) {
+            *out++ = ((c & 0x1Fu) << 6) | (s[i + 1] & 0x3Fu);
+            i += 2;
+        } else if (c < 0xF0) {
+            *out++ = ((c & 0x0Fu) << 12) | ((s[i + 1] & 0x3Fu) << 6) | (s[i + 2] & 0x3Fu);
+            i += 3;
+        } else {
+            *out++ = ((c & 0x07u) << 18) | ((s[i + 1] & 0x3Fu) << 12) |
+                     ((s[i + 2] & 0x3Fu) << 6) | (s[i + 3] & 0x3Fu);
+            i += 4;
+        }
+    }
+    return out - dst;
+}
+
+long long emlang_utf32_utf8_length(const unsigned int* src, long long count) {
+    if (!src || count <= 0) return 0;
+
+    long long bytes = 0;
+    for (long long i = 0; i < count; i++) {
+        unsigned int cp = src[i];
+        if (cp < 0x80) bytes += 1;
+        else if (cp < 0x800) bytes += 2;
+        else if (cp < 0x10000 && (cp < 0xD800 || cp > 0xDFFF)) bytes += 3;
+        else if (cp >= 0x10000 && cp <= 0x10FFFF) bytes += 4;
+        else return -1;
+    }
+    return bytes;
+}
+
+long long emlang_utf32_to_utf8(const unsigned int* src, long long count, char* dst) {
+    if (!src || count <= 0) return 0;
+    if (!dst) return -1;
+
+    char* out = dst;
+    for (long long i = 0; i < count; i++) {
+        int written = encode_utf8(src[i], out);
+        if (written == 0) return -1;
+        out += written;
+    }
+    return out - dst;
+}
+
+// ======================== SLICING ========================
+
+char* emlang_utf8_slice(const char* str, long long start, long long count) {
+    if (!str) return nullptr;
+    if (start < 0) start = 0;
+    if (count < 0) count = 0;
+
+    long long len = static_cast<long long>(strlen(str));
+    long long begin = emlang_utf8_offset(str, len, start);
+    long long end = begin + emlang_utf8_offset(str + begin, len - begin, count);
+
+    char* result = static_cast<char*>(malloc(static_cast<size_t>(end - begin + 1)));
+    if (!result) return nullptr;
+    memcpy(result, str + begin, static_cast<size_t>(end - begin));
+    result[end - begin] = '\0';
+    return result;
+}
+
+} // extern "C"
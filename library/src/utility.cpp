@@ -1,4 +1,5 @@
 #include "emlang_utility.h"
+#include "cycles.h"
 #include <time.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -10,12 +11,41 @@ typedef unsigned long DWORD;
 extern "C" {
     void __stdcall Sleep(DWORD dwMilliseconds);
 }
+#include <chrono>
 #else
 #include <unistd.h>
 #include <sys/time.h>
 typedef unsigned int useconds_t;
 #endif
 
+/**
+ * @brief Thread-safe broken-down local time for now
+ * @return 1 on success, 0 if the conversion failed
+ */
+static int local_now(struct tm* out) {
+    time_t now = time(nullptr);
+#ifdef _WIN32
+    return localtime_s(out, &now) == 0;
+#else
+    return localtime_r(&now, out) != nullptr;
+#endif
+}
+
+/**
+ * @brief Measure the cycle counter against the monotonic clock over ~10 ms
+ */
+static double calibrate_cycles_per_ns(void) {
+    const long long window = 10 * 1000 * 1000;
+    long long startNs = emlang_now_ns();
+    unsigned long long startCycles = emlang_read_cycles();
+    long long elapsed;
+    do {
+        elapsed = emlang_now_ns() - startNs;
+    } while (elapsed < window);
+    unsigned long long cycles = emlang_read_cycles() - startCycles;
+    return elapsed > 0 ? static_cast<double>(cycles) / static_cast<double>(elapsed) : 1.0;
+}
+
 extern "C" {
 
 // ======================== TIME & DATE UTILITIES ========================
@@ -25,21 +55,41 @@ long emlang_timestamp(void) {
 }
 
 int emlang_current_year(void) {
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
-    return timeinfo ? (timeinfo->tm_year + 1900) : 0;
+    struct tm timeinfo;
+    return local_now(&timeinfo) ? (timeinfo.tm_year + 1900) : 0;
 }
 
 int emlang_current_month(void) {
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
-    return timeinfo ? (timeinfo->tm_mon + 1) : 0;  // tm_mon is 0-11, we want 1-12
+    struct tm timeinfo;
+    return local_now(&timeinfo) ? (timeinfo.tm_mon + 1) : 0;  // tm_mon is 0-11, we want 1-12
 }
 
 int emlang_current_day(void) {
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
-    return timeinfo ? timeinfo->tm_mday : 0;
+    struct tm timeinfo;
+    return local_now(&timeinfo) ? timeinfo.tm_mday : 0;
+}
+
+// ======================== HIGH-RESOLUTION TIMERS ========================
+
+long long emlang_now_ns(void) {
+#ifdef _WIN32
+    return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+    // Served from the vDSO on Linux, no system call
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+long long emlang_cycles(void) {
+    return static_cast<long long>(emlang_read_cycles());
+}
+
+double emlang_cycles_per_ns(void) {
+    static const double rate = calibrate_cycles_per_ns();
+    return rate;
 }
 
 // ======================== SYSTEM UTILITIES ========================
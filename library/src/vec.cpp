@@ -0,0 +1,148 @@
+#include "emlang_vec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacity of the first allocation, in elements
+static const long long VEC_MIN_CAPACITY = 8;
+
+/**
+ * @brief Reallocate storage to exactly capacity elements
+ */
+static int vec_realloc(emlang_vec* vec, long long capacity) {
+    if (capacity < 0 || (vec->elem_size > 0 && capacity > 0x7FFFFFFFFFFFFFFFLL / vec->elem_size)) {
+        return 0;
+    }
+
+    size_t bytes = static_cast<size_t>(capacity * vec->elem_size);
+    void* data = realloc(vec->data, bytes > 0 ? bytes : 1);
+    if (!data) return 0;
+
+    vec->data = data;
+    vec->capacity = capacity;
+    return 1;
+}
+
+extern "C" {
+
+// ======================== LIFETIME ========================
+
+emlang_vec* emlang_vec_new(long long elem_size) {
+    if (elem_size <= 0) return nullptr;
+
+    emlang_vec* vec = static_cast<emlang_vec*>(malloc(sizeof(emlang_vec)));
+    if (vec) {
+        vec->data = nullptr;
+        vec->length = 0;
+        vec->capacity = 0;
+        vec->elem_size = elem_size;
+    }
+    return vec;
+}
+
+void emlang_vec_free(emlang_vec* vec) {
+    if (!vec) return;
+
+    free(vec->data);
+    free(vec);
+}
+
+// ======================== CAPACITY ========================
+
+int emlang_vec_reserve(emlang_vec* vec, long long capacity) {
+    if (!vec) return 0;
+    if (capacity <= vec->capacity) return 1;
+    return vec_realloc(vec, capacity);
+}
+
+int emlang_vec_grow(emlang_vec* vec, long long min_capacity) {
+    if (!vec) return 0;
+    if (min_capacity <= vec->capacity) return 1;
+
+    // Grow by 1.5x so freed blocks can eventually be reused by the allocator
+    long long capacity = vec->capacity < VEC_MIN_CAPACITY ? VEC_MIN_CAPACITY : vec->capacity + vec->capacity / 2;
+    if (capacity < min_capacity) capacity = min_capacity;
+    return vec_realloc(vec, capacity);
+}
+
+void emlang_vec_shrink(emlang_vec* vec) {
+    if (!vec || vec->capacity == vec->length) return;
+
+    if (vec->length == 0) {
+        free(vec->data);
+        vec->data = nullptr;
+        vec->capacity = 0;
+        return;
+    }
+    vec_realloc(vec, vec->length);
+}
+
+int emlang_vec_resize(emlang_vec* vec, long long length) {
+    if (!vec || length < 0) return 0;
+
+    if (length > vec->length) {
+        if (!emlang_vec_grow(vec, length)) return 0;
+        char* base = static_cast<char*>(vec->data);
+        memset(base + vec->length * vec->elem_size, 0,
+               static_cast<size_t>((length - vec->length) * vec->elem_size));
+    }
+    vec->length = length;
+    return 1;
+}
+
+void emlang_vec_clear(emlang_vec* vec) {
+    if (vec) {
+        vec->length = 0;
+    }
+}
+
+// ======================== ELEMENTS ========================
+
+long long emlang_vec_length(const emlang_vec* vec) {
+    return vec ? vec->length : 0;
+}
+
+int emlang_vec_push(emlang_vec* vec, const void* elem) {
+    return emlang_vec_append(vec, elem, 1);
+}
+
+int emlang_vec_append(emlang_vec* vec, const void* elems, long long count) {
+    if (!vec || count < 0 || (count > 0 && !elems)) return 0;
+    if (count == 0) return 1;
+    if (!emlang_vec_grow(vec, vec->length + count)) return 0;
+
+    char* base = static_cast<char*>(vec->data);
+    memcpy(base + vec->length * vec->elem_size, elems, static_cast<size_t>(count * vec->elem_size));
+    vec->length += count;
+    return 1;
+}
+
+int emlang_vec_pop(emlang_vec* vec, void* out) {
+    if (!vec || vec->length == 0) return 0;
+
+    vec->length--;
+    if (out) {
+        char* base = static_cast<char*>(vec->data);
+        memcpy(out, base + vec->length * vec->elem_size, static_cast<size_t>(vec->elem_size));
+    }
+    return 1;
+}
+
+void* emlang_vec_at(const emlang_vec* vec, long long index) {
+    if (!vec || index < 0 || index >= vec->length) return nullptr;
+    return static_cast<char*>(vec->data) + index * vec->elem_size;
+}
+
+void emlang_vec_index_fail(long long index, long long length) {
+    fprintf(stderr, "Runtime Error: vector index %lld out of range for length %lld\n", index, length);
+    fflush(stderr);
+    abort();
+}
+
+void emlang_vec_alloc_fail(long long capacity) {
+    fprintf(stderr, "Runtime Error: failed to grow vector to %lld elements\n", capacity);
+    fflush(stderr);
+    abort();
+}
+
+} // extern "C"
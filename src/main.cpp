@@ -39,6 +39,16 @@ static void printUsage(const char* programName) {
     std::cout << "  -O2                     Enable more optimizations" << std::endl;
     std::cout << "  -O3                     Enable aggressive optimizations" << std::endl;
     std::cout << "  --emit-llvm             Output LLVM IR instead of object file" << std::endl;
+    std::cout << "  --heap-profile          Sample allocations and write a pprof heap profile" << std::endl;
+    std::cout << "  --instrument-functions  Profile function entry/exit (=xray for XRay sleds)" << std::endl;
+    std::cout << "  -g                      Emit source-level debug info" << std::endl;
+    std::cout << "  -fno-omit-frame-pointer Keep frame pointers for cheap stack unwinding" << std::endl;
+    std::cout << "  --bounds-checks         Check array and slice indices at run time" << std::endl;
+    std::cout << "  --checked-arith         Abort on integer overflow in + - * and negation" << std::endl;
+    std::cout << "  -ffast-math             Let floating-point math be reordered, contracted and approximated" << std::endl;
+    std::cout << "  -fno-math-errno         Treat math builtins as pure, without errno side effects" << std::endl;
+    std::cout << "  -ffp-contract=fast|off  Fuse (or never fuse) multiply-adds into FMA instructions" << std::endl;
+    std::cout << "  --whole-program         Strip code unreachable from main and #[export] (link with --gc-sections)" << std::endl;
     std::cout << "  --debug                 Enable debug output" << std::endl;
     std::cout << "  -h, --help              Show this help message" << std::endl;
 }
@@ -47,6 +57,17 @@ struct CompilerOptions {
     std::string inputFile;
     std::string outputFile;
     bool emitLLVM = false;
+    bool heapProfile = false;
+    emlang::codegen::CodegenOptions::FunctionInstrumentation instrumentFunctions =
+        emlang::codegen::CodegenOptions::FunctionInstrumentation::None;
+    bool debugInfo = false;
+    bool framePointers = false;
+    bool boundsChecks = false;
+    bool checkedArith = false;
+    bool fastMath = false;
+    bool mathErrno = true;
+    bool fpContractFast = false;
+    bool wholeProgram = false;
     bool debug = false;
     bool showHelp = false;
 };
@@ -73,6 +94,39 @@ static CompilerOptions parseArguments(int argc, char* argv[]) {
             
         } else if (arg == "--emit-llvm") {
             options.emitLLVM = true;
+        } else if (arg == "--heap-profile") {
+            options.heapProfile = true;
+        } else if (arg == "--instrument-functions") {
+            options.instrumentFunctions = emlang::codegen::CodegenOptions::FunctionInstrumentation::Hooks;
+        } else if (arg == "--instrument-functions=xray") {
+            options.instrumentFunctions = emlang::codegen::CodegenOptions::FunctionInstrumentation::XRay;
+        } else if (arg == "-g") {
+            options.debugInfo = true;
+        } else if (arg == "-fno-omit-frame-pointer") {
+            options.framePointers = true;
+        } else if (arg == "-fomit-frame-pointer") {
+            options.framePointers = false;
+        } else if (arg == "--bounds-checks") {
+            options.boundsChecks = true;
+        } else if (arg == "--checked-arith") {
+            options.checkedArith = true;
+        } else if (arg == "-ffast-math") {
+            // Like C compilers, fast math implies the two narrower switches
+            options.fastMath = true;
+            options.mathErrno = false;
+            options.fpContractFast = true;
+        } else if (arg == "-fno-fast-math") {
+            options.fastMath = false;
+        } else if (arg == "-fno-math-errno") {
+            options.mathErrno = false;
+        } else if (arg == "-fmath-errno") {
+            options.mathErrno = true;
+        } else if (arg == "-ffp-contract=fast") {
+            options.fpContractFast = true;
+        } else if (arg == "-ffp-contract=off") {
+            options.fpContractFast = false;
+        } else if (arg == "--whole-program") {
+            options.wholeProgram = true;
         } else if (arg == "--debug") {
             options.debug = true;
         } else if (arg.substr(0, 1) == "-") {
@@ -164,9 +218,28 @@ int main(int argc, char* argv[]) {
             std::cout << "=== CODE GENERATION ===" << std::endl;
         }
         
-        emlang::codegen::CodeGenerator codegen("emlang_module");
+        emlang::codegen::CodegenOptions codegenOptions;
+        codegenOptions.heapProfile = options.heapProfile;
+        codegenOptions.instrumentFunctions = options.instrumentFunctions;
+        codegenOptions.sourceFile = options.inputFile;
+        codegenOptions.debugInfo = options.debugInfo;
+        codegenOptions.framePointers = options.framePointers;
+        codegenOptions.boundsChecks = options.boundsChecks;
+        codegenOptions.checkedArith = options.checkedArith;
+        codegenOptions.fastMath = options.fastMath;
+        codegenOptions.mathErrno = options.mathErrno;
+        codegenOptions.fpContractFast = options.fpContractFast;
+        codegenOptions.wholeProgram = options.wholeProgram;
+        
+        emlang::codegen::CodeGenerator codegen("emlang_module", codegenOptions);
         codegen.generateIR(*ast);
         
+        if (options.checkedArith) {
+            const auto& exprGenerator = codegen.getExprGenerator();
+            std::cout << "Overflow checks: " << exprGenerator.getOverflowChecksEmitted() << " emitted, "
+                      << exprGenerator.getOverflowChecksRemoved() << " removed by range analysis" << std::endl;
+        }
+        
         if (options.debug) {
             codegen.printIR();
         }
@@ -0,0 +1,60 @@
+// Whole-Array Expression Test
+// Elementwise arithmetic over arrays and slices, fused into single loops, and sum reductions
+
+function dot(a: []int64, b: []int64): int64 {
+    return sum(a * b);
+}
+
+function main(): int32 {
+    let a: int64[8];
+    let b: int64[8];
+    let c: int64[8];
+    for i in 0..8 {
+        a[i] = i;
+        b[i] = 10 - i;
+    }
+
+    c = a * b + a;
+    emlang_print_int(c[3]);
+    emlang_println();
+    emlang_print_int(sum(c));
+    emlang_println();
+    emlang_print_int(dot(a[..], b[..]));
+    emlang_println();
+
+    // Scalars apply to every element
+    c = -a * 2 - 1;
+    emlang_print_int(sum(c[2..6]));
+    emlang_println();
+
+    // Assigning through a slice writes the elements it views
+    let tail: []int64 = c[4..];
+    tail = a[..4] + b[4..];
+    emlang_print_int(c[5]);
+    emlang_println();
+
+    // A target overlapping an operand at another offset sees the operand's old values
+    let shifted: []int64 = a[1..];
+    shifted = a[..7] * 2;
+    emlang_print_int(a[7]);
+    emlang_println();
+
+    // Unsigned elements divide and take remainders as unsigned
+    let big: uint8[2] = [200, 250];
+    let third: uint8[2];
+    third = big / 3 + big % 7;
+    emlang_print_int(third[0]);
+    emlang_println();
+    emlang_print_int(third[1]);
+    emlang_println();
+
+    let x: double[4];
+    let y: double[4];
+    for i in 0..4 {
+        x[i] = 1.5;
+    }
+    y = x * 2.0 + x;
+    emlang_print_float(sum(y));
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Async Test
+// Async functions run as coroutines on the single-threaded executor
+
+async function leaf(value: int64): int64 {
+    // Give every other ready task a turn before finishing
+    yield_now();
+    return value;
+}
+
+async function tree(depth: int64, value: int64): int64 {
+    if (depth == 0) {
+        return await leaf(value);
+    }
+    // Both halves are started before either is awaited, so they run concurrently
+    let left = tree(depth - 1, value * 2);
+    let right = tree(depth - 1, value * 2 + 1);
+    return await left + await right;
+}
+
+async function countdown(from: int64): void {
+    let i: int64 = from;
+    while (i > 0) {
+        emlang_print_int(i);
+        emlang_println();
+        yield_now();
+        i = i - 1;
+    }
+}
+
+async function twice(value: int64): int64 {
+    let ticker = countdown(2);
+    let first: task<int64> = leaf(value);
+    await ticker;
+    return await first * 2;
+}
+
+function main(): int32 {
+    // 4096 leaves are suspended at once before the first one finishes
+    emlang_print_int(await tree(12, 1));
+    emlang_println();
+    emlang_print_int(await twice(21));
+    emlang_println();
+    await countdown(3);
+
+    // A task is awaited once; each branch may await it because only one runs
+    let pending = leaf(5);
+    if (emlang_abs(-1) == 1) {
+        emlang_print_int(await pending);
+    } else {
+        emlang_print_int(-(await pending));
+    }
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,48 @@
+// Function Attribute Test
+// Inlining, layout and optimization hints on functions
+
+#[pure, inline(always)]
+function square(x: int32): int32 {
+    return x * x;
+}
+
+#[pure]
+function sum_squares(n: int32): int32 {
+    if (n == 0) {
+        return 0;
+    }
+    return square(n) + sum_squares(n - 1);
+}
+
+#[cold]
+#[noinline]
+function report_failure(code: int32): void {
+    emlang_print_int(code);
+    emlang_println();
+}
+
+#[hot, opt(3)]
+function accumulate(limit: int32): int32 {
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while (i < limit) {
+        total = total + square(i);
+        i = i + 1;
+    }
+    return total;
+}
+
+#[optnone]
+function checksum(value: int32): int32 {
+    return value % 1000;
+}
+
+function main(): int32 {
+    let total: int32 = accumulate(10);
+    if (total != sum_squares(9)) {
+        report_failure(total);
+    }
+    emlang_print_int(checksum(total));
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,25 @@
+// Benchmark Test
+// Times a small kernel with the built-in harness
+
+function sum_to(n: int32): int32 {
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while (i < n) {
+        total = total + i;
+        i = i + 1;
+    }
+    return total;
+}
+
+function main(): int32 {
+    let start = emlang_now_ns();
+
+    let b = emlang_bench_begin("sum_to(1000)");
+    while (emlang_bench_iteration(b) != 0) {
+        emlang_bench_consume(sum_to(1000));
+    }
+    emlang_bench_end(b);
+
+    emlang_bench_consume(emlang_now_ns() - start);
+    return 0;
+}
@@ -0,0 +1,37 @@
+// Checked Arithmetic Test
+// Build with --checked-arith: every result fits, so the program runs to the end
+
+function scale(values: []int64, factor: int64): int64 {
+    let total: int64 = 0;
+    for i in 0..slice_len(values) {
+        // i + 1 stays below the slice length: its check is removed
+        total = total + values[i] * factor + (i + 1);
+    }
+    return total;
+}
+
+function main(): int32 {
+    let numbers: int64[8];
+    for i in 0..8 {
+        // Both bounds are constants, so i * 1000 - 3 provably fits
+        numbers[i] = i * 1000 - 3;
+    }
+    emlang_print_int(scale(numbers[..], 2));
+    emlang_println();
+
+    let big: int32 = 2000000000;
+    let small: int32 = -147483647;
+    emlang_print_int(big + small);
+    emlang_println();
+    emlang_print_int(-small);
+    emlang_println();
+
+    let digits: int32 = 0;
+    for n in 0..100 {
+        // A remainder by 10 is at most 9 in magnitude
+        digits = digits + n % 10 * 3;
+    }
+    emlang_print_int(digits);
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Const Array Test
+// Array literals: read-only tables, bulk-copied initializers and fill loops
+
+const PRIMES: int32[6] = [2, 3, 5, 7, 11, 13];
+
+function digit_sum(digits: []uint8): int32 {
+    let sum: int32 = 0;
+    for i in 0..slice_len(digits) {
+        sum = sum + digits[i];
+    }
+    return sum;
+}
+
+function main(): int32 {
+    // Read in place from read-only data
+    const squares: int32[5] = [0, 1, 4, 9, 16];
+    const offsets: int64[3] = [-1, 0, 1];
+    emlang_print_int(squares[3] + PRIMES[5]);
+    emlang_println();
+    emlang_print_int(offsets[0]);
+    emlang_println();
+
+    // Copied to the stack with one memcpy, then modified
+    let digits: uint8[4] = [1, 9, 8, 4];
+    let two: uint8 = 2;
+    digits[0] = two;
+    emlang_print_int(digit_sum(digits[..]));
+    emlang_println();
+
+    // Constant slots are copied, the rest stored; the run of fill is a loop
+    let fill: int32 = 7;
+    let mixed: int32[12] = [1, fill, 3, fill, fill, fill, fill, fill, fill, fill, fill, 12];
+    let total: int32 = 0;
+    for i in 0..12 {
+        total = total + mixed[i];
+    }
+    emlang_print_int(total);
+    emlang_println();
+
+    // Untyped literals are fixed-size arrays
+    let inferred = [10, 20, 30];
+    inferred[1] = 5;
+    emlang_print_int(inferred[0] + inferred[1] + inferred[2]);
+    emlang_println();
+    return 0;
+}
@@ -17,3 +17,13 @@ function duplicate() : number { return 1; }
 function duplicate() : string { return "hello"; } // Error: Duplicate function
 
 let z: boolean = 5 + true; // Error: Type mismatch in binary operation
+
+#[pure]
+function total(s: []int64): int64 {
+    return sum(s); // Error: pure function reads memory through a slice
+}
+
+#[pure]
+function double_all(s: []int64): void {
+    s = s * 2; // Error: pure function reads and writes memory through a slice
+}
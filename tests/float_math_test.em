@@ -0,0 +1,73 @@
+// Float Math Test
+// Float, unsigned and signed arithmetic lowered by operand type; build with
+// -ffast-math or -ffp-contract=fast to let the dot product vectorize and fuse
+
+#[fast_math]
+function dot(a: []double, b: []double): double {
+    let total: double = 0.0;
+    for i in 0..slice_len(a) {
+        total = total + a[i] * b[i];
+    }
+    return total;
+}
+
+function average(values: []float): float {
+    let total: float = 0.0;
+    for i in 0..slice_len(values) {
+        total = total + values[i];
+    }
+    return total / slice_len(values);
+}
+
+function widen(value: uint32): uint32 {
+    return value;
+}
+
+function byte_of(value: uint8): uint32 {
+    return value;
+}
+
+function main(): int32 {
+    let a: double[4];
+    let b: double[4];
+    for i in 0..4 {
+        a[i] = i + 0.5;
+        b[i] = 2.0;
+    }
+    // (0.5 + 1.5 + 2.5 + 3.5) * 2 = 16
+    emlang_print_int(dot(a[..], b[..]));
+    emlang_println();
+
+    let samples: float[3];
+    samples[0] = 1.5;
+    samples[1] = 2.0;
+    samples[2] = 2.5;
+    emlang_print_float(average(samples[..]));
+    emlang_println();
+
+    // Unsigned values divide and compare without the sign bit
+    let base: uint32 = 3000000;
+    let large: uint32 = base * 1000;
+    let half: uint32 = large / 2;
+    emlang_print_int(half > 1000000000);
+    emlang_println();
+
+    // Unsigned values widen with zeros: initializer, assignment, argument and return
+    let byte: uint8 = 200;
+    let word: uint32 = byte;
+    let wide: uint64 = 0;
+    wide = byte;
+    emlang_print_int(word + wide + widen(byte) + byte_of(byte));
+    emlang_println();
+
+    // Literal-only arithmetic keeps double precision in a double
+    let third: double = 1.0 / 3.0;
+    emlang_print_int(third * 3.0 == 1.0);
+    emlang_println();
+
+    // Signed division truncates toward zero
+    let negative: int32 = -7;
+    emlang_print_int(negative / 2);
+    emlang_println();
+    return 0;
+}
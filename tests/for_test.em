@@ -0,0 +1,64 @@
+// For Test
+// Counted range loops with default and constant steps, empty ranges and nesting,
+// and C-style loops
+
+function sum(values: []int64): int64 {
+    let total: int64 = 0;
+    for i in 0..slice_len(values) {
+        total = total + values[i];
+    }
+    return total;
+}
+
+function main(): int32 {
+    let numbers: int64[10];
+    for i in 0..10 {
+        numbers[i] = i + 1;
+    }
+    emlang_print_int(sum(numbers[..]));
+    emlang_println();
+
+    // 1 + 4 + 7 + 10: the last value stops short of the end
+    let stepped: int64 = 0;
+    for i in 1..11 step 3 {
+        stepped = stepped + i;
+    }
+    emlang_print_int(stepped);
+    emlang_println();
+
+    let empty: int32 = 0;
+    for i in 5..5 {
+        empty = empty + 1;
+    }
+    for i in 7..2 {
+        empty = empty + 1;
+    }
+    emlang_print_int(empty);
+    emlang_println();
+
+    let n: int64 = 4;
+    let cells: int32 = 0;
+    for row in 0..n {
+        for col in row..n step 2 {
+            cells = cells + 1;
+        }
+    }
+    emlang_print_int(cells);
+    emlang_println();
+
+    let negative: int32 = 0;
+    for i in -3..3 {
+        negative = negative + i;
+    }
+    emlang_print_int(negative);
+    emlang_println();
+
+    // 1 + 2 + 4 + 8 + 16 + 32 + 64
+    let powers: int32 = 0;
+    for (let p: int32 = 1; p < 100; p = p * 2) {
+        powers = powers + p;
+    }
+    emlang_print_int(powers);
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,28 @@
+// Function Instrumentation Test
+// Compile with --instrument-functions; folded stacks go to emlang-functions.folded
+// and the self/total table to stderr when the program exits
+
+function fibonacci(n: int32): int32 {
+    if (n <= 1) {
+        return n;
+    }
+    return fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+function spin(count: int32): int32 {
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while (i < count) {
+        total = total + i;
+        i = i + 1;
+    }
+    return total;
+}
+
+function main(): int32 {
+    emlang_print_int(fibonacci(20));
+    emlang_println();
+    emlang_print_int(spin(100000));
+    emlang_println();
+    return 0;
+}
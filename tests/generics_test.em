@@ -0,0 +1,64 @@
+// Generics Test
+// Generic functions specialized per type: deduction, constraints, shared instances
+
+function max<T: numeric>(a: T, b: T): T {
+    if (a > b) {
+        return a;
+    }
+    return b;
+}
+
+function min<T: numeric>(a: T, b: T): T {
+    if (a < b) {
+        return a;
+    }
+    return b;
+}
+
+function clamp<T: numeric>(value: T, low: T, high: T): T {
+    return min(max(value, low), high);
+}
+
+function total<T: numeric>(values: []T): T {
+    let result: T = 0;
+    for i in 0..slice_len(values) {
+        result = result + values[i];
+    }
+    return result;
+}
+
+function first<T>(values: []T): T {
+    return values[0];
+}
+
+function main(): int32 {
+    let small: int32 = 3;
+    let large: int64 = 40;
+
+    // max.int32 is shared by both calls; the literal takes the type of the variable
+    emlang_print_int(max(small, 7));
+    emlang_println();
+    emlang_print_int(max(9, small));
+    emlang_println();
+    emlang_print_int(max(large, 2));
+    emlang_println();
+    emlang_print_float(max(1.5, 2.5));
+    emlang_println();
+    // An integer literal next to a float literal deduces float, not int32
+    emlang_print_float(max(2, 2.5));
+    emlang_println();
+
+    // clamp.int32 calls min.int32 and reuses max.int32 from its body
+    emlang_print_int(clamp(small, 5, 10));
+    emlang_println();
+
+    let numbers: int64[4];
+    for i in 0..4 {
+        numbers[i] = i * 10;
+    }
+    emlang_print_int(total(numbers[..]));
+    emlang_println();
+    emlang_print_int(first(numbers[1..]));
+    emlang_println();
+    return 0;
+}
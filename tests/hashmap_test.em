@@ -0,0 +1,32 @@
+// Hash Map Test
+// Inserts, looks up, erases and iterates int64 and string keyed maps
+
+function main(): int32 {
+    let counts = emlang_hashmap_new_str();
+    emlang_hashmap_insert_str(counts, "apple", 3);
+    emlang_hashmap_insert_str(counts, "pear", 5);
+    emlang_hashmap_insert_str(counts, "apple", 4);
+    emlang_print_int(emlang_hashmap_get_str(counts, "apple", 0));
+    emlang_println();
+
+    let squares = emlang_hashmap_new();
+    let i: int32 = 0;
+    while (i < 100) {
+        emlang_hashmap_insert(squares, i, i * i);
+        i = i + 1;
+    }
+    emlang_hashmap_erase(squares, 7);
+
+    let total: int32 = 0;
+    let slot: int32 = emlang_hashmap_next(squares, 0);
+    while (slot >= 0) {
+        total = total + 1;
+        slot = emlang_hashmap_next(squares, slot + 1);
+    }
+    emlang_print_int(total);
+    emlang_println();
+
+    emlang_hashmap_free(squares);
+    emlang_hashmap_free(counts);
+    return 0;
+}
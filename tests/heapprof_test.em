@@ -0,0 +1,29 @@
+// Heap Profiling Test
+// Compile with --heap-profile and inspect with: pprof -top emlang-heap.pb
+
+function leak(count: int32): int32 {
+    let i: int32 = 0;
+    while (i < count) {
+        emlang_malloc(4096);
+        i = i + 1;
+    }
+    return count;
+}
+
+function churn(count: int32): int32 {
+    let i: int32 = 0;
+    while (i < count) {
+        let block = emlang_malloc(1024);
+        emlang_free(block);
+        i = i + 1;
+    }
+    return count;
+}
+
+function main(): int32 {
+    leak(2000);
+    churn(20000);
+    emlang_print_int(emlang_heapprof_dump("emlang-heap.pb"));
+    emlang_println();
+    return 0;
+}
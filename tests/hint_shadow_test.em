@@ -0,0 +1,28 @@
+// Hint Shadow Test
+// A program's own likely and prefetch take precedence over the hint intrinsics
+
+function likely(count: int32): bool {
+    return count > 2;
+}
+
+function prefetch(values: []int32, index: int64, weight: int32): int32 {
+    return values[index] * weight;
+}
+
+function main(): int32 {
+    let seen: int32 = 0;
+    let i: int32 = 0;
+    while (i < 5) {
+        if likely(i) {
+            seen = seen + 1;
+        }
+        i = i + 1;
+    }
+    emlang_print_int(seen);
+    emlang_println();
+
+    let values: int32[3] = [4, 5, 6];
+    emlang_print_int(prefetch(values[..], 1, 3));
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,32 @@
+// Branch Hint Test
+// Marks the error path cold and prefetches ahead of a sum
+
+function checked_div(a: int32, b: int32): int32 {
+    if unlikely(b == 0) {
+        return 0;
+    }
+    return a / b;
+}
+
+function main(): int32 {
+    let buffer = emlang_malloc(4096);
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while likely(i < 10) {
+        prefetch(buffer, 0, 3);
+        total = total + checked_div(70, i);
+        i = i + 1;
+    }
+    // A hint may also start a longer condition
+    if likely(total > 0) && i == 10 {
+        emlang_print_int(i);
+        emlang_println();
+    }
+    let large: bool = likely(total > 100);
+    if (large) {
+        emlang_print_int(total);
+    }
+    emlang_println();
+    emlang_free(buffer);
+    return 0;
+}
@@ -0,0 +1,17 @@
+// Number Test
+// Parsing and shortest round-trip formatting of int64 and double
+
+function main(): int32 {
+    let big = emlang_str_to_int64("-9223372036854775808");
+    let text = emlang_int64_to_str(big);
+    emlang_print(text);
+    emlang_println();
+    emlang_free(text);
+
+    let third = emlang_str_to_double("3.33333333333333314829616256247390992939472198486328125e-1");
+    let shortest = emlang_double_to_str(third);
+    emlang_print(shortest);
+    emlang_println();
+    emlang_free(shortest);
+    return 0;
+}
@@ -0,0 +1,25 @@
+// Performance Counter Test
+// Measures nested regions; the summary is printed to stderr at exit
+
+function sum_to(n: int32): int32 {
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while (i < n) {
+        total = total + i;
+        i = i + 1;
+    }
+    return total;
+}
+
+function main(): int32 {
+    let round: int32 = 0;
+    emlang_perf_begin("main loop");
+    while (round < 100) {
+        emlang_perf_begin("sum_to");
+        emlang_bench_consume(sum_to(10000));
+        emlang_perf_end("sum_to");
+        round = round + 1;
+    }
+    emlang_perf_end("main loop");
+    return 0;
+}
@@ -0,0 +1,25 @@
+// Restrict Test
+// Restrict pointers: noalias parameters and scoped alias metadata on element accesses
+
+function scale(dst: int32* restrict, src: int32* restrict, n: int32, k: int32): void {
+    for i in 0..n {
+        dst[i] = src[i] * k;
+    }
+}
+
+function main(): int32 {
+    let input: int32[4] = [1, 2, 3, 4];
+    let output: int32[4] = [0, 0, 0, 0];
+    scale(&output[0], &input[0], 4, 10);
+    emlang_print_int(output[0] + output[1] + output[2] + output[3]);
+    emlang_println();
+
+    // A restrict local: the only handle to the value it points at
+    let value: int32 = 5;
+    let p: int32* restrict = &value;
+    *p = *p + 1;
+    p[0] = p[0] * 7;
+    emlang_print_int(value);
+    emlang_println();
+    return 0;
+}
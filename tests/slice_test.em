@@ -0,0 +1,71 @@
+// Slice Test
+// Slices arrays and vectors, passes slices to functions and sums them in counted loops
+
+function sum(values: []int64): int64 {
+    let total: int64 = 0;
+    let i: int64 = 0;
+    while (i < slice_len(values)) {
+        total = total + values[i];
+        i = i + 1;
+    }
+    return total;
+}
+
+function fill(values: []int64, start: int64): void {
+    let i: int64 = 0;
+    while (i < slice_len(values)) {
+        values[i] = start + i;
+        i = i + 1;
+    }
+}
+
+function bump(counter: int32*): void {
+    *counter = *counter + 1;
+}
+
+function main(): int32 {
+    let numbers: int64[10];
+    fill(numbers[..], 1);
+    emlang_print_int(sum(numbers[..]));
+    emlang_println();
+    emlang_print_int(sum(numbers[2..5]));
+    emlang_println();
+
+    let tail: []int64 = numbers[7..];
+    emlang_print_int(slice_len(tail));
+    emlang_println();
+    emlang_print_int(tail[0] + numbers[..3][2]);
+    emlang_println();
+
+    let squares: vec<int64>;
+    let j: int64 = 0;
+    while (j < 6) {
+        vec_push(squares, j * j);
+        j = j + 1;
+    }
+    emlang_print_int(sum(squares[1..4]));
+    emlang_println();
+    vec_free(squares);
+
+    let counts: int32[8];
+    let k: int32 = 0;
+    while (k < 8) {
+        counts[k] = k * 2;
+        k = k + 1;
+    }
+    emlang_print_int(counts[7]);
+    emlang_println();
+
+    // A counter stepped through a pointer as well keeps its per-element checks
+    let marks: int32[4];
+    let m: int32 = 0;
+    let step = &m;
+    while (m < 4) {
+        bump(step);
+        marks[m] = m;
+        m = m + 1;
+    }
+    emlang_print_int(marks[1] + marks[3]);
+    emlang_println();
+    return 0;
+}
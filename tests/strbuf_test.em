@@ -0,0 +1,24 @@
+// String Builder and Rope Test
+// Builds strings incrementally without quadratic re-scanning
+
+function main(): int32 {
+    let sb = emlang_strbuf_new();
+    emlang_strbuf_append_str(sb, "count: ");
+    emlang_strbuf_append_int(sb, 42);
+    emlang_strbuf_append_char(sb, ' ');
+    emlang_strbuf_append_float(sb, 2.5);
+    emlang_print_str(emlang_strbuf_view(sb));
+    emlang_println();
+
+    let rope = emlang_rope_from_str("hello world");
+    emlang_rope_insert(rope, 5, ",");
+    emlang_rope_append(rope, "!");
+    emlang_strbuf_clear(sb);
+    emlang_rope_to_strbuf(rope, sb);
+    emlang_print_str(emlang_strbuf_view(sb));
+    emlang_println();
+
+    emlang_rope_free(rope);
+    emlang_strbuf_free(sb);
+    return 0;
+}
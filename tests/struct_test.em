@@ -0,0 +1,89 @@
+// Structs with layout attributes and struct-of-arrays storage
+
+struct Point {
+    x: int32,
+    y: int32
+}
+
+#[reorder]
+struct Mixed {
+    flag: bool,
+    total: int64,
+    count: int32
+}
+
+#[packed]
+struct Header {
+    tag: int32,
+    length: int64
+}
+
+#[align(64)]
+struct Counter {
+    hits: int64
+}
+
+#[soa]
+struct Particle {
+    x: int32,
+    y: int32,
+    mass: int32
+}
+
+function manhattan(p: Point): int32 {
+    return p.x + p.y;
+}
+
+function make(x: int32, y: int32): Point {
+    let p: Point = {x: x, y: y};
+    return p;
+}
+
+function main(): int32 {
+    let p: Point = {x: 3, y: 4};
+    p.y = p.y + 10;
+    emlang_print_int(manhattan(p));
+    emlang_println();
+    emlang_print_int(make(5, 6).y);
+    emlang_println();
+
+    let m: Mixed = {
+        flag: true,
+        count: 7
+    };
+    m.total = 40;
+    emlang_print_int(m.count);
+    emlang_println();
+
+    let h: Header = {tag: 1, length: 99};
+    emlang_print_int(h.length);
+    emlang_println();
+
+    let counters: Counter[4];
+    counters[2].hits = 5;
+    emlang_print_int(counters[2].hits + counters[1].hits);
+    emlang_println();
+
+    let particles: Particle[64];
+    let i: int32 = 0;
+    while (i < 64) {
+        particles[i].x = i;
+        particles[i].mass = 2;
+        i = i + 1;
+    }
+    let sum: int32 = 0;
+    i = 0;
+    while (i < 64) {
+        sum = sum + particles[i].x * particles[i].mass;
+        i = i + 1;
+    }
+    emlang_print_int(sum);
+    emlang_println();
+
+    let points: Point[8];
+    points[3] = make(1, 2);
+    points[4].x = 9;
+    emlang_print_int(points[3].x + points[3].y + points[4].x);
+    emlang_println();
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Switch Statement Test
+// Dispatches a small bytecode program through a switch
+
+function step(op: int32, acc: int32): int32 {
+    switch (op) {
+        case 0:
+            return acc + 1;
+        case 1, 2:
+            return acc * 2;
+        case 3:
+        case 4:
+            return acc - 3;
+        case -1:
+            return 0;
+        default:
+            return acc;
+    }
+}
+
+function classify(c: char): int32 {
+    let kind: int32 = 0;
+    switch (c) {
+        case 'a', 'e', 'i', 'o', 'u':
+            kind = 1;
+        case ' ':
+            kind = 2;
+        default:
+            kind = 3;
+    }
+    return kind;
+}
+
+function main(): int32 {
+    let acc: int32 = 1;
+    let pc: int32 = 0;
+    while (pc < 8) {
+        acc = step(pc, acc);
+        pc = pc + 1;
+    }
+    emlang_print_int(acc);
+    emlang_print_int(classify('e') + classify(' ') * 10 + classify('x') * 100);
+    return 0;
+}
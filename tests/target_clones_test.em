@@ -0,0 +1,29 @@
+// Target Clones Test
+// One binary, one clone per CPU feature set, picked at startup
+
+#[target_clones("avx512f", "avx2+fma", "sse4.2", "default")]
+function dot(n: int32): int32 {
+    let total: int32 = 0;
+    let i: int32 = 0;
+    while (i < n) {
+        total = total + i * (n - i);
+        i = i + 1;
+    }
+    return total;
+}
+
+#[target_clones("avx2", "default")]
+function tri(n: int32): int32 {
+    if (n == 0) {
+        return 0;
+    }
+    return n + tri(n - 1);
+}
+
+function main(): int32 {
+    emlang_print_int(dot(100));
+    emlang_println();
+    emlang_print_int(tri(50));
+    emlang_println();
+    return 0;
+}
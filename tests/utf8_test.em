@@ -0,0 +1,14 @@
+// UTF-8 Test
+// Non-ASCII identifiers and string literals, codepoint counting and slicing
+
+function main(): int32 {
+    let grüße = "Grüße, 世界! 🎉";
+    emlang_print_int(emlang_utf8_strlen(grüße));
+    emlang_println();
+
+    let world = emlang_utf8_slice(grüße, 7, 2);
+    emlang_print(world);
+    emlang_println();
+    emlang_free(world);
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Vector Test
+// Pushes, indexes, assigns and pops elements of growable vectors
+
+function main(): int32 {
+    let squares: vec<int64>;
+    let i: int32 = 0;
+    while (i < 100) {
+        vec_push(squares, i * i);
+        i = i + 1;
+    }
+    emlang_print_int(vec_len(squares));
+    emlang_println();
+
+    squares[10] = 7;
+    let total: int64 = 0;
+    let j: int32 = 0;
+    while (j < 100) {
+        total = total + squares[j];
+        j = j + 1;
+    }
+    emlang_print_int(total);
+    emlang_println();
+
+    let primes: vec<int32> = [2, 3, 5, 7, 11];
+    emlang_print_int(vec_pop(primes));
+    emlang_println();
+    emlang_print_int(vec_len(primes));
+    emlang_println();
+
+    // Nested type arguments close with a single >> token
+    let rows: vec<vec<int32>>;
+    vec_push(rows, primes);
+    emlang_print_int(vec_len(rows[0]));
+    emlang_println();
+
+    vec_free(rows);
+    vec_free(primes);
+    vec_free(squares);
+    return 0;
+}
@@ -0,0 +1,36 @@
+// Whole Program Test
+// Compile with --whole-program: only main and exported functions stay external.
+// nm on the object then defines main and checksum, and no debug_dump, dead_helper or DEBUG_NAMES.
+
+#[export]
+function checksum(value: int32): int32 {
+    return value * 31 + 7;
+}
+
+// Only reachable through main; internal, and inlined or kept private
+function scale(value: int32, factor: int32, unused: int32): int32 {
+    return value * factor;
+}
+
+// Only read by dead code; removed from the object file
+const DEBUG_NAMES: int32[4] = [100, 200, 300, 400];
+
+// Never called; removed from the object file
+function debug_dump(value: int32): void {
+    emlang_print_int(DEBUG_NAMES[value % 4] + value);
+    emlang_println();
+}
+
+// Only called from dead code; removed along with it
+function dead_helper(value: int32): int32 {
+    debug_dump(value);
+    return value;
+}
+
+function main(): int32 {
+    emlang_print_int(scale(6, 7, 0));
+    emlang_println();
+    emlang_print_int(checksum(3));
+    emlang_println();
+    return 0;
+}